@@ -0,0 +1,177 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "kv_index.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fstream>
+
+namespace {
+
+#ifdef MAP_POPULATE
+// Fault the whole file in up front rather than on the first lookups.
+const int kMapFlags = MAP_PRIVATE | MAP_POPULATE;
+#else
+const int kMapFlags = MAP_PRIVATE;
+#endif
+
+// 64-bit FNV-1a.
+uint64_t HashKey(const char* data, size_t size) {
+  uint64_t hash = 14695981039346656037ull;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+}  // namespace
+
+KeyValueIndex::KeyValueIndex()
+    : mask_(0), size_(0), mapping_(nullptr), mapping_size_(0) {}
+
+KeyValueIndex::~KeyValueIndex() { Clear(); }
+
+void KeyValueIndex::Clear() {
+  if (mapping_ != nullptr) munmap(mapping_, mapping_size_);
+  mapping_ = nullptr;
+  mapping_size_ = 0;
+  owned_.clear();
+  table_.clear();
+  mask_ = 0;
+  size_ = 0;
+}
+
+bool KeyValueIndex::LoadFile(const std::string& path) {
+  Clear();
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    return false;
+  }
+  if (st.st_size > 0) {
+    void* mapping = mmap(nullptr, st.st_size, PROT_READ, kMapFlags, fd, 0);
+    if (mapping == MAP_FAILED) {
+      close(fd);
+      return false;
+    }
+    mapping_ = mapping;
+    mapping_size_ = st.st_size;
+  }
+  // The mapping stays valid after the descriptor is closed.
+  close(fd);
+  Build(static_cast<const char*>(mapping_), mapping_size_);
+  return true;
+}
+
+void KeyValueIndex::LoadPairs(
+    const std::vector<std::pair<std::string, std::string>>& pairs) {
+  Clear();
+  for (const auto& pair : pairs) {
+    owned_ += pair.first;
+    owned_ += '\t';
+    owned_ += pair.second;
+    owned_ += '\n';
+  }
+  Build(owned_.data(), owned_.size());
+}
+
+void KeyValueIndex::Build(const char* data, size_t size) {
+  const char* end = data + size;
+  size_t lines = 0;
+  for (const char* p = data; p < end;) {
+    const char* eol = static_cast<const char*>(memchr(p, '\n', end - p));
+    lines++;
+    if (eol == nullptr) break;
+    p = eol + 1;
+  }
+
+  size_t capacity = 16;
+  while (capacity < 2 * lines) capacity *= 2;
+  table_.assign(capacity, Entry());
+  mask_ = capacity - 1;
+
+  for (const char* p = data; p < end;) {
+    const char* eol = static_cast<const char*>(memchr(p, '\n', end - p));
+    if (eol == nullptr) eol = end;
+    const char* tab = static_cast<const char*>(memchr(p, '\t', eol - p));
+    // Lines without a tab (including empty lines) are skipped.
+    if (tab != nullptr) {
+      Entry entry;
+      entry.key = p;
+      entry.key_size = static_cast<uint32_t>(tab - p);
+      entry.value = tab + 1;
+      entry.value_size = static_cast<uint32_t>(eol - tab - 1);
+      entry.hash = HashKey(entry.key, entry.key_size);
+      Insert(entry);
+    }
+    p = eol + 1;
+  }
+}
+
+void KeyValueIndex::Insert(const Entry& entry) {
+  for (size_t i = entry.hash & mask_;; i = (i + 1) & mask_) {
+    Entry& slot = table_[i];
+    if (slot.key == nullptr) {
+      slot = entry;
+      size_++;
+      return;
+    }
+    if (slot.hash == entry.hash && slot.key_size == entry.key_size &&
+        memcmp(slot.key, entry.key, entry.key_size) == 0) {
+      // A later line for the same key wins.
+      slot = entry;
+      return;
+    }
+  }
+}
+
+bool KeyValueIndex::Lookup(grpc::string_ref key,
+                           grpc::string_ref* value) const {
+  if (table_.empty()) return false;
+  const uint64_t hash = HashKey(key.data(), key.size());
+  for (size_t i = hash & mask_;; i = (i + 1) & mask_) {
+    const Entry& slot = table_[i];
+    if (slot.key == nullptr) return false;
+    if (slot.hash == hash && slot.key_size == key.size() &&
+        memcmp(slot.key, key.data(), key.size()) == 0) {
+      *value = grpc::string_ref(slot.value, slot.value_size);
+      return true;
+    }
+  }
+}
+
+bool WriteSampleDataFile(const std::string& path, int num_keys,
+                         int value_size) {
+  std::ofstream out(path.c_str(), std::ios::out | std::ios::trunc);
+  if (!out) return false;
+  for (int i = 0; i < num_keys; ++i) {
+    std::string value = "value" + std::to_string(i);
+    value.resize(value_size > 0 ? value_size : value.size(), '.');
+    out << "key" << i << '\t' << value << '\n';
+  }
+  out.close();
+  return !out.fail();
+}
@@ -0,0 +1,89 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_EXAMPLES_CPP_KEYVALUESTORE_KV_INDEX_H
+#define GRPC_EXAMPLES_CPP_KEYVALUESTORE_KV_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <grpcpp/support/string_ref.h>
+
+// An immutable hash index over a key-value data file.
+//
+// The data file holds one "key<TAB>value" pair per line. It is memory-mapped
+// and the index only stores pointers into the mapping, so loading does not
+// copy keys or values and the resident data is shared with the page cache.
+// Once built the index is never modified: any number of threads can call
+// Lookup() concurrently without locks.
+class KeyValueIndex {
+ public:
+  KeyValueIndex();
+  ~KeyValueIndex();
+
+  KeyValueIndex(const KeyValueIndex&) = delete;
+  KeyValueIndex& operator=(const KeyValueIndex&) = delete;
+
+  // Maps and indexes the data file at \a path. Returns false if the file
+  // cannot be opened or mapped.
+  bool LoadFile(const std::string& path);
+
+  // Indexes an in-memory copy of \a pairs, for small or test data sets.
+  void LoadPairs(const std::vector<std::pair<std::string, std::string>>& pairs);
+
+  // Returns true and points \a value at the value of \a key if it is present.
+  // \a value stays valid for the lifetime of the index.
+  bool Lookup(grpc::string_ref key, grpc::string_ref* value) const;
+
+  size_t size() const { return size_; }
+
+ private:
+  struct Entry {
+    const char* key;  // nullptr for an empty slot
+    const char* value;
+    uint32_t key_size;
+    uint32_t value_size;
+    uint64_t hash;
+  };
+
+  void Clear();
+  void Build(const char* data, size_t size);
+  void Insert(const Entry& entry);
+
+  // Open addressing with linear probing; the table is a power of two at least
+  // twice as large as the number of keys.
+  std::vector<Entry> table_;
+  size_t mask_;
+  size_t size_;
+
+  // Either a read-only mapping of the data file, or owned_ for LoadPairs().
+  void* mapping_;
+  size_t mapping_size_;
+  std::string owned_;
+};
+
+// Writes a data file of \a num_keys pairs "key<i>" -> \a value_size bytes, as
+// used by the load client. Returns false on I/O error.
+bool WriteSampleDataFile(const std::string& path, int num_keys,
+                         int value_size);
+
+#endif  // GRPC_EXAMPLES_CPP_KEYVALUESTORE_KV_INDEX_H
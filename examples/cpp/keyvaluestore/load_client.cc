@@ -0,0 +1,189 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Load generator for the key-value store server.
+//
+// Each thread opens its own channel and one stream, then sends requests for
+// random keys "key0".."key<num_keys - 1>" back to back, one request in flight
+// at a time, for the given duration. With --batch=1 every key is a GetValues
+// request; with --batch=N > 1 the keys go N at a time through GetValuesBatch.
+// At the end the client reports the throughput and the latency percentiles
+// of the requests.
+//
+// Usage: keyvaluestore_load_client [--target=ADDR] [--threads=N]
+//                                  [--seconds=N] [--batch=N] [--num_keys=N]
+//
+// The keys match the sample data file written by
+// "keyvaluestore_server --data_file=PATH --generate_keys=N".
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <grpcpp/grpcpp.h>
+
+#ifdef BAZEL_BUILD
+#include "examples/protos/keyvaluestore.grpc.pb.h"
+#else
+#include "keyvaluestore.grpc.pb.h"
+#endif
+
+using grpc::Channel;
+using grpc::ClientContext;
+using grpc::Status;
+using keyvaluestore::BatchRequest;
+using keyvaluestore::BatchResponse;
+using keyvaluestore::KeyValueStore;
+using keyvaluestore::Request;
+using keyvaluestore::Response;
+
+typedef std::chrono::steady_clock Clock;
+
+struct ThreadStats {
+  long keys = 0;
+  long errors = 0;
+  // Latency of each request, in microseconds.
+  std::vector<double> latencies;
+};
+
+// Runs requests on one stream until \a end, recording them in \a stats.
+void RunThread(const std::string& target, int batch, int num_keys, int seed,
+               Clock::time_point end, ThreadStats* stats) {
+  grpc::ChannelArguments args;
+  // Each thread gets its own connection.
+  args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+  std::unique_ptr<KeyValueStore::Stub> stub(KeyValueStore::NewStub(
+      grpc::CreateCustomChannel(target, grpc::InsecureChannelCredentials(),
+                                args)));
+  std::mt19937 random(seed);
+  std::uniform_int_distribution<int> pick_key(0, num_keys - 1);
+  auto next_key = [&]() { return "key" + std::to_string(pick_key(random)); };
+
+  ClientContext context;
+  if (batch <= 1) {
+    auto stream = stub->GetValues(&context);
+    Request request;
+    Response response;
+    while (Clock::now() < end) {
+      request.set_key(next_key());
+      Clock::time_point start = Clock::now();
+      if (!stream->Write(request) || !stream->Read(&response)) {
+        stats->errors++;
+        break;
+      }
+      stats->latencies.push_back(
+          std::chrono::duration<double, std::micro>(Clock::now() - start)
+              .count());
+      stats->keys++;
+    }
+    stream->WritesDone();
+    if (!stream->Finish().ok()) stats->errors++;
+  } else {
+    auto stream = stub->GetValuesBatch(&context);
+    BatchRequest request;
+    BatchResponse response;
+    while (Clock::now() < end) {
+      request.clear_keys();
+      for (int i = 0; i < batch; i++) request.add_keys(next_key());
+      Clock::time_point start = Clock::now();
+      if (!stream->Write(request) || !stream->Read(&response)) {
+        stats->errors++;
+        break;
+      }
+      stats->latencies.push_back(
+          std::chrono::duration<double, std::micro>(Clock::now() - start)
+              .count());
+      stats->keys += response.values_size();
+    }
+    stream->WritesDone();
+    if (!stream->Finish().ok()) stats->errors++;
+  }
+}
+
+double Percentile(const std::vector<double>& sorted, double percentile) {
+  if (sorted.empty()) return 0;
+  size_t index = static_cast<size_t>(percentile / 100 * (sorted.size() - 1));
+  return sorted[index];
+}
+
+int main(int argc, char** argv) {
+  std::string target("localhost:50051");
+  int num_threads = 4;
+  int seconds = 10;
+  int batch = 1;
+  int num_keys = 5;
+  for (int i = 1; i < argc; i++) {
+    std::string arg(argv[i]);
+    if (arg.compare(0, 9, "--target=") == 0) {
+      target = arg.substr(9);
+    } else if (arg.compare(0, 10, "--threads=") == 0) {
+      num_threads = std::atoi(arg.substr(10).c_str());
+    } else if (arg.compare(0, 10, "--seconds=") == 0) {
+      seconds = std::atoi(arg.substr(10).c_str());
+    } else if (arg.compare(0, 8, "--batch=") == 0) {
+      batch = std::atoi(arg.substr(8).c_str());
+    } else if (arg.compare(0, 11, "--num_keys=") == 0) {
+      num_keys = std::atoi(arg.substr(11).c_str());
+    } else {
+      std::cerr << "Unknown argument " << arg << std::endl;
+      return 1;
+    }
+  }
+  if (num_keys < 1) num_keys = 1;
+
+  std::vector<ThreadStats> stats(num_threads);
+  std::vector<std::thread> threads;
+  Clock::time_point start = Clock::now();
+  Clock::time_point end = start + std::chrono::seconds(seconds);
+  for (int i = 0; i < num_threads; i++) {
+    threads.emplace_back(RunThread, target, batch, num_keys, i, end,
+                         &stats[i]);
+  }
+  for (auto& thread : threads) thread.join();
+  double elapsed =
+      std::chrono::duration<double>(Clock::now() - start).count();
+
+  long keys = 0;
+  long errors = 0;
+  std::vector<double> latencies;
+  for (const ThreadStats& s : stats) {
+    keys += s.keys;
+    errors += s.errors;
+    latencies.insert(latencies.end(), s.latencies.begin(), s.latencies.end());
+  }
+  std::sort(latencies.begin(), latencies.end());
+
+  std::cout << num_threads << " threads, batch " << batch << ", "
+            << elapsed << " s" << std::endl;
+  std::cout << "  " << static_cast<long>(latencies.size() / elapsed)
+            << " requests/s, " << static_cast<long>(keys / elapsed)
+            << " keys/s";
+  if (errors > 0) std::cout << ", " << errors << " errors";
+  std::cout << std::endl;
+  std::cout << "  latency (us): p50 " << Percentile(latencies, 50) << ", p90 "
+            << Percentile(latencies, 90) << ", p99 "
+            << Percentile(latencies, 99) << ", p99.9 "
+            << Percentile(latencies, 99.9) << std::endl;
+  return errors > 0 ? 1 : 0;
+}
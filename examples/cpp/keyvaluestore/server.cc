@@ -16,82 +16,424 @@
  *
  */
 
+#include <cstdlib>
+#include <deque>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include <grpcpp/grpcpp.h>
 
 #ifdef BAZEL_BUILD
+#include "examples/cpp/keyvaluestore/kv_index.h"
 #include "examples/protos/keyvaluestore.grpc.pb.h"
 #else
+#include "kv_index.h"
 #include "keyvaluestore.grpc.pb.h"
 #endif
 
 using grpc::Server;
+using grpc::ServerAsyncReaderWriter;
 using grpc::ServerBuilder;
+using grpc::ServerCompletionQueue;
 using grpc::ServerContext;
 using grpc::ServerReaderWriter;
 using grpc::Status;
+using grpc::WriteOptions;
+using grpc::string_ref;
+using keyvaluestore::BatchRequest;
+using keyvaluestore::BatchResponse;
 using keyvaluestore::KeyValueStore;
 using keyvaluestore::Request;
 using keyvaluestore::Response;
 
-struct kv_pair {
-  const char* key;
-  const char* value;
-};
-
-static const kv_pair kvs_map[] = {
+// Served when no data file is given.
+static const std::vector<std::pair<std::string, std::string>> kDefaultPairs = {
     {"key1", "value1"}, {"key2", "value2"}, {"key3", "value3"},
     {"key4", "value4"}, {"key5", "value5"},
 };
 
-const char* get_value_from_map(const char* key) {
-  for (size_t i = 0; i < sizeof(kvs_map) / sizeof(kv_pair); ++i) {
-    if (strcmp(key, kvs_map[i].key) == 0) {
-      return kvs_map[i].value;
+// Fills in the answer to one request. Missing keys map to an empty value.
+void Answer(const KeyValueIndex& index, const Request& request,
+            Response* response) {
+  string_ref value;
+  if (index.Lookup(request.key(), &value)) {
+    response->set_value(value.data(), value.size());
+  } else {
+    response->clear_value();
+  }
+}
+
+void Answer(const KeyValueIndex& index, const BatchRequest& request,
+            BatchResponse* response) {
+  response->clear_values();
+  response->mutable_values()->Reserve(request.keys_size());
+  for (const std::string& key : request.keys()) {
+    string_ref value;
+    if (index.Lookup(key, &value)) {
+      response->add_values(value.data(), value.size());
+    } else {
+      response->add_values();
     }
   }
-  return "";
 }
 
 // Logic and data behind the server's behavior.
 class KeyValueStoreServiceImpl final : public KeyValueStore::Service {
+ public:
+  explicit KeyValueStoreServiceImpl(const KeyValueIndex* index)
+      : index_(index) {}
+
+ private:
   Status GetValues(ServerContext* context,
                    ServerReaderWriter<Response, Request>* stream) override {
     Request request;
+    Response response;
+    while (stream->Read(&request)) {
+      Answer(*index_, request, &response);
+      stream->Write(response);
+    }
+    return Status::OK;
+  }
+
+  // One write per batch of keys instead of one per key.
+  Status GetValuesBatch(
+      ServerContext* context,
+      ServerReaderWriter<BatchResponse, BatchRequest>* stream) override {
+    BatchRequest request;
+    BatchResponse response;
     while (stream->Read(&request)) {
-      Response response;
-      response.set_value(get_value_from_map(request.key().c_str()));
+      Answer(*index_, request, &response);
       stream->Write(response);
     }
     return Status::OK;
   }
+
+  const KeyValueIndex* index_;
+};
+
+// Callback API reactor serving one GetValues or GetValuesBatch stream.
+//
+// Unlike the synchronous handler, the reactor keeps reading while a response
+// is being written. Responses that pile up meanwhile are written back to back
+// with the buffer hint set on all but the last one, so that they leave in a
+// single flush instead of one per response.
+template <class RequestType, class ResponseType>
+class CoalescingReactor final
+    : public grpc::experimental::ServerBidiReactor<RequestType, ResponseType> {
+ public:
+  explicit CoalescingReactor(const KeyValueIndex* index) : index_(index) {}
+
+  void OnStarted(ServerContext* context) override {
+    this->StartRead(&request_);
+  }
+
+  void OnReadDone(bool ok) override {
+    bool read_more = false;
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      if (ok) {
+        pending_.emplace_back();
+        Answer(*index_, request_, &pending_.back());
+        read_more = true;
+      } else {
+        reads_done_ = true;
+      }
+    }
+    if (read_more) this->StartRead(&request_);
+    MaybeWrite();
+  }
+
+  void OnWriteDone(bool ok) override {
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      writing_ = false;
+      // The stream is broken; whatever is still queued cannot be delivered.
+      if (!ok) pending_.clear();
+    }
+    MaybeWrite();
+  }
+
+  void OnCancel() override {}
+
+  void OnDone() override { delete this; }
+
+ private:
+  // Starts the next write, or finishes the call once all requests have been
+  // read and answered. At most one write is in flight at a time.
+  void MaybeWrite() {
+    WriteOptions options;
+    bool write;
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      if (writing_ || finished_) return;
+      if (pending_.empty()) {
+        if (!reads_done_) return;
+        finished_ = true;
+        write = false;
+      } else {
+        writing_ = write = true;
+        in_flight_.Swap(&pending_.front());
+        pending_.pop_front();
+        if (!pending_.empty()) options.set_buffer_hint();
+      }
+    }
+    if (write) {
+      this->StartWrite(&in_flight_, options);
+    } else {
+      this->Finish(Status::OK);
+    }
+  }
+
+  const KeyValueIndex* index_;
+  RequestType request_;
+  ResponseType in_flight_;
+
+  std::mutex mu_;
+  std::deque<ResponseType> pending_;
+  bool writing_ = false;
+  bool reads_done_ = false;
+  bool finished_ = false;
+};
+
+class KeyValueStoreCallbackServiceImpl final
+    : public KeyValueStore::ExperimentalCallbackService {
+ public:
+  explicit KeyValueStoreCallbackServiceImpl(const KeyValueIndex* index)
+      : index_(index) {}
+
+ private:
+  grpc::experimental::ServerBidiReactor<Request, Response>* GetValues()
+      override {
+    return new CoalescingReactor<Request, Response>(index_);
+  }
+
+  grpc::experimental::ServerBidiReactor<BatchRequest, BatchResponse>*
+  GetValuesBatch() override {
+    return new CoalescingReactor<BatchRequest, BatchResponse>(index_);
+  }
+
+  const KeyValueIndex* index_;
+};
+
+// A completion queue tag: the event loop hands it the event's ok.
+class AsyncTag {
+ public:
+  virtual ~AsyncTag() {}
+  virtual void Done(bool ok) = 0;
 };
 
-void RunServer() {
+// Tag that forwards the event to a member function of Call.
+template <class Call>
+class AsyncEvent final : public AsyncTag {
+ public:
+  AsyncEvent(Call* call, void (Call::*handler)(bool))
+      : call_(call), handler_(handler) {}
+
+  void Done(bool ok) override { (call_->*handler_)(ok); }
+
+ private:
+  Call* call_;
+  void (Call::*handler_)(bool);
+};
+
+// Async API state machine serving one GetValues or GetValuesBatch stream.
+//
+// It behaves like CoalescingReactor: one read and one write may be in flight
+// at the same time, and the responses queued during a write are sent with the
+// buffer hint. Its events are all handled by the thread that drains the
+// completion queue, so it needs no locking.
+template <class RequestType, class ResponseType>
+class AsyncStreamCall final {
+ public:
+  typedef void (KeyValueStore::AsyncService::*RequestMethod)(
+      ServerContext*, ServerAsyncReaderWriter<ResponseType, RequestType>*,
+      grpc::CompletionQueue*, ServerCompletionQueue*, void*);
+
+  // Asks for the next call to the method; the instance deletes itself once
+  // that call is over.
+  AsyncStreamCall(KeyValueStore::AsyncService* service, RequestMethod method,
+                  ServerCompletionQueue* cq, const KeyValueIndex* index)
+      : service_(service),
+        method_(method),
+        cq_(cq),
+        index_(index),
+        stream_(&ctx_),
+        started_(this, &AsyncStreamCall::OnStarted),
+        read_done_(this, &AsyncStreamCall::OnReadDone),
+        write_done_(this, &AsyncStreamCall::OnWriteDone),
+        finish_done_(this, &AsyncStreamCall::OnFinishDone) {
+    (service_->*method_)(&ctx_, &stream_, cq_, cq_, &started_);
+  }
+
+ private:
+  void OnStarted(bool ok) {
+    // The server is shutting down.
+    if (!ok) {
+      delete this;
+      return;
+    }
+    // Serve the next client while this one is served.
+    new AsyncStreamCall(service_, method_, cq_, index_);
+    stream_.Read(&request_, &read_done_);
+  }
+
+  void OnReadDone(bool ok) {
+    if (ok) {
+      pending_.emplace_back();
+      Answer(*index_, request_, &pending_.back());
+      stream_.Read(&request_, &read_done_);
+    } else {
+      reads_done_ = true;
+    }
+    MaybeWrite();
+  }
+
+  void OnWriteDone(bool ok) {
+    writing_ = false;
+    // The stream is broken; whatever is still queued cannot be delivered.
+    if (!ok) pending_.clear();
+    MaybeWrite();
+  }
+
+  // Neither a read nor a write is in flight once the call is finished.
+  void OnFinishDone(bool ok) { delete this; }
+
+  // Starts the next write, or finishes the call once all requests have been
+  // read and answered. At most one write is in flight at a time.
+  void MaybeWrite() {
+    if (writing_ || finished_) return;
+    if (pending_.empty()) {
+      if (!reads_done_) return;
+      finished_ = true;
+      stream_.Finish(Status::OK, &finish_done_);
+      return;
+    }
+    WriteOptions options;
+    writing_ = true;
+    in_flight_.Swap(&pending_.front());
+    pending_.pop_front();
+    if (!pending_.empty()) options.set_buffer_hint();
+    stream_.Write(in_flight_, options, &write_done_);
+  }
+
+  KeyValueStore::AsyncService* service_;
+  RequestMethod method_;
+  ServerCompletionQueue* cq_;
+  const KeyValueIndex* index_;
+  ServerContext ctx_;
+  ServerAsyncReaderWriter<ResponseType, RequestType> stream_;
+  AsyncEvent<AsyncStreamCall> started_;
+  AsyncEvent<AsyncStreamCall> read_done_;
+  AsyncEvent<AsyncStreamCall> write_done_;
+  AsyncEvent<AsyncStreamCall> finish_done_;
+
+  RequestType request_;
+  ResponseType in_flight_;
+  std::deque<ResponseType> pending_;
+  bool writing_ = false;
+  bool reads_done_ = false;
+  bool finished_ = false;
+};
+
+// Serves both methods from \a cq until it is shut down.
+void HandleAsyncRpcs(KeyValueStore::AsyncService* service,
+                     ServerCompletionQueue* cq, const KeyValueIndex* index) {
+  new AsyncStreamCall<Request, Response>(
+      service, &KeyValueStore::AsyncService::RequestGetValues, cq, index);
+  new AsyncStreamCall<BatchRequest, BatchResponse>(
+      service, &KeyValueStore::AsyncService::RequestGetValuesBatch, cq, index);
+  void* tag;
+  bool ok;
+  while (cq->Next(&tag, &ok)) {
+    static_cast<AsyncTag*>(tag)->Done(ok);
+  }
+}
+
+// Usage: keyvaluestore_server [--address=ADDR] [--data_file=PATH]
+//                             [--generate_keys=N [--value_size=N]]
+//                             [--callback | --async]
+//
+// --data_file loads "key<TAB>value" lines from PATH; with --generate_keys, a
+// sample file of N keys is written to PATH first. --callback serves the
+// requests with the callback API, and --async with the completion queue
+// based async API on a single thread, instead of the synchronous API.
+int main(int argc, char** argv) {
   std::string server_address("0.0.0.0:50051");
-  KeyValueStoreServiceImpl service;
+  std::string data_file;
+  int generate_keys = 0;
+  int value_size = 0;
+  bool use_callback = false;
+  bool use_async = false;
+  for (int i = 1; i < argc; i++) {
+    std::string arg(argv[i]);
+    if (arg.compare(0, 10, "--address=") == 0) {
+      server_address = arg.substr(10);
+    } else if (arg.compare(0, 12, "--data_file=") == 0) {
+      data_file = arg.substr(12);
+    } else if (arg.compare(0, 16, "--generate_keys=") == 0) {
+      generate_keys = std::atoi(arg.substr(16).c_str());
+    } else if (arg.compare(0, 13, "--value_size=") == 0) {
+      value_size = std::atoi(arg.substr(13).c_str());
+    } else if (arg == "--callback") {
+      use_callback = true;
+    } else if (arg == "--async") {
+      use_async = true;
+    } else {
+      std::cerr << "Unknown argument " << arg << std::endl;
+      return 1;
+    }
+  }
+  if (use_callback && use_async) {
+    std::cerr << "--callback and --async are exclusive" << std::endl;
+    return 1;
+  }
+
+  KeyValueIndex index;
+  if (data_file.empty()) {
+    index.LoadPairs(kDefaultPairs);
+  } else {
+    if (generate_keys > 0 &&
+        !WriteSampleDataFile(data_file, generate_keys, value_size)) {
+      std::cerr << "Cannot write " << data_file << std::endl;
+      return 1;
+    }
+    if (!index.LoadFile(data_file)) {
+      std::cerr << "Cannot load " << data_file << std::endl;
+      return 1;
+    }
+  }
+  std::cout << "Loaded " << index.size() << " keys" << std::endl;
+
+  KeyValueStoreServiceImpl sync_service(&index);
+  KeyValueStoreCallbackServiceImpl callback_service(&index);
+  KeyValueStore::AsyncService async_service;
+  std::unique_ptr<ServerCompletionQueue> cq;
 
   ServerBuilder builder;
   // Listen on the given address without any authentication mechanism.
   builder.AddListeningPort(server_address, grpc::InsecureServerCredentials());
-  // Register "service" as the instance through which we'll communicate with
-  // clients. In this case, it corresponds to an *synchronous* service.
-  builder.RegisterService(&service);
+  // Register the service through which we'll communicate with clients, either
+  // the *synchronous*, the *callback* or the *asynchronous* implementation.
+  if (use_callback) {
+    builder.RegisterService(&callback_service);
+  } else if (use_async) {
+    builder.RegisterService(&async_service);
+    cq = builder.AddCompletionQueue();
+  } else {
+    builder.RegisterService(&sync_service);
+  }
   // Finally assemble the server.
   std::unique_ptr<Server> server(builder.BuildAndStart());
   std::cout << "Server listening on " << server_address << std::endl;
 
+  if (use_async) HandleAsyncRpcs(&async_service, cq.get(), &index);
+
   // Wait for the server to shutdown. Note that some other thread must be
   // responsible for shutting down the server for this call to ever return.
   server->Wait();
-}
-
-int main(int argc, char** argv) {
-  RunServer();
 
   return 0;
 }
@@ -0,0 +1,283 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "generic_relay.h"
+
+#include <string>
+
+#include <grpc/support/log.h>
+
+using grpc::ByteBuffer;
+using grpc::ChannelInterface;
+using grpc::ClientContext;
+using grpc::GenericClientAsyncReaderWriter;
+using grpc::GenericServerAsyncReaderWriter;
+using grpc::GenericServerContext;
+using grpc::ServerBuilder;
+using grpc::ServerCompletionQueue;
+using grpc::Status;
+using grpc::string_ref;
+
+namespace {
+
+// Pseudo-headers and grpc-* keys are owned by the transport of each hop (the
+// deadline, for instance, is forwarded separately), and user-agent would be
+// duplicated by the relay's own channel.
+bool IsForwardableMetadata(const string_ref& key) {
+  if (key.starts_with(":") || key.starts_with("grpc-")) return false;
+  return key != "user-agent";
+}
+
+template <typename Multimap, typename AddFn>
+void ForwardMetadata(const Multimap& from, AddFn add) {
+  for (const auto& entry : from) {
+    if (!IsForwardableMetadata(entry.first)) continue;
+    add(std::string(entry.first.data(), entry.first.size()),
+        std::string(entry.second.data(), entry.second.size()));
+  }
+}
+
+}  // namespace
+
+// State of one relayed call. It owns both the server side stream (towards the
+// downstream client) and the client side stream (towards the upstream server).
+//
+// Every asynchronous operation holds a reference on the call; the call deletes
+// itself once the last pending operation has been delivered.
+class GenericRelay::RelayCall {
+ public:
+  RelayCall(GenericRelay* relay, ServerCompletionQueue* cq)
+      : relay_(relay),
+        cq_(cq),
+        server_stream_(&server_ctx_),
+        refs_(0),
+        client_done_(false),
+        upstream_done_(false),
+        on_request_(this, &RelayCall::OnRequest),
+        on_done_(this, &RelayCall::OnDone),
+        on_start_(this, &RelayCall::OnStart),
+        on_client_read_(this, &RelayCall::OnClientRead),
+        on_upstream_write_(this, &RelayCall::OnUpstreamWrite),
+        on_writes_done_(this, &RelayCall::OnWritesDone),
+        on_initial_metadata_(this, &RelayCall::OnInitialMetadata),
+        on_upstream_read_(this, &RelayCall::OnUpstreamRead),
+        on_client_write_(this, &RelayCall::OnClientWrite),
+        on_upstream_finish_(this, &RelayCall::OnUpstreamFinish),
+        on_client_finish_(this, &RelayCall::OnClientFinish) {
+    // The done tag is only delivered if the call is actually started, so it is
+    // accounted for in OnRequest().
+    server_ctx_.AsyncNotifyWhenDone(&on_done_);
+    relay_->service_.RequestCall(&server_ctx_, &server_stream_, cq_, cq_,
+                                 Ref(&on_request_));
+  }
+
+  // Completion queue tag bound to one member function of a call.
+  class Tag {
+   public:
+    typedef void (RelayCall::*Handler)(bool ok);
+
+    Tag(RelayCall* call, Handler handler) : call_(call), handler_(handler) {}
+
+    void Run(bool ok) {
+      (call_->*handler_)(ok);
+      call_->Unref();
+    }
+
+   private:
+    RelayCall* call_;
+    Handler handler_;
+  };
+
+ private:
+  Tag* Ref(Tag* tag) {
+    ++refs_;
+    return tag;
+  }
+
+  void Unref() {
+    if (--refs_ == 0) delete this;
+  }
+
+  void OnRequest(bool ok) {
+    if (!ok) return;  // The server is shutting down.
+    ++refs_;          // For on_done_.
+    relay_->RequestCall(cq_);
+
+    client_ctx_.set_deadline(server_ctx_.deadline());
+    ForwardMetadata(server_ctx_.client_metadata(),
+                    [this](const std::string& key, const std::string& value) {
+                      client_ctx_.AddMetadata(key, value);
+                    });
+    upstream_ =
+        relay_->stub_.PrepareCall(&client_ctx_, server_ctx_.method(), cq_);
+    upstream_->StartCall(Ref(&on_start_));
+
+    // Both directions are started right away: requests flow upstream as soon
+    // as the client sends them, while responses wait for the upstream's
+    // initial metadata so that it can be forwarded ahead of the first message.
+    server_stream_.Read(&to_upstream_, Ref(&on_client_read_));
+    upstream_->ReadInitialMetadata(Ref(&on_initial_metadata_));
+  }
+
+  void OnDone(bool /*ok*/) {
+    client_done_ = true;
+    if (server_ctx_.IsCancelled()) client_ctx_.TryCancel();
+  }
+
+  // A failed start surfaces again as a failed read and the final status, so
+  // there is nothing to do here.
+  void OnStart(bool /*ok*/) {}
+
+  // Client -> upstream direction.
+
+  void OnClientRead(bool ok) {
+    if (upstream_done_) return;
+    if (ok) {
+      upstream_->Write(to_upstream_, Ref(&on_upstream_write_));
+    } else {
+      upstream_->WritesDone(Ref(&on_writes_done_));
+    }
+  }
+
+  void OnUpstreamWrite(bool ok) {
+    if (!ok || upstream_done_ || client_done_) return;
+    server_stream_.Read(&to_upstream_, Ref(&on_client_read_));
+  }
+
+  void OnWritesDone(bool /*ok*/) {}
+
+  // Upstream -> client direction.
+
+  void OnInitialMetadata(bool ok) {
+    if (ok) {
+      ForwardMetadata(
+          client_ctx_.GetServerInitialMetadata(),
+          [this](const std::string& key, const std::string& value) {
+            server_ctx_.AddInitialMetadata(key, value);
+          });
+    }
+    upstream_->Read(&to_client_, Ref(&on_upstream_read_));
+  }
+
+  void OnUpstreamRead(bool ok) {
+    if (ok && !client_done_) {
+      server_stream_.Write(to_client_, Ref(&on_client_write_));
+    } else {
+      upstream_->Finish(&status_, Ref(&on_upstream_finish_));
+    }
+  }
+
+  void OnClientWrite(bool ok) {
+    if (ok) {
+      upstream_->Read(&to_client_, Ref(&on_upstream_read_));
+    } else {
+      // The client went away; OnDone() cancels the upstream call.
+      upstream_->Finish(&status_, Ref(&on_upstream_finish_));
+    }
+  }
+
+  void OnUpstreamFinish(bool /*ok*/) {
+    upstream_done_ = true;
+    if (client_done_) return;
+    ForwardMetadata(client_ctx_.GetServerTrailingMetadata(),
+                    [this](const std::string& key, const std::string& value) {
+                      server_ctx_.AddTrailingMetadata(key, value);
+                    });
+    server_stream_.Finish(status_, Ref(&on_client_finish_));
+  }
+
+  void OnClientFinish(bool /*ok*/) {}
+
+  GenericRelay* const relay_;
+  ServerCompletionQueue* const cq_;
+
+  GenericServerContext server_ctx_;
+  GenericServerAsyncReaderWriter server_stream_;
+  ClientContext client_ctx_;
+  std::unique_ptr<GenericClientAsyncReaderWriter> upstream_;
+
+  // One buffer per direction. A buffer is only refilled by a read once the
+  // write that forwarded its previous content has completed.
+  ByteBuffer to_upstream_;
+  ByteBuffer to_client_;
+  Status status_;
+
+  int refs_;
+  bool client_done_;
+  bool upstream_done_;
+
+  Tag on_request_;
+  Tag on_done_;
+  Tag on_start_;
+  Tag on_client_read_;
+  Tag on_upstream_write_;
+  Tag on_writes_done_;
+  Tag on_initial_metadata_;
+  Tag on_upstream_read_;
+  Tag on_client_write_;
+  Tag on_upstream_finish_;
+  Tag on_client_finish_;
+};
+
+GenericRelay::GenericRelay(std::shared_ptr<ChannelInterface> upstream,
+                           int num_threads)
+    : stub_(std::move(upstream)),
+      num_threads_(num_threads > 0 ? num_threads : 1),
+      shutdown_(false) {}
+
+GenericRelay::~GenericRelay() { Shutdown(); }
+
+void GenericRelay::RegisterWith(ServerBuilder* builder) {
+  GPR_ASSERT(cqs_.empty());
+  builder->RegisterAsyncGenericService(&service_);
+  for (int i = 0; i < num_threads_; i++) {
+    cqs_.emplace_back(builder->AddCompletionQueue());
+  }
+}
+
+void GenericRelay::Start() {
+  GPR_ASSERT(threads_.empty());
+  for (const auto& cq : cqs_) {
+    for (int i = 0; i < kPendingCallsPerQueue; i++) RequestCall(cq.get());
+    threads_.emplace_back(&GenericRelay::Serve, this, cq.get());
+  }
+}
+
+void GenericRelay::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (shutdown_) return;
+    shutdown_ = true;
+  }
+  for (const auto& cq : cqs_) cq->Shutdown();
+  for (auto& thread : threads_) thread.join();
+  threads_.clear();
+}
+
+void GenericRelay::RequestCall(ServerCompletionQueue* cq) {
+  std::lock_guard<std::mutex> lock(mu_);
+  if (!shutdown_) new RelayCall(this, cq);
+}
+
+void GenericRelay::Serve(ServerCompletionQueue* cq) {
+  void* tag;
+  bool ok;
+  while (cq->Next(&tag, &ok)) {
+    static_cast<RelayCall::Tag*>(tag)->Run(ok);
+  }
+}
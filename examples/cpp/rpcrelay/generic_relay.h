@@ -0,0 +1,103 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_EXAMPLES_CPP_RPCRELAY_GENERIC_RELAY_H
+#define GRPC_EXAMPLES_CPP_RPCRELAY_GENERIC_RELAY_H
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <grpcpp/generic/async_generic_service.h>
+#include <grpcpp/generic/generic_stub.h>
+#include <grpcpp/grpcpp.h>
+
+// GenericRelay forwards every RPC it receives, whatever its method or
+// streaming type, to a single upstream channel.
+//
+// Calls are accepted through an AsyncGenericService and re-issued through a
+// GenericStub, so messages travel as opaque ByteBuffers: the slices read from
+// one side are handed to the other side as-is, without being parsed or copied.
+// Unary and client/server/bidi streaming methods all look like bidi streams at
+// this level, so one state machine handles every kind of call.
+//
+// Each call pumps two independent directions (client->upstream and
+// upstream->client). A direction keeps at most one read or one write in
+// flight: the next message is only read from the sender once the receiver has
+// accepted the previous one. A slow receiver therefore stops the relay from
+// reading, which in turn lets HTTP/2 flow control push back on the sender,
+// instead of the relay buffering an unbounded number of messages.
+//
+// The relay owns one ServerCompletionQueue per worker thread. A call accepted
+// on a queue also issues its upstream operations on that queue, so every event
+// of a given call is handled by the same thread and the per-call state needs
+// no locking.
+//
+// Sample usage:
+//   GenericRelay relay(grpc::CreateChannel(backend, creds), 4);
+//   ServerBuilder builder;
+//   builder.AddListeningPort(address, grpc::InsecureServerCredentials());
+//   relay.RegisterWith(&builder);
+//   auto server = builder.BuildAndStart();
+//   relay.Start();
+//   ...
+//   server->Shutdown();
+//   relay.Shutdown();
+class GenericRelay {
+ public:
+  GenericRelay(std::shared_ptr<grpc::ChannelInterface> upstream,
+               int num_threads);
+  ~GenericRelay();
+
+  // Registers the generic service and the relay's completion queues with
+  // \a builder. Must be called once, before the server is built.
+  void RegisterWith(grpc::ServerBuilder* builder);
+
+  // Starts the worker threads. Must be called after the server is built.
+  void Start();
+
+  // Shuts the completion queues down and joins the worker threads. The server
+  // must already have been shut down.
+  void Shutdown();
+
+ private:
+  class RelayCall;
+
+  // Number of calls requested ahead of time on each completion queue, so that
+  // a burst of new RPCs does not wait for RequestCall round trips.
+  static const int kPendingCallsPerQueue = 8;
+
+  // Requests one new incoming call on \a cq, unless the relay is shutting
+  // down.
+  void RequestCall(grpc::ServerCompletionQueue* cq);
+  void Serve(grpc::ServerCompletionQueue* cq);
+
+  grpc::GenericStub stub_;
+  grpc::AsyncGenericService service_;
+  std::vector<std::unique_ptr<grpc::ServerCompletionQueue>> cqs_;
+  std::vector<std::thread> threads_;
+  int num_threads_;
+
+  // Guards the race between RequestCall() and Shutdown(): once the completion
+  // queues start shutting down, no new calls may be requested on them.
+  std::mutex mu_;
+  bool shutdown_;
+};
+
+#endif  // GRPC_EXAMPLES_CPP_RPCRELAY_GENERIC_RELAY_H
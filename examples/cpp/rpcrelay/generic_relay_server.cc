@@ -0,0 +1,67 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <grpcpp/grpcpp.h>
+
+#include "generic_relay.h"
+
+// Relays every RPC received on --listen (default 0.0.0.0:50051) to --upstream
+// (default localhost:50052), whatever its service, method or streaming type.
+//
+// Usage: generic_relay_server [--listen=ADDR] [--upstream=ADDR] [--threads=N]
+int main(int argc, char** argv) {
+  std::string listen_address("0.0.0.0:50051");
+  std::string upstream_address("localhost:50052");
+  int num_threads = std::thread::hardware_concurrency();
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg(argv[i]);
+    if (arg.compare(0, 9, "--listen=") == 0) {
+      listen_address = arg.substr(9);
+    } else if (arg.compare(0, 11, "--upstream=") == 0) {
+      upstream_address = arg.substr(11);
+    } else if (arg.compare(0, 10, "--threads=") == 0) {
+      num_threads = std::atoi(arg.substr(10).c_str());
+    } else {
+      std::cerr << "Unknown argument " << arg << std::endl;
+      return 1;
+    }
+  }
+
+  GenericRelay relay(
+      grpc::CreateChannel(upstream_address, grpc::InsecureChannelCredentials()),
+      num_threads);
+
+  grpc::ServerBuilder builder;
+  builder.AddListeningPort(listen_address, grpc::InsecureServerCredentials());
+  relay.RegisterWith(&builder);
+  std::unique_ptr<grpc::Server> server(builder.BuildAndStart());
+  relay.Start();
+  std::cout << "Generic relay listening on " << listen_address
+            << ", forwarding to " << upstream_address << std::endl;
+
+  server->Wait();
+  relay.Shutdown();
+  return 0;
+}
@@ -16,189 +16,59 @@
  *
  */
 
-#include <memory>
+#include <cstdlib>
 #include <iostream>
 #include <string>
 #include <thread>
+#include <vector>
 
-#include <grpcpp/grpcpp.h>
-#include <grpc/support/log.h>
-
-#include "helloworld.grpc.pb.h"
 #include "relay_client.h"
+#include "relay_server.h"
 
-using std::cout;
-using grpc::Server;
-using grpc::ServerAsyncResponseWriter;
-using grpc::ServerBuilder;
-using grpc::ServerContext;
-using grpc::ServerCompletionQueue;
-using grpc::Status;
-
-using grpc::Channel;
-using grpc::ClientAsyncResponseReader;
-using grpc::ClientContext;
-using grpc::CompletionQueue;
-
-using helloworld::HelloRequest;
-using helloworld::HelloReply;
-using helloworld::Greeter;
-
-class ServerImpl final {
- public:
-  ServerImpl(RelayClient* relayClient) : relayClient_(relayClient) {}
-
-  ~ServerImpl() {
-    server_->Shutdown();
-    // Always shutdown the completion queue after the server.
-    cq_->Shutdown();
-  }
-
-  // There is no shutdown handling in this code.
-  void Run() {
-    std::string server_address("0.0.0.0:50051");
-
-    ServerBuilder builder;
-    // Listen on the given address without any authentication mechanism.
-    builder.AddListeningPort(server_address, grpc::InsecureServerCredentials());
-    // Register "service_" as the instance through which we'll communicate with
-    // clients. In this case it corresponds to an *asynchronous* service.
-    builder.RegisterService(&service_);
-    // Get hold of the completion queue used for the asynchronous communication
-    // with the gRPC runtime.
-    cq_ = builder.AddCompletionQueue();
-    // Finally assemble the server.
-    server_ = builder.BuildAndStart();
-    std::cout << "Relay Server listening on " << server_address << std::endl;
-
-    // Proceed to the server's main loop.
-    HandleRpcs();
-  }
-
- private:
-  // Class encompasing the state and logic needed to serve a request.
-  class CallData : RelayState {
-   public:
-    // Take in the "service" instance (in this case representing an asynchronous
-    // server) and the completion queue "cq" used for asynchronous communication
-    // with the gRPC runtime.
-    CallData(Greeter::AsyncService* service, ServerCompletionQueue* cq, RelayClient* relayClient)
-        : service_(service), cq_(cq), relayClient_(relayClient), responder_(&ctx_), status_(CREATE) {
-      // Invoke the serving logic right away.
-      Proceed();
-    }
-
-    void FinishServerProcessing() {
-      GPR_ASSERT(status_ == PROCESS);
-      status_ = RESPOND;
-      // And we are done! Let the gRPC runtime know we've finished, using the
-      // memory address of this instance as the uniquely identifying tag for
-      // the event.
-      status_ = FINISH;
-
-      // This call registers this CallData instance with the completion
-      // of writing response to client. this->Proceed() will invoked upon
-      // response completion with status_==FINISH.
-      responder_.Finish(reply_, Status::OK, this);
-    }
-
-    void Proceed() {
-      if (status_ == CREATE) {
-        cout << "Procceed when status=CREATE!\n" << std::flush;
-        // Make this instance progress to the PROCESS state.
-        status_ = PROCESS;
-
-        // This call register this CallData instance with the SayHello RPC
-        // method. Incoming calls to SayHello will result in this CallData
-        // instance being dequeued from cq_->Next(...).       
-        // As part of the initial CREATE state, we *request* that the system
-        // start processing SayHello requests. In this request, "this" acts are
-        // the tag uniquely identifying the request (so that different CallData
-        // instances can serve different requests concurrently), in this case
-        // the memory address of this CallData instance.
-        service_->RequestSayHello(&ctx_, &request_, &responder_, cq_, cq_,
-                                  this);
-      } else if (status_ == PROCESS) {
-        cout << "Procceed when status=PROCESS!\n" << std::flush;
-        // Spawn a new CallData instance to serve new clients while we process
-        // the one for this CallData. The instance will deallocate itself as
-        // part of its FINISH state.
-        new CallData(service_, cq_, relayClient_);
-
-        // The actual processing.
-        relayClient_->RelayHello(this);
-      } else {
-        cout << "Procceed when status=FINISH!\n" << std::flush;
-        GPR_ASSERT(status_ == FINISH);
-        // Once in the FINISH state, deallocate ourselves (CallData).
-        delete this;
-      }
+// Usage: greeter_relay_server [--listen=ADDR] [--backends=ADDR[,ADDR...]]
+//                             [--channels_per_backend=N] [--threads=N]
+int main(int argc, char** argv) {
+  std::string server_address("0.0.0.0:50051");
+  std::string backends("localhost:50052");
+  int channels_per_backend = 2;
+  int num_threads = std::thread::hardware_concurrency();
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg(argv[i]);
+    if (arg.compare(0, 9, "--listen=") == 0) {
+      server_address = arg.substr(9);
+    } else if (arg.compare(0, 11, "--backends=") == 0) {
+      backends = arg.substr(11);
+    } else if (arg.compare(0, 23, "--channels_per_backend=") == 0) {
+      channels_per_backend = std::atoi(arg.substr(23).c_str());
+    } else if (arg.compare(0, 10, "--threads=") == 0) {
+      num_threads = std::atoi(arg.substr(10).c_str());
+    } else {
+      std::cerr << "Unknown argument " << arg << std::endl;
+      return 1;
     }
+  }
 
-   private:
-    // The means of communication with the gRPC runtime for an asynchronous
-    // server.
-    Greeter::AsyncService* service_;
-    // The producer-consumer queue where for asynchronous server notifications.
-    ServerCompletionQueue* cq_;
-    // Context for the rpc, allowing to tweak aspects of it such as the use
-    // of compression, authentication, as well as to send metadata back to the
-    // client.
-    ServerContext ctx_;
-
-    // What we get from the client.
-    HelloRequest request_;
-    // What we send back to the client.
-    HelloReply reply_;
-
-    // The means to get back to the client.
-    ServerAsyncResponseWriter<HelloReply> responder_;
-
-    RelayClient* relayClient_;
-
-    // Let's implement a tiny state machine with the following states.
-    enum CallStatus { CREATE, PROCESS, RESPOND, FINISH };
-    CallStatus status_;  // The current serving state.
-  };
-
-  // This can be run in multiple threads if needed.
-  void HandleRpcs() {
-    // Spawn a new CallData instance to serve new clients.
-    new CallData(&service_, cq_.get(), relayClient_);
-    void* tag;  // uniquely identifies a request.
-    bool ok;
-    while (true) {
-      // Block waiting to read the next event from the completion queue. The
-      // event is uniquely identified by its tag, which in this case is the
-      // memory address of a CallData instance.
-      // The return value of Next should always be checked. This return value
-      // tells us whether there is any kind of event or cq_ is shutting down.
-      GPR_ASSERT(cq_->Next(&tag, &ok));
-      GPR_ASSERT(ok);
-      static_cast<CallData*>(tag)->Proceed();
+  std::vector<std::string> backend_list;
+  size_t start = 0;
+  while (start <= backends.size()) {
+    size_t end = backends.find(',', start);
+    if (end == std::string::npos) end = backends.size();
+    if (end > start) {
+      backend_list.push_back(backends.substr(start, end - start));
     }
+    start = end + 1;
   }
 
-  std::unique_ptr<ServerCompletionQueue> cq_;
-  Greeter::AsyncService service_;
-  std::unique_ptr<Server> server_;
-  RelayClient* relayClient_;
-};
-
-int main(int argc, char** argv) {
-  // Instantiate the client. It requires a channel, out of which the actual RPCs
-  // are created. This channel models a connection to an endpoint (in this case,
-  // localhost at port 50051). We indicate that the channel isn't authenticated
-  // (use of InsecureChannelCredentials()).
-  RelayClient relayClient(grpc::CreateChannel(
-          "localhost:50052", grpc::InsecureChannelCredentials()));
-  ServerImpl server(&relayClient);
-
-  // Spawn reader thread that loops indefinitely
-  std::thread serverThread = std::thread(&ServerImpl::Run, &server);
-  std::thread clientThread = std::thread(&RelayClient::AsyncCompleteRpc, &relayClient);
-  serverThread.join();
-  clientThread.join();
+  // The client keeps a pool of channels to the backends. We indicate that the
+  // channels aren't authenticated (use of InsecureChannelCredentials()).
+  RelayClient relayClient(backend_list, channels_per_backend);
+  RelayServer server(&relayClient, num_threads);
+  server.Start(server_address);
+  std::cout << "Relay Server listening on " << server_address << " with "
+            << num_threads << " threads, relaying to " << backends
+            << std::endl;
+  server.Wait();
 
   return 0;
 }
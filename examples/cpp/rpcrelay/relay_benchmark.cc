@@ -0,0 +1,181 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Measures the cost of going through GenericRelay compared to calling the
+// backend directly. A Greeter backend and a relay in front of it are started
+// in-process; the same unary load is then sent once straight to the backend
+// and once through the relay, for a range of payload sizes.
+//
+// Usage: relay_benchmark [--calls=N] [--clients=N] [--relay_threads=N]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <grpcpp/grpcpp.h>
+
+#include "generic_relay.h"
+#include "helloworld.grpc.pb.h"
+
+using grpc::Channel;
+using grpc::ClientContext;
+using grpc::Server;
+using grpc::ServerBuilder;
+using grpc::ServerContext;
+using grpc::Status;
+using helloworld::Greeter;
+using helloworld::HelloReply;
+using helloworld::HelloRequest;
+
+namespace {
+
+class GreeterServiceImpl final : public Greeter::Service {
+  Status SayHello(ServerContext* context, const HelloRequest* request,
+                  HelloReply* reply) override {
+    reply->set_message(request->name());
+    return Status::OK;
+  }
+};
+
+std::unique_ptr<Server> StartServer(ServerBuilder* builder, int* port) {
+  builder->AddListeningPort("localhost:0", grpc::InsecureServerCredentials(),
+                            port);
+  // Let the largest payload below through on both hops.
+  builder->SetMaxReceiveMessageSize(-1);
+  return builder->BuildAndStart();
+}
+
+std::shared_ptr<Channel> Connect(int port) {
+  grpc::ChannelArguments args;
+  args.SetMaxReceiveMessageSize(-1);
+  // Every channel gets its own connection, so that the direct run does not
+  // share a transport with the relay's upstream channel.
+  args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+  return grpc::CreateCustomChannel("localhost:" + std::to_string(port),
+                                   grpc::InsecureChannelCredentials(), args);
+}
+
+struct Result {
+  double seconds;
+  int calls;
+  int failures;
+};
+
+// Runs \a calls_per_client sequential SayHello calls from each of
+// \a num_clients threads, all sharing \a channel.
+Result RunLoad(std::shared_ptr<Channel> channel, int num_clients,
+               int calls_per_client, const std::string& payload) {
+  std::unique_ptr<Greeter::Stub> stub(Greeter::NewStub(channel));
+  std::vector<int> failures(num_clients, 0);
+  std::vector<std::thread> clients;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int c = 0; c < num_clients; c++) {
+    clients.emplace_back([&, c] {
+      HelloRequest request;
+      request.set_name(payload);
+      for (int i = 0; i < calls_per_client; i++) {
+        ClientContext context;
+        HelloReply reply;
+        if (!stub->SayHello(&context, request, &reply).ok()) failures[c]++;
+      }
+    });
+  }
+  for (auto& client : clients) client.join();
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  Result result = {elapsed.count(), num_clients * calls_per_client, 0};
+  for (int f : failures) result.failures += f;
+  return result;
+}
+
+void Report(const char* label, const Result& result, int num_clients) {
+  double qps = result.calls / result.seconds;
+  std::cout << "  " << label << ": " << static_cast<int>(qps) << " qps, "
+            << 1e6 * result.seconds * num_clients / result.calls
+            << " us/call";
+  if (result.failures > 0) std::cout << " (" << result.failures << " failed)";
+  std::cout << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int calls = 10000;
+  int num_clients = 4;
+  int relay_threads = 4;
+  for (int i = 1; i < argc; i++) {
+    std::string arg(argv[i]);
+    if (arg.compare(0, 8, "--calls=") == 0) {
+      calls = std::atoi(arg.substr(8).c_str());
+    } else if (arg.compare(0, 10, "--clients=") == 0) {
+      num_clients = std::atoi(arg.substr(10).c_str());
+    } else if (arg.compare(0, 16, "--relay_threads=") == 0) {
+      relay_threads = std::atoi(arg.substr(16).c_str());
+    } else {
+      std::cerr << "Unknown argument " << arg << std::endl;
+      return 1;
+    }
+  }
+
+  GreeterServiceImpl service;
+  ServerBuilder backend_builder;
+  backend_builder.RegisterService(&service);
+  int backend_port = 0;
+  std::unique_ptr<Server> backend =
+      StartServer(&backend_builder, &backend_port);
+
+  GenericRelay relay(Connect(backend_port), relay_threads);
+  ServerBuilder relay_builder;
+  relay.RegisterWith(&relay_builder);
+  int relay_port = 0;
+  std::unique_ptr<Server> relay_server =
+      StartServer(&relay_builder, &relay_port);
+  relay.Start();
+
+  std::shared_ptr<Channel> direct = Connect(backend_port);
+  std::shared_ptr<Channel> relayed = Connect(relay_port);
+
+  const int calls_per_client = calls / num_clients;
+  for (size_t size : {16, 1024, 64 * 1024, 1024 * 1024}) {
+    std::string payload(size, 'x');
+    // Warm both paths up so connection setup is not measured.
+    RunLoad(direct, 1, 10, payload);
+    RunLoad(relayed, 1, 10, payload);
+
+    Result d = RunLoad(direct, num_clients, calls_per_client, payload);
+    Result r = RunLoad(relayed, num_clients, calls_per_client, payload);
+    std::cout << size << " byte payload, " << num_clients << " clients:"
+              << std::endl;
+    Report("direct ", d, num_clients);
+    Report("relayed", r, num_clients);
+    std::cout << "  relay overhead: "
+              << 1e6 * (r.seconds - d.seconds) * num_clients / d.calls
+              << " us/call" << std::endl;
+  }
+
+  relay_server->Shutdown();
+  relay.Shutdown();
+  backend->Shutdown();
+  return 0;
+}
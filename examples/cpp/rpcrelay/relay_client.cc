@@ -17,7 +17,6 @@
  */
 #include "relay_client.h"
 
-#include <iostream>
 #include <memory>
 #include <string>
 
@@ -25,30 +24,61 @@
 #include <grpc/support/log.h>
 
 using std::string;
-using grpc::Channel;
-using grpc::ClientAsyncResponseReader;
+using grpc::ChannelArguments;
 using grpc::ClientContext;
 using grpc::CompletionQueue;
 using grpc::Status;
-using helloworld::HelloRequest;
-using helloworld::HelloReply;
 using helloworld::Greeter;
 
-void RelayClient::RelayHello(RelayState* relayState) {
-    // Data we are sending to the server.
-    HelloRequest request;
-    request.set_name(relayState->request.name());
+RelayClient::RelayClient(const std::vector<string>& backends,
+                         int channelsPerBackend) {
+    GPR_ASSERT(!backends.empty());
+    for (const string& backend : backends) {
+        for (int i = 0; i < channelsPerBackend; i++) {
+            // Channels with identical arguments would share their subchannel,
+            // and so their connection, through the global subchannel pool.
+            ChannelArguments args;
+            args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+            std::unique_ptr<Upstream> upstream(new Upstream);
+            upstream->stub = Greeter::NewStub(grpc::CreateCustomChannel(
+                    backend, grpc::InsecureChannelCredentials(), args));
+            pool_.push_back(std::move(upstream));
+        }
+    }
+}
+
+RelayClient::Upstream* RelayClient::PickUpstream() {
+    const size_t size = pool_.size();
+    const size_t start = nextUpstream_.fetch_add(1, std::memory_order_relaxed);
+    Upstream* best = nullptr;
+    int bestOutstanding = 0;
+    for (size_t i = 0; i < size; i++) {
+        Upstream* upstream = pool_[(start + i) % size].get();
+        int outstanding =
+                upstream->outstanding.load(std::memory_order_relaxed);
+        if (best == nullptr || outstanding < bestOutstanding) {
+            best = upstream;
+            bestOutstanding = outstanding;
+        }
+    }
+    return best;
+}
 
+void RelayClient::RelayHello(RelayState* relayState, CompletionQueue* cq) {
     // Call object to store rpc data
     AsyncClientCall* call = new AsyncClientCall;
     call->relayState_ = relayState;
+    call->upstream_ = PickUpstream();
+    call->upstream_->outstanding.fetch_add(1, std::memory_order_relaxed);
+
+    // The deadline of the incoming call is propagated, and the upstream call
+    // is cancelled by the library if the incoming call is cancelled.
+    call->context =
+            ClientContext::FromServerContext(relayState->serverContext());
 
-    // stub_->PrepareAsyncSayHello() creates an RPC object, returning
-    // an instance to store in "call" but does not actually start the RPC
-    // Because we are using the asynchronous API, we need to hold on to
-    // the "call" instance in order to get updates on the ongoing RPC.
-    call->response_reader =
-        stub_->PrepareAsyncSayHello(&call->context, request, &cq_);
+    // The request is sent as received: no copy into a new HelloRequest.
+    call->response_reader = call->upstream_->stub->PrepareAsyncSayHello(
+            call->context.get(), relayState->request, cq);
 
     // StartCall initiates the RPC call
     call->response_reader->StartCall();
@@ -56,34 +86,20 @@ void RelayClient::RelayHello(RelayState* relayState) {
     // Request that, upon completion of the RPC, "reply" be updated with the
     // server's response; "status" with the indication of whether the operation
     // was successful. Tag the request with the memory address of the call object.
-    call->response_reader->Finish(&call->reply, &call->status, (void*)call);
+    call->response_reader->Finish(&call->reply, &call->status,
+                                  static_cast<RelayTag*>(call));
 }
 
-// Loop while listening for completed responses.
-// Prints out the response from the server.
-void RelayClient::AsyncCompleteRpc() {
-    void* got_tag;
-    bool ok = false;
-
-    // Block until the next result is available in the completion queue "cq".
-    while (cq_.Next(&got_tag, &ok)) {
-        // The tag in this example is the memory location of the call object
-        AsyncClientCall* call = static_cast<AsyncClientCall*>(got_tag);
+void RelayClient::AsyncClientCall::Proceed(bool ok) {
+    // Verify that the request was completed successfully. Note that "ok"
+    // corresponds solely to the request for updates introduced by Finish().
+    GPR_ASSERT(ok);
+    upstream_->outstanding.fetch_sub(1, std::memory_order_relaxed);
 
-        // Verify that the request was completed successfully. Note that "ok"
-        // corresponds solely to the request for updates introduced by Finish().
-        GPR_ASSERT(ok);
-
-        if (call->status.ok()) {
-            std::cout << "RelayClient received: " << call->reply.message() << std::endl;
-            call->relayState_->serverReplay.set_message(call->reply.message());
-        } else {
-            static const string rpcErrMsg = "RPC failed";
-            std::cout << rpcErrMsg << std::endl;
-            call->relayState_->serverReplay.set_message(rpcErrMsg);
-        }
-        call->relayState_->FinishServerProcessing();
-        // Once we're complete, deallocate the call object.
-        delete call;
+    if (status.ok()) {
+        relayState_->serverReplay.Swap(&reply);
     }
-}
\ No newline at end of file
+    relayState_->FinishServerProcessing(status);
+    // Once we're complete, deallocate the call object.
+    delete this;
+}
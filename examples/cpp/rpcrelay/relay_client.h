@@ -16,71 +16,99 @@
  *
  */
 
-#include <iostream>
+#ifndef GRPC_EXAMPLES_CPP_RPCRELAY_RELAY_CLIENT_H
+#define GRPC_EXAMPLES_CPP_RPCRELAY_RELAY_CLIENT_H
+
+#include <atomic>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <grpcpp/grpcpp.h>
-#include <grpc/support/log.h>
-#include <thread>
 
 #include "helloworld.grpc.pb.h"
 
-using grpc::Channel;
-using grpc::ClientAsyncResponseReader;
-using grpc::ClientContext;
-using grpc::CompletionQueue;
-using grpc::Status;
-using helloworld::HelloRequest;
-using helloworld::HelloReply;
-using helloworld::Greeter;
+// Everything the relay puts on a completion queue derives from RelayTag, so
+// that one loop can drain a queue shared by server calls and upstream calls.
+class RelayTag {
+  public:
+    virtual ~RelayTag() {}
+
+    // Invoked by the thread draining the completion queue, with the "ok" bit
+    // of the event.
+    virtual void Proceed(bool ok) = 0;
+};
 
 class RelayState {
   public:
-    HelloRequest request;
-    HelloReply serverReplay;
+    virtual ~RelayState() {}
 
-    // All server side processing is finished. Call it to start to responding
-    // to client.
-    virtual void FinishServerProcessing() = 0;
+    helloworld::HelloRequest request;
+    helloworld::HelloReply serverReplay;
+
+    // The incoming call. Its deadline and cancellation are propagated to the
+    // upstream call.
+    virtual const grpc::ServerContext& serverContext() const = 0;
+
+    // All server side processing is finished, with the upstream call's
+    // status. Call it to start to responding to client.
+    virtual void FinishServerProcessing(const grpc::Status& status) = 0;
 };
 
+// Relays Greeter calls to a pool of upstream channels spread over several
+// backends. Each call goes to the channel with the fewest calls in flight.
 class RelayClient {
   public:
-    explicit RelayClient(std::shared_ptr<Channel> channel)
-            : stub_(Greeter::NewStub(channel)) {};
-    
-    // Assembles the client's payload and sends it to the server.
-    void RelayHello(RelayState* relayState);
-
-    // Loop while listening for completed responses.
-    // Prints out the response from the server.
-    void AsyncCompleteRpc();
+    // Opens channelsPerBackend channels to each of backends. Each channel has
+    // its own connection, so that a single HTTP/2 connection does not limit
+    // the number of concurrent streams towards a backend.
+    RelayClient(const std::vector<std::string>& backends,
+                int channelsPerBackend);
+
+    // Sends relayState->request upstream. The upstream call completes on cq,
+    // which should be the queue the incoming call was accepted on: the
+    // thread draining it then calls relayState->FinishServerProcessing(), so
+    // both halves of a relayed call are handled by the same thread.
+    void RelayHello(RelayState* relayState, grpc::CompletionQueue* cq);
 
   private:
+    // One channel of the pool.
+    struct Upstream {
+        std::unique_ptr<helloworld::Greeter::Stub> stub;
+
+        // Calls started on this channel and not completed yet.
+        std::atomic<int> outstanding{0};
+    };
+
     // struct for keeping state and data information
-    struct AsyncClientCall {
+    struct AsyncClientCall : public RelayTag {
+        void Proceed(bool ok) override;
+
         // Container for the data we expect from the server.
-        HelloReply reply;
+        helloworld::HelloReply reply;
 
         RelayState* relayState_;
 
-        // Context for the client. It could be used to convey extra information to
-        // the server and/or tweak certain RPC behaviors.
-        ClientContext context;
+        Upstream* upstream_;
 
-        // Storage for the status of the RPC upon completion.
-        Status status;
+        // Context for the client. It is derived from the incoming call's
+        // context, so it inherits its deadline and is cancelled with it.
+        std::unique_ptr<grpc::ClientContext> context;
 
+        // Storage for the status of the RPC upon completion.
+        grpc::Status status;
 
-        std::unique_ptr<ClientAsyncResponseReader<HelloReply>> response_reader;
+        std::unique_ptr<
+            grpc::ClientAsyncResponseReader<helloworld::HelloReply>>
+            response_reader;
     };
 
-    // Out of the passed in Channel comes the stub, stored here, our view of the
-    // server's exposed services.
-    std::unique_ptr<Greeter::Stub> stub_;
+    // Returns the channel with the fewest outstanding calls. The scan starts
+    // at a rotating position so that ties are spread over the pool.
+    Upstream* PickUpstream();
+
+    std::vector<std::unique_ptr<Upstream>> pool_;
+    std::atomic<unsigned> nextUpstream_{0};
+};
 
-    // The producer-consumer queue we use to communicate asynchronously with the
-    // gRPC runtime.
-    CompletionQueue cq_;
-};
\ No newline at end of file
+#endif  // GRPC_EXAMPLES_CPP_RPCRELAY_RELAY_CLIENT_H
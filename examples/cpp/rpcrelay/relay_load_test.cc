@@ -0,0 +1,199 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Load test for RelayServer: starts several Greeter backends and the relay in
+// the same process, then drives the relay with a fixed number of calls in
+// flight for each relay thread count from 1 up to --max_threads, and prints
+// the throughput and its speedup over a single relay thread.
+//
+// Usage: relay_load_test [--backends=N] [--max_threads=N] [--seconds=N]
+//                        [--load_threads=N] [--window=N]
+//
+// The backends and the load generator share the machine with the relay, so
+// the scaling flattens out once they become the bottleneck; give the load
+// generator enough threads and calls in flight to keep the relay busy.
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <grpcpp/grpcpp.h>
+
+#include "relay_client.h"
+#include "relay_server.h"
+
+using grpc::ClientAsyncResponseReader;
+using grpc::ClientContext;
+using grpc::CompletionQueue;
+using grpc::Server;
+using grpc::ServerBuilder;
+using grpc::ServerContext;
+using grpc::Status;
+using helloworld::Greeter;
+using helloworld::HelloReply;
+using helloworld::HelloRequest;
+
+namespace {
+
+class GreeterServiceImpl final : public Greeter::Service {
+  Status SayHello(ServerContext* context, const HelloRequest* request,
+                  HelloReply* reply) override {
+    reply->set_message("Hello " + request->name());
+    return Status::OK;
+  }
+};
+
+// One in-flight call of the load generator.
+struct LoadCall {
+  ClientContext context;
+  HelloReply reply;
+  Status status;
+  std::unique_ptr<ClientAsyncResponseReader<HelloReply>> reader;
+};
+
+// Keeps \a window calls in flight on its own channel and completion queue
+// until \a stop is set, and returns the number of calls that succeeded while
+// \a measuring was set.
+long RunLoadThread(int port, int window, const std::atomic<bool>* measuring,
+                   const std::atomic<bool>* stop) {
+  grpc::ChannelArguments args;
+  args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+  std::unique_ptr<Greeter::Stub> stub(Greeter::NewStub(
+      grpc::CreateCustomChannel("localhost:" + std::to_string(port),
+                                grpc::InsecureChannelCredentials(), args)));
+  CompletionQueue cq;
+  HelloRequest request;
+  request.set_name("world");
+
+  auto start_call = [&]() {
+    LoadCall* call = new LoadCall;
+    call->reader = stub->PrepareAsyncSayHello(&call->context, request, &cq);
+    call->reader->StartCall();
+    call->reader->Finish(&call->reply, &call->status, call);
+  };
+
+  for (int i = 0; i < window; i++) start_call();
+  long completed = 0;
+  int in_flight = window;
+  void* tag;
+  bool ok;
+  while (in_flight > 0 && cq.Next(&tag, &ok)) {
+    LoadCall* call = static_cast<LoadCall*>(tag);
+    if (call->status.ok() && measuring->load(std::memory_order_relaxed)) {
+      completed++;
+    }
+    delete call;
+    if (stop->load(std::memory_order_relaxed)) {
+      in_flight--;
+    } else {
+      start_call();
+    }
+  }
+  cq.Shutdown();
+  while (cq.Next(&tag, &ok)) {
+  }
+  return completed;
+}
+
+double MeasureQps(int port, int load_threads, int window, int seconds) {
+  std::atomic<bool> measuring(false);
+  std::atomic<bool> stop(false);
+  std::vector<long> completed(load_threads, 0);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < load_threads; i++) {
+    threads.emplace_back([&, i] {
+      completed[i] = RunLoadThread(port, window, &measuring, &stop);
+    });
+  }
+  // Let connections come up before counting.
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+  auto start = std::chrono::steady_clock::now();
+  measuring = true;
+  std::this_thread::sleep_for(std::chrono::seconds(seconds));
+  measuring = false;
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  stop = true;
+  for (auto& thread : threads) thread.join();
+  long total = 0;
+  for (long c : completed) total += c;
+  return total / elapsed.count();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int num_backends = 2;
+  int max_threads = std::thread::hardware_concurrency() / 2;
+  int seconds = 5;
+  int load_threads = 4;
+  int window = 64;
+  for (int i = 1; i < argc; i++) {
+    std::string arg(argv[i]);
+    if (arg.compare(0, 11, "--backends=") == 0) {
+      num_backends = std::atoi(arg.substr(11).c_str());
+    } else if (arg.compare(0, 14, "--max_threads=") == 0) {
+      max_threads = std::atoi(arg.substr(14).c_str());
+    } else if (arg.compare(0, 10, "--seconds=") == 0) {
+      seconds = std::atoi(arg.substr(10).c_str());
+    } else if (arg.compare(0, 15, "--load_threads=") == 0) {
+      load_threads = std::atoi(arg.substr(15).c_str());
+    } else if (arg.compare(0, 9, "--window=") == 0) {
+      window = std::atoi(arg.substr(9).c_str());
+    } else {
+      std::cerr << "Unknown argument " << arg << std::endl;
+      return 1;
+    }
+  }
+  if (max_threads < 1) max_threads = 1;
+
+  GreeterServiceImpl service;
+  std::vector<std::unique_ptr<Server>> backends;
+  std::vector<std::string> backend_addresses;
+  for (int i = 0; i < num_backends; i++) {
+    ServerBuilder builder;
+    int port = 0;
+    builder.AddListeningPort("localhost:0", grpc::InsecureServerCredentials(),
+                             &port);
+    builder.RegisterService(&service);
+    backends.push_back(builder.BuildAndStart());
+    backend_addresses.push_back("localhost:" + std::to_string(port));
+  }
+
+  double base_qps = 0;
+  for (int threads = 1; threads <= max_threads; threads *= 2) {
+    RelayClient relayClient(backend_addresses, threads);
+    RelayServer relay(&relayClient, threads);
+    int port = 0;
+    relay.Start("localhost:0", &port);
+
+    double qps = MeasureQps(port, load_threads, window, seconds);
+    if (threads == 1) base_qps = qps;
+    std::cout << threads << " relay threads: " << static_cast<long>(qps)
+              << " qps, speedup " << qps / base_qps << std::endl;
+    relay.Shutdown();
+  }
+
+  for (auto& backend : backends) backend->Shutdown();
+  return 0;
+}
@@ -0,0 +1,163 @@
+/*
+ *
+ * Copyright 2015 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "relay_server.h"
+
+#include <grpc/support/log.h>
+
+using grpc::ServerAsyncResponseWriter;
+using grpc::ServerBuilder;
+using grpc::ServerCompletionQueue;
+using grpc::ServerContext;
+using grpc::Status;
+
+using helloworld::Greeter;
+using helloworld::HelloReply;
+
+// Class encompasing the state and logic needed to serve a request.
+class RelayServer::CallData final : public RelayState, public RelayTag {
+ public:
+  // Take in the server and the completion queue "cq" used for asynchronous
+  // communication with the gRPC runtime. The upstream call is issued on the
+  // same queue.
+  CallData(RelayServer* server, ServerCompletionQueue* cq)
+      : server_(server), cq_(cq), responder_(&ctx_), status_(CREATE) {
+    // As part of the initial CREATE state, we *request* that the system
+    // start processing SayHello requests. In this request, "this" acts are
+    // the tag uniquely identifying the request. Tags are always passed as
+    // RelayTag pointers, which is what HandleRpcs() casts them back to.
+    server_->service_.RequestSayHello(&ctx_, &request, &responder_, cq_, cq_,
+                                      tag());
+  }
+
+  const ServerContext& serverContext() const override { return ctx_; }
+
+  void FinishServerProcessing(const Status& status) override {
+    GPR_ASSERT(status_ == PROCESS);
+    // This call registers this CallData instance with the completion
+    // of writing response to client. this->Proceed() will invoked upon
+    // response completion with status_==FINISH.
+    status_ = FINISH;
+    if (status.ok()) {
+      responder_.Finish(serverReplay, Status::OK, tag());
+    } else {
+      // Deadline exceeded, cancellation or a backend error: the client gets
+      // the upstream status rather than an empty reply.
+      responder_.FinishWithError(status, tag());
+    }
+  }
+
+  void Proceed(bool ok) override {
+    if (status_ == CREATE) {
+      if (!ok) {
+        // The server is shutting down and no call was received.
+        delete this;
+        return;
+      }
+      status_ = PROCESS;
+      // Spawn a new CallData instance to serve new clients while we process
+      // the one for this CallData. The instance will deallocate itself as
+      // part of its FINISH state.
+      server_->RequestCall(cq_);
+
+      // The actual processing.
+      server_->relayClient_->RelayHello(this, cq_);
+    } else {
+      GPR_ASSERT(status_ == FINISH);
+      // Once in the FINISH state, deallocate ourselves (CallData).
+      delete this;
+    }
+  }
+
+ private:
+  RelayTag* tag() { return this; }
+
+  RelayServer* server_;
+  // The producer-consumer queue where for asynchronous server notifications.
+  ServerCompletionQueue* cq_;
+  // Context for the rpc, allowing to tweak aspects of it such as the use
+  // of compression, authentication, as well as to send metadata back to the
+  // client.
+  ServerContext ctx_;
+
+  // The means to get back to the client.
+  ServerAsyncResponseWriter<HelloReply> responder_;
+
+  // Let's implement a tiny state machine with the following states.
+  enum CallStatus { CREATE, PROCESS, FINISH };
+  CallStatus status_;  // The current serving state.
+};
+
+RelayServer::RelayServer(RelayClient* relayClient, int numThreads)
+    : relayClient_(relayClient),
+      numThreads_(numThreads > 0 ? numThreads : 1),
+      shutdown_(false) {}
+
+RelayServer::~RelayServer() { Shutdown(); }
+
+void RelayServer::Start(const std::string& server_address,
+                        int* selected_port) {
+  ServerBuilder builder;
+  // Listen on the given address without any authentication mechanism.
+  builder.AddListeningPort(server_address, grpc::InsecureServerCredentials(),
+                           selected_port);
+  // Register "service_" as the instance through which we'll communicate with
+  // clients. In this case it corresponds to an *asynchronous* service.
+  builder.RegisterService(&service_);
+  for (int i = 0; i < numThreads_; i++) {
+    cqs_.emplace_back(builder.AddCompletionQueue());
+  }
+  // Finally assemble the server.
+  server_ = builder.BuildAndStart();
+
+  for (const auto& cq : cqs_) {
+    for (int i = 0; i < kPendingCallsPerQueue; i++) RequestCall(cq.get());
+    threads_.emplace_back(&RelayServer::HandleRpcs, this, cq.get());
+  }
+}
+
+void RelayServer::Wait() { server_->Wait(); }
+
+void RelayServer::Shutdown() {
+  if (server_ == nullptr) return;
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (shutdown_) return;
+    shutdown_ = true;
+  }
+  server_->Shutdown();
+  // Always shutdown the completion queue after the server.
+  for (const auto& cq : cqs_) cq->Shutdown();
+  for (auto& thread : threads_) thread.join();
+}
+
+void RelayServer::RequestCall(ServerCompletionQueue* cq) {
+  std::lock_guard<std::mutex> lock(mu_);
+  if (!shutdown_) new CallData(this, cq);
+}
+
+void RelayServer::HandleRpcs(ServerCompletionQueue* cq) {
+  void* tag;  // uniquely identifies a request.
+  bool ok;
+  // Block waiting to read the next event from the completion queue. The event
+  // is either an incoming call (CallData) or an upstream call completing.
+  // Next() returns false once the queue is shut down and drained.
+  while (cq->Next(&tag, &ok)) {
+    static_cast<RelayTag*>(tag)->Proceed(ok);
+  }
+}
@@ -0,0 +1,79 @@
+/*
+ *
+ * Copyright 2015 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_EXAMPLES_CPP_RPCRELAY_RELAY_SERVER_H
+#define GRPC_EXAMPLES_CPP_RPCRELAY_RELAY_SERVER_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <grpcpp/grpcpp.h>
+
+#include "helloworld.grpc.pb.h"
+#include "relay_client.h"
+
+// Serves the Greeter service by relaying every call through a RelayClient.
+//
+// The server owns one completion queue per thread. An incoming call and the
+// upstream call it triggers complete on the same queue, so each relayed call
+// is handled from start to end by a single thread and the threads share
+// nothing but the RelayClient's channel pool.
+class RelayServer final {
+ public:
+  RelayServer(RelayClient* relayClient, int numThreads);
+  ~RelayServer();
+
+  // Listens on \a server_address and starts the worker threads. If
+  // \a selected_port is not null, it receives the port that was bound.
+  void Start(const std::string& server_address, int* selected_port = nullptr);
+
+  // Blocks until the server is shut down.
+  void Wait();
+
+  // Shuts the server down, waiting for the calls in flight, then stops the
+  // worker threads.
+  void Shutdown();
+
+ private:
+  class CallData;
+
+  // Number of calls requested ahead of time on each completion queue.
+  static const int kPendingCallsPerQueue = 8;
+
+  // Requests one new incoming call on \a cq, unless the server is shutting
+  // down.
+  void RequestCall(grpc::ServerCompletionQueue* cq);
+
+  // This is run by each worker thread, on its own queue.
+  void HandleRpcs(grpc::ServerCompletionQueue* cq);
+
+  RelayClient* relayClient_;
+  const int numThreads_;
+  helloworld::Greeter::AsyncService service_;
+  std::unique_ptr<grpc::Server> server_;
+  std::vector<std::unique_ptr<grpc::ServerCompletionQueue>> cqs_;
+  std::vector<std::thread> threads_;
+
+  std::mutex mu_;
+  bool shutdown_;
+};
+
+#endif  // GRPC_EXAMPLES_CPP_RPCRELAY_RELAY_SERVER_H
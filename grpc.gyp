@@ -401,6 +401,7 @@
         'src/core/lib/surface/lame_client.cc',
         'src/core/lib/surface/metadata_array.cc',
         'src/core/lib/surface/server.cc',
+        'src/core/lib/surface/server_response_cache.cc',
         'src/core/lib/surface/validate_metadata.cc',
         'src/core/lib/surface/version.cc',
         'src/core/lib/transport/bdp_estimator.cc',
@@ -412,6 +413,7 @@
         'src/core/lib/transport/pid_controller.cc',
         'src/core/lib/transport/service_config.cc',
         'src/core/lib/transport/static_metadata.cc',
+        'src/core/lib/transport/registered_metadata.cc',
         'src/core/lib/transport/status_conversion.cc',
         'src/core/lib/transport/status_metadata.cc',
         'src/core/lib/transport/timeout_encoding.cc',
@@ -537,6 +539,7 @@
         'src/core/ext/filters/client_channel/parse_address.cc',
         'src/core/ext/filters/client_channel/proxy_mapper.cc',
         'src/core/ext/filters/client_channel/proxy_mapper_registry.cc',
+        'src/core/ext/filters/client_channel/request_coalescing_filter.cc',
         'src/core/ext/filters/client_channel/request_routing.cc',
         'src/core/ext/filters/client_channel/resolver.cc',
         'src/core/ext/filters/client_channel/resolver_registry.cc',
@@ -766,6 +769,7 @@
         'src/core/lib/surface/lame_client.cc',
         'src/core/lib/surface/metadata_array.cc',
         'src/core/lib/surface/server.cc',
+        'src/core/lib/surface/server_response_cache.cc',
         'src/core/lib/surface/validate_metadata.cc',
         'src/core/lib/surface/version.cc',
         'src/core/lib/transport/bdp_estimator.cc',
@@ -777,6 +781,7 @@
         'src/core/lib/transport/pid_controller.cc',
         'src/core/lib/transport/service_config.cc',
         'src/core/lib/transport/static_metadata.cc',
+        'src/core/lib/transport/registered_metadata.cc',
         'src/core/lib/transport/status_conversion.cc',
         'src/core/lib/transport/status_metadata.cc',
         'src/core/lib/transport/timeout_encoding.cc',
@@ -801,6 +806,7 @@
         'src/core/ext/filters/client_channel/parse_address.cc',
         'src/core/ext/filters/client_channel/proxy_mapper.cc',
         'src/core/ext/filters/client_channel/proxy_mapper_registry.cc',
+        'src/core/ext/filters/client_channel/request_coalescing_filter.cc',
         'src/core/ext/filters/client_channel/request_routing.cc',
         'src/core/ext/filters/client_channel/resolver.cc',
         'src/core/ext/filters/client_channel/resolver_registry.cc',
@@ -1011,6 +1017,7 @@
         'src/core/lib/surface/lame_client.cc',
         'src/core/lib/surface/metadata_array.cc',
         'src/core/lib/surface/server.cc',
+        'src/core/lib/surface/server_response_cache.cc',
         'src/core/lib/surface/validate_metadata.cc',
         'src/core/lib/surface/version.cc',
         'src/core/lib/transport/bdp_estimator.cc',
@@ -1022,6 +1029,7 @@
         'src/core/lib/transport/pid_controller.cc',
         'src/core/lib/transport/service_config.cc',
         'src/core/lib/transport/static_metadata.cc',
+        'src/core/lib/transport/registered_metadata.cc',
         'src/core/lib/transport/status_conversion.cc',
         'src/core/lib/transport/status_metadata.cc',
         'src/core/lib/transport/timeout_encoding.cc',
@@ -1046,6 +1054,7 @@
         'src/core/ext/filters/client_channel/parse_address.cc',
         'src/core/ext/filters/client_channel/proxy_mapper.cc',
         'src/core/ext/filters/client_channel/proxy_mapper_registry.cc',
+        'src/core/ext/filters/client_channel/request_coalescing_filter.cc',
         'src/core/ext/filters/client_channel/request_routing.cc',
         'src/core/ext/filters/client_channel/resolver.cc',
         'src/core/ext/filters/client_channel/resolver_registry.cc',
@@ -1233,6 +1242,7 @@
         'src/core/lib/surface/lame_client.cc',
         'src/core/lib/surface/metadata_array.cc',
         'src/core/lib/surface/server.cc',
+        'src/core/lib/surface/server_response_cache.cc',
         'src/core/lib/surface/validate_metadata.cc',
         'src/core/lib/surface/version.cc',
         'src/core/lib/transport/bdp_estimator.cc',
@@ -1244,6 +1254,7 @@
         'src/core/lib/transport/pid_controller.cc',
         'src/core/lib/transport/service_config.cc',
         'src/core/lib/transport/static_metadata.cc',
+        'src/core/lib/transport/registered_metadata.cc',
         'src/core/lib/transport/status_conversion.cc',
         'src/core/lib/transport/status_metadata.cc',
         'src/core/lib/transport/timeout_encoding.cc',
@@ -1303,6 +1314,7 @@
         'src/core/ext/filters/client_channel/parse_address.cc',
         'src/core/ext/filters/client_channel/proxy_mapper.cc',
         'src/core/ext/filters/client_channel/proxy_mapper_registry.cc',
+        'src/core/ext/filters/client_channel/request_coalescing_filter.cc',
         'src/core/ext/filters/client_channel/request_routing.cc',
         'src/core/ext/filters/client_channel/resolver.cc',
         'src/core/ext/filters/client_channel/resolver_registry.cc',
@@ -58,6 +58,23 @@ GRPCAPI void grpc_call_details_destroy(grpc_call_details* details);
     the reverse order they were initialized. */
 GRPCAPI void grpc_register_plugin(void (*init)(void), void (*destroy)(void));
 
+/** EXPERIMENTAL API - This function may be removed and changed, in the future.
+
+    Registers \a key as a well-known metadata key of the application (say a
+    tenant id, request id or trace context header), giving it the treatment
+    that the library's own headers get: metadata with this key is cheap to
+    create and look up, and its key is reliably indexed by HPACK. \a flags is
+    a bitset of GRPC_WELL_KNOWN_METADATA_* flags.
+
+    Must be called before grpc_init(), while no other thread is using the
+    library; registrations last for the lifetime of the process. At most
+    GRPC_MAX_WELL_KNOWN_METADATA_KEYS keys can be registered.
+    Returns the index of the key (registering a key again returns its
+    existing index and adds \a flags), or -1 if \a key is not a legal
+    metadata key, is built into the library or cannot be registered now. */
+GRPCAPI int grpc_register_well_known_metadata_key(const char* key,
+                                                  uint32_t flags);
+
 /** Initialize the grpc library.
 
     After it's called, a matching invocation to grpc_shutdown() is expected.
@@ -73,6 +73,17 @@ GRPCAPI void grpc_byte_buffer_reader_destroy(grpc_byte_buffer_reader* reader);
 GRPCAPI int grpc_byte_buffer_reader_next(grpc_byte_buffer_reader* reader,
                                          grpc_slice* slice);
 
+/** EXPERIMENTAL API - This function may be removed and changed, in the future.
+ *
+ * Updates \a slice to point to the next piece of data from \a reader and
+ * returns 1. Returns 0 at the end of the stream. Unlike
+ * grpc_byte_buffer_reader_next(), no reference is taken on the slice: it is a
+ * read-only view into the data owned by the reader, which stays valid until
+ * the reader is destroyed, provided the underlying grpc_byte_buffer is neither
+ * modified nor destroyed in the meantime. */
+GRPCAPI int grpc_byte_buffer_reader_peek(grpc_byte_buffer_reader* reader,
+                                         grpc_slice** slice);
+
 /** Merge all data from \a reader into single slice */
 GRPCAPI grpc_slice
 grpc_byte_buffer_reader_readall(grpc_byte_buffer_reader* reader);
@@ -310,6 +310,12 @@ typedef struct {
   "grpc.experimental.tcp_min_read_chunk_size"
 #define GRPC_ARG_TCP_MAX_READ_CHUNK_SIZE \
   "grpc.experimental.tcp_max_read_chunk_size"
+/** Channel arg (integer) setting SO_BUSY_POLL, in microseconds, on the TCP
+    sockets of a channel or server: blocking reads on these sockets busy poll
+    the device queue for up to that long before sleeping. Raising it above the
+    net.core.busy_read sysctl needs CAP_NET_ADMIN. Linux only; 0 or unset
+    leaves the system default. See also the "epoll1-busy" polling engine. */
+#define GRPC_ARG_SOCKET_BUSY_POLL_US "grpc.experimental.socket_busy_poll_us"
 /* Timeout in milliseconds to use for calls to the grpclb load balancer.
    If 0 or unset, the balancer calls will have no deadline. */
 #define GRPC_ARG_GRPCLB_CALL_TIMEOUT_MS "grpc.grpclb_call_timeout_ms"
@@ -317,6 +323,13 @@ typedef struct {
    balancer before using fallback backend addresses from the resolver.
    If 0, fallback will never be used. Default value is 10000. */
 #define GRPC_ARG_GRPCLB_FALLBACK_TIMEOUT_MS "grpc.grpclb_fallback_timeout_ms"
+/* Percentage (0..100) of the backends in a new serverlist from the grpclb load
+   balancer that must be READY before picks move over to them. Until then,
+   picks keep going to the READY backends of the previous serverlist while
+   connections to the new ones are established in the background. If 0 or
+   unset, picks move over as soon as one new backend is READY. */
+#define GRPC_ARG_GRPCLB_PREWARM_READY_PERCENT \
+  "grpc.grpclb_prewarm_ready_percent"
 /** If non-zero, grpc server's cronet compression workaround will be enabled */
 #define GRPC_ARG_WORKAROUND_CRONET_COMPRESSION \
   "grpc.workaround.cronet_compression"
@@ -362,6 +375,18 @@ typedef struct {
 #define GRPC_ARG_CHANNEL_POOL_DOMAIN "grpc.channel_pooling_domain"
 /** gRPC Objective-C channel pooling id. */
 #define GRPC_ARG_CHANNEL_ID "grpc.channel_id"
+/** Maximum number of bytes of responses the server keeps for methods that the
+ *  service config (GRPC_ARG_SERVICE_CONFIG, set on the server) marks as
+ *  cacheable with a "responseCacheTtl". The cache is also charged to the
+ *  server's resource quota. Defaults to 4 MiB; 0 disables the cache. */
+#define GRPC_ARG_SERVER_RESPONSE_CACHE_MAX_BYTES \
+  "grpc.server_response_cache_max_bytes"
+/** If non-zero, identical unary calls that are in flight at the same time on
+ *  a connection share a single RPC, for the methods that the service config
+ *  marks with "coalesceRequests": true. Calls are identical if they have the
+ *  same method, authority and request payload; other metadata is not
+ *  compared. Defaults to 0. */
+#define GRPC_ARG_ENABLE_REQUEST_COALESCING "grpc.enable_request_coalescing"
 /** \} */
 
 /** Result of a grpc call. If the caller satisfies the prerequisites of a
@@ -462,6 +487,14 @@ typedef struct grpc_metadata {
   } internal_data;
 } grpc_metadata;
 
+/** Maximum number of keys that can be registered with
+    grpc_register_well_known_metadata_key() */
+#define GRPC_MAX_WELL_KNOWN_METADATA_KEYS 8
+/** Flag for grpc_register_well_known_metadata_key(): the key's values come
+    from a small set (e.g. a tenant id) rather than being unique per call (e.g.
+    a request id), so they are worth interning */
+#define GRPC_WELL_KNOWN_METADATA_REPEATED_VALUES (0x00000001u)
+
 /** The type of completion (for grpc_event) */
 typedef enum grpc_completion_type {
   /** Shutting down */
@@ -21,6 +21,7 @@
 
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include <grpc/grpc.h>
 #include <grpcpp/impl/call.h>
@@ -38,6 +39,28 @@ namespace experimental {
 /// TODO(roth): Once we see whether this proves useful, either create a gRFC
 /// and change this to be a method of the Channel class, or remove it.
 void ChannelResetConnectionBackoff(Channel* channel);
+
+/// Watches the connectivity state of a group of channels with a single
+/// deadline timer and a single completion, which costs much less than a
+/// NotifyOnStateChange per channel when watching many channels.
+/// \a states[i] holds the last observed state of \a channels[i] and is
+/// updated when it changes. \a tag is returned by \a cq once every channel
+/// has changed state or \a deadline has passed, whichever comes first, with
+/// ok set if any of the states changed. \a states must stay valid until then.
+void NotifyOnChannelsStateChange(const std::vector<Channel*>& channels,
+                                 grpc_connectivity_state* states,
+                                 gpr_timespec deadline, CompletionQueue* cq,
+                                 void* tag);
+
+template <typename T>
+void NotifyOnChannelsStateChange(const std::vector<Channel*>& channels,
+                                 grpc_connectivity_state* states,
+                                 const T& deadline, CompletionQueue* cq,
+                                 void* tag) {
+  TimePoint<T> deadline_tp(deadline);
+  NotifyOnChannelsStateChange(channels, states, deadline_tp.raw_time(), cq,
+                              tag);
+}
 }  // namespace experimental
 
 /// Channels represent a connection to an endpoint. Created by \a CreateChannel.
@@ -63,6 +86,9 @@ class Channel final : public ChannelInterface,
   template <class InputMessage, class OutputMessage>
   friend class internal::BlockingUnaryCallImpl;
   friend void experimental::ChannelResetConnectionBackoff(Channel* channel);
+  friend void experimental::NotifyOnChannelsStateChange(
+      const std::vector<Channel*>& channels, grpc_connectivity_state* states,
+      gpr_timespec deadline, CompletionQueue* cq, void* tag);
   friend std::shared_ptr<Channel> CreateChannelInternal(
       const grpc::string& host, grpc_channel* c_channel,
       std::vector<
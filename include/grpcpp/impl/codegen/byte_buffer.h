@@ -41,22 +41,26 @@ template <class R>
 class CallOpRecvMessage;
 class CallOpGenericRecvMessage;
 class MethodHandler;
-template <class ServiceType, class RequestType, class ResponseType>
+template <class ServiceType, class RequestType, class ResponseType,
+          class MessageAllocation>
 class RpcMethodHandler;
-template <class ServiceType, class RequestType, class ResponseType>
+template <class ServiceType, class RequestType, class ResponseType,
+          class MessageAllocation>
 class ServerStreamingHandler;
-template <class RequestType, class ResponseType>
+template <class RequestType, class ResponseType, class MessageAllocation>
 class CallbackUnaryHandler;
-template <class RequestType, class ResponseType>
+template <class RequestType, class ResponseType, class MessageAllocation>
 class CallbackServerStreamingHandler;
 template <StatusCode code>
 class ErrorMethodHandler;
 template <class R>
 class DeserializeFuncType;
 class GrpcByteBufferPeer;
-template <class ServiceType, class RequestType, class ResponseType>
+template <class ServiceType, class RequestType, class ResponseType,
+          class MessageAllocation>
 class RpcMethodHandler;
-template <class ServiceType, class RequestType, class ResponseType>
+template <class ServiceType, class RequestType, class ResponseType,
+          class MessageAllocation>
 class ServerStreamingHandler;
 
 }  // namespace internal
@@ -157,17 +161,21 @@ class ByteBuffer final {
   template <class R>
   friend class internal::CallOpRecvMessage;
   friend class internal::CallOpGenericRecvMessage;
-  template <class ServiceType, class RequestType, class ResponseType>
+  template <class ServiceType, class RequestType, class ResponseType,
+            class MessageAllocation>
   friend class RpcMethodHandler;
-  template <class ServiceType, class RequestType, class ResponseType>
+  template <class ServiceType, class RequestType, class ResponseType,
+            class MessageAllocation>
   friend class ServerStreamingHandler;
-  template <class ServiceType, class RequestType, class ResponseType>
+  template <class ServiceType, class RequestType, class ResponseType,
+            class MessageAllocation>
   friend class internal::RpcMethodHandler;
-  template <class ServiceType, class RequestType, class ResponseType>
+  template <class ServiceType, class RequestType, class ResponseType,
+            class MessageAllocation>
   friend class internal::ServerStreamingHandler;
-  template <class RequestType, class ResponseType>
+  template <class RequestType, class ResponseType, class MessageAllocation>
   friend class internal::CallbackUnaryHandler;
-  template <class RequestType, class ResponseType>
+  template <class RequestType, class ResponseType, class MessageAllocation>
   friend class ::grpc::internal::CallbackServerStreamingHandler;
   template <StatusCode code>
   friend class internal::ErrorMethodHandler;
@@ -843,13 +843,15 @@ class CallOpSet : public CallOpSetInterface,
  public:
   CallOpSet() : core_cq_tag_(this), return_tag_(this) {}
   // The copy constructor and assignment operator reset the value of
-  // core_cq_tag_, return_tag_, done_intercepting_ and interceptor_methods_
-  // since those are only meaningful on a specific object, not across objects.
+  // core_cq_tag_, return_tag_, done_intercepting_, intercepted_ and
+  // interceptor_methods_ since those are only meaningful on a specific object,
+  // not across objects.
   CallOpSet(const CallOpSet& other)
       : core_cq_tag_(this),
         return_tag_(this),
         call_(other.call_),
         done_intercepting_(false),
+        intercepted_(false),
         interceptor_methods_(InterceptorBatchMethodsImpl()) {}
 
   CallOpSet& operator=(const CallOpSet& other) {
@@ -857,6 +859,7 @@ class CallOpSet : public CallOpSetInterface,
     return_tag_ = this;
     call_ = other.call_;
     done_intercepting_ = false;
+    intercepted_ = false;
     interceptor_methods_ = InterceptorBatchMethodsImpl();
     return *this;
   }
@@ -867,6 +870,15 @@ class CallOpSet : public CallOpSetInterface,
     call_ =
         *call;  // It's fine to create a copy of call since it's just pointers
 
+    // Fast path: with no interceptors registered on the channel or server,
+    // none of the interception hook points can be observed, so skip filling
+    // them in and start the batch directly.
+    intercepted_ = !InterceptorBatchMethodsImpl::InterceptorsListEmpty(call_);
+    if (!intercepted_) {
+      ContinueFillOpsAfterInterception();
+      return;
+    }
+
     if (RunInterceptors()) {
       ContinueFillOpsAfterInterception();
     } else {
@@ -893,6 +905,12 @@ class CallOpSet : public CallOpSetInterface,
     this->Op5::FinishOp(status);
     this->Op6::FinishOp(status);
     saved_status_ = *status;
+    if (!intercepted_) {
+      FinishOpsWithoutInterception();
+      *tag = return_tag_;
+      g_core_codegen_interface->grpc_call_unref(call_.call());
+      return true;
+    }
     if (RunInterceptorsPostRecv()) {
       *tag = return_tag_;
       g_core_codegen_interface->grpc_call_unref(call_.call());
@@ -974,13 +992,31 @@ class CallOpSet : public CallOpSetInterface,
     this->Op4::SetFinishInterceptionHookPoint(&interceptor_methods_);
     this->Op5::SetFinishInterceptionHookPoint(&interceptor_methods_);
     this->Op6::SetFinishInterceptionHookPoint(&interceptor_methods_);
+    // Batches that expose no post-recv hook points (e.g. a batch that only
+    // sends) do not need a second pass up the interceptor stack, which would
+    // otherwise cost an extra round trip through the core.
+    if (!interceptor_methods_.HasHookPoints()) {
+      return true;
+    }
     return interceptor_methods_.RunInterceptors();
   }
+  // The ops reset their per-batch state when their finish hook points are set,
+  // so that still needs to happen when no interceptors are registered. The
+  // hook points themselves are never read on this path.
+  void FinishOpsWithoutInterception() {
+    this->Op1::SetFinishInterceptionHookPoint(&interceptor_methods_);
+    this->Op2::SetFinishInterceptionHookPoint(&interceptor_methods_);
+    this->Op3::SetFinishInterceptionHookPoint(&interceptor_methods_);
+    this->Op4::SetFinishInterceptionHookPoint(&interceptor_methods_);
+    this->Op5::SetFinishInterceptionHookPoint(&interceptor_methods_);
+    this->Op6::SetFinishInterceptionHookPoint(&interceptor_methods_);
+  }
 
   void* core_cq_tag_;
   void* return_tag_;
   Call call_;
   bool done_intercepting_ = false;
+  bool intercepted_ = false;
   InterceptorBatchMethodsImpl interceptor_methods_;
   bool saved_status_;
 };
@@ -70,11 +70,14 @@ class ServerInterface;
 namespace internal {
 class CompletionQueueTag;
 class RpcMethod;
-template <class ServiceType, class RequestType, class ResponseType>
+template <class ServiceType, class RequestType, class ResponseType,
+          class MessageAllocation>
 class RpcMethodHandler;
-template <class ServiceType, class RequestType, class ResponseType>
+template <class ServiceType, class RequestType, class ResponseType,
+          class MessageAllocation>
 class ClientStreamingHandler;
-template <class ServiceType, class RequestType, class ResponseType>
+template <class ServiceType, class RequestType, class ResponseType,
+          class MessageAllocation>
 class ServerStreamingHandler;
 template <class ServiceType, class RequestType, class ResponseType>
 class BidiStreamingHandler;
@@ -259,11 +262,14 @@ class CompletionQueue : private GrpcLibraryCodegen {
   friend class ::grpc::ServerWriter;
   template <class W, class R>
   friend class ::grpc::internal::ServerReaderWriterBody;
-  template <class ServiceType, class RequestType, class ResponseType>
+  template <class ServiceType, class RequestType, class ResponseType,
+            class MessageAllocation>
   friend class ::grpc::internal::RpcMethodHandler;
-  template <class ServiceType, class RequestType, class ResponseType>
+  template <class ServiceType, class RequestType, class ResponseType,
+            class MessageAllocation>
   friend class ::grpc::internal::ClientStreamingHandler;
-  template <class ServiceType, class RequestType, class ResponseType>
+  template <class ServiceType, class RequestType, class ResponseType,
+            class MessageAllocation>
   friend class ::grpc::internal::ServerStreamingHandler;
   template <class Streamer, bool WriteNeeded>
   friend class ::grpc::internal::TemplatedBidiStreamingHandler;
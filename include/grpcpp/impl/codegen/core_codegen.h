@@ -116,6 +116,9 @@ class CoreCodegen final : public CoreCodegenInterface {
 
   void assert_fail(const char* failed_assertion, const char* file,
                    int line) override;
+
+  int grpc_byte_buffer_reader_peek(grpc_byte_buffer_reader* reader,
+                                   grpc_slice** slice) override;
 };
 
 }  // namespace grpc
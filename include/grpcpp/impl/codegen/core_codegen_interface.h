@@ -133,6 +133,11 @@ class CoreCodegenInterface {
 
   virtual gpr_timespec gpr_inf_future(gpr_clock_type type) = 0;
   virtual gpr_timespec gpr_time_0(gpr_clock_type type) = 0;
+
+  // Added after the rest of the interface so that the vtable slots of the
+  // methods above keep their positions.
+  virtual int grpc_byte_buffer_reader_peek(grpc_byte_buffer_reader* reader,
+                                           grpc_slice** slice) = 0;
 };
 
 extern CoreCodegenInterface* g_core_codegen_interface;
@@ -77,6 +77,7 @@ class InterceptorBatchMethodsImpl
 
   void AddInterceptionHookPoint(experimental::InterceptionHookPoints type) {
     hooks_[static_cast<size_t>(type)] = true;
+    has_hook_points_ = true;
   }
 
   ByteBuffer* GetSerializedSendMessage() override {
@@ -219,6 +220,24 @@ class InterceptorBatchMethodsImpl
   // Alternatively, RunInterceptors(std::function<void(void)> f) can be used.
   void SetCallOpSetInterface(CallOpSetInterface* ops) { ops_ = ops; }
 
+  // Returns true if no interceptors are registered on \a call, either through
+  // the channel for client calls or through the server for server calls. This
+  // is checked before any hook points are filled in so that CallOpSet can skip
+  // the interception bookkeeping entirely on its fast path.
+  static bool InterceptorsListEmpty(const Call& call) {
+    auto* client_rpc_info = call.client_rpc_info();
+    if (client_rpc_info != nullptr) {
+      return client_rpc_info->interceptors_.size() == 0;
+    }
+    auto* server_rpc_info = call.server_rpc_info();
+    return server_rpc_info == nullptr ||
+           server_rpc_info->interceptors_.size() == 0;
+  }
+
+  // Returns true if any hook point has been added since the state was last
+  // cleared
+  bool HasHookPoints() const { return has_hook_points_; }
+
   // Returns true if no interceptors are run. This should be used only by
   // subclasses of CallOpSetInterface. SetCall and SetCallOpSetInterface should
   // have been called before this. After all the interceptors are done running,
@@ -359,12 +378,14 @@ class InterceptorBatchMethodsImpl
              static_cast<size_t>(i) + 1)) {
       hooks_[static_cast<size_t>(i)] = false;
     }
+    has_hook_points_ = false;
   }
 
   std::array<bool,
              static_cast<size_t>(
                  experimental::InterceptionHookPoints::NUM_INTERCEPTION_HOOKS)>
       hooks_;
+  bool has_hook_points_ = false;
 
   size_t current_interceptor_index_ = 0;  // Current iterator
   bool reverse_ = false;
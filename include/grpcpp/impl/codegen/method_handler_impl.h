@@ -49,7 +49,8 @@ Status CatchingFunctionHandler(Callable&& handler) {
 }
 
 /// A wrapper class of an application provided rpc method handler.
-template <class ServiceType, class RequestType, class ResponseType>
+template <class ServiceType, class RequestType, class ResponseType,
+          class MessageAllocation = DefaultMessageAllocation>
 class RpcMethodHandler : public MethodHandler {
  public:
   RpcMethodHandler(std::function<Status(ServiceType*, ServerContext*,
@@ -59,14 +60,15 @@ class RpcMethodHandler : public MethodHandler {
       : func_(func), service_(service) {}
 
   void RunHandler(const HandlerParameter& param) final {
-    ResponseType rsp;
+    auto* request = static_cast<RequestType*>(param.request);
+    ResponseType* rsp = MessageAllocation::template NewResponse<ResponseType>(
+        param.call->call(), request);
     Status status = param.status;
     if (status.ok()) {
-      status = CatchingFunctionHandler([this, &param, &rsp] {
-        return func_(service_, param.server_context,
-                     static_cast<RequestType*>(param.request), &rsp);
+      status = CatchingFunctionHandler([this, &param, request, rsp] {
+        return func_(service_, param.server_context, request, rsp);
       });
-      static_cast<RequestType*>(param.request)->~RequestType();
+      MessageAllocation::DeleteMessage(request);
     }
 
     GPR_CODEGEN_ASSERT(!param.server_context->sent_initial_metadata_);
@@ -79,25 +81,27 @@ class RpcMethodHandler : public MethodHandler {
       ops.set_compression_level(param.server_context->compression_level());
     }
     if (status.ok()) {
-      status = ops.SendMessagePtr(&rsp);
+      status = ops.SendMessagePtr(rsp);
     }
     ops.ServerSendStatus(&param.server_context->trailing_metadata_, status);
     param.call->PerformOps(&ops);
     param.call->cq()->Pluck(&ops);
+    MessageAllocation::DeleteMessage(rsp);
+    MessageAllocation::EndCall(request, rsp);
   }
 
   void* Deserialize(grpc_call* call, grpc_byte_buffer* req,
                     Status* status) final {
     ByteBuffer buf;
     buf.set_buffer(req);
-    auto* request = new (g_core_codegen_interface->grpc_call_arena_alloc(
-        call, sizeof(RequestType))) RequestType();
+    auto* request = MessageAllocation::template NewRequest<RequestType>(call);
     *status = SerializationTraits<RequestType>::Deserialize(&buf, request);
     buf.Release();
     if (status->ok()) {
       return request;
     }
-    request->~RequestType();
+    MessageAllocation::DeleteMessage(request);
+    MessageAllocation::EndCall(request, static_cast<ResponseType*>(nullptr));
     return nullptr;
   }
 
@@ -111,7 +115,8 @@ class RpcMethodHandler : public MethodHandler {
 };
 
 /// A wrapper class of an application provided client streaming handler.
-template <class ServiceType, class RequestType, class ResponseType>
+template <class ServiceType, class RequestType, class ResponseType,
+          class MessageAllocation = DefaultMessageAllocation>
 class ClientStreamingHandler : public MethodHandler {
  public:
   ClientStreamingHandler(
@@ -123,9 +128,10 @@ class ClientStreamingHandler : public MethodHandler {
 
   void RunHandler(const HandlerParameter& param) final {
     ServerReader<RequestType> reader(param.call, param.server_context);
-    ResponseType rsp;
-    Status status = CatchingFunctionHandler([this, &param, &reader, &rsp] {
-      return func_(service_, param.server_context, &reader, &rsp);
+    ResponseType* rsp = MessageAllocation::template NewResponse<ResponseType>(
+        param.call->call(), static_cast<RequestType*>(nullptr));
+    Status status = CatchingFunctionHandler([this, &param, &reader, rsp] {
+      return func_(service_, param.server_context, &reader, rsp);
     });
 
     CallOpSet<CallOpSendInitialMetadata, CallOpSendMessage,
@@ -139,11 +145,13 @@ class ClientStreamingHandler : public MethodHandler {
       }
     }
     if (status.ok()) {
-      status = ops.SendMessagePtr(&rsp);
+      status = ops.SendMessagePtr(rsp);
     }
     ops.ServerSendStatus(&param.server_context->trailing_metadata_, status);
     param.call->PerformOps(&ops);
     param.call->cq()->Pluck(&ops);
+    MessageAllocation::DeleteMessage(rsp);
+    MessageAllocation::EndCall(static_cast<RequestType*>(nullptr), rsp);
   }
 
  private:
@@ -154,7 +162,8 @@ class ClientStreamingHandler : public MethodHandler {
 };
 
 /// A wrapper class of an application provided server streaming handler.
-template <class ServiceType, class RequestType, class ResponseType>
+template <class ServiceType, class RequestType, class ResponseType,
+          class MessageAllocation = DefaultMessageAllocation>
 class ServerStreamingHandler : public MethodHandler {
  public:
   ServerStreamingHandler(
@@ -165,14 +174,15 @@ class ServerStreamingHandler : public MethodHandler {
       : func_(func), service_(service) {}
 
   void RunHandler(const HandlerParameter& param) final {
+    auto* request = static_cast<RequestType*>(param.request);
     Status status = param.status;
     if (status.ok()) {
       ServerWriter<ResponseType> writer(param.call, param.server_context);
-      status = CatchingFunctionHandler([this, &param, &writer] {
-        return func_(service_, param.server_context,
-                     static_cast<RequestType*>(param.request), &writer);
+      status = CatchingFunctionHandler([this, &param, request, &writer] {
+        return func_(service_, param.server_context, request, &writer);
       });
-      static_cast<RequestType*>(param.request)->~RequestType();
+      MessageAllocation::DeleteMessage(request);
+      MessageAllocation::EndCall(request, static_cast<ResponseType*>(nullptr));
     }
 
     CallOpSet<CallOpSendInitialMetadata, CallOpServerSendStatus> ops;
@@ -195,14 +205,14 @@ class ServerStreamingHandler : public MethodHandler {
                     Status* status) final {
     ByteBuffer buf;
     buf.set_buffer(req);
-    auto* request = new (g_core_codegen_interface->grpc_call_arena_alloc(
-        call, sizeof(RequestType))) RequestType();
+    auto* request = MessageAllocation::template NewRequest<RequestType>(call);
     *status = SerializationTraits<RequestType>::Deserialize(&buf, request);
     buf.Release();
     if (status->ok()) {
       return request;
     }
-    request->~RequestType();
+    MessageAllocation::DeleteMessage(request);
+    MessageAllocation::EndCall(request, static_cast<ResponseType*>(nullptr));
     return nullptr;
   }
 
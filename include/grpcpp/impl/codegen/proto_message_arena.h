@@ -0,0 +1,155 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPCPP_IMPL_CODEGEN_PROTO_MESSAGE_ARENA_H
+#define GRPCPP_IMPL_CODEGEN_PROTO_MESSAGE_ARENA_H
+
+#include <new>
+#include <type_traits>
+
+#include <grpc/impl/codegen/grpc_types.h>
+#include <grpcpp/impl/codegen/config_protobuf.h>
+#include <grpcpp/impl/codegen/core_codegen_interface.h>
+#include <grpcpp/impl/codegen/rpc_service_method.h>
+
+/// This header provides a message allocation policy for the method handlers
+/// that places the request and response of each call on a protobuf arena.
+/// Generated code uses it for services compiled with the
+/// \a use_message_arena=true option of the C++ plugin.
+
+namespace grpc {
+
+extern CoreCodegenInterface* g_core_codegen_interface;
+
+namespace internal {
+
+/// Size of the first block of each per-call protobuf arena. It is carved out
+/// of the call arena together with the protobuf arena itself, so that calls
+/// with small messages never allocate from the heap; larger messages spill
+/// into blocks that the protobuf arena allocates and frees on its own.
+constexpr size_t kMessageArenaInitialBlockSize = 1024;
+
+/// Creates a protobuf arena whose initial block is \a block. The arena itself
+/// is constructed at \a storage, which must hold sizeof(protobuf::Arena).
+inline protobuf::Arena* NewMessageArena(void* storage, void* block,
+                                        size_t block_size) {
+  protobuf::ArenaOptions options;
+  options.initial_block = static_cast<char*>(block);
+  options.initial_block_size = block_size;
+  return new (storage) protobuf::Arena(options);
+}
+
+/// Creates a protobuf arena that lives on the arena of \a call. It must be
+/// destroyed with DestroyMessageArena before the call is released.
+inline protobuf::Arena* NewCallMessageArena(grpc_call* call) {
+  char* storage =
+      static_cast<char*>(g_core_codegen_interface->grpc_call_arena_alloc(
+          call, sizeof(protobuf::Arena) + kMessageArenaInitialBlockSize));
+  return NewMessageArena(storage, storage + sizeof(protobuf::Arena),
+                         kMessageArenaInitialBlockSize);
+}
+
+inline void DestroyMessageArena(protobuf::Arena* arena) { arena->~Arena(); }
+
+/// Message allocation policy (see DefaultMessageAllocation) that creates the
+/// arena-enabled messages of a call (option cc_enable_arenas) on a single
+/// protobuf arena, so that their nested messages, strings and repeated fields
+/// are arena allocated as well. Other message types cannot be created on an
+/// arena and fall back to DefaultMessageAllocation. The arena is created by
+/// the first arena-enabled message of the call, handed from the request to
+/// the response, and released by EndCall.
+struct ProtoArenaMessageAllocation {
+  template <class MessageType>
+  using OnArena = protobuf::Arena::is_arena_constructable<MessageType>;
+
+  template <class RequestType>
+  static RequestType* NewRequest(grpc_call* call) {
+    return NewRequest<RequestType>(call, OnArena<RequestType>());
+  }
+
+  template <class ResponseType, class RequestType>
+  static ResponseType* NewResponse(grpc_call* call, RequestType* request) {
+    return NewResponse<ResponseType>(call, MessageArena(request),
+                                     OnArena<ResponseType>());
+  }
+
+  template <class MessageType>
+  static void DeleteMessage(MessageType* message) {
+    DeleteMessage(message, OnArena<MessageType>());
+  }
+
+  template <class RequestType, class ResponseType>
+  static void EndCall(RequestType* request, ResponseType* response) {
+    protobuf::Arena* arena = MessageArena(request);
+    if (arena == nullptr) arena = MessageArena(response);
+    if (arena != nullptr) DestroyMessageArena(arena);
+  }
+
+ private:
+  template <class RequestType>
+  static RequestType* NewRequest(grpc_call* call, std::true_type) {
+    return protobuf::Arena::CreateMessage<RequestType>(
+        NewCallMessageArena(call));
+  }
+  template <class RequestType>
+  static RequestType* NewRequest(grpc_call* call, std::false_type) {
+    return DefaultMessageAllocation::NewRequest<RequestType>(call);
+  }
+
+  /// \a arena is the arena of the request, or nullptr if it has none.
+  template <class ResponseType>
+  static ResponseType* NewResponse(grpc_call* call, protobuf::Arena* arena,
+                                   std::true_type) {
+    return protobuf::Arena::CreateMessage<ResponseType>(
+        arena != nullptr ? arena : NewCallMessageArena(call));
+  }
+  template <class ResponseType>
+  static ResponseType* NewResponse(grpc_call* call, protobuf::Arena* arena,
+                                   std::false_type) {
+    return DefaultMessageAllocation::NewResponse<ResponseType>(
+        call, static_cast<void*>(nullptr));
+  }
+
+  // Arena messages are destroyed together with their arena
+  template <class MessageType>
+  static void DeleteMessage(MessageType* message, std::true_type) {}
+  template <class MessageType>
+  static void DeleteMessage(MessageType* message, std::false_type) {
+    DefaultMessageAllocation::DeleteMessage(message);
+  }
+
+  /// Returns the arena that \a message was created on by this policy, or
+  /// nullptr if there is no message or its type is not arena-enabled.
+  template <class MessageType>
+  static protobuf::Arena* MessageArena(MessageType* message) {
+    return MessageArena(message, OnArena<MessageType>());
+  }
+  template <class MessageType>
+  static protobuf::Arena* MessageArena(MessageType* message, std::true_type) {
+    return message != nullptr ? message->GetArena() : nullptr;
+  }
+  template <class MessageType>
+  static protobuf::Arena* MessageArena(MessageType* message, std::false_type) {
+    return nullptr;
+  }
+};
+
+}  // namespace internal
+}  // namespace grpc
+
+#endif  // GRPCPP_IMPL_CODEGEN_PROTO_MESSAGE_ARENA_H
@@ -28,6 +28,7 @@
 #include <grpc/impl/codegen/log.h>
 #include <grpcpp/impl/codegen/byte_buffer.h>
 #include <grpcpp/impl/codegen/config.h>
+#include <grpcpp/impl/codegen/core_codegen_interface.h>
 #include <grpcpp/impl/codegen/rpc_method.h>
 #include <grpcpp/impl/codegen/status.h>
 
@@ -77,6 +78,35 @@ class MethodHandler {
   }
 };
 
+/// Message allocation policy of the method handlers. Handlers create the
+/// request and response messages they own through the policy, delete each of
+/// them once it is no longer used, and then call EndCall once with both of
+/// them. The default constructs both messages on the call arena.
+struct DefaultMessageAllocation {
+  template <class RequestType>
+  static RequestType* NewRequest(grpc_call* call) {
+    return new (g_core_codegen_interface->grpc_call_arena_alloc(
+        call, sizeof(RequestType))) RequestType();
+  }
+
+  /// \a request is the request of the same call, or nullptr if there is
+  /// none (client streaming, or the request failed to deserialize).
+  template <class ResponseType, class RequestType>
+  static ResponseType* NewResponse(grpc_call* call, RequestType* request) {
+    return new (g_core_codegen_interface->grpc_call_arena_alloc(
+        call, sizeof(ResponseType))) ResponseType();
+  }
+
+  template <class MessageType>
+  static void DeleteMessage(MessageType* message) {
+    message->~MessageType();
+  }
+
+  /// Either message may be nullptr if the call did not create it.
+  template <class RequestType, class ResponseType>
+  static void EndCall(RequestType* request, ResponseType* response) {}
+};
+
 /// Server side rpc method class
 class RpcServiceMethod : public RpcMethod {
  public:
@@ -251,7 +251,8 @@ class UnimplementedBidiReactor
   }
 };
 
-template <class RequestType, class ResponseType>
+template <class RequestType, class ResponseType,
+          class MessageAllocation = DefaultMessageAllocation>
 class CallbackUnaryHandler : public MethodHandler {
  public:
   CallbackUnaryHandler(
@@ -262,11 +263,13 @@ class CallbackUnaryHandler : public MethodHandler {
   void RunHandler(const HandlerParameter& param) final {
     // Arena allocate a controller structure (that includes request/response)
     g_core_codegen_interface->grpc_call_ref(param.call->call());
+    auto* request = static_cast<RequestType*>(param.request);
     auto* controller = new (g_core_codegen_interface->grpc_call_arena_alloc(
         param.call->call(), sizeof(ServerCallbackRpcControllerImpl)))
         ServerCallbackRpcControllerImpl(
-            param.server_context, param.call,
-            static_cast<RequestType*>(param.request),
+            param.server_context, param.call, request,
+            MessageAllocation::template NewResponse<ResponseType>(
+                param.call->call(), request),
             std::move(param.call_requester));
     Status status = param.status;
 
@@ -284,14 +287,14 @@ class CallbackUnaryHandler : public MethodHandler {
                     Status* status) final {
     ByteBuffer buf;
     buf.set_buffer(req);
-    auto* request = new (g_core_codegen_interface->grpc_call_arena_alloc(
-        call, sizeof(RequestType))) RequestType();
+    auto* request = MessageAllocation::template NewRequest<RequestType>(call);
     *status = SerializationTraits<RequestType>::Deserialize(&buf, request);
     buf.Release();
     if (status->ok()) {
       return request;
     }
-    request->~RequestType();
+    MessageAllocation::DeleteMessage(request);
+    MessageAllocation::EndCall(request, static_cast<ResponseType*>(nullptr));
     return nullptr;
   }
 
@@ -320,7 +323,7 @@ class CallbackUnaryHandler : public MethodHandler {
       // The response is dropped if the status is not OK.
       if (s.ok()) {
         finish_ops_.ServerSendStatus(&ctx_->trailing_metadata_,
-                                     finish_ops_.SendMessagePtr(&resp_));
+                                     finish_ops_.SendMessagePtr(resp_));
       } else {
         finish_ops_.ServerSendStatus(&ctx_->trailing_metadata_, s);
       }
@@ -350,22 +353,30 @@ class CallbackUnaryHandler : public MethodHandler {
     }
 
    private:
-    friend class CallbackUnaryHandler<RequestType, ResponseType>;
+    friend class CallbackUnaryHandler<RequestType, ResponseType,
+                                      MessageAllocation>;
 
     ServerCallbackRpcControllerImpl(ServerContext* ctx, Call* call,
-                                    const RequestType* req,
+                                    RequestType* req, ResponseType* resp,
                                     std::function<void()> call_requester)
         : ctx_(ctx),
           call_(*call),
           req_(req),
+          resp_(resp),
           call_requester_(std::move(call_requester)) {
       ctx_->BeginCompletionOp(call, [this](bool) { MaybeDone(); }, nullptr);
     }
 
-    ~ServerCallbackRpcControllerImpl() { req_->~RequestType(); }
+    ~ServerCallbackRpcControllerImpl() {
+      if (req_ != nullptr) {
+        MessageAllocation::DeleteMessage(req_);
+      }
+      MessageAllocation::DeleteMessage(resp_);
+      MessageAllocation::EndCall(req_, resp_);
+    }
 
     const RequestType* request() { return req_; }
-    ResponseType* response() { return &resp_; }
+    ResponseType* response() { return resp_; }
 
     void MaybeDone() {
       if (--callbacks_outstanding_ == 0) {
@@ -386,15 +397,16 @@ class CallbackUnaryHandler : public MethodHandler {
 
     ServerContext* ctx_;
     Call call_;
-    const RequestType* req_;
-    ResponseType resp_;
+    RequestType* req_;
+    ResponseType* resp_;
     std::function<void()> call_requester_;
     std::atomic_int callbacks_outstanding_{
         2};  // reserve for Finish and CompletionOp
   };
 };
 
-template <class RequestType, class ResponseType>
+template <class RequestType, class ResponseType,
+          class MessageAllocation = DefaultMessageAllocation>
 class CallbackClientStreamingHandler : public MethodHandler {
  public:
   CallbackClientStreamingHandler(
@@ -449,7 +461,7 @@ class CallbackClientStreamingHandler : public MethodHandler {
       // The response is dropped if the status is not OK.
       if (s.ok()) {
         finish_ops_.ServerSendStatus(&ctx_->trailing_metadata_,
-                                     finish_ops_.SendMessagePtr(&resp_));
+                                     finish_ops_.SendMessagePtr(resp_));
       } else {
         finish_ops_.ServerSendStatus(&ctx_->trailing_metadata_, s);
       }
@@ -483,13 +495,16 @@ class CallbackClientStreamingHandler : public MethodHandler {
     }
 
    private:
-    friend class CallbackClientStreamingHandler<RequestType, ResponseType>;
+    friend class CallbackClientStreamingHandler<RequestType, ResponseType,
+                                                MessageAllocation>;
 
     ServerCallbackReaderImpl(
         ServerContext* ctx, Call* call, std::function<void()> call_requester,
         experimental::ServerReadReactor<RequestType, ResponseType>* reactor)
         : ctx_(ctx),
           call_(*call),
+          resp_(MessageAllocation::template NewResponse<ResponseType>(
+              call->call(), static_cast<RequestType*>(nullptr))),
           call_requester_(std::move(call_requester)),
           reactor_(reactor) {
       ctx_->BeginCompletionOp(call, [this](bool) { MaybeDone(); }, reactor);
@@ -502,9 +517,12 @@ class CallbackClientStreamingHandler : public MethodHandler {
       read_ops_.set_core_cq_tag(&read_tag_);
     }
 
-    ~ServerCallbackReaderImpl() {}
+    ~ServerCallbackReaderImpl() {
+      MessageAllocation::DeleteMessage(resp_);
+      MessageAllocation::EndCall(static_cast<RequestType*>(nullptr), resp_);
+    }
 
-    ResponseType* response() { return &resp_; }
+    ResponseType* response() { return resp_; }
 
     void MaybeDone() {
       if (--callbacks_outstanding_ == 0) {
@@ -528,7 +546,7 @@ class CallbackClientStreamingHandler : public MethodHandler {
 
     ServerContext* ctx_;
     Call call_;
-    ResponseType resp_;
+    ResponseType* resp_;
     std::function<void()> call_requester_;
     experimental::ServerReadReactor<RequestType, ResponseType>* reactor_;
     std::atomic_int callbacks_outstanding_{
@@ -536,7 +554,8 @@ class CallbackClientStreamingHandler : public MethodHandler {
   };
 };
 
-template <class RequestType, class ResponseType>
+template <class RequestType, class ResponseType,
+          class MessageAllocation = DefaultMessageAllocation>
 class CallbackServerStreamingHandler : public MethodHandler {
  public:
   CallbackServerStreamingHandler(
@@ -574,14 +593,14 @@ class CallbackServerStreamingHandler : public MethodHandler {
                     Status* status) final {
     ByteBuffer buf;
     buf.set_buffer(req);
-    auto* request = new (g_core_codegen_interface->grpc_call_arena_alloc(
-        call, sizeof(RequestType))) RequestType();
+    auto* request = MessageAllocation::template NewRequest<RequestType>(call);
     *status = SerializationTraits<RequestType>::Deserialize(&buf, request);
     buf.Release();
     if (status->ok()) {
       return request;
     }
-    request->~RequestType();
+    MessageAllocation::DeleteMessage(request);
+    MessageAllocation::EndCall(request, static_cast<ResponseType*>(nullptr));
     return nullptr;
   }
 
@@ -658,10 +677,11 @@ class CallbackServerStreamingHandler : public MethodHandler {
     }
 
    private:
-    friend class CallbackServerStreamingHandler<RequestType, ResponseType>;
+    friend class CallbackServerStreamingHandler<RequestType, ResponseType,
+                                                MessageAllocation>;
 
     ServerCallbackWriterImpl(
-        ServerContext* ctx, Call* call, const RequestType* req,
+        ServerContext* ctx, Call* call, RequestType* req,
         std::function<void()> call_requester,
         experimental::ServerWriteReactor<RequestType, ResponseType>* reactor)
         : ctx_(ctx),
@@ -678,7 +698,12 @@ class CallbackServerStreamingHandler : public MethodHandler {
                      &write_ops_);
       write_ops_.set_core_cq_tag(&write_tag_);
     }
-    ~ServerCallbackWriterImpl() { req_->~RequestType(); }
+    ~ServerCallbackWriterImpl() {
+      if (req_ != nullptr) {
+        MessageAllocation::DeleteMessage(req_);
+        MessageAllocation::EndCall(req_, static_cast<ResponseType*>(nullptr));
+      }
+    }
 
     const RequestType* request() { return req_; }
 
@@ -704,7 +729,7 @@ class CallbackServerStreamingHandler : public MethodHandler {
 
     ServerContext* ctx_;
     Call call_;
-    const RequestType* req_;
+    RequestType* req_;
     std::function<void()> call_requester_;
     experimental::ServerWriteReactor<RequestType, ResponseType>* reactor_;
     std::atomic_int callbacks_outstanding_{
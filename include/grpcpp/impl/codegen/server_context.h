@@ -58,19 +58,22 @@ class ServerWriter;
 namespace internal {
 template <class W, class R>
 class ServerReaderWriterBody;
-template <class ServiceType, class RequestType, class ResponseType>
+template <class ServiceType, class RequestType, class ResponseType,
+          class MessageAllocation>
 class RpcMethodHandler;
-template <class ServiceType, class RequestType, class ResponseType>
+template <class ServiceType, class RequestType, class ResponseType,
+          class MessageAllocation>
 class ClientStreamingHandler;
-template <class ServiceType, class RequestType, class ResponseType>
+template <class ServiceType, class RequestType, class ResponseType,
+          class MessageAllocation>
 class ServerStreamingHandler;
 template <class ServiceType, class RequestType, class ResponseType>
 class BidiStreamingHandler;
-template <class RequestType, class ResponseType>
+template <class RequestType, class ResponseType, class MessageAllocation>
 class CallbackUnaryHandler;
-template <class RequestType, class ResponseType>
+template <class RequestType, class ResponseType, class MessageAllocation>
 class CallbackClientStreamingHandler;
-template <class RequestType, class ResponseType>
+template <class RequestType, class ResponseType, class MessageAllocation>
 class CallbackServerStreamingHandler;
 template <class RequestType, class ResponseType>
 class CallbackBidiHandler;
@@ -283,19 +286,22 @@ class ServerContext {
   friend class ::grpc::ServerWriter;
   template <class W, class R>
   friend class ::grpc::internal::ServerReaderWriterBody;
-  template <class ServiceType, class RequestType, class ResponseType>
+  template <class ServiceType, class RequestType, class ResponseType,
+            class MessageAllocation>
   friend class ::grpc::internal::RpcMethodHandler;
-  template <class ServiceType, class RequestType, class ResponseType>
+  template <class ServiceType, class RequestType, class ResponseType,
+            class MessageAllocation>
   friend class ::grpc::internal::ClientStreamingHandler;
-  template <class ServiceType, class RequestType, class ResponseType>
+  template <class ServiceType, class RequestType, class ResponseType,
+            class MessageAllocation>
   friend class ::grpc::internal::ServerStreamingHandler;
   template <class Streamer, bool WriteNeeded>
   friend class ::grpc::internal::TemplatedBidiStreamingHandler;
-  template <class RequestType, class ResponseType>
+  template <class RequestType, class ResponseType, class MessageAllocation>
   friend class ::grpc::internal::CallbackUnaryHandler;
-  template <class RequestType, class ResponseType>
+  template <class RequestType, class ResponseType, class MessageAllocation>
   friend class ::grpc::internal::CallbackClientStreamingHandler;
-  template <class RequestType, class ResponseType>
+  template <class RequestType, class ResponseType, class MessageAllocation>
   friend class ::grpc::internal::CallbackServerStreamingHandler;
   template <class RequestType, class ResponseType>
   friend class ::grpc::internal::CallbackBidiHandler;
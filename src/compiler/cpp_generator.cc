@@ -142,6 +142,9 @@ grpc::string GetHeaderIncludes(grpc_generator::File* file,
         "grpcpp/impl/codegen/stub_options.h",
         "grpcpp/impl/codegen/sync_stream.h"};
     std::vector<grpc::string> headers(headers_strs, array_end(headers_strs));
+    if (params.use_message_arena) {
+      headers.push_back("grpcpp/impl/codegen/proto_message_arena.h");
+    }
     PrintIncludes(printer.get(), headers, params.use_system_headers,
                   params.grpc_search_path);
     printer->Print(vars, "\n");
@@ -954,7 +957,7 @@ void PrintHeaderServerMethodCallback(
         *vars,
         "  ::grpc::Service::experimental().MarkMethodCallback($Idx$,\n"
         "    new ::grpc::internal::CallbackUnaryHandler< "
-        "$RealRequest$, $RealResponse$>(\n"
+        "$RealRequest$, $RealResponse$$MessageAllocation$>(\n"
         "      [this](::grpc::ServerContext* context,\n"
         "             const $RealRequest$* request,\n"
         "             $RealResponse$* response,\n"
@@ -968,14 +971,14 @@ void PrintHeaderServerMethodCallback(
         *vars,
         "  ::grpc::Service::experimental().MarkMethodCallback($Idx$,\n"
         "    new ::grpc::internal::CallbackClientStreamingHandler< "
-        "$RealRequest$, $RealResponse$>(\n"
+        "$RealRequest$, $RealResponse$$MessageAllocation$>(\n"
         "      [this] { return this->$Method$(); }));\n");
   } else if (ServerOnlyStreaming(method)) {
     printer->Print(
         *vars,
         "  ::grpc::Service::experimental().MarkMethodCallback($Idx$,\n"
         "    new ::grpc::internal::CallbackServerStreamingHandler< "
-        "$RealRequest$, $RealResponse$>(\n"
+        "$RealRequest$, $RealResponse$$MessageAllocation$>(\n"
         "      [this] { return this->$Method$(); }));\n");
   } else if (method->BidiStreaming()) {
     printer->Print(
@@ -1500,6 +1503,10 @@ grpc::string GetHeaderServices(grpc_generator::File* file,
     if (!file->package().empty()) {
       vars["Package"].append(".");
     }
+    vars["MessageAllocation"] =
+        params.use_message_arena
+            ? ", ::grpc::internal::ProtoArenaMessageAllocation"
+            : "";
 
     if (!params.services_namespace.empty()) {
       vars["services_namespace"] = params.services_namespace;
@@ -1937,7 +1944,7 @@ void PrintSourceService(grpc_generator::Printer* printer,
           "    ::grpc::internal::RpcMethod::NORMAL_RPC,\n"
           "    new ::grpc::internal::RpcMethodHandler< $ns$$Service$::Service, "
           "$Request$, "
-          "$Response$>(\n"
+          "$Response$$MessageAllocation$>(\n"
           "        std::mem_fn(&$ns$$Service$::Service::$Method$), this)));\n");
     } else if (ClientOnlyStreaming(method.get())) {
       printer->Print(
@@ -1946,7 +1953,7 @@ void PrintSourceService(grpc_generator::Printer* printer,
           "    $prefix$$Service$_method_names[$Idx$],\n"
           "    ::grpc::internal::RpcMethod::CLIENT_STREAMING,\n"
           "    new ::grpc::internal::ClientStreamingHandler< "
-          "$ns$$Service$::Service, $Request$, $Response$>(\n"
+          "$ns$$Service$::Service, $Request$, $Response$$MessageAllocation$>(\n"
           "        std::mem_fn(&$ns$$Service$::Service::$Method$), this)));\n");
     } else if (ServerOnlyStreaming(method.get())) {
       printer->Print(
@@ -1955,7 +1962,7 @@ void PrintSourceService(grpc_generator::Printer* printer,
           "    $prefix$$Service$_method_names[$Idx$],\n"
           "    ::grpc::internal::RpcMethod::SERVER_STREAMING,\n"
           "    new ::grpc::internal::ServerStreamingHandler< "
-          "$ns$$Service$::Service, $Request$, $Response$>(\n"
+          "$ns$$Service$::Service, $Request$, $Response$$MessageAllocation$>(\n"
           "        std::mem_fn(&$ns$$Service$::Service::$Method$), this)));\n");
     } else if (method->BidiStreaming()) {
       printer->Print(
@@ -1999,6 +2006,10 @@ grpc::string GetSourceServices(grpc_generator::File* file,
       vars["ns"] = "";
       vars["prefix"] = "";
     }
+    vars["MessageAllocation"] =
+        params.use_message_arena
+            ? ", ::grpc::internal::ProtoArenaMessageAllocation"
+            : "";
 
     for (int i = 0; i < file->service_count(); ++i) {
       PrintSourceService(printer.get(), file->service(i).get(), &vars);
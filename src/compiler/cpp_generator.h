@@ -56,6 +56,9 @@ struct Parameters {
   grpc::string gmock_search_path;
   // *EXPERIMENTAL* Additional include files in grpc.pb.h
   std::vector<grpc::string> additional_header_includes;
+  // Allocate the request and response messages of sync and callback service
+  // handlers on a per-call protobuf arena.
+  bool use_message_arena;
 };
 
 // Return the prologue of the generated header file.
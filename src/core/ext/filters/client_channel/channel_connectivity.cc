@@ -246,3 +246,147 @@ void grpc_channel_watch_connectivity_state(
     abort();
   }
 }
+
+namespace {
+struct group_watcher;
+
+/* One channel of a group watch. */
+struct group_watch {
+  group_watcher* group;
+  grpc_channel* channel;
+  grpc_connectivity_state* state;
+  gpr_atm done;
+  grpc_closure on_complete;
+  grpc_closure watcher_timer_init;
+};
+
+/* Shared by all the channels of a group watch, with the group_watch array
+   allocated right after it. */
+struct group_watcher {
+  /* One ref per unfinished watch plus one for the timer */
+  gpr_refcount refs;
+  /* Number of watches not yet registered with their channel */
+  gpr_atm unregistered;
+  /* Number of watches whose state hasn't changed yet */
+  gpr_atm unchanged;
+  gpr_atm any_changed;
+  grpc_millis deadline;
+  grpc_closure on_timeout;
+  grpc_timer alarm;
+  grpc_completion_queue* cq;
+  grpc_cq_completion completion_storage;
+  void* tag;
+  size_t num_watches;
+
+  group_watch* watches() { return reinterpret_cast<group_watch*>(this + 1); }
+};
+}  // namespace
+
+static void group_finished_completion(void* pg, grpc_cq_completion* ignored) {
+  group_watcher* g = static_cast<group_watcher*>(pg);
+  for (size_t i = 0; i < g->num_watches; i++) {
+    GRPC_CHANNEL_INTERNAL_UNREF(g->watches()[i].channel,
+                                "watch_channel_connectivity_group");
+  }
+  gpr_free(g);
+}
+
+static void group_unref(group_watcher* g) {
+  if (!gpr_unref(&g->refs)) return;
+  grpc_error* error =
+      gpr_atm_no_barrier_load(&g->any_changed)
+          ? GRPC_ERROR_NONE
+          : GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                "Timed out waiting for connection state change");
+  grpc_cq_end_op(g->cq, g->tag, error, group_finished_completion, g,
+                 &g->completion_storage);
+}
+
+static void group_watch_complete(void* pw, grpc_error* error) {
+  group_watch* w = static_cast<group_watch*>(pw);
+  group_watcher* g = w->group;
+  gpr_atm_no_barrier_store(&w->done, 1);
+  /* A watch is only cancelled once the group has timed out */
+  if (error != GRPC_ERROR_CANCELLED) {
+    gpr_atm_no_barrier_store(&g->any_changed, 1);
+    if (gpr_atm_full_fetch_add(&g->unchanged, -1) == 1) {
+      /* Every state changed: no need to wait for the deadline anymore. The
+         timer was started when the last watch was registered, which was
+         before this watch could complete. */
+      grpc_timer_cancel(&g->alarm);
+    }
+  }
+  group_unref(g);
+}
+
+static void group_timeout_complete(void* pg, grpc_error* error) {
+  group_watcher* g = static_cast<group_watcher*>(pg);
+  if (error != GRPC_ERROR_CANCELLED) {
+    for (size_t i = 0; i < g->num_watches; i++) {
+      group_watch* w = &g->watches()[i];
+      if (gpr_atm_no_barrier_load(&w->done)) continue;
+      grpc_channel_element* client_channel_elem =
+          grpc_channel_stack_last_element(
+              grpc_channel_get_channel_stack(w->channel));
+      grpc_client_channel_watch_connectivity_state(
+          client_channel_elem,
+          grpc_polling_entity_create_from_pollset(grpc_cq_pollset(g->cq)),
+          nullptr, &w->on_complete, nullptr);
+    }
+  }
+  group_unref(g);
+}
+
+static void group_watcher_timer_init(void* pw, grpc_error* error_ignored) {
+  group_watcher* g = static_cast<group_watch*>(pw)->group;
+  /* Start the timer once every watch can be found by its cancellation */
+  if (gpr_atm_full_fetch_add(&g->unregistered, -1) == 1) {
+    grpc_timer_init(&g->alarm, g->deadline, &g->on_timeout);
+  }
+}
+
+void grpc_channel_watch_connectivity_state_group(
+    grpc_channel** channels, grpc_connectivity_state* states,
+    size_t num_channels, gpr_timespec deadline, grpc_completion_queue* cq,
+    void* tag) {
+  grpc_core::ExecCtx exec_ctx;
+  GPR_ASSERT(num_channels > 0);
+  GPR_ASSERT(grpc_cq_begin_op(cq, tag));
+  group_watcher* g = static_cast<group_watcher*>(
+      gpr_malloc(sizeof(*g) + num_channels * sizeof(group_watch)));
+  gpr_ref_init(&g->refs, static_cast<int>(num_channels) + 1);
+  gpr_atm_no_barrier_store(&g->unregistered,
+                           static_cast<gpr_atm>(num_channels));
+  gpr_atm_no_barrier_store(&g->unchanged, static_cast<gpr_atm>(num_channels));
+  gpr_atm_no_barrier_store(&g->any_changed, 0);
+  g->deadline = grpc_timespec_to_millis_round_up(deadline);
+  GRPC_CLOSURE_INIT(&g->on_timeout, group_timeout_complete, g,
+                    grpc_schedule_on_exec_ctx);
+  g->cq = cq;
+  g->tag = tag;
+  g->num_watches = num_channels;
+  /* Fill in every watch before registering any of them, since a watch may
+     complete (and need the whole group) as soon as it is registered */
+  for (size_t i = 0; i < num_channels; i++) {
+    group_watch* w = &g->watches()[i];
+    w->group = g;
+    w->channel = channels[i];
+    w->state = &states[i];
+    gpr_atm_no_barrier_store(&w->done, 0);
+    GRPC_CLOSURE_INIT(&w->on_complete, group_watch_complete, w,
+                      grpc_schedule_on_exec_ctx);
+    GRPC_CLOSURE_INIT(&w->watcher_timer_init, group_watcher_timer_init, w,
+                      grpc_schedule_on_exec_ctx);
+    GRPC_CHANNEL_INTERNAL_REF(w->channel, "watch_channel_connectivity_group");
+  }
+  for (size_t i = 0; i < num_channels; i++) {
+    group_watch* w = &g->watches()[i];
+    grpc_channel_element* client_channel_elem = grpc_channel_stack_last_element(
+        grpc_channel_get_channel_stack(w->channel));
+    GPR_ASSERT(client_channel_elem->filter == &grpc_client_channel_filter);
+    grpc_client_channel_watch_connectivity_state(
+        client_channel_elem,
+        grpc_polling_entity_create_from_pollset(grpc_cq_pollset(cq)), w->state,
+        &w->on_complete, &w->watcher_timer_init);
+  }
+}
@@ -59,6 +59,18 @@ void grpc_client_channel_watch_connectivity_state(
     grpc_connectivity_state* state, grpc_closure* on_complete,
     grpc_closure* watcher_timer_init);
 
+/** Watch the connectivity state of \a num_channels client channels at once,
+    as one grpc_channel_watch_connectivity_state per channel would, but with a
+    single deadline timer and a single completion: \a tag is posted to \a cq
+    once every channel has left its last observed state, or at \a deadline,
+    whichever comes first. \a states[i] holds the last observed state of
+    \a channels[i] and is updated when it changes; it must stay valid until
+    the completion. The completion succeeds if any of the states changed. */
+void grpc_channel_watch_connectivity_state_group(
+    grpc_channel** channels, grpc_connectivity_state* states,
+    size_t num_channels, gpr_timespec deadline, grpc_completion_queue* cq,
+    void* tag);
+
 /* Debug helper: pull the subchannel call from a call stack element */
 grpc_subchannel_call* grpc_client_channel_get_subchannel_call(
     grpc_call_element* elem);
@@ -20,18 +20,44 @@
 
 #include "src/core/ext/filters/client_channel/global_subchannel_pool.h"
 
+#include <grpc/support/alloc.h>
+
 #include "src/core/ext/filters/client_channel/subchannel.h"
 
 namespace grpc_core {
 
+namespace {
+
+// Initial number of buckets of each shard.
+constexpr size_t kInitialBucketsPerShard = 16;
+
+}  // namespace
+
 GlobalSubchannelPool::GlobalSubchannelPool() {
-  subchannel_map_ = grpc_avl_create(&subchannel_avl_vtable_);
-  gpr_mu_init(&mu_);
+  for (Shard& shard : shards_) {
+    gpr_mu_init(&shard.mu);
+    shard.buckets = static_cast<Entry**>(
+        gpr_zalloc(kInitialBucketsPerShard * sizeof(*shard.buckets)));
+    shard.num_buckets = kInitialBucketsPerShard;
+    shard.size = 0;
+  }
 }
 
 GlobalSubchannelPool::~GlobalSubchannelPool() {
-  gpr_mu_destroy(&mu_);
-  grpc_avl_unref(subchannel_map_, nullptr);
+  for (Shard& shard : shards_) {
+    for (size_t i = 0; i < shard.num_buckets; ++i) {
+      Entry* entry = shard.buckets[i];
+      while (entry != nullptr) {
+        Entry* next = entry->next;
+        Delete(entry->key);
+        GRPC_SUBCHANNEL_WEAK_UNREF(entry->subchannel, "global_subchannel_pool");
+        Delete(entry);
+        entry = next;
+      }
+    }
+    gpr_free(shard.buckets);
+    gpr_mu_destroy(&shard.mu);
+  }
 }
 
 void GlobalSubchannelPool::Init() {
@@ -54,124 +80,104 @@ RefCountedPtr<GlobalSubchannelPool> GlobalSubchannelPool::instance() {
   return *instance_;
 }
 
+GlobalSubchannelPool::Entry** GlobalSubchannelPool::FindLocked(
+    Shard* shard, const SubchannelKey& key) {
+  // The low bits of the hash select the shard, so the bucket is picked from
+  // the remaining ones.
+  const size_t bucket =
+      (key.hash() / kNumShards) & (shard->num_buckets - 1);
+  Entry** link = &shard->buckets[bucket];
+  while (*link != nullptr) {
+    const SubchannelKey& other = *(*link)->key;
+    if (other.hash() == key.hash() && other.Cmp(key) == 0) break;
+    link = &(*link)->next;
+  }
+  return link;
+}
+
+void GlobalSubchannelPool::GrowLocked(Shard* shard) {
+  const size_t num_buckets = shard->num_buckets * 2;
+  Entry** buckets =
+      static_cast<Entry**>(gpr_zalloc(num_buckets * sizeof(*buckets)));
+  for (size_t i = 0; i < shard->num_buckets; ++i) {
+    Entry* entry = shard->buckets[i];
+    while (entry != nullptr) {
+      Entry* next = entry->next;
+      const size_t bucket =
+          (entry->key->hash() / kNumShards) & (num_buckets - 1);
+      entry->next = buckets[bucket];
+      buckets[bucket] = entry;
+      entry = next;
+    }
+  }
+  gpr_free(shard->buckets);
+  shard->buckets = buckets;
+  shard->num_buckets = num_buckets;
+}
+
 grpc_subchannel* GlobalSubchannelPool::RegisterSubchannel(
     SubchannelKey* key, grpc_subchannel* constructed) {
-  grpc_subchannel* c = nullptr;
-  // Compare and swap (CAS) loop:
-  while (c == nullptr) {
-    // Ref the shared map to have a local copy.
-    gpr_mu_lock(&mu_);
-    grpc_avl old_map = grpc_avl_ref(subchannel_map_, nullptr);
-    gpr_mu_unlock(&mu_);
-    // Check to see if a subchannel already exists.
-    c = static_cast<grpc_subchannel*>(grpc_avl_get(old_map, key, nullptr));
+  Shard* shard = ShardForKey(shards_, *key);
+  for (;;) {
+    gpr_mu_lock(&shard->mu);
+    Entry** link = FindLocked(shard, *key);
+    if (*link == nullptr) {
+      // There hasn't been such subchannel. Add one.
+      Entry* entry = New<Entry>();
+      entry->key = New<SubchannelKey>(*key);
+      entry->subchannel =
+          GRPC_SUBCHANNEL_WEAK_REF(constructed, "subchannel_register+new");
+      entry->next = nullptr;
+      *link = entry;
+      if (++shard->size > shard->num_buckets) GrowLocked(shard);
+      gpr_mu_unlock(&shard->mu);
+      return constructed;
+    }
+    grpc_subchannel* c = GRPC_SUBCHANNEL_REF_FROM_WEAK_REF(
+        (*link)->subchannel, "subchannel_register+reuse");
+    gpr_mu_unlock(&shard->mu);
     if (c != nullptr) {
       // The subchannel already exists. Reuse it.
-      c = GRPC_SUBCHANNEL_REF_FROM_WEAK_REF(c, "subchannel_register+reuse");
       GRPC_SUBCHANNEL_UNREF(constructed, "subchannel_register+found_existing");
-      // Exit the CAS loop without modifying the shared map.
-    } else {
-      // There hasn't been such subchannel. Add one.
-      // Note that we should ref the old map first because grpc_avl_add() will
-      // unref it while we still need to access it later.
-      grpc_avl new_map = grpc_avl_add(
-          grpc_avl_ref(old_map, nullptr), New<SubchannelKey>(*key),
-          GRPC_SUBCHANNEL_WEAK_REF(constructed, "subchannel_register+new"),
-          nullptr);
-      // Try to publish the change to the shared map. It may happen (but
-      // unlikely) that some other thread has changed the shared map, so compare
-      // to make sure it's unchanged before swapping. Retry if it's changed.
-      gpr_mu_lock(&mu_);
-      if (old_map.root == subchannel_map_.root) {
-        GPR_SWAP(grpc_avl, new_map, subchannel_map_);
-        c = constructed;
-      }
-      gpr_mu_unlock(&mu_);
-      grpc_avl_unref(new_map, nullptr);
+      return c;
     }
-    grpc_avl_unref(old_map, nullptr);
+    // The registered subchannel has lost its last strong ref and is about to
+    // unregister itself (see disconnect() in subchannel.cc). Retry until it
+    // is gone.
   }
-  return c;
 }
 
 void GlobalSubchannelPool::UnregisterSubchannel(SubchannelKey* key) {
-  bool done = false;
-  // Compare and swap (CAS) loop:
-  while (!done) {
-    // Ref the shared map to have a local copy.
-    gpr_mu_lock(&mu_);
-    grpc_avl old_map = grpc_avl_ref(subchannel_map_, nullptr);
-    gpr_mu_unlock(&mu_);
-    // Remove the subchannel.
-    // Note that we should ref the old map first because grpc_avl_remove() will
-    // unref it while we still need to access it later.
-    grpc_avl new_map =
-        grpc_avl_remove(grpc_avl_ref(old_map, nullptr), key, nullptr);
-    // Try to publish the change to the shared map. It may happen (but
-    // unlikely) that some other thread has changed the shared map, so compare
-    // to make sure it's unchanged before swapping. Retry if it's changed.
-    gpr_mu_lock(&mu_);
-    if (old_map.root == subchannel_map_.root) {
-      GPR_SWAP(grpc_avl, new_map, subchannel_map_);
-      done = true;
-    }
-    gpr_mu_unlock(&mu_);
-    grpc_avl_unref(new_map, nullptr);
-    grpc_avl_unref(old_map, nullptr);
+  Shard* shard = ShardForKey(shards_, *key);
+  gpr_mu_lock(&shard->mu);
+  Entry** link = FindLocked(shard, *key);
+  Entry* entry = *link;
+  if (entry != nullptr) {
+    *link = entry->next;
+    --shard->size;
+  }
+  gpr_mu_unlock(&shard->mu);
+  if (entry != nullptr) {
+    Delete(entry->key);
+    GRPC_SUBCHANNEL_WEAK_UNREF(entry->subchannel, "global_subchannel_pool");
+    Delete(entry);
   }
 }
 
 grpc_subchannel* GlobalSubchannelPool::FindSubchannel(SubchannelKey* key) {
-  // Lock, and take a reference to the subchannel map.
-  // We don't need to do the search under a lock as AVL's are immutable.
-  gpr_mu_lock(&mu_);
-  grpc_avl index = grpc_avl_ref(subchannel_map_, nullptr);
-  gpr_mu_unlock(&mu_);
-  grpc_subchannel* c = GRPC_SUBCHANNEL_REF_FROM_WEAK_REF(
-      static_cast<grpc_subchannel*>(grpc_avl_get(index, key, nullptr)),
-      "found_from_pool");
-  grpc_avl_unref(index, nullptr);
+  Shard* shard = ShardForKey(shards_, *key);
+  gpr_mu_lock(&shard->mu);
+  Entry* entry = *FindLocked(shard, *key);
+  // Taking the strong ref under the lock guarantees that the weak ref held by
+  // the map (and so the subchannel) is still alive.
+  grpc_subchannel* c =
+      entry == nullptr ? nullptr
+                       : GRPC_SUBCHANNEL_REF_FROM_WEAK_REF(entry->subchannel,
+                                                           "found_from_pool");
+  gpr_mu_unlock(&shard->mu);
   return c;
 }
 
 RefCountedPtr<GlobalSubchannelPool>* GlobalSubchannelPool::instance_ = nullptr;
 
-namespace {
-
-void sck_avl_destroy(void* p, void* user_data) {
-  SubchannelKey* key = static_cast<SubchannelKey*>(p);
-  Delete(key);
-}
-
-void* sck_avl_copy(void* p, void* unused) {
-  const SubchannelKey* key = static_cast<const SubchannelKey*>(p);
-  auto* new_key = New<SubchannelKey>(*key);
-  return static_cast<void*>(new_key);
-}
-
-long sck_avl_compare(void* a, void* b, void* unused) {
-  const SubchannelKey* key_a = static_cast<const SubchannelKey*>(a);
-  const SubchannelKey* key_b = static_cast<const SubchannelKey*>(b);
-  return key_a->Cmp(*key_b);
-}
-
-void scv_avl_destroy(void* p, void* user_data) {
-  GRPC_SUBCHANNEL_WEAK_UNREF((grpc_subchannel*)p, "global_subchannel_pool");
-}
-
-void* scv_avl_copy(void* p, void* unused) {
-  GRPC_SUBCHANNEL_WEAK_REF((grpc_subchannel*)p, "global_subchannel_pool");
-  return p;
-}
-
-}  // namespace
-
-const grpc_avl_vtable GlobalSubchannelPool::subchannel_avl_vtable_ = {
-    sck_avl_destroy,  // destroy_key
-    sck_avl_copy,     // copy_key
-    sck_avl_compare,  // compare_keys
-    scv_avl_destroy,  // destroy_value
-    scv_avl_copy      // copy_value
-};
-
 }  // namespace grpc_core
@@ -55,12 +55,43 @@ class GlobalSubchannelPool final : public SubchannelPoolInterface {
   // non-local static object can be trivially destructible.)
   static RefCountedPtr<GlobalSubchannelPool>* instance_;
 
-  // The vtable for subchannel operations in an AVL tree.
-  static const grpc_avl_vtable subchannel_avl_vtable_;
-  // A map from subchannel key to subchannel.
-  grpc_avl subchannel_map_;
-  // To protect subchannel_map_.
-  gpr_mu mu_;
+  // Number of independently locked shards of the subchannel map. A key's
+  // shard is picked by its hash, so operations on different keys rarely
+  // contend on the same lock.
+  static constexpr size_t kNumShards = 32;
+
+  // A registered subchannel. The map holds a weak ref to the subchannel and
+  // its own copy of the key.
+  struct Entry {
+    SubchannelKey* key;
+    grpc_subchannel* subchannel;
+    Entry* next;
+  };
+
+  // One shard: a chained hash table protected by its own mutex. Lookups cost
+  // a hash probe and a full key comparison only on a hash match; mutations
+  // allocate only the entry itself, besides an occasional rehash.
+  struct Shard {
+    gpr_mu mu;
+    Entry** buckets;
+    size_t num_buckets;  // Always a power of two.
+    size_t size;
+  };
+
+  static Shard* ShardForKey(Shard* shards, const SubchannelKey& key) {
+    return &shards[key.hash() % kNumShards];
+  }
+
+  // Returns the link pointing to the entry for \a key in \a shard, or to the
+  // null link ending its bucket if there is no such entry. Must be called with
+  // the shard's mutex held.
+  static Entry** FindLocked(Shard* shard, const SubchannelKey& key);
+
+  // Doubles the number of buckets of \a shard. Must be called with the shard's
+  // mutex held.
+  static void GrowLocked(Shard* shard);
+
+  Shard shards_[kNumShards];
 };
 
 }  // namespace grpc_core
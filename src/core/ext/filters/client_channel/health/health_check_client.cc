@@ -42,6 +42,90 @@ grpc_core::TraceFlag grpc_health_check_client_trace(false,
 
 namespace grpc_core {
 
+//
+// protobuf helpers
+//
+
+namespace {
+
+grpc_slice EncodeRequest(const char* service_name) {
+  grpc_health_v1_HealthCheckRequest request_struct;
+  request_struct.has_service = true;
+  snprintf(request_struct.service, sizeof(request_struct.service), "%s",
+           service_name);
+  pb_ostream_t ostream;
+  memset(&ostream, 0, sizeof(ostream));
+  pb_encode(&ostream, grpc_health_v1_HealthCheckRequest_fields,
+            &request_struct);
+  grpc_slice request_slice = GRPC_SLICE_MALLOC(ostream.bytes_written);
+  ostream = pb_ostream_from_buffer(GRPC_SLICE_START_PTR(request_slice),
+                                   GRPC_SLICE_LENGTH(request_slice));
+  GPR_ASSERT(pb_encode(&ostream, grpc_health_v1_HealthCheckRequest_fields,
+                       &request_struct) != 0);
+  return request_slice;
+}
+
+// Returns true if the response is the encoding of a SERVING status, which is
+// what a healthy backend sends: field 1 (status), varint 1 (SERVING).
+bool IsServingResponse(grpc_slice_buffer* slice_buffer) {
+  static const uint8_t kServingResponse[] = {0x08, 0x01};
+  return slice_buffer->count == 1 &&
+         GRPC_SLICE_LENGTH(slice_buffer->slices[0]) ==
+             sizeof(kServingResponse) &&
+         memcmp(GRPC_SLICE_START_PTR(slice_buffer->slices[0]),
+                kServingResponse, sizeof(kServingResponse)) == 0;
+}
+
+// Returns true if healthy.
+// If there was an error parsing the response, sets *error and returns false.
+bool DecodeResponse(grpc_slice_buffer* slice_buffer, grpc_error** error) {
+  // If message is empty, assume unhealthy.
+  if (slice_buffer->length == 0) {
+    *error =
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING("health check response was empty");
+    return false;
+  }
+  // Skip the protobuf decoder for the common case of a healthy backend.
+  if (IsServingResponse(slice_buffer)) return true;
+  // Concatenate the slices to form a single string.
+  UniquePtr<uint8_t> recv_message_deleter;
+  uint8_t* recv_message;
+  if (slice_buffer->count == 1) {
+    recv_message = GRPC_SLICE_START_PTR(slice_buffer->slices[0]);
+  } else {
+    recv_message = static_cast<uint8_t*>(gpr_malloc(slice_buffer->length));
+    recv_message_deleter.reset(recv_message);
+    size_t offset = 0;
+    for (size_t i = 0; i < slice_buffer->count; ++i) {
+      memcpy(recv_message + offset,
+             GRPC_SLICE_START_PTR(slice_buffer->slices[i]),
+             GRPC_SLICE_LENGTH(slice_buffer->slices[i]));
+      offset += GRPC_SLICE_LENGTH(slice_buffer->slices[i]);
+    }
+  }
+  // Deserialize message.
+  grpc_health_v1_HealthCheckResponse response_struct;
+  pb_istream_t istream =
+      pb_istream_from_buffer(recv_message, slice_buffer->length);
+  if (!pb_decode(&istream, grpc_health_v1_HealthCheckResponse_fields,
+                 &response_struct)) {
+    // Can't parse message; assume unhealthy.
+    *error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "cannot parse health check response");
+    return false;
+  }
+  if (!response_struct.has_status) {
+    // Field not present; assume unhealthy.
+    *error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "status field not present in health check response");
+    return false;
+  }
+  return response_struct.status ==
+         grpc_health_v1_HealthCheckResponse_ServingStatus_SERVING;
+}
+
+}  // namespace
+
 //
 // HealthCheckClient
 //
@@ -53,6 +137,7 @@ HealthCheckClient::HealthCheckClient(
     grpc_core::RefCountedPtr<grpc_core::channelz::SubchannelNode> channelz_node)
     : InternallyRefCounted<HealthCheckClient>(&grpc_health_check_client_trace),
       service_name_(service_name),
+      request_slice_(EncodeRequest(service_name)),
       connected_subchannel_(std::move(connected_subchannel)),
       interested_parties_(interested_parties),
       channelz_node_(std::move(channelz_node)),
@@ -62,6 +147,7 @@ HealthCheckClient::HealthCheckClient(
                   HEALTH_CHECK_INITIAL_CONNECT_BACKOFF_SECONDS * 1000)
               .set_multiplier(HEALTH_CHECK_RECONNECT_BACKOFF_MULTIPLIER)
               .set_jitter(HEALTH_CHECK_RECONNECT_JITTER)
+              .set_jitter_initial_backoff(true)
               .set_max_backoff(HEALTH_CHECK_RECONNECT_MAX_BACKOFF_SECONDS *
                                1000)) {
   if (grpc_health_check_client_trace.enabled()) {
@@ -78,6 +164,7 @@ HealthCheckClient::~HealthCheckClient() {
     gpr_log(GPR_INFO, "destroying HealthCheckClient %p", this);
   }
   GRPC_ERROR_UNREF(error_);
+  grpc_slice_unref_internal(request_slice_);
   gpr_mu_destroy(&mu_);
 }
 
@@ -197,82 +284,6 @@ void HealthCheckClient::OnRetryTimer(void* arg, grpc_error* error) {
   self->Unref(DEBUG_LOCATION, "health_retry_timer");
 }
 
-//
-// protobuf helpers
-//
-
-namespace {
-
-void EncodeRequest(const char* service_name,
-                   ManualConstructor<SliceBufferByteStream>* send_message) {
-  grpc_health_v1_HealthCheckRequest request_struct;
-  request_struct.has_service = true;
-  snprintf(request_struct.service, sizeof(request_struct.service), "%s",
-           service_name);
-  pb_ostream_t ostream;
-  memset(&ostream, 0, sizeof(ostream));
-  pb_encode(&ostream, grpc_health_v1_HealthCheckRequest_fields,
-            &request_struct);
-  grpc_slice request_slice = GRPC_SLICE_MALLOC(ostream.bytes_written);
-  ostream = pb_ostream_from_buffer(GRPC_SLICE_START_PTR(request_slice),
-                                   GRPC_SLICE_LENGTH(request_slice));
-  GPR_ASSERT(pb_encode(&ostream, grpc_health_v1_HealthCheckRequest_fields,
-                       &request_struct) != 0);
-  grpc_slice_buffer slice_buffer;
-  grpc_slice_buffer_init(&slice_buffer);
-  grpc_slice_buffer_add(&slice_buffer, request_slice);
-  send_message->Init(&slice_buffer, 0);
-  grpc_slice_buffer_destroy_internal(&slice_buffer);
-}
-
-// Returns true if healthy.
-// If there was an error parsing the response, sets *error and returns false.
-bool DecodeResponse(grpc_slice_buffer* slice_buffer, grpc_error** error) {
-  // If message is empty, assume unhealthy.
-  if (slice_buffer->length == 0) {
-    *error =
-        GRPC_ERROR_CREATE_FROM_STATIC_STRING("health check response was empty");
-    return false;
-  }
-  // Concatenate the slices to form a single string.
-  UniquePtr<uint8_t> recv_message_deleter;
-  uint8_t* recv_message;
-  if (slice_buffer->count == 1) {
-    recv_message = GRPC_SLICE_START_PTR(slice_buffer->slices[0]);
-  } else {
-    recv_message = static_cast<uint8_t*>(gpr_malloc(slice_buffer->length));
-    recv_message_deleter.reset(recv_message);
-    size_t offset = 0;
-    for (size_t i = 0; i < slice_buffer->count; ++i) {
-      memcpy(recv_message + offset,
-             GRPC_SLICE_START_PTR(slice_buffer->slices[i]),
-             GRPC_SLICE_LENGTH(slice_buffer->slices[i]));
-      offset += GRPC_SLICE_LENGTH(slice_buffer->slices[i]);
-    }
-  }
-  // Deserialize message.
-  grpc_health_v1_HealthCheckResponse response_struct;
-  pb_istream_t istream =
-      pb_istream_from_buffer(recv_message, slice_buffer->length);
-  if (!pb_decode(&istream, grpc_health_v1_HealthCheckResponse_fields,
-                 &response_struct)) {
-    // Can't parse message; assume unhealthy.
-    *error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
-        "cannot parse health check response");
-    return false;
-  }
-  if (!response_struct.has_status) {
-    // Field not present; assume unhealthy.
-    *error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
-        "status field not present in health check response");
-    return false;
-  }
-  return response_struct.status ==
-         grpc_health_v1_HealthCheckResponse_ServingStatus_SERVING;
-}
-
-}  // namespace
-
 //
 // HealthCheckClient::CallState
 //
@@ -368,7 +379,13 @@ void HealthCheckClient::CallState::StartCall() {
   payload_.send_initial_metadata.peer_string = nullptr;
   batch_.send_initial_metadata = true;
   // Add send_message op.
-  EncodeRequest(health_check_client_->service_name_, &send_message_);
+  grpc_slice_buffer slice_buffer;
+  grpc_slice_buffer_init(&slice_buffer);
+  grpc_slice_buffer_add(
+      &slice_buffer,
+      grpc_slice_ref_internal(health_check_client_->request_slice_));
+  send_message_.Init(&slice_buffer, 0);
+  grpc_slice_buffer_destroy_internal(&slice_buffer);
   payload_.send_message.send_message.reset(send_message_.get());
   batch_.send_message = true;
   // Add send_trailing_metadata op.
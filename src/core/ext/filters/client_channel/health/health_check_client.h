@@ -145,6 +145,8 @@ class HealthCheckClient : public InternallyRefCounted<HealthCheckClient> {
                              grpc_error* error);  // Requires holding mu_.
 
   const char* service_name_;  // Do not own.
+  // The serialized request, encoded once and sent by every call.
+  grpc_slice request_slice_;
   RefCountedPtr<ConnectedSubchannel> connected_subchannel_;
   grpc_pollset_set* interested_parties_;  // Do not own.
   RefCountedPtr<channelz::SubchannelNode> channelz_node_;
@@ -32,6 +32,13 @@
 #include "src/core/lib/iomgr/polling_entity.h"
 #include "src/core/lib/transport/connectivity_state.h"
 
+// Integer channel arg (0..100) passed by a parent policy to a child that
+// keeps a pending subchannel list across updates: the child keeps picking
+// from its current list until this percentage of the pending list's
+// subchannels is READY. Defaults to 0 (swap on the first READY subchannel).
+#define GRPC_ARG_LB_POLICY_SWAP_READY_PERCENT \
+  "grpc.lb_policy_swap_ready_percent"
+
 extern grpc_core::DebugOnlyTraceFlag grpc_trace_lb_policy_refcount;
 
 namespace grpc_core {
@@ -88,6 +88,7 @@
 #include "src/core/lib/backoff/backoff.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_stack.h"
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/host_port.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
@@ -169,6 +170,8 @@ class GrpcLb : public LoadBalancingPolicy {
     grpc_closure* original_on_complete;
     // Stats for client-side load reporting.
     RefCountedPtr<GrpcLbClientStats> client_stats;
+    // When the pick was started, for the pick queueing time stats.
+    grpc_millis start_time;
     // Next pending pick.
     PendingPick* next = nullptr;
   };
@@ -331,6 +334,9 @@ class GrpcLb : public LoadBalancingPolicy {
   // Timeout in milliseconds for before using fallback backend addresses.
   // 0 means not using fallback.
   int lb_fallback_timeout_ms_ = 0;
+  // Percentage of the backends of a new serverlist that must be READY before
+  // the RR policy moves picks over to them.
+  int prewarm_ready_percent_ = 0;
   // The backend addresses from the resolver.
   UniquePtr<ServerAddressList> fallback_backend_addresses_;
   // Fallback timer.
@@ -1017,6 +1023,10 @@ GrpcLb::GrpcLb(const LoadBalancingPolicy::Args& args)
   arg = grpc_channel_args_find(args.args, GRPC_ARG_GRPCLB_FALLBACK_TIMEOUT_MS);
   lb_fallback_timeout_ms_ = grpc_channel_arg_get_integer(
       arg, {GRPC_GRPCLB_DEFAULT_FALLBACK_TIMEOUT_MS, 0, INT_MAX});
+  // Record pre-warming threshold.
+  arg =
+      grpc_channel_args_find(args.args, GRPC_ARG_GRPCLB_PREWARM_READY_PERCENT);
+  prewarm_ready_percent_ = grpc_channel_arg_get_integer(arg, {0, 0, 100});
   // Process channel args.
   ProcessChannelArgsLocked(*args.args);
 }
@@ -1511,6 +1521,8 @@ void GrpcLb::PendingPickSetMetadataAndContext(PendingPick* pp) {
  * order to unref the round robin instance upon its invocation */
 void GrpcLb::OnPendingPickComplete(void* arg, grpc_error* error) {
   PendingPick* pp = static_cast<PendingPick*>(arg);
+  GRPC_STATS_INC_GRPCLB_PICK_QUEUE_TIME_MS(ExecCtx::Get()->Now() -
+                                           pp->start_time);
   PendingPickSetMetadataAndContext(pp);
   GRPC_CLOSURE_SCHED(pp->original_on_complete, GRPC_ERROR_REF(error));
   Delete(pp);
@@ -1520,6 +1532,7 @@ GrpcLb::PendingPick* GrpcLb::PendingPickCreate(PickState* pick) {
   PendingPick* pp = New<PendingPick>();
   pp->grpclb_policy = this;
   pp->pick = pick;
+  pp->start_time = ExecCtx::Get()->Now();
   GRPC_CLOSURE_INIT(&pp->on_complete, &GrpcLb::OnPendingPickComplete, pp,
                     grpc_schedule_on_exec_ctx);
   pp->original_on_complete = pick->on_complete;
@@ -1578,6 +1591,9 @@ bool GrpcLb::PickFromRoundRobinPolicyLocked(bool force_async, PendingPick* pp,
   if (pick_done) {
     PendingPickSetMetadataAndContext(pp);
     if (force_async) {
+      // The pick was queued in grpclb until the RR policy was created.
+      GRPC_STATS_INC_GRPCLB_PICK_QUEUE_TIME_MS(ExecCtx::Get()->Now() -
+                                               pp->start_time);
       GRPC_CLOSURE_SCHED(pp->original_on_complete, *error);
       *error = GRPC_ERROR_NONE;
       pick_done = false;
@@ -1660,7 +1676,7 @@ grpc_channel_args* GrpcLb::CreateRoundRobinPolicyArgsLocked() {
   // Replace the server address list in the channel args that we pass down to
   // the subchannel.
   static const char* keys_to_remove[] = {GRPC_ARG_SERVER_ADDRESS_LIST};
-  grpc_arg args_to_add[3] = {
+  grpc_arg args_to_add[4] = {
       CreateServerAddressListChannelArg(addresses),
       // A channel arg indicating if the target is a backend inferred from a
       // grpclb load balancer.
@@ -1675,6 +1691,13 @@ grpc_channel_args* GrpcLb::CreateRoundRobinPolicyArgsLocked() {
         const_cast<char*>(GRPC_ARG_INHIBIT_HEALTH_CHECKING), 1);
     ++num_args_to_add;
   }
+  // Have RR connect to the backends of a new serverlist in the background
+  // and keep picking from the previous one until enough of them are READY.
+  if (prewarm_ready_percent_ > 0) {
+    args_to_add[num_args_to_add++] = grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_ARG_LB_POLICY_SWAP_READY_PERCENT),
+        prewarm_ready_percent_);
+  }
   grpc_channel_args* args = grpc_channel_args_copy_and_add_and_remove(
       args_, keys_to_remove, GPR_ARRAY_SIZE(keys_to_remove), args_to_add,
       num_args_to_add);
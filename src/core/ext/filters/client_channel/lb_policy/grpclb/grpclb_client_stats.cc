@@ -22,31 +22,62 @@
 
 #include <string.h>
 
+#include <grpc/support/alloc.h>
 #include <grpc/support/atm.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/string_util.h>
 
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
 namespace grpc_core {
 
+namespace {
+
+// More stripes than this would make GetLocked() slower for little benefit.
+constexpr size_t kMaxStripes = 64;
+
+void IncrementCounter(gpr_atm* counter) {
+  // The counters are only read when reporting, so no ordering is needed.
+  gpr_atm_no_barrier_fetch_add(counter, (gpr_atm)1);
+}
+
+}  // namespace
+
+GrpcLbClientStats::GrpcLbClientStats()
+    : num_stripes_(GPR_MIN(GPR_MAX(gpr_cpu_num_cores(), 1u), kMaxStripes)) {
+  stripes_ = static_cast<Stripe*>(
+      gpr_malloc_aligned(num_stripes_ * sizeof(Stripe), GPR_CACHELINE_SIZE));
+  memset(stripes_, 0, num_stripes_ * sizeof(Stripe));
+}
+
+GrpcLbClientStats::~GrpcLbClientStats() { gpr_free_aligned(stripes_); }
+
+GrpcLbClientStats::Counters* GrpcLbClientStats::CurrentStripe() {
+  return &stripes_[ExecCtx::Get()->starting_cpu() % num_stripes_].counters;
+}
+
 void GrpcLbClientStats::AddCallStarted() {
-  gpr_atm_full_fetch_add(&num_calls_started_, (gpr_atm)1);
+  IncrementCounter(&CurrentStripe()->num_calls_started);
 }
 
 void GrpcLbClientStats::AddCallFinished(
     bool finished_with_client_failed_to_send, bool finished_known_received) {
-  gpr_atm_full_fetch_add(&num_calls_finished_, (gpr_atm)1);
+  Counters* counters = CurrentStripe();
+  IncrementCounter(&counters->num_calls_finished);
   if (finished_with_client_failed_to_send) {
-    gpr_atm_full_fetch_add(&num_calls_finished_with_client_failed_to_send_,
-                           (gpr_atm)1);
+    IncrementCounter(&counters->num_calls_finished_with_client_failed_to_send);
   }
   if (finished_known_received) {
-    gpr_atm_full_fetch_add(&num_calls_finished_known_received_, (gpr_atm)1);
+    IncrementCounter(&counters->num_calls_finished_known_received);
   }
 }
 
 void GrpcLbClientStats::AddCallDroppedLocked(char* token) {
   // Increment num_calls_started and num_calls_finished.
-  gpr_atm_full_fetch_add(&num_calls_started_, (gpr_atm)1);
-  gpr_atm_full_fetch_add(&num_calls_finished_, (gpr_atm)1);
+  Counters* counters = CurrentStripe();
+  IncrementCounter(&counters->num_calls_started);
+  IncrementCounter(&counters->num_calls_finished);
   // Record the drop.
   if (drop_token_counts_ == nullptr) {
     drop_token_counts_.reset(New<DroppedCallCounts>());
@@ -64,7 +95,7 @@ void GrpcLbClientStats::AddCallDroppedLocked(char* token) {
 namespace {
 
 void AtomicGetAndResetCounter(int64_t* value, gpr_atm* counter) {
-  *value = static_cast<int64_t>(gpr_atm_full_xchg(counter, (gpr_atm)0));
+  *value += static_cast<int64_t>(gpr_atm_full_xchg(counter, (gpr_atm)0));
 }
 
 }  // namespace
@@ -74,12 +105,21 @@ void GrpcLbClientStats::GetLocked(
     int64_t* num_calls_finished_with_client_failed_to_send,
     int64_t* num_calls_finished_known_received,
     UniquePtr<DroppedCallCounts>* drop_token_counts) {
-  AtomicGetAndResetCounter(num_calls_started, &num_calls_started_);
-  AtomicGetAndResetCounter(num_calls_finished, &num_calls_finished_);
-  AtomicGetAndResetCounter(num_calls_finished_with_client_failed_to_send,
-                           &num_calls_finished_with_client_failed_to_send_);
-  AtomicGetAndResetCounter(num_calls_finished_known_received,
-                           &num_calls_finished_known_received_);
+  *num_calls_started = 0;
+  *num_calls_finished = 0;
+  *num_calls_finished_with_client_failed_to_send = 0;
+  *num_calls_finished_known_received = 0;
+  for (size_t i = 0; i < num_stripes_; ++i) {
+    Counters* counters = &stripes_[i].counters;
+    AtomicGetAndResetCounter(num_calls_started, &counters->num_calls_started);
+    AtomicGetAndResetCounter(num_calls_finished,
+                             &counters->num_calls_finished);
+    AtomicGetAndResetCounter(
+        num_calls_finished_with_client_failed_to_send,
+        &counters->num_calls_finished_with_client_failed_to_send);
+    AtomicGetAndResetCounter(num_calls_finished_known_received,
+                             &counters->num_calls_finished_known_received);
+  }
   *drop_token_counts = std::move(drop_token_counts_);
 }
 
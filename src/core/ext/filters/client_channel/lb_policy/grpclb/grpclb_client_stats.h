@@ -41,8 +41,13 @@ class GrpcLbClientStats : public RefCounted<GrpcLbClientStats> {
 
   typedef InlinedVector<DropTokenCount, 10> DroppedCallCounts;
 
-  GrpcLbClientStats() {}
+  GrpcLbClientStats();
+  ~GrpcLbClientStats();
 
+  // These methods may be called from any number of threads at a time.
+  // Each thread updates the counters of the stripe of the CPU its ExecCtx
+  // started on, so concurrent calls on different CPUs do not contend on the
+  // same cache line.
   void AddCallStarted();
   void AddCallFinished(bool finished_with_client_failed_to_send,
                        bool finished_known_received);
@@ -51,19 +56,33 @@ class GrpcLbClientStats : public RefCounted<GrpcLbClientStats> {
   void AddCallDroppedLocked(char* token);
 
   // This method is not thread-safe; caller must synchronize.
+  // Adds up and resets the counters of all stripes. Calls that finish while
+  // this is running are either included in this report or in the next one.
   void GetLocked(int64_t* num_calls_started, int64_t* num_calls_finished,
                  int64_t* num_calls_finished_with_client_failed_to_send,
                  int64_t* num_calls_finished_known_received,
                  UniquePtr<DroppedCallCounts>* drop_token_counts);
 
  private:
+  struct Counters {
+    gpr_atm num_calls_started;
+    gpr_atm num_calls_finished;
+    gpr_atm num_calls_finished_with_client_failed_to_send;
+    gpr_atm num_calls_finished_known_received;
+  };
+  // Each stripe sits on its own cache line.
+  union Stripe {
+    Counters counters;
+    char padding[GPR_CACHELINE_SIZE];
+  };
+
+  Counters* CurrentStripe();
+
   // This field must only be accessed via *_locked() methods.
   UniquePtr<DroppedCallCounts> drop_token_counts_;
   // These fields may be accessed from multiple threads at a time.
-  gpr_atm num_calls_started_ = 0;
-  gpr_atm num_calls_finished_ = 0;
-  gpr_atm num_calls_finished_with_client_failed_to_send_ = 0;
-  gpr_atm num_calls_finished_known_received_ = 0;
+  Stripe* stripes_;
+  size_t num_stripes_;
 };
 
 }  // namespace grpc_core
@@ -140,6 +140,18 @@ class RoundRobin : public LoadBalancingPolicy {
     // Starts watching the subchannels in this list.
     void StartWatchingLocked();
 
+    // Applies an update that only changes the addresses to this list in
+    // place (see SubchannelList::UpdateAddressesLocked()). If the policy has
+    // started picking, only the subchannels for new addresses start being
+    // watched. Returns false if a new list must be created instead.
+    bool UpdateInPlaceLocked(const ServerAddressList& addresses,
+                             const grpc_channel_args& args,
+                             bool started_picking);
+
+    // Returns true if \a addresses contains the address of a READY
+    // subchannel of this list.
+    bool KeepsReadySubchannelLocked(const ServerAddressList& addresses);
+
     // Updates the counters of subchannels in each state when a
     // subchannel transitions from old_state to new_state.
     // transient_failure_error is the error that is reported when
@@ -157,6 +169,10 @@ class RoundRobin : public LoadBalancingPolicy {
     // subchannels in each state.
     void UpdateRoundRobinStateFromSubchannelStateCountsLocked();
 
+    // Returns true if this pending list has enough READY subchannels to
+    // replace the RR policy's current subchannel list.
+    bool ReadyToReplaceCurrentListLocked();
+
     size_t GetNextReadySubchannelIndexLocked();
     void UpdateLastReadySubchannelIndexLocked(size_t last_ready_index);
 
@@ -195,6 +211,10 @@ class RoundRobin : public LoadBalancingPolicy {
    * racing callbacks that reference outdated subchannel lists won't perform any
    * update. */
   OrphanablePtr<RoundRobinSubchannelList> latest_pending_subchannel_list_;
+  /** Percentage of a pending list's subchannels that must be READY before
+   * it replaces a current list that still has READY subchannels. 0 promotes
+   * the pending list on its first READY subchannel. */
+  int swap_ready_percent_ = 0;
   /** have we started picking? */
   bool started_picking_ = false;
   /** are we shutting down? */
@@ -436,6 +456,94 @@ void RoundRobin::RoundRobinSubchannelList::StartWatchingLocked() {
   }
 }
 
+int CompareServerAddresses(const void* a, const void* b) {
+  const ServerAddress* address_a = *static_cast<const ServerAddress* const*>(a);
+  const ServerAddress* address_b = *static_cast<const ServerAddress* const*>(b);
+  return address_a->Cmp(*address_b);
+}
+
+bool RoundRobin::RoundRobinSubchannelList::KeepsReadySubchannelLocked(
+    const ServerAddressList& addresses) {
+  InlinedVector<const ServerAddress*, 10> sorted;
+  sorted.reserve(addresses.size());
+  for (size_t i = 0; i < addresses.size(); ++i) {
+    sorted.push_back(&addresses[i]);
+  }
+  qsort(sorted.data(), sorted.size(), sizeof(const ServerAddress*),
+        CompareServerAddresses);
+  for (size_t i = 0; i < num_subchannels(); ++i) {
+    if (subchannel(i)->connectivity_state() != GRPC_CHANNEL_READY) continue;
+    const ServerAddress* key = &subchannel(i)->address();
+    if (bsearch(&key, sorted.data(), sorted.size(),
+                sizeof(const ServerAddress*),
+                CompareServerAddresses) != nullptr) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool RoundRobin::RoundRobinSubchannelList::UpdateInPlaceLocked(
+    const ServerAddressList& addresses, const grpc_channel_args& args,
+    bool started_picking) {
+  // Unlike a new list, which only replaces this one once it has a READY
+  // subchannel, an in-place update drops removed subchannels right away. So
+  // if this list has READY subchannels, only update it in place if one of
+  // them is kept; otherwise picks would stall until a new one connects.
+  if (num_ready_ > 0 && !KeepsReadySubchannelLocked(addresses)) return false;
+  InlinedVector<RoundRobinSubchannelData*, 10> added;
+  if (!UpdateAddressesLocked(addresses, args, &added)) return false;
+  // Recompute the state counters, since removed subchannels may have been
+  // counted. New subchannels are still IDLE and thus not counted.
+  num_ready_ = 0;
+  num_connecting_ = 0;
+  num_transient_failure_ = 0;
+  for (size_t i = 0; i < num_subchannels(); ++i) {
+    switch (subchannel(i)->connectivity_state()) {
+      case GRPC_CHANNEL_READY:
+        ++num_ready_;
+        break;
+      case GRPC_CHANNEL_CONNECTING:
+        ++num_connecting_;
+        break;
+      case GRPC_CHANNEL_TRANSIENT_FAILURE:
+        ++num_transient_failure_;
+        break;
+      default:
+        break;
+    }
+  }
+  // Indices have changed; keep the rotation going from roughly the same
+  // position.
+  if (last_ready_index_ >= num_subchannels()) {
+    last_ready_index_ = num_subchannels() - 1;
+  }
+  if (started_picking) {
+    for (size_t i = 0; i < added.size(); ++i) {
+      grpc_error* error = GRPC_ERROR_NONE;
+      grpc_connectivity_state state =
+          added[i]->CheckConnectivityStateLocked(&error);
+      if (state != GRPC_CHANNEL_IDLE) {
+        added[i]->UpdateConnectivityStateLocked(state, error);
+      }
+    }
+    for (size_t i = 0; i < added.size(); ++i) {
+      added[i]->StartConnectivityWatchLocked();
+    }
+  }
+  UpdateRoundRobinStateFromSubchannelStateCountsLocked();
+  // The update may have removed every READY subchannel without leaving any
+  // in a state that MaybeUpdateRoundRobinConnectivityStateLocked() reports.
+  RoundRobin* p = static_cast<RoundRobin*>(policy());
+  if (num_ready_ == 0 &&
+      grpc_connectivity_state_check(&p->state_tracker_) ==
+          GRPC_CHANNEL_READY) {
+    grpc_connectivity_state_set(&p->state_tracker_, GRPC_CHANNEL_CONNECTING,
+                                GRPC_ERROR_NONE, "rr_update_lost_ready");
+  }
+  return true;
+}
+
 void RoundRobin::RoundRobinSubchannelList::UpdateStateCountersLocked(
     grpc_connectivity_state old_state, grpc_connectivity_state new_state,
     grpc_error* transient_failure_error) {
@@ -506,6 +614,8 @@ void RoundRobin::RoundRobinSubchannelList::
   AutoChildRefsUpdater guard(p);
   if (num_ready_ > 0) {
     if (p->subchannel_list_.get() != this) {
+      // Keep serving from the current list while this one warms up.
+      if (!ReadyToReplaceCurrentListLocked()) return;
       // Promote this list to p->subchannel_list_.
       // This list must be p->latest_pending_subchannel_list_, because
       // any previous update would have been shut down already and
@@ -527,11 +637,42 @@ void RoundRobin::RoundRobinSubchannelList::
     }
     // Drain pending picks.
     p->DrainPendingPicksLocked();
+  } else if (p->subchannel_list_.get() == this &&
+             p->latest_pending_subchannel_list_ != nullptr &&
+             p->latest_pending_subchannel_list_->num_ready_ > 0) {
+    // The current list lost its last READY subchannel while the pending
+    // list was still warming up. Switch over now instead of stalling picks.
+    // This shuts down the current list.
+    p->latest_pending_subchannel_list_
+        ->UpdateRoundRobinStateFromSubchannelStateCountsLocked();
+    return;
   }
   // Update the RR policy's connectivity state if needed.
   MaybeUpdateRoundRobinConnectivityStateLocked();
 }
 
+bool RoundRobin::RoundRobinSubchannelList::ReadyToReplaceCurrentListLocked() {
+  RoundRobin* p = static_cast<RoundRobin*>(policy());
+  if (p->swap_ready_percent_ == 0) return true;
+  // Picks are stalled anyway if the current list has nothing READY.
+  if (p->subchannel_list_ == nullptr || p->subchannel_list_->num_ready_ == 0) {
+    return true;
+  }
+  // Subchannels in TRANSIENT_FAILURE are not waited for, so that a few
+  // unreachable backends do not hold back the swap forever.
+  const size_t num_usable = num_subchannels() - num_transient_failure_;
+  if (num_ready_ * 100 < num_usable * p->swap_ready_percent_) {
+    if (grpc_lb_round_robin_trace.enabled()) {
+      gpr_log(GPR_INFO,
+              "[RR %p] pending subchannel list %p has %" PRIuPTR
+              " of %" PRIuPTR " subchannels READY; waiting for %d%%",
+              p, this, num_ready_, num_usable, p->swap_ready_percent_);
+    }
+    return false;
+  }
+  return true;
+}
+
 void RoundRobin::RoundRobinSubchannelData::UpdateConnectivityStateLocked(
     grpc_connectivity_state connectivity_state, grpc_error* error) {
   RoundRobin* p = static_cast<RoundRobin*>(subchannel_list()->policy());
@@ -572,6 +713,12 @@ void RoundRobin::RoundRobinSubchannelData::ProcessConnectivityChangeLocked(
   UpdateConnectivityStateLocked(connectivity_state, error);
   // Update overall state and renew notification.
   subchannel_list()->UpdateRoundRobinStateFromSubchannelStateCountsLocked();
+  // If that replaced this list with a pending one, stop watching.
+  if (subchannel_list()->shutting_down()) {
+    UnrefSubchannelLocked("connectivity_shutdown");
+    StopConnectivityWatchLocked();
+    return;
+  }
   RenewConnectivityWatchLocked();
 }
 
@@ -662,6 +809,25 @@ void RoundRobin::UpdateLocked(const grpc_channel_args& args,
     gpr_log(GPR_INFO, "[RR %p] received update with %" PRIuPTR " addresses",
             this, addresses->size());
   }
+  swap_ready_percent_ = grpc_channel_arg_get_integer(
+      grpc_channel_args_find(&args, GRPC_ARG_LB_POLICY_SWAP_READY_PERCENT),
+      {0, 0, 100});
+  // If the current list is in use and only the addresses changed, update it
+  // in place, so that subchannels present before and after the update keep
+  // their connectivity watches and stay available for picks.
+  if (subchannel_list_ != nullptr &&
+      latest_pending_subchannel_list_ == nullptr &&
+      subchannel_list_->num_subchannels() > 0 && !addresses->empty() &&
+      subchannel_list_->UpdateInPlaceLocked(*addresses, args,
+                                            started_picking_)) {
+    if (subchannel_list_->num_subchannels() == 0) {
+      grpc_connectivity_state_set(
+          &state_tracker_, GRPC_CHANNEL_TRANSIENT_FAILURE,
+          GRPC_ERROR_CREATE_FROM_STATIC_STRING("Empty update"),
+          "rr_update_empty");
+    }
+    return;
+  }
   // Replace latest_pending_subchannel_list_.
   if (latest_pending_subchannel_list_ != nullptr) {
     if (grpc_lb_round_robin_trace.enabled()) {
@@ -82,10 +82,10 @@ class SubchannelData {
   }
 
   // Returns the index into the subchannel list of this object.
-  size_t Index() const {
-    return static_cast<size_t>(static_cast<const SubchannelDataType*>(this) -
-                               subchannel_list_->subchannel(0));
-  }
+  size_t Index() const { return index_; }
+
+  // Returns the address this subchannel was created for.
+  const ServerAddress& address() const { return address_; }
 
   // Returns a pointer to the subchannel.
   grpc_subchannel* subchannel() const { return subchannel_; }
@@ -160,6 +160,14 @@ class SubchannelData {
   void UnrefSubchannelLocked(const char* reason);
 
  private:
+  // For setting index_ and calling RemoveLocked().
+  friend class SubchannelList<SubchannelListType, SubchannelDataType>;
+
+  // Shuts down and destroys this object after it was dropped from its list
+  // by an update. If a connectivity notification is pending, destruction is
+  // deferred until the canceled notification comes back.
+  void RemoveLocked();
+
   // Updates connected_subchannel_ based on pending_connectivity_state_unsafe_.
   // Returns true if the connectivity state should be reported.
   bool UpdateConnectedSubchannelLocked();
@@ -168,6 +176,12 @@ class SubchannelData {
 
   // Backpointer to owning subchannel list.  Not owned.
   SubchannelList<SubchannelListType, SubchannelDataType>* subchannel_list_;
+  // Position in the owning subchannel list.
+  size_t index_ = 0;
+  // Address used to create the subchannel.
+  ServerAddress address_;
+  // Set when an update removed this object from its list.
+  bool removed_ = false;
 
   // The subchannel and connected subchannel.
   grpc_subchannel* subchannel_;
@@ -187,13 +201,13 @@ class SubchannelData {
 template <typename SubchannelListType, typename SubchannelDataType>
 class SubchannelList : public InternallyRefCounted<SubchannelListType> {
  public:
-  typedef InlinedVector<SubchannelDataType, 10> SubchannelVector;
+  typedef InlinedVector<SubchannelDataType*, 10> SubchannelVector;
 
   // The number of subchannels in the list.
   size_t num_subchannels() const { return subchannels_.size(); }
 
   // The data for the subchannel at a particular index.
-  SubchannelDataType* subchannel(size_t index) { return &subchannels_[index]; }
+  SubchannelDataType* subchannel(size_t index) { return subchannels_[index]; }
 
   // Returns true if the subchannel list is shutting down.
   bool shutting_down() const { return shutting_down_; }
@@ -201,9 +215,9 @@ class SubchannelList : public InternallyRefCounted<SubchannelListType> {
   // Populates refs_list with the uuids of this SubchannelLists's subchannels.
   void PopulateChildRefsList(channelz::ChildRefsList* refs_list) {
     for (size_t i = 0; i < subchannels_.size(); ++i) {
-      if (subchannels_[i].subchannel() != nullptr) {
+      if (subchannels_[i]->subchannel() != nullptr) {
         grpc_core::channelz::SubchannelNode* subchannel_node =
-            grpc_subchannel_get_channelz_node(subchannels_[i].subchannel());
+            grpc_subchannel_get_channelz_node(subchannels_[i]->subchannel());
         if (subchannel_node != nullptr) {
           refs_list->push_back(subchannel_node->uuid());
         }
@@ -221,6 +235,19 @@ class SubchannelList : public InternallyRefCounted<SubchannelListType> {
   // the backoff code out of subchannels and into LB policies.
   void ResetBackoffLocked();
 
+  // Applies an update in place instead of building a new list.
+  // Entries whose address is still present are kept, along with their
+  // subchannel, connectivity state and any pending connectivity watch.
+  // Entries whose address is gone are shut down, and new addresses get
+  // new entries, which are appended to \a added without being watched.
+  // Entries are reordered to match \a addresses.
+  // Returns false without changing anything if \a args differ from the
+  // args this list was created with in anything but the addresses, in
+  // which case the caller must create a new list.
+  bool UpdateAddressesLocked(const ServerAddressList& addresses,
+                             const grpc_channel_args& args,
+                             InlinedVector<SubchannelDataType*, 10>* added);
+
   // Note: Caller must ensure that this is invoked inside of the combiner.
   void Orphan() override {
     ShutdownLocked();
@@ -247,6 +274,14 @@ class SubchannelList : public InternallyRefCounted<SubchannelListType> {
 
   void ShutdownLocked();
 
+  // Creates the entry for \a address, or returns null if no subchannel
+  // could be created for it.
+  SubchannelDataType* CreateSubchannelDataLocked(const ServerAddress& address);
+
+  // Orders entries by address, for qsort() and bsearch().
+  static int CompareSubchannelData(const void* a, const void* b);
+  static int CompareAddressToSubchannelData(const void* key, const void* elem);
+
   // Backpointer to owning policy.
   LoadBalancingPolicy* policy_;
 
@@ -256,6 +291,11 @@ class SubchannelList : public InternallyRefCounted<SubchannelListType> {
 
   grpc_combiner* combiner_;
 
+  grpc_client_channel_factory* client_channel_factory_;
+
+  // The channel args shared by all subchannels, without the per-address args.
+  grpc_channel_args* args_;
+
   // The list of subchannels.
   SubchannelVector subchannels_;
 
@@ -279,6 +319,7 @@ SubchannelData<SubchannelListType, SubchannelDataType>::SubchannelData(
     const ServerAddress& address, grpc_subchannel* subchannel,
     grpc_combiner* combiner)
     : subchannel_list_(subchannel_list),
+      address_(address),
       subchannel_(subchannel),
       // We assume that the current state is IDLE.  If not, we'll get a
       // callback telling us that.
@@ -450,6 +491,15 @@ void SubchannelData<SubchannelListType, SubchannelDataType>::
         grpc_connectivity_state_name(sd->pending_connectivity_state_unsafe_),
         grpc_error_string(error), sd->subchannel_list_->shutting_down());
   }
+  // If removed by an update, nothing refers to this object anymore.
+  if (sd->removed_) {
+    SubchannelListType* subchannel_list = sd->subchannel_list();
+    sd->UnrefSubchannelLocked("connectivity_removed");
+    sd->connectivity_notification_pending_ = false;
+    Delete(static_cast<SubchannelDataType*>(sd));
+    subchannel_list->Unref(DEBUG_LOCATION, "connectivity_watch");
+    return;
+  }
   // If shutting down, unref subchannel and stop watching.
   if (sd->subchannel_list_->shutting_down() || error == GRPC_ERROR_CANCELLED) {
     sd->UnrefSubchannelLocked("connectivity_shutdown");
@@ -479,6 +529,16 @@ void SubchannelData<SubchannelListType, SubchannelDataType>::ShutdownLocked() {
   }
 }
 
+template <typename SubchannelListType, typename SubchannelDataType>
+void SubchannelData<SubchannelListType, SubchannelDataType>::RemoveLocked() {
+  if (connectivity_notification_pending_) {
+    removed_ = true;
+    CancelConnectivityWatchLocked("removed");
+  } else {
+    Delete(static_cast<SubchannelDataType*>(this));
+  }
+}
+
 //
 // SubchannelList
 //
@@ -492,7 +552,8 @@ SubchannelList<SubchannelListType, SubchannelDataType>::SubchannelList(
     : InternallyRefCounted<SubchannelListType>(tracer),
       policy_(policy),
       tracer_(tracer),
-      combiner_(GRPC_COMBINER_REF(combiner, "subchannel_list")) {
+      combiner_(GRPC_COMBINER_REF(combiner, "subchannel_list")),
+      client_channel_factory_(client_channel_factory) {
   if (tracer_->enabled()) {
     gpr_log(GPR_INFO,
             "[%s %p] Creating subchannel list %p for %" PRIuPTR " subchannels",
@@ -508,52 +569,62 @@ SubchannelList<SubchannelListType, SubchannelDataType>::SubchannelList(
   static const char* keys_to_remove[] = {GRPC_ARG_SUBCHANNEL_ADDRESS,
                                          GRPC_ARG_SERVER_ADDRESS_LIST,
                                          GRPC_ARG_INHIBIT_HEALTH_CHECKING};
+  args_ = grpc_channel_args_copy_and_remove(&args, keys_to_remove,
+                                            GPR_ARRAY_SIZE(keys_to_remove));
   // Create a subchannel for each address.
   for (size_t i = 0; i < addresses.size(); i++) {
-    // If there were any balancer addresses, we would have chosen grpclb
-    // policy, which does not use a SubchannelList.
-    GPR_ASSERT(!addresses[i].IsBalancer());
-    InlinedVector<grpc_arg, 4> args_to_add;
-    args_to_add.emplace_back(SubchannelPoolInterface::CreateChannelArg(
-        policy_->subchannel_pool()->get()));
-    const size_t subchannel_address_arg_index = args_to_add.size();
-    args_to_add.emplace_back(
-        grpc_create_subchannel_address_arg(&addresses[i].address()));
-    if (addresses[i].args() != nullptr) {
-      for (size_t j = 0; j < addresses[i].args()->num_args; ++j) {
-        args_to_add.emplace_back(addresses[i].args()->args[j]);
-      }
-    }
-    grpc_channel_args* new_args = grpc_channel_args_copy_and_add_and_remove(
-        &args, keys_to_remove, GPR_ARRAY_SIZE(keys_to_remove),
-        args_to_add.data(), args_to_add.size());
-    gpr_free(args_to_add[subchannel_address_arg_index].value.string);
-    grpc_subchannel* subchannel = grpc_client_channel_factory_create_subchannel(
-        client_channel_factory, new_args);
-    grpc_channel_args_destroy(new_args);
-    if (subchannel == nullptr) {
-      // Subchannel could not be created.
-      if (tracer_->enabled()) {
-        char* address_uri = grpc_sockaddr_to_uri(&addresses[i].address());
-        gpr_log(GPR_INFO,
-                "[%s %p] could not create subchannel for address uri %s, "
-                "ignoring",
-                tracer_->name(), policy_, address_uri);
-        gpr_free(address_uri);
-      }
-      continue;
+    SubchannelDataType* sd = CreateSubchannelDataLocked(addresses[i]);
+    if (sd == nullptr) continue;
+    sd->index_ = subchannels_.size();
+    subchannels_.push_back(sd);
+  }
+}
+
+template <typename SubchannelListType, typename SubchannelDataType>
+SubchannelDataType*
+SubchannelList<SubchannelListType, SubchannelDataType>::
+    CreateSubchannelDataLocked(const ServerAddress& address) {
+  // If there were any balancer addresses, we would have chosen grpclb
+  // policy, which does not use a SubchannelList.
+  GPR_ASSERT(!address.IsBalancer());
+  InlinedVector<grpc_arg, 4> args_to_add;
+  args_to_add.emplace_back(SubchannelPoolInterface::CreateChannelArg(
+      policy_->subchannel_pool()->get()));
+  const size_t subchannel_address_arg_index = args_to_add.size();
+  args_to_add.emplace_back(
+      grpc_create_subchannel_address_arg(&address.address()));
+  if (address.args() != nullptr) {
+    for (size_t j = 0; j < address.args()->num_args; ++j) {
+      args_to_add.emplace_back(address.args()->args[j]);
     }
+  }
+  grpc_channel_args* new_args = grpc_channel_args_copy_and_add(
+      args_, args_to_add.data(), args_to_add.size());
+  gpr_free(args_to_add[subchannel_address_arg_index].value.string);
+  grpc_subchannel* subchannel = grpc_client_channel_factory_create_subchannel(
+      client_channel_factory_, new_args);
+  grpc_channel_args_destroy(new_args);
+  if (subchannel == nullptr) {
+    // Subchannel could not be created.
     if (tracer_->enabled()) {
-      char* address_uri = grpc_sockaddr_to_uri(&addresses[i].address());
+      char* address_uri = grpc_sockaddr_to_uri(&address.address());
       gpr_log(GPR_INFO,
-              "[%s %p] subchannel list %p index %" PRIuPTR
-              ": Created subchannel %p for address uri %s",
-              tracer_->name(), policy_, this, subchannels_.size(), subchannel,
-              address_uri);
+              "[%s %p] could not create subchannel for address uri %s, "
+              "ignoring",
+              tracer_->name(), policy_, address_uri);
       gpr_free(address_uri);
     }
-    subchannels_.emplace_back(this, addresses[i], subchannel, combiner);
+    return nullptr;
   }
+  if (tracer_->enabled()) {
+    char* address_uri = grpc_sockaddr_to_uri(&address.address());
+    gpr_log(GPR_INFO,
+            "[%s %p] subchannel list %p: Created subchannel %p for address "
+            "uri %s",
+            tracer_->name(), policy_, this, subchannel, address_uri);
+    gpr_free(address_uri);
+  }
+  return New<SubchannelDataType>(this, address, subchannel, combiner_);
 }
 
 template <typename SubchannelListType, typename SubchannelDataType>
@@ -562,6 +633,10 @@ SubchannelList<SubchannelListType, SubchannelDataType>::~SubchannelList() {
     gpr_log(GPR_INFO, "[%s %p] Destroying subchannel_list %p", tracer_->name(),
             policy_, this);
   }
+  for (size_t i = 0; i < subchannels_.size(); i++) {
+    Delete(subchannels_[i]);
+  }
+  grpc_channel_args_destroy(args_);
   GRPC_COMBINER_UNREF(combiner_, "subchannel_list");
 }
 
@@ -574,7 +649,7 @@ void SubchannelList<SubchannelListType, SubchannelDataType>::ShutdownLocked() {
   GPR_ASSERT(!shutting_down_);
   shutting_down_ = true;
   for (size_t i = 0; i < subchannels_.size(); i++) {
-    SubchannelDataType* sd = &subchannels_[i];
+    SubchannelDataType* sd = subchannels_[i];
     sd->ShutdownLocked();
   }
 }
@@ -583,11 +658,87 @@ template <typename SubchannelListType, typename SubchannelDataType>
 void SubchannelList<SubchannelListType,
                     SubchannelDataType>::ResetBackoffLocked() {
   for (size_t i = 0; i < subchannels_.size(); i++) {
-    SubchannelDataType* sd = &subchannels_[i];
+    SubchannelDataType* sd = subchannels_[i];
     sd->ResetBackoffLocked();
   }
 }
 
+template <typename SubchannelListType, typename SubchannelDataType>
+int SubchannelList<SubchannelListType, SubchannelDataType>::
+    CompareSubchannelData(const void* a, const void* b) {
+  const SubchannelDataType* sd_a =
+      *static_cast<SubchannelDataType* const*>(a);
+  const SubchannelDataType* sd_b =
+      *static_cast<SubchannelDataType* const*>(b);
+  return sd_a->address().Cmp(sd_b->address());
+}
+
+template <typename SubchannelListType, typename SubchannelDataType>
+int SubchannelList<SubchannelListType, SubchannelDataType>::
+    CompareAddressToSubchannelData(const void* key, const void* elem) {
+  const ServerAddress* address = static_cast<const ServerAddress*>(key);
+  const SubchannelDataType* sd =
+      *static_cast<SubchannelDataType* const*>(elem);
+  return address->Cmp(sd->address());
+}
+
+template <typename SubchannelListType, typename SubchannelDataType>
+bool SubchannelList<SubchannelListType, SubchannelDataType>::
+    UpdateAddressesLocked(const ServerAddressList& addresses,
+                          const grpc_channel_args& args,
+                          InlinedVector<SubchannelDataType*, 10>* added) {
+  GPR_ASSERT(!shutting_down_);
+  // The subchannels can only be reused if they would be created with the
+  // same args.
+  const bool inhibit_health_checking = grpc_channel_arg_get_bool(
+      grpc_channel_args_find(&args, GRPC_ARG_INHIBIT_HEALTH_CHECKING), false);
+  static const char* keys_to_remove[] = {GRPC_ARG_SUBCHANNEL_ADDRESS,
+                                         GRPC_ARG_SERVER_ADDRESS_LIST,
+                                         GRPC_ARG_INHIBIT_HEALTH_CHECKING};
+  grpc_channel_args* new_args = grpc_channel_args_copy_and_remove(
+      &args, keys_to_remove, GPR_ARRAY_SIZE(keys_to_remove));
+  const bool args_changed =
+      inhibit_health_checking != inhibit_health_checking_ ||
+      grpc_channel_args_compare(new_args, args_) != 0;
+  grpc_channel_args_destroy(new_args);
+  if (args_changed) return false;
+  if (tracer_->enabled()) {
+    gpr_log(GPR_INFO,
+            "[%s %p] Updating subchannel list %p in place: %" PRIuPTR
+            " subchannels -> %" PRIuPTR " addresses",
+            tracer_->name(), policy_, this, subchannels_.size(),
+            addresses.size());
+  }
+  // Sort the current entries by address, so that each address of the
+  // update is matched by a binary search rather than a linear scan.
+  SubchannelVector old_subchannels(std::move(subchannels_));
+  qsort(old_subchannels.data(), old_subchannels.size(),
+        sizeof(SubchannelDataType*), CompareSubchannelData);
+  InlinedVector<bool, 10> reused;
+  for (size_t i = 0; i < old_subchannels.size(); ++i) reused.push_back(false);
+  subchannels_.reserve(addresses.size());
+  for (size_t i = 0; i < addresses.size(); ++i) {
+    SubchannelDataType** found = static_cast<SubchannelDataType**>(
+        bsearch(&addresses[i], old_subchannels.data(), old_subchannels.size(),
+                sizeof(SubchannelDataType*), CompareAddressToSubchannelData));
+    SubchannelDataType* sd = nullptr;
+    if (found != nullptr && !reused[found - old_subchannels.data()]) {
+      reused[found - old_subchannels.data()] = true;
+      sd = *found;
+    } else {
+      sd = CreateSubchannelDataLocked(addresses[i]);
+      if (sd == nullptr) continue;
+      added->push_back(sd);
+    }
+    sd->index_ = subchannels_.size();
+    subchannels_.push_back(sd);
+  }
+  for (size_t i = 0; i < old_subchannels.size(); ++i) {
+    if (!reused[i]) old_subchannels[i]->RemoveLocked();
+  }
+  return true;
+}
+
 }  // namespace grpc_core
 
 #endif /* GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_SUBCHANNEL_LIST_H */
@@ -0,0 +1,989 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/request_coalescing_filter.h"
+
+#include <string.h>
+
+#include <grpc/impl/codegen/grpc_types.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channel_stack_builder.h"
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/gpr/arena.h"
+#include "src/core/lib/gprpp/inlined_vector.h"
+#include "src/core/lib/gprpp/manual_constructor.h"
+#include "src/core/lib/gprpp/mutex_lock.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/call_combiner.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/surface/channel_init.h"
+#include "src/core/lib/transport/byte_stream.h"
+#include "src/core/lib/transport/error_utils.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "src/core/lib/transport/service_config.h"
+#include "src/core/lib/transport/status_metadata.h"
+
+namespace grpc_core {
+namespace {
+
+class CoalescingMethodParams : public RefCounted<CoalescingMethodParams> {
+ public:
+  static RefCountedPtr<CoalescingMethodParams> CreateFromJson(
+      const grpc_json* json);
+
+  bool coalesce_requests() const { return coalesce_requests_; }
+
+ private:
+  // So New() can call our private ctor.
+  template <typename T, typename... Args>
+  friend T* grpc_core::New(Args&&... args);
+
+  explicit CoalescingMethodParams(bool coalesce_requests)
+      : coalesce_requests_(coalesce_requests) {}
+
+  bool coalesce_requests_;
+};
+
+RefCountedPtr<CoalescingMethodParams> CoalescingMethodParams::CreateFromJson(
+    const grpc_json* json) {
+  bool coalesce_requests = false;
+  bool found = false;
+  for (grpc_json* field = json->child; field != nullptr; field = field->next) {
+    if (field->key == nullptr) continue;
+    if (strcmp(field->key, "coalesceRequests") == 0) {
+      if (found) return nullptr;  // Duplicate.
+      found = true;
+      if (field->type == GRPC_JSON_TRUE) {
+        coalesce_requests = true;
+      } else if (field->type != GRPC_JSON_FALSE) {
+        return nullptr;
+      }
+    }
+  }
+  return MakeRefCounted<CoalescingMethodParams>(coalesce_requests);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+static void send_message_on_complete(void* arg, grpc_error* error);
+static void on_send_message_next_done(void* arg, grpc_error* error);
+static void recv_initial_metadata_ready(void* arg, grpc_error* error);
+static void recv_message_ready(void* arg, grpc_error* error);
+static void recv_message_next_done(void* arg, grpc_error* error);
+static void continue_recv_message(void* arg, grpc_error* error);
+static void recv_trailing_metadata_ready(void* arg, grpc_error* error);
+static void deliver_group_result(void* arg, grpc_error* error);
+static void reissue_batch(void* arg, grpc_error* error);
+
+namespace {
+
+constexpr size_t kNumGroupBuckets = 64;
+
+typedef grpc_core::InlinedVector<grpc_mdelem, 8> mdelem_list;
+
+struct call_data;
+
+// The identical calls in flight for one key: the leader, which is sent, and
+// the followers, which get a copy of the leader's response.
+struct call_group : public grpc_core::RefCounted<call_group> {
+  call_group(grpc_slice key, uint32_t hash) : key(key), hash(hash) {
+    grpc_slice_buffer_init(&message);
+  }
+
+  ~call_group() {
+    grpc_slice_unref_internal(key);
+    for (size_t i = 0; i < initial_metadata.size(); ++i) {
+      GRPC_MDELEM_UNREF(initial_metadata[i]);
+    }
+    grpc_slice_buffer_destroy_internal(&message);
+    for (size_t i = 0; i < trailing_metadata.size(); ++i) {
+      GRPC_MDELEM_UNREF(trailing_metadata[i]);
+    }
+    GRPC_ERROR_UNREF(error);
+  }
+
+  grpc_slice key;
+  uint32_t hash;
+
+  // Guarded by channel_data::mu.
+  call_group* bucket_next = nullptr;
+  call_data* followers = nullptr;
+  bool coalesced = false;
+
+  // The leader's response, written by the leader before the group is
+  // finished.
+  mdelem_list initial_metadata;
+  bool has_message = false;
+  uint32_t message_flags = 0;
+  grpc_slice_buffer message;
+  mdelem_list trailing_metadata;
+  grpc_error* error = GRPC_ERROR_NONE;
+  // Set if the leader was cancelled or ran out of time: its response is not
+  // handed to the followers, which send their request themselves.
+  bool leader_gave_up = false;
+};
+
+struct channel_data {
+  channel_data() {
+    gpr_mu_init(&mu);
+    memset(groups, 0, sizeof(groups));
+  }
+
+  ~channel_data() { gpr_mu_destroy(&mu); }
+
+  // Maps path names to refcounted CoalescingMethodParams.
+  grpc_core::RefCountedPtr<grpc_core::SliceHashTable<
+      grpc_core::RefCountedPtr<grpc_core::CoalescingMethodParams>>>
+      method_params_table;
+  gpr_mu mu;
+  // The groups whose leader is in flight, hashed by key.
+  call_group* groups[kNumGroupBuckets];
+};
+
+enum coalescing_role {
+  // The first batch has not been seen yet.
+  UNDECIDED,
+  // The call is sent as usual and does not lead a group.
+  PASS_THROUGH,
+  LEADER,
+  FOLLOWER,
+};
+
+struct call_data {
+  call_data(grpc_call_element* elem, const channel_data& chand,
+            const grpc_call_element_args& args)
+      : owning_call(args.call_stack),
+        call_combiner(args.call_combiner),
+        arena(args.arena),
+        path(grpc_slice_ref_internal(args.path)),
+        deadline(args.deadline),
+        role(PASS_THROUGH) {
+    if (chand.method_params_table != nullptr) {
+      grpc_core::RefCountedPtr<grpc_core::CoalescingMethodParams> params =
+          grpc_core::ServiceConfig::MethodConfigTableLookup(
+              *chand.method_params_table, args.path);
+      if (params != nullptr && params->coalesce_requests()) role = UNDECIDED;
+    }
+    GRPC_CLOSURE_INIT(&send_message_on_complete, ::send_message_on_complete,
+                      elem, grpc_schedule_on_exec_ctx);
+    GRPC_CLOSURE_INIT(&on_send_message_next_done, ::on_send_message_next_done,
+                      elem, grpc_schedule_on_exec_ctx);
+    GRPC_CLOSURE_INIT(&recv_initial_metadata_ready,
+                      ::recv_initial_metadata_ready, elem,
+                      grpc_schedule_on_exec_ctx);
+    GRPC_CLOSURE_INIT(&recv_message_ready, ::recv_message_ready, elem,
+                      grpc_schedule_on_exec_ctx);
+    GRPC_CLOSURE_INIT(&recv_message_next_done, ::recv_message_next_done, elem,
+                      grpc_schedule_on_exec_ctx);
+    GRPC_CLOSURE_INIT(&continue_recv_message, ::continue_recv_message, elem,
+                      grpc_schedule_on_exec_ctx);
+    GRPC_CLOSURE_INIT(&recv_trailing_metadata_ready,
+                      ::recv_trailing_metadata_ready, elem,
+                      grpc_schedule_on_exec_ctx);
+    GRPC_CLOSURE_INIT(&deliver_group_result, ::deliver_group_result, elem,
+                      grpc_schedule_on_exec_ctx);
+  }
+
+  ~call_data() {
+    grpc_slice_unref_internal(path);
+    GRPC_ERROR_UNREF(cancel_error);
+  }
+
+  grpc_call_stack* owning_call;
+  grpc_call_combiner* call_combiner;
+  gpr_arena* arena;
+  grpc_slice path;
+  grpc_millis deadline;
+  coalescing_role role;
+  grpc_error* cancel_error = GRPC_ERROR_NONE;
+  grpc_core::RefCountedPtr<call_group> group;
+
+  // State for reading the request message to build the group key.
+  grpc_transport_stream_op_batch* send_message_batch = nullptr;
+  grpc_core::ManualConstructor<grpc_core::ByteStreamCache> send_message_cache;
+  grpc_core::ManualConstructor<grpc_core::ByteStreamCache::CachingByteStream>
+      send_message_caching_stream;
+  size_t send_message_bytes_read = 0;
+  grpc_closure on_send_message_next_done;
+  grpc_closure* original_send_message_on_complete = nullptr;
+  grpc_closure send_message_on_complete;
+
+  // The response message handed up, for leaders and followers.
+  grpc_core::ManualConstructor<grpc_core::SliceBufferByteStream>
+      recv_message_replacement;
+
+  // Leader state.
+  grpc_metadata_batch* recv_initial_metadata = nullptr;
+  grpc_closure* original_recv_initial_metadata_ready = nullptr;
+  grpc_closure recv_initial_metadata_ready;
+  bool recv_message_seen = false;
+  grpc_core::OrphanablePtr<grpc_core::ByteStream>* recv_message = nullptr;
+  grpc_core::OrphanablePtr<grpc_core::ByteStream> recv_message_stream;
+  grpc_closure* original_recv_message_ready = nullptr;
+  grpc_closure recv_message_ready;
+  grpc_closure recv_message_next_done;
+  grpc_closure continue_recv_message;
+  bool recv_message_draining = false;
+  grpc_metadata_batch* recv_trailing_metadata = nullptr;
+  grpc_closure* original_recv_trailing_metadata_ready = nullptr;
+  grpc_closure recv_trailing_metadata_ready;
+  bool seen_recv_trailing_metadata = false;
+  grpc_error* recv_trailing_metadata_error = GRPC_ERROR_NONE;
+  bool group_finished = false;
+
+  // Follower state. The links and in_group are guarded by channel_data::mu.
+  call_data* prev_follower = nullptr;
+  call_data* next_follower = nullptr;
+  bool in_group = false;
+  // The follower's first batch, held until the leader finishes so that it
+  // can still be sent if the leader gives up.
+  grpc_transport_stream_op_batch* held_batch = nullptr;
+  // Set once the leader's response can be handed up.
+  bool response_available = false;
+  bool message_delivered = false;
+  grpc_transport_stream_op_batch* pending_recv_initial_metadata = nullptr;
+  grpc_transport_stream_op_batch* pending_recv_message = nullptr;
+  grpc_transport_stream_op_batch* pending_recv_trailing_metadata = nullptr;
+  grpc_closure deliver_group_result;
+};
+
+}  // namespace
+
+//
+// group bookkeeping
+//
+
+static call_group** group_bucket(channel_data* chand, uint32_t hash) {
+  return &chand->groups[hash % kNumGroupBuckets];
+}
+
+static call_group* find_group_locked(channel_data* chand,
+                                     const grpc_slice& key, uint32_t hash) {
+  for (call_group* group = *group_bucket(chand, hash); group != nullptr;
+       group = group->bucket_next) {
+    if (group->hash == hash && grpc_slice_eq(group->key, key)) return group;
+  }
+  return nullptr;
+}
+
+static void remove_group_locked(channel_data* chand, call_group* group) {
+  for (call_group** link = group_bucket(chand, group->hash); *link != nullptr;
+       link = &(*link)->bucket_next) {
+    if (*link == group) {
+      *link = group->bucket_next;
+      group->bucket_next = nullptr;
+      return;
+    }
+  }
+}
+
+// Builds the key under which identical requests are coalesced, from the
+// authority, the path and the request message.
+static grpc_slice make_group_key(call_data* calld,
+                                 grpc_transport_stream_op_batch* batch) {
+  grpc_metadata_batch* md =
+      batch->payload->send_initial_metadata.send_initial_metadata;
+  grpc_slice authority = md->idx.named.authority != nullptr
+                             ? GRPC_MDVALUE(md->idx.named.authority->md)
+                             : grpc_empty_slice();
+  const grpc_slice_buffer* payload = calld->send_message_cache->cache_buffer();
+  const uint32_t flags = calld->send_message_caching_stream->flags();
+  const uint32_t authority_len =
+      static_cast<uint32_t>(GRPC_SLICE_LENGTH(authority));
+  const uint32_t path_len =
+      static_cast<uint32_t>(GRPC_SLICE_LENGTH(calld->path));
+  grpc_slice key = GRPC_SLICE_MALLOC(3 * sizeof(uint32_t) + authority_len +
+                                     path_len + payload->length);
+  uint8_t* p = GRPC_SLICE_START_PTR(key);
+  memcpy(p, &authority_len, sizeof(authority_len));
+  p += sizeof(authority_len);
+  memcpy(p, GRPC_SLICE_START_PTR(authority), authority_len);
+  p += authority_len;
+  memcpy(p, &path_len, sizeof(path_len));
+  p += sizeof(path_len);
+  memcpy(p, GRPC_SLICE_START_PTR(calld->path), path_len);
+  p += path_len;
+  memcpy(p, &flags, sizeof(flags));
+  p += sizeof(flags);
+  for (size_t i = 0; i < payload->count; ++i) {
+    memcpy(p, GRPC_SLICE_START_PTR(payload->slices[i]),
+           GRPC_SLICE_LENGTH(payload->slices[i]));
+    p += GRPC_SLICE_LENGTH(payload->slices[i]);
+  }
+  return key;
+}
+
+// Makes the call the leader of a new group or a follower of an existing one.
+static void join_group(grpc_call_element* elem,
+                       grpc_transport_stream_op_batch* batch) {
+  channel_data* chand = static_cast<channel_data*>(elem->channel_data);
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  grpc_slice key = make_group_key(calld, batch);
+  const uint32_t hash = grpc_slice_hash(key);
+  bool key_used = false;
+  {
+    grpc_core::MutexLock lock(&chand->mu);
+    call_group* group = find_group_locked(chand, key, hash);
+    if (group == nullptr) {
+      calld->role = LEADER;
+      calld->group = grpc_core::MakeRefCounted<call_group>(key, hash);
+      key_used = true;
+      call_group** bucket = group_bucket(chand, hash);
+      calld->group->bucket_next = *bucket;
+      *bucket = calld->group.get();
+    } else {
+      calld->role = FOLLOWER;
+      calld->group = group->Ref();
+      calld->next_follower = group->followers;
+      if (group->followers != nullptr) {
+        group->followers->prev_follower = calld;
+      }
+      group->followers = calld;
+      calld->in_group = true;
+      if (!group->coalesced) {
+        group->coalesced = true;
+        GRPC_STATS_INC_CLIENT_COALESCED_CALL_GROUPS();
+      }
+      GRPC_STATS_INC_CLIENT_CALLS_COALESCED();
+    }
+  }
+  if (!key_used) grpc_slice_unref_internal(key);
+}
+
+static void leave_group(channel_data* chand, call_data* calld) {
+  grpc_core::MutexLock lock(&chand->mu);
+  if (!calld->in_group) return;
+  if (calld->prev_follower != nullptr) {
+    calld->prev_follower->next_follower = calld->next_follower;
+  } else {
+    calld->group->followers = calld->next_follower;
+  }
+  if (calld->next_follower != nullptr) {
+    calld->next_follower->prev_follower = calld->prev_follower;
+  }
+  calld->prev_follower = calld->next_follower = nullptr;
+  calld->in_group = false;
+}
+
+// Called once the leader has its response (or failed): stops new calls from
+// joining the group and hands the response to the followers.
+static void finish_group(channel_data* chand, call_data* leader) {
+  call_group* group = leader->group.get();
+  leader->group_finished = true;
+  call_data* followers;
+  {
+    grpc_core::MutexLock lock(&chand->mu);
+    remove_group_locked(chand, group);
+    followers = group->followers;
+    group->followers = nullptr;
+    for (call_data* follower = followers; follower != nullptr;
+         follower = follower->next_follower) {
+      follower->in_group = false;
+      // Keeps the follower alive until deliver_group_result() runs, even if
+      // it is cancelled in the meantime.
+      GRPC_CALL_STACK_REF(follower->owning_call, "coalesced response");
+    }
+  }
+  while (followers != nullptr) {
+    call_data* follower = followers;
+    followers = follower->next_follower;
+    follower->prev_follower = follower->next_follower = nullptr;
+    GRPC_CALL_COMBINER_START(follower->call_combiner,
+                             &follower->deliver_group_result, GRPC_ERROR_NONE,
+                             "coalesced response");
+  }
+}
+
+//
+// leader
+//
+
+// Returns true if the leader's status, from \a error or else from its
+// trailing metadata, is DEADLINE_EXCEEDED.
+static bool deadline_exceeded(call_data* calld, grpc_error* error) {
+  grpc_status_code status;
+  if (error != GRPC_ERROR_NONE) {
+    grpc_error_get_status(error, calld->deadline, &status, nullptr, nullptr,
+                          nullptr);
+  } else if (calld->recv_trailing_metadata->idx.named.grpc_status != nullptr) {
+    status = grpc_get_status_code_from_metadata(
+        calld->recv_trailing_metadata->idx.named.grpc_status->md);
+  } else {
+    return false;
+  }
+  return status == GRPC_STATUS_DEADLINE_EXCEEDED;
+}
+
+static void copy_metadata(grpc_metadata_batch* batch, mdelem_list* out) {
+  for (grpc_linked_mdelem* l = batch->list.head; l != nullptr; l = l->next) {
+    out->push_back(GRPC_MDELEM_REF(l->md));
+  }
+}
+
+static void recv_initial_metadata_ready(void* arg, grpc_error* error) {
+  grpc_call_element* elem = static_cast<grpc_call_element*>(arg);
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  if (error == GRPC_ERROR_NONE) {
+    copy_metadata(calld->recv_initial_metadata,
+                  &calld->group->initial_metadata);
+  }
+  GRPC_CLOSURE_RUN(calld->original_recv_initial_metadata_ready,
+                   GRPC_ERROR_REF(error));
+}
+
+// Reads the leader's response message into its group. Returns false if an
+// async read has been dispatched, in which case recv_message_next_done()
+// will be invoked when it is complete.
+static bool read_recv_message(call_data* calld, grpc_error** error) {
+  grpc_slice_buffer* message = &calld->group->message;
+  while (message->length < calld->recv_message_stream->length()) {
+    if (!calld->recv_message_stream->Next(
+            calld->recv_message_stream->length() - message->length,
+            &calld->recv_message_next_done)) {
+      return false;
+    }
+    grpc_slice slice;
+    *error = calld->recv_message_stream->Pull(&slice);
+    if (*error != GRPC_ERROR_NONE) return true;
+    grpc_slice_buffer_add(message, slice);
+  }
+  return true;
+}
+
+// Hands the message up to the leader, along with a copy of it if it was read
+// successfully. Takes ownership of \a error.
+static void finish_recv_message(grpc_call_element* elem, grpc_error* error) {
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  call_group* group = calld->group.get();
+  if (error == GRPC_ERROR_NONE) {
+    group->has_message = true;
+    group->message_flags = calld->recv_message_stream->flags();
+    grpc_slice_buffer copy;
+    grpc_slice_buffer_init(&copy);
+    for (size_t i = 0; i < group->message.count; ++i) {
+      grpc_slice_buffer_add(&copy,
+                            grpc_slice_ref_internal(group->message.slices[i]));
+    }
+    calld->recv_message_replacement.Init(&copy, group->message_flags);
+    calld->recv_message->reset(calld->recv_message_replacement.get());
+    grpc_slice_buffer_destroy_internal(&copy);
+  } else {
+    grpc_slice_buffer_reset_and_unref_internal(&group->message);
+  }
+  calld->recv_message_stream.reset();
+  if (calld->seen_recv_trailing_metadata) {
+    calld->seen_recv_trailing_metadata = false;
+    GRPC_CALL_COMBINER_START(calld->call_combiner,
+                             &calld->recv_trailing_metadata_ready,
+                             calld->recv_trailing_metadata_error,
+                             "continue recv_trailing_metadata_ready");
+    calld->recv_trailing_metadata_error = GRPC_ERROR_NONE;
+  }
+  GRPC_CLOSURE_RUN(calld->original_recv_message_ready, error);
+}
+
+static void recv_message_ready(void* arg, grpc_error* error) {
+  grpc_call_element* elem = static_cast<grpc_call_element*>(arg);
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  if (error != GRPC_ERROR_NONE || *calld->recv_message == nullptr) {
+    GRPC_CLOSURE_RUN(calld->original_recv_message_ready,
+                     GRPC_ERROR_REF(error));
+    return;
+  }
+  calld->recv_message_stream = std::move(*calld->recv_message);
+  grpc_error* read_error = GRPC_ERROR_NONE;
+  if (!read_recv_message(calld, &read_error)) {
+    calld->recv_message_draining = true;
+    GRPC_CALL_COMBINER_STOP(calld->call_combiner,
+                            "waiting for the rest of the coalesced response");
+    return;
+  }
+  finish_recv_message(elem, read_error);
+}
+
+static void recv_message_next_done(void* arg, grpc_error* error) {
+  grpc_call_element* elem = static_cast<grpc_call_element*>(arg);
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  GRPC_CALL_COMBINER_START(calld->call_combiner, &calld->continue_recv_message,
+                           GRPC_ERROR_REF(error),
+                           "continue reading the coalesced response");
+}
+
+static void continue_recv_message(void* arg, grpc_error* error) {
+  grpc_call_element* elem = static_cast<grpc_call_element*>(arg);
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  grpc_error* read_error = GRPC_ERROR_REF(error);
+  if (read_error == GRPC_ERROR_NONE) {
+    grpc_slice slice;
+    read_error = calld->recv_message_stream->Pull(&slice);
+    if (read_error == GRPC_ERROR_NONE) {
+      grpc_slice_buffer_add(&calld->group->message, slice);
+      if (!read_recv_message(calld, &read_error)) {
+        GRPC_CALL_COMBINER_STOP(
+            calld->call_combiner,
+            "waiting for the rest of the coalesced response");
+        return;
+      }
+    }
+  }
+  calld->recv_message_draining = false;
+  finish_recv_message(elem, read_error);
+}
+
+static void recv_trailing_metadata_ready(void* arg, grpc_error* error) {
+  grpc_call_element* elem = static_cast<grpc_call_element*>(arg);
+  channel_data* chand = static_cast<channel_data*>(elem->channel_data);
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  if (calld->recv_message_draining) {
+    calld->seen_recv_trailing_metadata = true;
+    calld->recv_trailing_metadata_error = GRPC_ERROR_REF(error);
+    GRPC_CALL_COMBINER_STOP(calld->call_combiner,
+                            "deferring recv_trailing_metadata_ready until "
+                            "after recv_message_ready");
+    return;
+  }
+  call_group* group = calld->group.get();
+  if (calld->cancel_error != GRPC_ERROR_NONE) {
+    group->leader_gave_up = true;
+  } else {
+    copy_metadata(calld->recv_trailing_metadata, &group->trailing_metadata);
+    group->error = GRPC_ERROR_REF(error);
+    group->leader_gave_up = deadline_exceeded(calld, error);
+  }
+  finish_group(chand, calld);
+  GRPC_CLOSURE_RUN(calld->original_recv_trailing_metadata_ready,
+                   GRPC_ERROR_REF(error));
+}
+
+static void intercept_leader_recv_ops(call_data* calld,
+                                      grpc_transport_stream_op_batch* batch) {
+  if (batch->recv_initial_metadata) {
+    calld->recv_initial_metadata =
+        batch->payload->recv_initial_metadata.recv_initial_metadata;
+    calld->original_recv_initial_metadata_ready =
+        batch->payload->recv_initial_metadata.recv_initial_metadata_ready;
+    batch->payload->recv_initial_metadata.recv_initial_metadata_ready =
+        &calld->recv_initial_metadata_ready;
+  }
+  // Only the first message is handed to the followers.
+  if (batch->recv_message && !calld->recv_message_seen) {
+    calld->recv_message_seen = true;
+    calld->recv_message = batch->payload->recv_message.recv_message;
+    calld->original_recv_message_ready =
+        batch->payload->recv_message.recv_message_ready;
+    batch->payload->recv_message.recv_message_ready =
+        &calld->recv_message_ready;
+  }
+  if (batch->recv_trailing_metadata) {
+    calld->recv_trailing_metadata =
+        batch->payload->recv_trailing_metadata.recv_trailing_metadata;
+    calld->original_recv_trailing_metadata_ready =
+        batch->payload->recv_trailing_metadata.recv_trailing_metadata_ready;
+    batch->payload->recv_trailing_metadata.recv_trailing_metadata_ready =
+        &calld->recv_trailing_metadata_ready;
+  }
+}
+
+//
+// follower
+//
+
+static void add_metadata_copies(gpr_arena* arena, const mdelem_list& mds,
+                                grpc_metadata_batch* batch) {
+  if (mds.size() == 0) return;
+  grpc_linked_mdelem* storage = static_cast<grpc_linked_mdelem*>(
+      gpr_arena_alloc(arena, sizeof(grpc_linked_mdelem) * mds.size()));
+  for (size_t i = 0; i < mds.size(); ++i) {
+    GRPC_LOG_IF_ERROR(
+        "coalesced metadata",
+        grpc_metadata_batch_add_tail(batch, &storage[i],
+                                     GRPC_MDELEM_REF(mds[i])));
+  }
+}
+
+// Adds to \a closures the completion of the held batch and of the recv ops
+// that are waiting for the leader's response, if it is available, or for the
+// call's cancellation.
+static void complete_pending_ops(call_data* calld,
+                                 grpc_core::CallCombinerClosureList* closures) {
+  const bool cancelled = calld->cancel_error != GRPC_ERROR_NONE;
+  if (!cancelled && !calld->response_available) return;
+  call_group* group = calld->group.get();
+  if (calld->held_batch != nullptr) {
+    grpc_transport_stream_op_batch* batch = calld->held_batch;
+    calld->held_batch = nullptr;
+    batch->payload->send_message.send_message.reset();
+    closures->Add(batch->on_complete, GRPC_ERROR_REF(calld->cancel_error),
+                  "coalesced on_complete");
+  }
+  if (calld->pending_recv_initial_metadata != nullptr) {
+    auto* payload =
+        &calld->pending_recv_initial_metadata->payload->recv_initial_metadata;
+    calld->pending_recv_initial_metadata = nullptr;
+    if (!cancelled) {
+      add_metadata_copies(calld->arena, group->initial_metadata,
+                          payload->recv_initial_metadata);
+    }
+    closures->Add(payload->recv_initial_metadata_ready,
+                  GRPC_ERROR_REF(calld->cancel_error),
+                  "coalesced recv_initial_metadata_ready");
+  }
+  if (calld->pending_recv_message != nullptr) {
+    auto* payload = &calld->pending_recv_message->payload->recv_message;
+    calld->pending_recv_message = nullptr;
+    if (!cancelled && group->has_message && !calld->message_delivered) {
+      calld->message_delivered = true;
+      grpc_slice_buffer copy;
+      grpc_slice_buffer_init(&copy);
+      for (size_t i = 0; i < group->message.count; ++i) {
+        grpc_slice_buffer_add(
+            &copy, grpc_slice_ref_internal(group->message.slices[i]));
+      }
+      calld->recv_message_replacement.Init(&copy, group->message_flags);
+      payload->recv_message->reset(calld->recv_message_replacement.get());
+      grpc_slice_buffer_destroy_internal(&copy);
+    } else {
+      payload->recv_message->reset();
+    }
+    closures->Add(payload->recv_message_ready,
+                  GRPC_ERROR_REF(calld->cancel_error),
+                  "coalesced recv_message_ready");
+  }
+  if (calld->pending_recv_trailing_metadata != nullptr) {
+    auto* payload = &calld->pending_recv_trailing_metadata->payload
+                         ->recv_trailing_metadata;
+    calld->pending_recv_trailing_metadata = nullptr;
+    grpc_error* error;
+    if (cancelled) {
+      error = GRPC_ERROR_REF(calld->cancel_error);
+    } else {
+      add_metadata_copies(calld->arena, group->trailing_metadata,
+                          payload->recv_trailing_metadata);
+      error = GRPC_ERROR_REF(group->error);
+    }
+    closures->Add(payload->recv_trailing_metadata_ready, error,
+                  "coalesced recv_trailing_metadata_ready");
+  }
+}
+
+static void reissue_batch(void* arg, grpc_error* ignored) {
+  grpc_transport_stream_op_batch* batch =
+      static_cast<grpc_transport_stream_op_batch*>(arg);
+  grpc_call_element* elem =
+      static_cast<grpc_call_element*>(batch->handler_private.extra_arg);
+  grpc_call_next_op(elem, batch);
+}
+
+// Sends down the held batch and the pending recv ops of a follower whose
+// leader gave up: from then on the call is sent as if it was never
+// coalesced.
+static void reissue_follower(grpc_call_element* elem) {
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  calld->role = PASS_THROUGH;
+  grpc_transport_stream_op_batch* batches[] = {
+      calld->held_batch, calld->pending_recv_initial_metadata,
+      calld->pending_recv_message, calld->pending_recv_trailing_metadata};
+  calld->held_batch = nullptr;
+  calld->pending_recv_initial_metadata = nullptr;
+  calld->pending_recv_message = nullptr;
+  calld->pending_recv_trailing_metadata = nullptr;
+  grpc_core::CallCombinerClosureList closures;
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(batches); ++i) {
+    grpc_transport_stream_op_batch* batch = batches[i];
+    bool seen = batch == nullptr;
+    for (size_t j = 0; j < i && !seen; ++j) seen = batches[j] == batch;
+    if (seen) continue;
+    batch->handler_private.extra_arg = elem;
+    GRPC_CLOSURE_INIT(&batch->handler_private.closure, reissue_batch, batch,
+                      grpc_schedule_on_exec_ctx);
+    closures.Add(&batch->handler_private.closure, GRPC_ERROR_NONE,
+                 "reissuing coalesced call");
+  }
+  closures.RunClosures(calld->call_combiner);
+}
+
+// Runs in the follower's call combiner once the leader finished. A follower
+// only fails on its own deadline or cancellation: if the leader gave up, the
+// follower is sent instead.
+static void deliver_group_result(void* arg, grpc_error* error) {
+  grpc_call_element* elem = static_cast<grpc_call_element*>(arg);
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  if (calld->group->leader_gave_up && calld->cancel_error == GRPC_ERROR_NONE) {
+    reissue_follower(elem);
+  } else {
+    calld->response_available = true;
+    grpc_core::CallCombinerClosureList closures;
+    complete_pending_ops(calld, &closures);
+    closures.RunClosures(calld->call_combiner);
+  }
+  GRPC_CALL_STACK_UNREF(calld->owning_call, "coalesced response");
+}
+
+// Followers send nothing unless their leader gives up: their first batch is
+// held and completes when the leader finishes, later send ops complete right
+// away, and their recv ops wait for the leader's response.
+static void follower_start_batch(grpc_call_element* elem,
+                                 grpc_transport_stream_op_batch* batch) {
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  if (calld->cancel_error != GRPC_ERROR_NONE) {
+    grpc_transport_stream_op_batch_finish_with_failure(
+        batch, GRPC_ERROR_REF(calld->cancel_error), calld->call_combiner);
+    return;
+  }
+  // The first batch carries the whole request.
+  const bool hold = batch->send_initial_metadata;
+  if (hold) {
+    calld->held_batch = batch;
+  } else if (batch->send_message) {
+    batch->payload->send_message.send_message.reset();
+  }
+  if (batch->recv_initial_metadata) {
+    calld->pending_recv_initial_metadata = batch;
+  }
+  if (batch->recv_message) calld->pending_recv_message = batch;
+  if (batch->recv_trailing_metadata) {
+    calld->pending_recv_trailing_metadata = batch;
+  }
+  grpc_core::CallCombinerClosureList closures;
+  complete_pending_ops(calld, &closures);
+  if (!hold && batch->on_complete != nullptr) {
+    closures.Add(batch->on_complete, GRPC_ERROR_NONE, "coalesced on_complete");
+  }
+  closures.RunClosures(calld->call_combiner);
+}
+
+//
+// reading the request message
+//
+
+static void send_message_on_complete(void* arg, grpc_error* error) {
+  grpc_call_element* elem = static_cast<grpc_call_element*>(arg);
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  calld->send_message_cache.Destroy();
+  GRPC_CLOSURE_RUN(calld->original_send_message_on_complete,
+                   GRPC_ERROR_REF(error));
+}
+
+// Pulls a slice from the send_message byte stream, updating
+// calld->send_message_bytes_read.
+static grpc_error* pull_slice_from_send_message(call_data* calld) {
+  grpc_slice incoming_slice;
+  grpc_error* error = calld->send_message_caching_stream->Pull(&incoming_slice);
+  if (error == GRPC_ERROR_NONE) {
+    calld->send_message_bytes_read += GRPC_SLICE_LENGTH(incoming_slice);
+    grpc_slice_unref_internal(incoming_slice);
+  }
+  return error;
+}
+
+// Reads as many slices as possible from the send_message byte stream. Upon
+// successful return, if calld->send_message_bytes_read ==
+// calld->send_message_caching_stream->length(), then we have completed
+// reading from the byte stream; otherwise, an async read has been dispatched
+// and on_send_message_next_done() will be invoked when it is complete.
+static grpc_error* read_all_available_send_message_data(call_data* calld) {
+  while (calld->send_message_bytes_read <
+             calld->send_message_caching_stream->length() &&
+         calld->send_message_caching_stream->Next(
+             SIZE_MAX, &calld->on_send_message_next_done)) {
+    grpc_error* error = pull_slice_from_send_message(calld);
+    if (error != GRPC_ERROR_NONE) return error;
+  }
+  return GRPC_ERROR_NONE;
+}
+
+// Async callback for ByteStream::Next(). The request was not available
+// synchronously, so the call is not coalesced: reset the byte stream and
+// send the batch down as-is.
+static void on_send_message_next_done(void* arg, grpc_error* error) {
+  grpc_call_element* elem = static_cast<grpc_call_element*>(arg);
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  if (error != GRPC_ERROR_NONE) {
+    grpc_transport_stream_op_batch_finish_with_failure(
+        calld->send_message_batch, GRPC_ERROR_REF(error),
+        calld->call_combiner);
+    return;
+  }
+  error = pull_slice_from_send_message(calld);
+  if (error != GRPC_ERROR_NONE) {
+    grpc_transport_stream_op_batch_finish_with_failure(
+        calld->send_message_batch, error, calld->call_combiner);
+    return;
+  }
+  calld->send_message_caching_stream->Reset();
+  grpc_call_next_op(elem, calld->send_message_batch);
+}
+
+// Reads the request of the first batch of a call to a coalescing method and
+// decides the call's role. Returns true if the batch has been taken care of.
+static bool start_coalescing(grpc_call_element* elem,
+                             grpc_transport_stream_op_batch* batch) {
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  // Only calls whose request is complete in their first batch are coalesced.
+  calld->role = PASS_THROUGH;
+  if (calld->cancel_error != GRPC_ERROR_NONE ||
+      !batch->send_initial_metadata || !batch->send_message ||
+      !batch->send_trailing_metadata) {
+    return false;
+  }
+  calld->send_message_cache.Init(
+      std::move(batch->payload->send_message.send_message));
+  calld->send_message_caching_stream.Init(calld->send_message_cache.get());
+  batch->payload->send_message.send_message.reset(
+      calld->send_message_caching_stream.get());
+  calld->original_send_message_on_complete = batch->on_complete;
+  batch->on_complete = &calld->send_message_on_complete;
+  calld->send_message_batch = batch;
+  grpc_error* error = read_all_available_send_message_data(calld);
+  if (error != GRPC_ERROR_NONE) {
+    grpc_transport_stream_op_batch_finish_with_failure(batch, error,
+                                                       calld->call_combiner);
+    return true;
+  }
+  if (calld->send_message_bytes_read <
+      calld->send_message_caching_stream->length()) {
+    return true;
+  }
+  join_group(elem, batch);
+  calld->send_message_caching_stream->Reset();
+  return false;
+}
+
+//
+// filter
+//
+
+static void start_transport_stream_op_batch(
+    grpc_call_element* elem, grpc_transport_stream_op_batch* batch) {
+  channel_data* chand = static_cast<channel_data*>(elem->channel_data);
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  if (batch->cancel_stream) {
+    GRPC_ERROR_UNREF(calld->cancel_error);
+    calld->cancel_error =
+        GRPC_ERROR_REF(batch->payload->cancel_stream.cancel_error);
+    if (calld->role == FOLLOWER) {
+      leave_group(chand, calld);
+      grpc_core::CallCombinerClosureList closures;
+      complete_pending_ops(calld, &closures);
+      closures.RunClosuresWithoutYielding(calld->call_combiner);
+    }
+    grpc_call_next_op(elem, batch);
+    return;
+  }
+  if (calld->role == UNDECIDED && start_coalescing(elem, batch)) return;
+  if (calld->role == FOLLOWER) {
+    follower_start_batch(elem, batch);
+    return;
+  }
+  if (calld->role == LEADER) intercept_leader_recv_ops(calld, batch);
+  grpc_call_next_op(elem, batch);
+}
+
+static grpc_error* init_call_elem(grpc_call_element* elem,
+                                  const grpc_call_element_args* args) {
+  channel_data* chand = static_cast<channel_data*>(elem->channel_data);
+  new (elem->call_data) call_data(elem, *chand, *args);
+  return GRPC_ERROR_NONE;
+}
+
+static void destroy_call_elem(grpc_call_element* elem,
+                              const grpc_call_final_info* final_info,
+                              grpc_closure* ignored) {
+  channel_data* chand = static_cast<channel_data*>(elem->channel_data);
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  if (calld->role == FOLLOWER) {
+    leave_group(chand, calld);
+  } else if (calld->role == LEADER && !calld->group_finished) {
+    // The leader never asked for its status.
+    calld->group->leader_gave_up = true;
+    finish_group(chand, calld);
+  }
+  calld->~call_data();
+}
+
+static grpc_error* init_channel_elem(grpc_channel_element* elem,
+                                     grpc_channel_element_args* args) {
+  GPR_ASSERT(!args->is_last);
+  channel_data* chand = new (elem->channel_data) channel_data();
+  const grpc_arg* channel_arg =
+      grpc_channel_args_find(args->channel_args, GRPC_ARG_SERVICE_CONFIG);
+  const char* service_config_str = grpc_channel_arg_get_string(channel_arg);
+  if (service_config_str != nullptr) {
+    grpc_core::UniquePtr<grpc_core::ServiceConfig> service_config =
+        grpc_core::ServiceConfig::Create(service_config_str);
+    if (service_config != nullptr) {
+      chand->method_params_table = service_config->CreateMethodConfigTable(
+          grpc_core::CoalescingMethodParams::CreateFromJson);
+    }
+  }
+  return GRPC_ERROR_NONE;
+}
+
+static void destroy_channel_elem(grpc_channel_element* elem) {
+  channel_data* chand = static_cast<channel_data*>(elem->channel_data);
+  chand->~channel_data();
+}
+
+const grpc_channel_filter grpc_request_coalescing_filter = {
+    start_transport_stream_op_batch,
+    grpc_channel_next_op,
+    sizeof(call_data),
+    init_call_elem,
+    grpc_call_stack_ignore_set_pollset_or_pollset_set,
+    destroy_call_elem,
+    sizeof(channel_data),
+    init_channel_elem,
+    destroy_channel_elem,
+    grpc_channel_next_get_info,
+    "request_coalescing"};
+
+static bool maybe_add_request_coalescing_filter(
+    grpc_channel_stack_builder* builder, void* arg) {
+  const grpc_channel_args* channel_args =
+      grpc_channel_stack_builder_get_channel_arguments(builder);
+  if (grpc_channel_args_want_minimal_stack(channel_args) ||
+      !grpc_channel_arg_get_bool(
+          grpc_channel_args_find(channel_args,
+                                 GRPC_ARG_ENABLE_REQUEST_COALESCING),
+          false) ||
+      grpc_channel_args_find(channel_args, GRPC_ARG_SERVICE_CONFIG) ==
+          nullptr) {
+    return true;
+  }
+  return grpc_channel_stack_builder_prepend_filter(
+      builder, &grpc_request_coalescing_filter, nullptr, nullptr);
+}
+
+void grpc_register_request_coalescing_filter() {
+  grpc_channel_init_register_stage(GRPC_CLIENT_SUBCHANNEL,
+                                   GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
+                                   maybe_add_request_coalescing_filter,
+                                   nullptr);
+  grpc_channel_init_register_stage(GRPC_CLIENT_DIRECT_CHANNEL,
+                                   GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
+                                   maybe_add_request_coalescing_filter,
+                                   nullptr);
+}
@@ -0,0 +1,47 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_REQUEST_COALESCING_FILTER_H
+#define GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_REQUEST_COALESCING_FILTER_H
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/channel/channel_stack.h"
+
+// Lets identical unary calls that are in flight at the same time share one
+// RPC. Enabled by GRPC_ARG_ENABLE_REQUEST_COALESCING, for the methods that
+// the service config marks with:
+//   "coalesceRequests": bool
+//
+// The first call for a given authority, method and request payload (the
+// leader) is sent as usual. Identical calls started before it completes
+// (the followers) are not sent at all: they get a copy of the leader's
+// initial metadata, response message and status. Each follower keeps its
+// request until the leader finishes, and sends it itself if the leader was
+// cancelled or failed with DEADLINE_EXCEEDED, so a follower only fails on
+// its own deadline or cancellation.
+//
+// The filter sits below the load balancing policy, in the subchannel and
+// direct channel stacks, so only calls sent on the same connection are
+// coalesced.
+extern const grpc_channel_filter grpc_request_coalescing_filter;
+
+/// Registers the filter in the client channel stacks.
+void grpc_register_request_coalescing_filter();
+
+#endif /* GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_REQUEST_COALESCING_FILTER_H */
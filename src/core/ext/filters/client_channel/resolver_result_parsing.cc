@@ -248,38 +248,6 @@ bool ParseWaitForReady(
   return true;
 }
 
-// Parses a JSON field of the form generated for a google.proto.Duration
-// proto message, as per:
-//   https://developers.google.com/protocol-buffers/docs/proto3#json
-bool ParseDuration(grpc_json* field, grpc_millis* duration) {
-  if (field->type != GRPC_JSON_STRING) return false;
-  size_t len = strlen(field->value);
-  if (field->value[len - 1] != 's') return false;
-  UniquePtr<char> buf(gpr_strdup(field->value));
-  *(buf.get() + len - 1) = '\0';  // Remove trailing 's'.
-  char* decimal_point = strchr(buf.get(), '.');
-  int nanos = 0;
-  if (decimal_point != nullptr) {
-    *decimal_point = '\0';
-    nanos = gpr_parse_nonnegative_int(decimal_point + 1);
-    if (nanos == -1) {
-      return false;
-    }
-    int num_digits = static_cast<int>(strlen(decimal_point + 1));
-    if (num_digits > 9) {  // We don't accept greater precision than nanos.
-      return false;
-    }
-    for (int i = 0; i < (9 - num_digits); ++i) {
-      nanos *= 10;
-    }
-  }
-  int seconds =
-      decimal_point == buf.get() ? 0 : gpr_parse_nonnegative_int(buf.get());
-  if (seconds == -1) return false;
-  *duration = seconds * GPR_MS_PER_SEC + nanos / GPR_NS_PER_MS;
-  return true;
-}
-
 UniquePtr<ClientChannelMethodParams::RetryPolicy> ParseRetryPolicy(
     grpc_json* field) {
   auto retry_policy = MakeUnique<ClientChannelMethodParams::RetryPolicy>();
@@ -300,13 +268,15 @@ UniquePtr<ClientChannelMethodParams::RetryPolicy> ParseRetryPolicy(
       }
     } else if (strcmp(sub_field->key, "initialBackoff") == 0) {
       if (retry_policy->initial_backoff > 0) return nullptr;  // Duplicate.
-      if (!ParseDuration(sub_field, &retry_policy->initial_backoff)) {
+      if (!ServiceConfig::ParseJsonDuration(sub_field,
+                                            &retry_policy->initial_backoff)) {
         return nullptr;
       }
       if (retry_policy->initial_backoff == 0) return nullptr;
     } else if (strcmp(sub_field->key, "maxBackoff") == 0) {
       if (retry_policy->max_backoff > 0) return nullptr;  // Duplicate.
-      if (!ParseDuration(sub_field, &retry_policy->max_backoff)) {
+      if (!ServiceConfig::ParseJsonDuration(sub_field,
+                                            &retry_policy->max_backoff)) {
         return nullptr;
       }
       if (retry_policy->max_backoff == 0) return nullptr;
@@ -361,7 +331,9 @@ ClientChannelMethodParams::CreateFromJson(const grpc_json* json) {
       }
     } else if (strcmp(field->key, "timeout") == 0) {
       if (method_params->timeout_ > 0) return nullptr;  // Duplicate.
-      if (!ParseDuration(field, &method_params->timeout_)) return nullptr;
+      if (!ServiceConfig::ParseJsonDuration(field, &method_params->timeout_)) {
+        return nullptr;
+      }
     } else if (strcmp(field->key, "retryPolicy") == 0) {
       if (method_params->retry_policy_ != nullptr) {
         return nullptr;  // Duplicate.
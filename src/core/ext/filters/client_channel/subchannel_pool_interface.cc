@@ -20,6 +20,9 @@
 
 #include "src/core/ext/filters/client_channel/subchannel_pool_interface.h"
 
+#include <string.h>
+
+#include "src/core/lib/gpr/murmur_hash.h"
 #include "src/core/lib/gpr/useful.h"
 
 // The subchannel pool to reuse subchannels.
@@ -31,6 +34,35 @@ namespace grpc_core {
 
 TraceFlag grpc_subchannel_pool_trace(false, "subchannel_pool");
 
+namespace {
+
+// Must be consistent with grpc_channel_args_compare(). Pointer args are
+// compared through their vtable, so only their key and type are hashed.
+uint32_t HashChannelArgs(const grpc_channel_args* args) {
+  if (args == nullptr) return 0;
+  uint32_t hash = static_cast<uint32_t>(args->num_args);
+  for (size_t i = 0; i < args->num_args; ++i) {
+    const grpc_arg& arg = args->args[i];
+    hash = gpr_murmur_hash3(arg.key, strlen(arg.key), hash);
+    hash = gpr_murmur_hash3(&arg.type, sizeof(arg.type), hash);
+    switch (arg.type) {
+      case GRPC_ARG_STRING:
+        hash = gpr_murmur_hash3(arg.value.string, strlen(arg.value.string),
+                                hash);
+        break;
+      case GRPC_ARG_INTEGER:
+        hash = gpr_murmur_hash3(&arg.value.integer, sizeof(arg.value.integer),
+                                hash);
+        break;
+      case GRPC_ARG_POINTER:
+        break;
+    }
+  }
+  return hash;
+}
+
+}  // namespace
+
 SubchannelKey::SubchannelKey(const grpc_channel_args* args) {
   Init(args, grpc_channel_args_normalize);
 }
@@ -40,12 +72,14 @@ SubchannelKey::~SubchannelKey() {
 }
 
 SubchannelKey::SubchannelKey(const SubchannelKey& other) {
-  Init(other.args_, grpc_channel_args_copy);
+  args_ = grpc_channel_args_copy(other.args_);
+  hash_ = other.hash_;
 }
 
 SubchannelKey& SubchannelKey::operator=(const SubchannelKey& other) {
   grpc_channel_args_destroy(const_cast<grpc_channel_args*>(args_));
-  Init(other.args_, grpc_channel_args_copy);
+  args_ = grpc_channel_args_copy(other.args_);
+  hash_ = other.hash_;
   return *this;
 }
 
@@ -57,6 +91,7 @@ void SubchannelKey::Init(
     const grpc_channel_args* args,
     grpc_channel_args* (*copy_channel_args)(const grpc_channel_args* args)) {
   args_ = copy_channel_args(args);
+  hash_ = HashChannelArgs(args_);
 }
 
 namespace {
@@ -47,6 +47,11 @@ class SubchannelKey {
 
   int Cmp(const SubchannelKey& other) const;
 
+  // A hash of the normalized channel args, computed once at construction.
+  // Keys that compare equal have equal hashes, so pools can look keys up by
+  // hash and only run the full Cmp() on a hash match.
+  uint32_t hash() const { return hash_; }
+
  private:
   // Initializes the subchannel key with the given \a args and the function to
   // copy channel args.
@@ -55,6 +60,7 @@ class SubchannelKey {
       grpc_channel_args* (*copy_channel_args)(const grpc_channel_args* args));
 
   const grpc_channel_args* args_;
+  uint32_t hash_;
 };
 
 // Interface for subchannel pool.
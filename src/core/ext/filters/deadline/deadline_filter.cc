@@ -27,7 +27,6 @@
 #include <grpc/support/time.h>
 
 #include "src/core/lib/channel/channel_stack_builder.h"
-#include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/surface/channel_init.h"
@@ -150,59 +149,23 @@ static void inject_recv_trailing_metadata_ready(
       &deadline_state->recv_trailing_metadata_ready;
 }
 
-// Callback and associated state for starting the timer after call stack
-// initialization has been completed.
-struct start_timer_after_init_state {
-  start_timer_after_init_state(grpc_call_element* elem, grpc_millis deadline)
-      : elem(elem), deadline(deadline) {}
-  ~start_timer_after_init_state() { start_timer_if_needed(elem, deadline); }
-
-  bool in_call_combiner = false;
-  grpc_call_element* elem;
-  grpc_millis deadline;
-  grpc_closure closure;
-};
-static void start_timer_after_init(void* arg, grpc_error* error) {
-  struct start_timer_after_init_state* state =
-      static_cast<struct start_timer_after_init_state*>(arg);
-  grpc_deadline_state* deadline_state =
-      static_cast<grpc_deadline_state*>(state->elem->call_data);
-  if (!state->in_call_combiner) {
-    // We are initially called without holding the call combiner, so we
-    // need to bounce ourselves into it.
-    state->in_call_combiner = true;
-    GRPC_CALL_COMBINER_START(deadline_state->call_combiner, &state->closure,
-                             GRPC_ERROR_REF(error),
-                             "scheduling deadline timer");
-    return;
-  }
-  grpc_core::Delete(state);
-  GRPC_CALL_COMBINER_STOP(deadline_state->call_combiner,
-                          "done scheduling deadline timer");
-}
-
+// Deadline will always be infinite on servers, so the timer will only be
+// set on clients with a finite deadline.
+// When the deadline passes, we indicate the failure by sending down an op
+// with cancel_error set.  However, we can't send down any ops until after
+// the call stack is fully initialized.  If we start the timer here, we have
+// no guarantee that the timer won't pop before call stack initialization is
+// finished.  To avoid that problem, the timer is started by the first batch
+// of the call, which runs after call stack initialization is done and
+// already holds the call combiner, rather than by a closure scheduled from
+// here that would need an allocation and a trip through the call combiner.
 grpc_deadline_state::grpc_deadline_state(grpc_call_element* elem,
                                          grpc_call_stack* call_stack,
                                          grpc_call_combiner* call_combiner,
                                          grpc_millis deadline)
-    : call_stack(call_stack), call_combiner(call_combiner) {
-  // Deadline will always be infinite on servers, so the timer will only be
-  // set on clients with a finite deadline.
-  if (deadline != GRPC_MILLIS_INF_FUTURE) {
-    // When the deadline passes, we indicate the failure by sending down
-    // an op with cancel_error set.  However, we can't send down any ops
-    // until after the call stack is fully initialized.  If we start the
-    // timer here, we have no guarantee that the timer won't pop before
-    // call stack initialization is finished.  To avoid that problem, we
-    // create a closure to start the timer, and we schedule that closure
-    // to be run after call stack initialization is done.
-    struct start_timer_after_init_state* state =
-        grpc_core::New<start_timer_after_init_state>(elem, deadline);
-    GRPC_CLOSURE_INIT(&state->closure, start_timer_after_init, state,
-                      grpc_schedule_on_exec_ctx);
-    GRPC_CLOSURE_SCHED(&state->closure, GRPC_ERROR_NONE);
-  }
-}
+    : call_stack(call_stack),
+      call_combiner(call_combiner),
+      pending_deadline(deadline) {}
 
 grpc_deadline_state::~grpc_deadline_state() { cancel_timer_if_needed(this); }
 
@@ -210,6 +173,7 @@ void grpc_deadline_state_reset(grpc_call_element* elem,
                                grpc_millis new_deadline) {
   grpc_deadline_state* deadline_state =
       static_cast<grpc_deadline_state*>(elem->call_data);
+  deadline_state->pending_deadline = GRPC_MILLIS_INF_FUTURE;
   cancel_timer_if_needed(deadline_state);
   start_timer_if_needed(elem, new_deadline);
 }
@@ -219,8 +183,13 @@ void grpc_deadline_state_client_start_transport_stream_op_batch(
   grpc_deadline_state* deadline_state =
       static_cast<grpc_deadline_state*>(elem->call_data);
   if (op->cancel_stream) {
+    deadline_state->pending_deadline = GRPC_MILLIS_INF_FUTURE;
     cancel_timer_if_needed(deadline_state);
   } else {
+    if (deadline_state->pending_deadline != GRPC_MILLIS_INF_FUTURE) {
+      start_timer_if_needed(elem, deadline_state->pending_deadline);
+      deadline_state->pending_deadline = GRPC_MILLIS_INF_FUTURE;
+    }
     // Make sure we know when the call is complete, so that we can cancel
     // the timer.
     if (op->recv_trailing_metadata) {
@@ -39,6 +39,9 @@ struct grpc_deadline_state {
   grpc_call_stack* call_stack;
   grpc_call_combiner* call_combiner;
   grpc_deadline_timer_state timer_state = GRPC_DEADLINE_STATE_INITIAL;
+  // The deadline of a client call whose timer has not been started yet.
+  // The timer is started by the first batch of the call.
+  grpc_millis pending_deadline = GRPC_MILLIS_INF_FUTURE;
   grpc_timer timer;
   grpc_closure timer_callback;
   // Closure to invoke when we receive trailing metadata.
@@ -74,9 +74,6 @@ static bool input_is_valid(uint8_t* input_ptr, size_t length) {
   (uint8_t)((decode_table[input_ptr[1]] << 4) | \
             (decode_table[input_ptr[2]] >> 2))
 
-#define COMPOSE_OUTPUT_BYTE_2(input_ptr) \
-  (uint8_t)((decode_table[input_ptr[2]] << 6) | decode_table[input_ptr[3]])
-
 // By RFC 4648, if the length of the encoded string without padding is 4n+r,
 // the length of decoded string is: 1) 3n if r = 0, 2) 3n + 1 if r = 2, 3, or
 // 3) invalid if r = 1.
@@ -110,13 +107,23 @@ bool grpc_base64_decode_partial(struct grpc_base64_decode_context* ctx) {
     return false;
   }
 
-  // Process a block of 4 input characters and 3 output bytes
+  // Process blocks of 4 input characters and 3 output bytes. The 6 bit values
+  // of a block are validated together and merged into one 24 bit word.
   while (ctx->input_end >= ctx->input_cur + 4 &&
          ctx->output_end >= ctx->output_cur + 3) {
-    if (!input_is_valid(ctx->input_cur, 4)) return false;
-    ctx->output_cur[0] = COMPOSE_OUTPUT_BYTE_0(ctx->input_cur);
-    ctx->output_cur[1] = COMPOSE_OUTPUT_BYTE_1(ctx->input_cur);
-    ctx->output_cur[2] = COMPOSE_OUTPUT_BYTE_2(ctx->input_cur);
+    const uint8_t* in = ctx->input_cur;
+    uint32_t a = decode_table[in[0]];
+    uint32_t b = decode_table[in[1]];
+    uint32_t c = decode_table[in[2]];
+    uint32_t d = decode_table[in[3]];
+    if (GPR_UNLIKELY(((a | b | c | d) & 0xC0) != 0)) {
+      // Logs the offending character and fails.
+      return input_is_valid(ctx->input_cur, 4);
+    }
+    uint32_t word = (a << 18) | (b << 12) | (c << 6) | d;
+    ctx->output_cur[0] = static_cast<uint8_t>(word >> 16);
+    ctx->output_cur[1] = static_cast<uint8_t>(word >> 8);
+    ctx->output_cur[2] = static_cast<uint8_t>(word);
     ctx->output_cur += 3;
     ctx->input_cur += 4;
   }
@@ -58,12 +58,14 @@ grpc_slice grpc_chttp2_base64_encode(grpc_slice input) {
   char* out = reinterpret_cast<char*> GRPC_SLICE_START_PTR(output);
   size_t i;
 
-  /* encode full triplets */
+  /* encode full triplets, each as a 24 bit word */
   for (i = 0; i < input_triplets; i++) {
-    out[0] = alphabet[in[0] >> 2];
-    out[1] = alphabet[((in[0] & 0x3) << 4) | (in[1] >> 4)];
-    out[2] = alphabet[((in[1] & 0xf) << 2) | (in[2] >> 6)];
-    out[3] = alphabet[in[2] & 0x3f];
+    uint32_t word = (static_cast<uint32_t>(in[0]) << 16) |
+                    (static_cast<uint32_t>(in[1]) << 8) | in[2];
+    out[0] = alphabet[word >> 18];
+    out[1] = alphabet[(word >> 12) & 0x3f];
+    out[2] = alphabet[(word >> 6) & 0x3f];
+    out[3] = alphabet[word & 0x3f];
     out += 4;
     in += 3;
   }
@@ -166,6 +168,42 @@ static void enc_add1(huff_out* out, uint8_t a) {
   enc_flush_some(out);
 }
 
+/* Appends the huffman codes of the four base64 symbols of a 24 bit word to the
+   |*bits| pending bits of |*acc|. */
+static void enc_add_word(uint64_t* acc, uint32_t* bits, uint32_t word) {
+  b64_huff_sym s0 = huff_alphabet[word >> 18];
+  b64_huff_sym s1 = huff_alphabet[(word >> 12) & 0x3f];
+  b64_huff_sym s2 = huff_alphabet[(word >> 6) & 0x3f];
+  b64_huff_sym s3 = huff_alphabet[word & 0x3f];
+  uint64_t a = *acc;
+  a = (a << s0.length) | s0.bits;
+  a = (a << s1.length) | s1.bits;
+  a = (a << s2.length) | s2.bits;
+  a = (a << s3.length) | s3.bits;
+  *acc = a;
+  *bits += static_cast<uint32_t>(s0.length) + s1.length + s2.length +
+           s3.length;
+}
+
+/* Writes the whole bytes of the |*bits| (at least 1) pending bits of |*acc|.
+   Always stores 8 bytes, of which only the whole ones are kept, so |*out|
+   needs 8 bytes of room. */
+static void enc_flush_word(uint64_t* acc, uint32_t* bits, uint8_t** out) {
+  uint64_t w = *acc << (64 - *bits);
+  uint8_t* p = *out;
+  p[0] = static_cast<uint8_t>(w >> 56);
+  p[1] = static_cast<uint8_t>(w >> 48);
+  p[2] = static_cast<uint8_t>(w >> 40);
+  p[3] = static_cast<uint8_t>(w >> 32);
+  p[4] = static_cast<uint8_t>(w >> 24);
+  p[5] = static_cast<uint8_t>(w >> 16);
+  p[6] = static_cast<uint8_t>(w >> 8);
+  p[7] = static_cast<uint8_t>(w);
+  *out = p + (*bits >> 3);
+  *bits &= 7;
+  *acc &= (uint64_t(1) << *bits) - 1;
+}
+
 grpc_slice grpc_chttp2_base64_encode_and_huffman_compress(grpc_slice input) {
   size_t input_length = GRPC_SLICE_LENGTH(input);
   size_t input_triplets = input_length / 3;
@@ -173,28 +211,31 @@ grpc_slice grpc_chttp2_base64_encode_and_huffman_compress(grpc_slice input) {
   size_t output_syms = input_triplets * 4 + tail_xtra[tail_case];
   size_t max_output_bits = 11 * output_syms;
   size_t max_output_length = max_output_bits / 8 + (max_output_bits % 8 != 0);
-  grpc_slice output = GRPC_SLICE_MALLOC(max_output_length);
+  /* 8 spare bytes for the word stores of enc_flush_word */
+  grpc_slice output = GRPC_SLICE_MALLOC(max_output_length + 8);
   uint8_t* in = GRPC_SLICE_START_PTR(input);
   uint8_t* start_out = GRPC_SLICE_START_PTR(output);
   huff_out out;
   size_t i;
 
-  out.temp = 0;
-  out.temp_length = 0;
-  out.out = start_out;
-
-  /* encode full triplets */
+  /* encode full triplets a block at a time: the (at most 44) bits of a
+     triplet's four symbols go into a 64 bit accumulator holding less than a
+     byte, whose whole bytes are then written with a single word store */
+  uint64_t acc = 0;
+  uint32_t acc_bits = 0;
+  uint8_t* block_out = start_out;
   for (i = 0; i < input_triplets; i++) {
-    const uint8_t low_to_high = static_cast<uint8_t>((in[0] & 0x3) << 4);
-    const uint8_t high_to_low = in[1] >> 4;
-    enc_add2(&out, in[0] >> 2, low_to_high | high_to_low);
-
-    const uint8_t a = static_cast<uint8_t>((in[1] & 0xf) << 2);
-    const uint8_t b = (in[2] >> 6);
-    enc_add2(&out, a | b, in[2] & 0x3f);
+    uint32_t word = (static_cast<uint32_t>(in[0]) << 16) |
+                    (static_cast<uint32_t>(in[1]) << 8) | in[2];
+    enc_add_word(&acc, &acc_bits, word);
+    enc_flush_word(&acc, &acc_bits, &block_out);
     in += 3;
   }
 
+  out.temp = static_cast<uint32_t>(acc);
+  out.temp_length = acc_bits;
+  out.out = block_out;
+
   /* encode the remaining bytes */
   switch (tail_case) {
     case 0:
@@ -38,6 +38,7 @@
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 #include "src/core/lib/transport/metadata.h"
+#include "src/core/lib/transport/registered_metadata.h"
 #include "src/core/lib/transport/static_metadata.h"
 #include "src/core/lib/transport/timeout_encoding.h"
 
@@ -220,6 +221,12 @@ static void add_key_with_index(grpc_chttp2_hpack_compressor* c,
     return;
   }
 
+  if (GRPC_IS_REGISTERED_METADATA_STRING(GRPC_MDKEY(elem))) {
+    c->indices_registered_keys[GRPC_REGISTERED_METADATA_INDEX(
+        GRPC_MDKEY(elem))] = new_index;
+    return;
+  }
+
   uint32_t key_hash = grpc_slice_hash(GRPC_MDKEY(elem));
 
   /* Store the key into {entries,indices}_keys */
@@ -519,13 +526,17 @@ static void hpack_enc(grpc_chttp2_hpack_compressor* c, grpc_mdelem elem,
 
   uint32_t indices_key;
 
-  /* should this elem be in the table? */
+  /* should this elem be in the table? the application registered the key
+     because it is sent on most calls, so don't wait for the popularity filter
+     to find that out */
+  const bool key_registered =
+      GRPC_IS_REGISTERED_METADATA_STRING(GRPC_MDKEY(elem));
   const size_t decoder_space_usage =
       grpc_chttp2_get_size_in_hpack_table(elem, st->use_true_binary_metadata);
-  const bool should_add_elem = elem_interned &&
-                               decoder_space_usage < MAX_DECODER_SPACE_USAGE &&
-                               c->filter_elems[HASH_FRAGMENT_1(elem_hash)] >=
-                                   c->filter_elems_sum / ONE_ON_ADD_PROBABILITY;
+  const bool should_add_elem =
+      elem_interned && decoder_space_usage < MAX_DECODER_SPACE_USAGE &&
+      (key_registered || c->filter_elems[HASH_FRAGMENT_1(elem_hash)] >=
+                             c->filter_elems_sum / ONE_ON_ADD_PROBABILITY);
 
   auto emit_maybe_add = [&should_add_elem, &elem, &st, &c, &indices_key,
                          &decoder_space_usage] {
@@ -538,22 +549,32 @@ static void hpack_enc(grpc_chttp2_hpack_compressor* c, grpc_mdelem elem,
   };
 
   /* no hits for the elem... maybe there's a key? */
-  indices_key = c->indices_keys[HASH_FRAGMENT_2(key_hash)];
-  if (grpc_slice_eq(c->entries_keys[HASH_FRAGMENT_2(key_hash)],
-                    GRPC_MDKEY(elem)) &&
-      indices_key > c->tail_remote_index) {
-    /* HIT: key (first cuckoo hash) */
-    emit_maybe_add();
-    return;
-  }
+  if (key_registered) {
+    indices_key = c->indices_registered_keys[GRPC_REGISTERED_METADATA_INDEX(
+        GRPC_MDKEY(elem))];
+    if (indices_key > c->tail_remote_index) {
+      /* HIT: registered key */
+      emit_maybe_add();
+      return;
+    }
+  } else {
+    indices_key = c->indices_keys[HASH_FRAGMENT_2(key_hash)];
+    if (grpc_slice_eq(c->entries_keys[HASH_FRAGMENT_2(key_hash)],
+                      GRPC_MDKEY(elem)) &&
+        indices_key > c->tail_remote_index) {
+      /* HIT: key (first cuckoo hash) */
+      emit_maybe_add();
+      return;
+    }
 
-  indices_key = c->indices_keys[HASH_FRAGMENT_3(key_hash)];
-  if (grpc_slice_eq(c->entries_keys[HASH_FRAGMENT_3(key_hash)],
-                    GRPC_MDKEY(elem)) &&
-      indices_key > c->tail_remote_index) {
-    /* HIT: key (first cuckoo hash) */
-    emit_maybe_add();
-    return;
+    indices_key = c->indices_keys[HASH_FRAGMENT_3(key_hash)];
+    if (grpc_slice_eq(c->entries_keys[HASH_FRAGMENT_3(key_hash)],
+                      GRPC_MDKEY(elem)) &&
+        indices_key > c->tail_remote_index) {
+      /* HIT: key (first cuckoo hash) */
+      emit_maybe_add();
+      return;
+    }
   }
 
   /* no elem, key in the table... fall back to literal emission */
@@ -577,13 +598,24 @@ static void hpack_enc(grpc_chttp2_hpack_compressor* c, grpc_mdelem elem,
 static void deadline_enc(grpc_chttp2_hpack_compressor* c, grpc_millis deadline,
                          framer_state* st) {
   char timeout_str[GRPC_HTTP2_TIMEOUT_ENCODE_MIN_BUFSIZE];
-  grpc_mdelem mdelem;
   grpc_http2_encode_timeout(deadline - grpc_core::ExecCtx::Get()->Now(),
                             timeout_str);
-  mdelem = grpc_mdelem_from_slices(GRPC_MDSTR_GRPC_TIMEOUT,
-                                   grpc_slice_from_copied_string(timeout_str));
-  hpack_enc(c, mdelem, st);
-  GRPC_MDELEM_UNREF(mdelem);
+  /* the encoding is coarse enough that consecutive calls with the same
+     timeout usually produce the same string, so look it up by value */
+  uint32_t hash = 0;
+  for (const char* p = timeout_str; *p != '\0'; p++) {
+    hash = hash * 31 + static_cast<uint8_t>(*p);
+  }
+  const uint32_t slot = hash % GRPC_CHTTP2_HPACKC_NUM_TIMEOUTS;
+  if (GRPC_MDISNULL(c->timeout_elems[slot]) ||
+      grpc_slice_str_cmp(GRPC_MDVALUE(c->timeout_elems[slot]), timeout_str) !=
+          0) {
+    GRPC_MDELEM_UNREF(c->timeout_elems[slot]);
+    c->timeout_elems[slot] = grpc_mdelem_from_slices(
+        GRPC_MDSTR_GRPC_TIMEOUT,
+        grpc_slice_intern(grpc_slice_from_static_string(timeout_str)));
+  }
+  hpack_enc(c, c->timeout_elems[slot], st);
 }
 
 static uint32_t elems_for_bytes(uint32_t bytes) { return (bytes + 31) / 32; }
@@ -611,6 +643,9 @@ void grpc_chttp2_hpack_compressor_destroy(grpc_chttp2_hpack_compressor* c) {
     }
     GRPC_MDELEM_UNREF(c->entries_elems[i]);
   }
+  for (i = 0; i < GRPC_CHTTP2_HPACKC_NUM_TIMEOUTS; i++) {
+    GRPC_MDELEM_UNREF(c->timeout_elems[i]);
+  }
   gpr_free(c->table_elem_size);
 }
 
@@ -26,6 +26,7 @@
 #include "src/core/ext/transport/chttp2/transport/frame.h"
 #include "src/core/lib/transport/metadata.h"
 #include "src/core/lib/transport/metadata_batch.h"
+#include "src/core/lib/transport/registered_metadata.h"
 #include "src/core/lib/transport/transport.h"
 
 // This should be <= 8. We use 6 to save space.
@@ -35,6 +36,8 @@
 #define GRPC_CHTTP2_HPACKC_INITIAL_TABLE_SIZE 4096
 /* maximum table size we'll actually use */
 #define GRPC_CHTTP2_HPACKC_MAX_TABLE_SIZE (1024 * 1024)
+/* number of recently sent grpc-timeout values to remember */
+#define GRPC_CHTTP2_HPACKC_NUM_TIMEOUTS 8
 
 extern grpc_core::TraceFlag grpc_http_trace;
 
@@ -67,6 +70,16 @@ typedef struct {
   grpc_mdelem entries_elems[GRPC_CHTTP2_HPACKC_NUM_VALUES];
   uint32_t indices_keys[GRPC_CHTTP2_HPACKC_NUM_VALUES];
   uint32_t indices_elems[GRPC_CHTTP2_HPACKC_NUM_VALUES];
+  /* the application's registered keys are not hashed into entries_keys, where
+     other keys could evict them: each has a slot of its own */
+  uint32_t indices_registered_keys[GRPC_REGISTERED_MDSTR_MAX];
+
+  /* interned grpc-timeout elems for recently sent timeout values, indexed by
+     a hash of the value: calls on a connection tend to use the same few
+     timeouts, so most of them reuse an elem instead of allocating a new one,
+     and since the elem is interned it can be indexed in the decoder's table
+     like any other popular header */
+  grpc_mdelem timeout_elems[GRPC_CHTTP2_HPACKC_NUM_TIMEOUTS];
 
   uint16_t* table_elem_size;
 } grpc_chttp2_hpack_compressor;
@@ -55,11 +55,14 @@ BackOff::BackOff(const Options& options)
 grpc_millis BackOff::NextAttemptTime() {
   if (initial_) {
     initial_ = false;
-    return current_backoff_ + grpc_core::ExecCtx::Get()->Now();
+    if (!options_.jitter_initial_backoff()) {
+      return current_backoff_ + grpc_core::ExecCtx::Get()->Now();
+    }
+  } else {
+    current_backoff_ = static_cast<grpc_millis>(
+        std::min(current_backoff_ * options_.multiplier(),
+                 static_cast<double>(options_.max_backoff())));
   }
-  current_backoff_ = static_cast<grpc_millis>(
-      std::min(current_backoff_ * options_.multiplier(),
-               static_cast<double>(options_.max_backoff())));
   const double jitter = generate_uniform_random_number_between(
       &rng_state_, -options_.jitter() * current_backoff_,
       options_.jitter() * current_backoff_);
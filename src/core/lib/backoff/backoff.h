@@ -61,6 +61,10 @@ class BackOff {
       max_backoff_ = max_backoff;
       return *this;
     }
+    Options& set_jitter_initial_backoff(bool jitter_initial_backoff) {
+      jitter_initial_backoff_ = jitter_initial_backoff;
+      return *this;
+    }
     /// how long to wait after the first failure before retrying
     grpc_millis initial_backoff() const { return initial_backoff_; }
     /// factor with which to multiply backoff after a failed retry
@@ -69,12 +73,16 @@ class BackOff {
     double jitter() const { return jitter_; }
     /// maximum time between retries
     grpc_millis max_backoff() const { return max_backoff_; }
+    /// whether to also randomize the first backoff, so that many clients
+    /// failing at the same moment do not all retry at the same moment
+    bool jitter_initial_backoff() const { return jitter_initial_backoff_; }
 
    private:
     grpc_millis initial_backoff_;
     double multiplier_;
     double jitter_;
     grpc_millis max_backoff_;
+    bool jitter_initial_backoff_ = false;
   };  // class Options
 
  private:
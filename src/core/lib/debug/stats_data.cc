@@ -31,6 +31,8 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "cqs_created",
     "client_channels_created",
     "client_subchannels_created",
+    "client_coalesced_call_groups",
+    "client_calls_coalesced",
     "server_channels_created",
     "syscall_poll",
     "syscall_wait",
@@ -38,8 +40,11 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "pollset_kicked_without_poller",
     "pollset_kicked_again",
     "pollset_kick_wakeup_fd",
+    "pollset_kick_wakeup_fd_coalesced",
     "pollset_kick_wakeup_cv",
     "pollset_kick_own_thread",
+    "pollset_worker_spin_kicked",
+    "pollset_worker_park",
     "syscall_epoll_ctl",
     "pollset_fd_cache_hits",
     "histogram_slow_lookups",
@@ -121,6 +126,10 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "executor_push_retries",
     "server_requested_calls",
     "server_slowpath_requests_queued",
+    "server_response_cache_hits",
+    "server_response_cache_misses",
+    "server_response_cache_inserts",
+    "server_response_cache_evictions",
     "cq_ev_queue_trylock_failures",
     "cq_ev_queue_trylock_successes",
     "cq_ev_queue_transient_pop_failures",
@@ -131,6 +140,10 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of completion queues created",
     "Number of client channels created",
     "Number of client subchannels created",
+    "How many client calls had identical in-flight calls coalesced into "
+    "them",
+    "How many client calls were answered with the response of an identical "
+    "in-flight call instead of being sent",
     "Number of server channels created",
     "Number of polling syscalls (epoll_wait, poll, etc) made by this process",
     "Number of sleeping syscalls made by this process",
@@ -142,10 +155,16 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "waking up (only valid for epoll1 right now)",
     "How many times was an eventfd used as the wakeup vector for a polling "
     "wakeup (only valid for epoll1 right now)",
+    "How many times was an eventfd wakeup skipped because an earlier one was "
+    "still pending (only valid for epoll1 right now)",
     "How many times was a condition variable used as the wakeup vector for a "
     "polling wakeup (only valid for epoll1 right now)",
     "How many times could a polling wakeup be satisfied by keeping the waking "
     "thread awake? (only valid for epoll1 right now)",
+    "How many times was a polling worker kicked while spinning, before it "
+    "parked on its condition variable (only valid for epoll1 right now)",
+    "How many times did a polling worker park on its condition variable (only "
+    "valid for epoll1 right now)",
     "Number of epoll_ctl calls made (only valid for epollex right now)",
     "Number of epoll_ctl calls skipped because the fd was cached as already "
     "being added.  (only valid for epollex right now)",
@@ -245,6 +264,13 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "How many calls were requested (not necessarily received) by the server",
     "How many times was the server slow path taken (indicates too few "
     "outstanding requests)",
+    "How many calls were answered from the server response cache without "
+    "invoking the method handler",
+    "How many calls to cacheable methods found no usable response in the "
+    "server response cache",
+    "How many responses were added to the server response cache",
+    "How many responses were dropped from the server response cache, either "
+    "because they expired or to free memory",
     "Number of lock (trylock) acquisition failures on completion queue event "
     "queue. High value here indicates high contention on completion queues",
     "Number of lock (trylock) acquisition successes on completion queue event "
@@ -266,6 +292,7 @@ const char* grpc_stats_histogram_name[GRPC_STATS_HISTOGRAM_COUNT] = {
     "http2_send_trailing_metadata_per_write",
     "http2_send_flowctl_per_write",
     "server_cqs_checked",
+    "grpclb_pick_queue_time_ms",
 };
 const char* grpc_stats_histogram_doc[GRPC_STATS_HISTOGRAM_COUNT] = {
     "Initial size of the grpc_call arena created at call start",
@@ -282,6 +309,7 @@ const char* grpc_stats_histogram_doc[GRPC_STATS_HISTOGRAM_COUNT] = {
     "Number of flow control updates written per TCP write",
     "How many completion queues were checked looking for a CQ that had "
     "requested the incoming call",
+    "Number of milliseconds a grpclb pick waited for a backend connection",
 };
 const int grpc_stats_table_0[65] = {
     0,      1,      2,      3,      4,     5,     7,     9,     11,    14,
@@ -661,17 +689,42 @@ void grpc_stats_inc_server_cqs_checked(int value) {
       GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED,
       grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_8, 8));
 }
-const int grpc_stats_histo_buckets[13] = {64, 128, 64, 64, 64, 64, 64,
-                                          64, 64,  64, 64, 64, 8};
-const int grpc_stats_histo_start[13] = {0,   64,  192, 256, 320, 384, 448,
-                                        512, 576, 640, 704, 768, 832};
-const int* const grpc_stats_histo_bucket_boundaries[13] = {
+void grpc_stats_inc_grpclb_pick_queue_time_ms(int value) {
+  value = GPR_CLAMP(value, 0, 1024);
+  if (value < 13) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_GRPCLB_PICK_QUEUE_TIME_MS,
+                             value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4637863191261478912ull) {
+    int bucket =
+        grpc_stats_table_7[((_val.uint - 4623507967449235456ull) >> 48)] + 13;
+    _bkt.dbl = grpc_stats_table_6[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_GRPCLB_PICK_QUEUE_TIME_MS,
+                             bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_GRPCLB_PICK_QUEUE_TIME_MS,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_6, 64));
+}
+const int grpc_stats_histo_buckets[14] = {64, 128, 64, 64, 64, 64, 64,
+                                          64, 64,  64, 64, 64, 8,  64};
+const int grpc_stats_histo_start[14] = {0,   64,  192, 256, 320, 384, 448,
+                                        512, 576, 640, 704, 768, 832, 840};
+const int* const grpc_stats_histo_bucket_boundaries[14] = {
     grpc_stats_table_0, grpc_stats_table_2, grpc_stats_table_4,
     grpc_stats_table_6, grpc_stats_table_4, grpc_stats_table_4,
     grpc_stats_table_6, grpc_stats_table_4, grpc_stats_table_6,
     grpc_stats_table_6, grpc_stats_table_6, grpc_stats_table_6,
-    grpc_stats_table_8};
-void (*const grpc_stats_inc_histogram[13])(int x) = {
+    grpc_stats_table_8, grpc_stats_table_6};
+void (*const grpc_stats_inc_histogram[14])(int x) = {
     grpc_stats_inc_call_initial_size,
     grpc_stats_inc_poll_events_returned,
     grpc_stats_inc_tcp_write_size,
@@ -684,4 +737,5 @@ void (*const grpc_stats_inc_histogram[13])(int x) = {
     grpc_stats_inc_http2_send_message_per_write,
     grpc_stats_inc_http2_send_trailing_metadata_per_write,
     grpc_stats_inc_http2_send_flowctl_per_write,
-    grpc_stats_inc_server_cqs_checked};
+    grpc_stats_inc_server_cqs_checked,
+    grpc_stats_inc_grpclb_pick_queue_time_ms};
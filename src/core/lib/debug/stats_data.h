@@ -32,6 +32,8 @@ typedef enum {
   GRPC_STATS_COUNTER_CQS_CREATED,
   GRPC_STATS_COUNTER_CLIENT_CHANNELS_CREATED,
   GRPC_STATS_COUNTER_CLIENT_SUBCHANNELS_CREATED,
+  GRPC_STATS_COUNTER_CLIENT_COALESCED_CALL_GROUPS,
+  GRPC_STATS_COUNTER_CLIENT_CALLS_COALESCED,
   GRPC_STATS_COUNTER_SERVER_CHANNELS_CREATED,
   GRPC_STATS_COUNTER_SYSCALL_POLL,
   GRPC_STATS_COUNTER_SYSCALL_WAIT,
@@ -39,8 +41,11 @@ typedef enum {
   GRPC_STATS_COUNTER_POLLSET_KICKED_WITHOUT_POLLER,
   GRPC_STATS_COUNTER_POLLSET_KICKED_AGAIN,
   GRPC_STATS_COUNTER_POLLSET_KICK_WAKEUP_FD,
+  GRPC_STATS_COUNTER_POLLSET_KICK_WAKEUP_FD_COALESCED,
   GRPC_STATS_COUNTER_POLLSET_KICK_WAKEUP_CV,
   GRPC_STATS_COUNTER_POLLSET_KICK_OWN_THREAD,
+  GRPC_STATS_COUNTER_POLLSET_WORKER_SPIN_KICKED,
+  GRPC_STATS_COUNTER_POLLSET_WORKER_PARK,
   GRPC_STATS_COUNTER_SYSCALL_EPOLL_CTL,
   GRPC_STATS_COUNTER_POLLSET_FD_CACHE_HITS,
   GRPC_STATS_COUNTER_HISTOGRAM_SLOW_LOOKUPS,
@@ -122,6 +127,10 @@ typedef enum {
   GRPC_STATS_COUNTER_EXECUTOR_PUSH_RETRIES,
   GRPC_STATS_COUNTER_SERVER_REQUESTED_CALLS,
   GRPC_STATS_COUNTER_SERVER_SLOWPATH_REQUESTS_QUEUED,
+  GRPC_STATS_COUNTER_SERVER_RESPONSE_CACHE_HITS,
+  GRPC_STATS_COUNTER_SERVER_RESPONSE_CACHE_MISSES,
+  GRPC_STATS_COUNTER_SERVER_RESPONSE_CACHE_INSERTS,
+  GRPC_STATS_COUNTER_SERVER_RESPONSE_CACHE_EVICTIONS,
   GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_FAILURES,
   GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_SUCCESSES,
   GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES,
@@ -143,6 +152,7 @@ typedef enum {
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_TRAILING_METADATA_PER_WRITE,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE,
   GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED,
+  GRPC_STATS_HISTOGRAM_GRPCLB_PICK_QUEUE_TIME_MS,
   GRPC_STATS_HISTOGRAM_COUNT
 } grpc_stats_histograms;
 extern const char* grpc_stats_histogram_name[GRPC_STATS_HISTOGRAM_COUNT];
@@ -174,7 +184,9 @@ typedef enum {
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE_BUCKETS = 64,
   GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_FIRST_SLOT = 832,
   GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_BUCKETS = 8,
-  GRPC_STATS_HISTOGRAM_BUCKETS = 840
+  GRPC_STATS_HISTOGRAM_GRPCLB_PICK_QUEUE_TIME_MS_FIRST_SLOT = 840,
+  GRPC_STATS_HISTOGRAM_GRPCLB_PICK_QUEUE_TIME_MS_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_BUCKETS = 904
 } grpc_stats_histogram_constants;
 #if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
 #define GRPC_STATS_INC_CLIENT_CALLS_CREATED() \
@@ -187,6 +199,10 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CLIENT_CHANNELS_CREATED)
 #define GRPC_STATS_INC_CLIENT_SUBCHANNELS_CREATED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CLIENT_SUBCHANNELS_CREATED)
+#define GRPC_STATS_INC_CLIENT_COALESCED_CALL_GROUPS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CLIENT_COALESCED_CALL_GROUPS)
+#define GRPC_STATS_INC_CLIENT_CALLS_COALESCED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CLIENT_CALLS_COALESCED)
 #define GRPC_STATS_INC_SERVER_CHANNELS_CREATED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SERVER_CHANNELS_CREATED)
 #define GRPC_STATS_INC_SYSCALL_POLL() \
@@ -201,10 +217,16 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_POLLSET_KICKED_AGAIN)
 #define GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_POLLSET_KICK_WAKEUP_FD)
+#define GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD_COALESCED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_POLLSET_KICK_WAKEUP_FD_COALESCED)
 #define GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_POLLSET_KICK_WAKEUP_CV)
 #define GRPC_STATS_INC_POLLSET_KICK_OWN_THREAD() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_POLLSET_KICK_OWN_THREAD)
+#define GRPC_STATS_INC_POLLSET_WORKER_SPIN_KICKED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_POLLSET_WORKER_SPIN_KICKED)
+#define GRPC_STATS_INC_POLLSET_WORKER_PARK() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_POLLSET_WORKER_PARK)
 #define GRPC_STATS_INC_SYSCALL_EPOLL_CTL() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SYSCALL_EPOLL_CTL)
 #define GRPC_STATS_INC_POLLSET_FD_CACHE_HITS() \
@@ -389,6 +411,14 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SERVER_REQUESTED_CALLS)
 #define GRPC_STATS_INC_SERVER_SLOWPATH_REQUESTS_QUEUED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SERVER_SLOWPATH_REQUESTS_QUEUED)
+#define GRPC_STATS_INC_SERVER_RESPONSE_CACHE_HITS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SERVER_RESPONSE_CACHE_HITS)
+#define GRPC_STATS_INC_SERVER_RESPONSE_CACHE_MISSES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SERVER_RESPONSE_CACHE_MISSES)
+#define GRPC_STATS_INC_SERVER_RESPONSE_CACHE_INSERTS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SERVER_RESPONSE_CACHE_INSERTS)
+#define GRPC_STATS_INC_SERVER_RESPONSE_CACHE_EVICTIONS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SERVER_RESPONSE_CACHE_EVICTIONS)
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_FAILURES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_FAILURES)
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_SUCCESSES() \
@@ -434,12 +464,17 @@ void grpc_stats_inc_http2_send_flowctl_per_write(int x);
 #define GRPC_STATS_INC_SERVER_CQS_CHECKED(value) \
   grpc_stats_inc_server_cqs_checked((int)(value))
 void grpc_stats_inc_server_cqs_checked(int x);
+#define GRPC_STATS_INC_GRPCLB_PICK_QUEUE_TIME_MS(value) \
+  grpc_stats_inc_grpclb_pick_queue_time_ms((int)(value))
+void grpc_stats_inc_grpclb_pick_queue_time_ms(int x);
 #else
 #define GRPC_STATS_INC_CLIENT_CALLS_CREATED()
 #define GRPC_STATS_INC_SERVER_CALLS_CREATED()
 #define GRPC_STATS_INC_CQS_CREATED()
 #define GRPC_STATS_INC_CLIENT_CHANNELS_CREATED()
 #define GRPC_STATS_INC_CLIENT_SUBCHANNELS_CREATED()
+#define GRPC_STATS_INC_CLIENT_COALESCED_CALL_GROUPS()
+#define GRPC_STATS_INC_CLIENT_CALLS_COALESCED()
 #define GRPC_STATS_INC_SERVER_CHANNELS_CREATED()
 #define GRPC_STATS_INC_SYSCALL_POLL()
 #define GRPC_STATS_INC_SYSCALL_WAIT()
@@ -447,8 +482,11 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_POLLSET_KICKED_WITHOUT_POLLER()
 #define GRPC_STATS_INC_POLLSET_KICKED_AGAIN()
 #define GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD()
+#define GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD_COALESCED()
 #define GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV()
 #define GRPC_STATS_INC_POLLSET_KICK_OWN_THREAD()
+#define GRPC_STATS_INC_POLLSET_WORKER_SPIN_KICKED()
+#define GRPC_STATS_INC_POLLSET_WORKER_PARK()
 #define GRPC_STATS_INC_SYSCALL_EPOLL_CTL()
 #define GRPC_STATS_INC_POLLSET_FD_CACHE_HITS()
 #define GRPC_STATS_INC_HISTOGRAM_SLOW_LOOKUPS()
@@ -530,6 +568,10 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_EXECUTOR_PUSH_RETRIES()
 #define GRPC_STATS_INC_SERVER_REQUESTED_CALLS()
 #define GRPC_STATS_INC_SERVER_SLOWPATH_REQUESTS_QUEUED()
+#define GRPC_STATS_INC_SERVER_RESPONSE_CACHE_HITS()
+#define GRPC_STATS_INC_SERVER_RESPONSE_CACHE_MISSES()
+#define GRPC_STATS_INC_SERVER_RESPONSE_CACHE_INSERTS()
+#define GRPC_STATS_INC_SERVER_RESPONSE_CACHE_EVICTIONS()
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_FAILURES()
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_SUCCESSES()
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES()
@@ -546,10 +588,11 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_HTTP2_SEND_TRAILING_METADATA_PER_WRITE(value)
 #define GRPC_STATS_INC_HTTP2_SEND_FLOWCTL_PER_WRITE(value)
 #define GRPC_STATS_INC_SERVER_CQS_CHECKED(value)
+#define GRPC_STATS_INC_GRPCLB_PICK_QUEUE_TIME_MS(value)
 #endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
-extern const int grpc_stats_histo_buckets[13];
-extern const int grpc_stats_histo_start[13];
-extern const int* const grpc_stats_histo_bucket_boundaries[13];
-extern void (*const grpc_stats_inc_histogram[13])(int x);
+extern const int grpc_stats_histo_buckets[14];
+extern const int grpc_stats_histo_start[14];
+extern const int* const grpc_stats_histo_bucket_boundaries[14];
+extern void (*const grpc_stats_inc_histogram[14])(int x);
 
 #endif /* GRPC_CORE_LIB_DEBUG_STATS_DATA_H */
@@ -3,6 +3,8 @@ server_calls_created_per_iteration:FLOAT,
 cqs_created_per_iteration:FLOAT,
 client_channels_created_per_iteration:FLOAT,
 client_subchannels_created_per_iteration:FLOAT,
+client_coalesced_call_groups_per_iteration:FLOAT,
+client_calls_coalesced_per_iteration:FLOAT,
 server_channels_created_per_iteration:FLOAT,
 syscall_poll_per_iteration:FLOAT,
 syscall_wait_per_iteration:FLOAT,
@@ -10,8 +12,11 @@ pollset_kick_per_iteration:FLOAT,
 pollset_kicked_without_poller_per_iteration:FLOAT,
 pollset_kicked_again_per_iteration:FLOAT,
 pollset_kick_wakeup_fd_per_iteration:FLOAT,
+pollset_kick_wakeup_fd_coalesced_per_iteration:FLOAT,
 pollset_kick_wakeup_cv_per_iteration:FLOAT,
 pollset_kick_own_thread_per_iteration:FLOAT,
+pollset_worker_spin_kicked_per_iteration:FLOAT,
+pollset_worker_park_per_iteration:FLOAT,
 syscall_epoll_ctl_per_iteration:FLOAT,
 pollset_fd_cache_hits_per_iteration:FLOAT,
 histogram_slow_lookups_per_iteration:FLOAT,
@@ -93,6 +98,10 @@ executor_queue_drained_per_iteration:FLOAT,
 executor_push_retries_per_iteration:FLOAT,
 server_requested_calls_per_iteration:FLOAT,
 server_slowpath_requests_queued_per_iteration:FLOAT,
+server_response_cache_hits_per_iteration:FLOAT,
+server_response_cache_misses_per_iteration:FLOAT,
+server_response_cache_inserts_per_iteration:FLOAT,
+server_response_cache_evictions_per_iteration:FLOAT,
 cq_ev_queue_trylock_failures_per_iteration:FLOAT,
 cq_ev_queue_trylock_successes_per_iteration:FLOAT,
 cq_ev_queue_transient_pop_failures_per_iteration:FLOAT
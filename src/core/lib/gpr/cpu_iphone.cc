@@ -20,6 +20,8 @@
 
 #include <grpc/support/cpu.h>
 
+#include "src/core/lib/gpr/numa.h"
+
 #ifdef GPR_CPU_IPHONE
 
 /* Probably 2 instead of 1, but see comment on gpr_cpu_current_cpu. */
@@ -33,4 +35,8 @@ unsigned gpr_cpu_num_cores(void) { return 1; }
    and some code might be relying on it. */
 unsigned gpr_cpu_current_cpu(void) { return 0; }
 
+unsigned gpr_cpu_num_numa_nodes(void) { return 1; }
+
+unsigned gpr_cpu_numa_node(unsigned cpu) { return 0; }
+
 #endif /* GPR_CPU_IPHONE */
@@ -24,15 +24,22 @@
 
 #ifdef GPR_CPU_LINUX
 
+#include <ctype.h>
+#include <dirent.h>
 #include <errno.h>
 #include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
+#include <grpc/support/alloc.h>
 #include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 
+#include "src/core/lib/gpr/numa.h"
+
 static int ncpus = 0;
 
 static void init_num_cpus() {
@@ -79,4 +86,102 @@ unsigned gpr_cpu_current_cpu(void) {
 #endif
 }
 
+static unsigned nnodes = 1;
+/* Node of each CPU, or nullptr if there is a single node */
+static unsigned* cpu_nodes = nullptr;
+
+/* One pass of gpr_parse_numa_cpulist(), which only counts the CPUs if
+   |cpu_nodes| is null */
+static int parse_cpulist(const char* list, unsigned node, unsigned* cpu_nodes,
+                         unsigned ncpu) {
+  const char* p = list;
+  if (*p == '\0' || *p == '\n') return 0;
+  int count = 0;
+  for (;;) {
+    if (!isdigit(static_cast<unsigned char>(*p))) return -1;
+    char* end;
+    unsigned long first = strtoul(p, &end, 10);
+    unsigned long last = first;
+    p = end;
+    if (*p == '-') {
+      p++;
+      if (!isdigit(static_cast<unsigned char>(*p))) return -1;
+      last = strtoul(p, &end, 10);
+      p = end;
+      if (last < first) return -1;
+    }
+    for (unsigned long cpu = first; cpu <= last && cpu < ncpu; cpu++) {
+      if (cpu_nodes != nullptr) cpu_nodes[cpu] = node;
+      count++;
+    }
+    if (*p == ',') {
+      p++;
+    } else if (*p == '\0' || (*p == '\n' && p[1] == '\0')) {
+      return count;
+    } else {
+      return -1;
+    }
+  }
+}
+
+int gpr_parse_numa_cpulist(const char* list, unsigned node,
+                           unsigned* cpu_nodes, unsigned ncpu) {
+  int count = parse_cpulist(list, node, nullptr, ncpu);
+  if (count > 0) parse_cpulist(list, node, cpu_nodes, ncpu);
+  return count;
+}
+
+static void init_numa_nodes() {
+  DIR* dir = opendir("/sys/devices/system/node");
+  if (dir == nullptr) return;
+  unsigned ncpu = gpr_cpu_num_cores();
+  cpu_nodes = static_cast<unsigned*>(gpr_zalloc(ncpu * sizeof(*cpu_nodes)));
+  unsigned node = 0;
+  bool malformed = false;
+  struct dirent* entry;
+  while (!malformed && (entry = readdir(dir)) != nullptr) {
+    unsigned id;
+    char tail;
+    if (sscanf(entry->d_name, "node%u%c", &id, &tail) != 1) continue;
+    char path[64];
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%u/cpulist",
+             id);
+    FILE* f = fopen(path, "r");
+    if (f == nullptr) continue;
+    char list[1024];
+    if (fgets(list, sizeof(list), f) != nullptr) {
+      int count = gpr_parse_numa_cpulist(list, node, cpu_nodes, ncpu);
+      if (count < 0) {
+        gpr_log(GPR_ERROR, "Cannot parse %s: assuming a single NUMA node",
+                path);
+        malformed = true;
+      } else if (count > 0) {
+        /* Nodes without CPUs (memory-only nodes) are not counted */
+        node++;
+      }
+    }
+    fclose(f);
+  }
+  closedir(dir);
+  if (malformed || node <= 1) {
+    gpr_free(cpu_nodes);
+    cpu_nodes = nullptr;
+    return;
+  }
+  nnodes = node;
+}
+
+static gpr_once numa_once = GPR_ONCE_INIT;
+
+unsigned gpr_cpu_num_numa_nodes(void) {
+  gpr_once_init(&numa_once, init_numa_nodes);
+  return nnodes;
+}
+
+unsigned gpr_cpu_numa_node(unsigned cpu) {
+  gpr_once_init(&numa_once, init_numa_nodes);
+  if (cpu_nodes == nullptr || cpu >= gpr_cpu_num_cores()) return 0;
+  return cpu_nodes[cpu];
+}
+
 #endif /* GPR_CPU_LINUX */
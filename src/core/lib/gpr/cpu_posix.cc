@@ -30,6 +30,7 @@
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 
+#include "src/core/lib/gpr/numa.h"
 #include "src/core/lib/gpr/useful.h"
 
 static long ncpus = 0;
@@ -78,4 +79,8 @@ unsigned gpr_cpu_current_cpu(void) {
   return (unsigned)GPR_HASH_POINTER(thread_id, gpr_cpu_num_cores());
 }
 
+unsigned gpr_cpu_num_numa_nodes(void) { return 1; }
+
+unsigned gpr_cpu_numa_node(unsigned cpu) { return 0; }
+
 #endif /* GPR_CPU_POSIX */
@@ -22,6 +22,8 @@
 #include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/gpr/numa.h"
+
 unsigned gpr_cpu_num_cores(void) {
   SYSTEM_INFO si;
   GetSystemInfo(&si);
@@ -30,4 +32,8 @@ unsigned gpr_cpu_num_cores(void) {
 
 unsigned gpr_cpu_current_cpu(void) { return GetCurrentProcessorNumber(); }
 
+unsigned gpr_cpu_num_numa_nodes(void) { return 1; }
+
+unsigned gpr_cpu_numa_node(unsigned cpu) { return 0; }
+
 #endif /* GPR_WINDOWS */
@@ -0,0 +1,46 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_GPR_NUMA_H
+#define GRPC_CORE_LIB_GPR_NUMA_H
+
+#include <grpc/support/port_platform.h>
+
+/* NUMA topology of the current system, alongside the CPU information of
+   grpc/support/cpu.h. On Linux it is read once from
+   /sys/devices/system/node; elsewhere, or if that fails, the system is
+   reported as a single node. */
+
+/* Return the number of NUMA nodes, at least 1. */
+unsigned gpr_cpu_num_numa_nodes(void);
+
+/* Return the NUMA node of |cpu|, in [0, gpr_cpu_num_numa_nodes() - 1]. Node
+   numbers are dense even if the system's are not. |cpu| is in
+   [0, gpr_cpu_num_cores() - 1], as returned by gpr_cpu_current_cpu(). */
+unsigned gpr_cpu_numa_node(unsigned cpu);
+
+#ifdef GPR_CPU_LINUX
+/* Exposed for testing. Parses a sysfs cpulist such as "0-3,8-11\n" and sets
+   cpu_nodes[cpu] to |node| for each of its CPUs below |ncpu|. Returns the
+   number of CPUs set, or -1 if the list is malformed, in which case
+   |cpu_nodes| is left untouched. */
+int gpr_parse_numa_cpulist(const char* list, unsigned node,
+                           unsigned* cpu_nodes, unsigned ncpu);
+#endif
+
+#endif /* GRPC_CORE_LIB_GPR_NUMA_H */
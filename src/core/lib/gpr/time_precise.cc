@@ -76,3 +76,32 @@ void gpr_precise_clock_now(gpr_timespec* clk) {
   clk->clock_type = GPR_CLOCK_PRECISE;
 }
 #endif /* GRPC_TIMERS_RDTSC */
+
+#if defined(GPR_LINUX) && defined(GPR_POSIX_TIME)
+#include <time.h>
+
+gpr_timespec gpr_coarse_clock_now(gpr_clock_type clock_type) {
+  clockid_t clock;
+  switch (clock_type) {
+    case GPR_CLOCK_MONOTONIC:
+      clock = CLOCK_MONOTONIC_COARSE;
+      break;
+    case GPR_CLOCK_REALTIME:
+      clock = CLOCK_REALTIME_COARSE;
+      break;
+    default:
+      return gpr_now(clock_type);
+  }
+  struct timespec ts;
+  if (clock_gettime(clock, &ts) != 0) return gpr_now(clock_type);
+  gpr_timespec now;
+  now.tv_sec = static_cast<int64_t>(ts.tv_sec);
+  now.tv_nsec = static_cast<int32_t>(ts.tv_nsec);
+  now.clock_type = clock_type;
+  return now;
+}
+#else  /* defined(GPR_LINUX) && defined(GPR_POSIX_TIME) */
+gpr_timespec gpr_coarse_clock_now(gpr_clock_type clock_type) {
+  return gpr_now(clock_type);
+}
+#endif /* defined(GPR_LINUX) && defined(GPR_POSIX_TIME) */
@@ -26,4 +26,11 @@
 void gpr_precise_clock_init(void);
 void gpr_precise_clock_now(gpr_timespec* clk);
 
+/* Reads the kernel's coarse version of the monotonic or realtime clock, for
+   timestamps that need not be precise. It is cheaper than gpr_now() because
+   the kernel only updates it once per scheduler tick, so it lags behind
+   gpr_now() by at most a tick (1-10ms, depending on the kernel's HZ). Where
+   there is no coarse clock, it returns gpr_now(clock_type). */
+gpr_timespec gpr_coarse_clock_now(gpr_clock_type clock_type);
+
 #endif /* GRPC_CORE_LIB_GPR_TIME_PRECISE_H */
@@ -101,10 +101,12 @@ void grpc_call_combiner_destroy(grpc_call_combiner* call_combiner) {
 #define DEBUG_ARGS , const char *file, int line
 #define DEBUG_FMT_STR "%s:%d: "
 #define DEBUG_FMT_ARGS , file, line
+#define DEBUG_PASS_ARGS , file, line
 #else
 #define DEBUG_ARGS
 #define DEBUG_FMT_STR
 #define DEBUG_FMT_ARGS
+#define DEBUG_PASS_ARGS
 #endif
 
 void grpc_call_combiner_start(grpc_call_combiner* call_combiner,
@@ -146,6 +148,34 @@ void grpc_call_combiner_start(grpc_call_combiner* call_combiner,
   }
 }
 
+void grpc_call_combiner_start_inline_if_idle(grpc_call_combiner* call_combiner,
+                                             grpc_closure* closure,
+                                             grpc_error* error DEBUG_ARGS,
+                                             const char* reason) {
+#ifndef GRPC_TSAN_ENABLED
+  // Under TSAN, closures must go through tsan_closure(), which is only done
+  // by grpc_call_combiner_start().
+  if (gpr_atm_full_cas(&call_combiner->size, 0, 1)) {
+    GPR_TIMER_SCOPE("call_combiner_start_inline", 0);
+    if (grpc_call_combiner_trace.enabled()) {
+      gpr_log(GPR_INFO,
+              "==> grpc_call_combiner_start_inline_if_idle() [%p] closure=%p "
+              "[" DEBUG_FMT_STR "%s] error=%s",
+              call_combiner, closure DEBUG_FMT_ARGS, reason,
+              grpc_error_string(error));
+      gpr_log(GPR_INFO, "  size: 0 -> 1");
+      gpr_log(GPR_INFO, "  EXECUTING INLINE");
+    }
+    GRPC_STATS_INC_CALL_COMBINER_LOCKS_SCHEDULED_ITEMS();
+    GRPC_STATS_INC_CALL_COMBINER_LOCKS_INITIATED();
+    GRPC_CLOSURE_RUN(closure, error);
+    return;
+  }
+#endif
+  grpc_call_combiner_start(call_combiner, closure, error DEBUG_PASS_ARGS,
+                           reason);
+}
+
 void grpc_call_combiner_stop(grpc_call_combiner* call_combiner DEBUG_ARGS,
                              const char* reason) {
   GPR_TIMER_SCOPE("call_combiner_stop", 0);
@@ -196,6 +226,9 @@ void grpc_call_combiner_set_notify_on_cancel(grpc_call_combiner* call_combiner,
   while (true) {
     // Decode original state.
     gpr_atm original_state = gpr_atm_acq_load(&call_combiner->cancel_state);
+    // Unregistering when nothing is registered (as every call does when it
+    // is destroyed) leaves the state unchanged, so skip the CAS.
+    if (closure == nullptr && original_state == 0) break;
     grpc_error* original_error = decode_cancel_state_error(original_state);
     // If error is set, invoke the cancellation closure immediately.
     // Otherwise, store the new closure.
@@ -87,10 +87,19 @@ void grpc_call_combiner_destroy(grpc_call_combiner* call_combiner);
                            __LINE__, (reason))
 #define GRPC_CALL_COMBINER_STOP(call_combiner, reason) \
   grpc_call_combiner_stop((call_combiner), __FILE__, __LINE__, (reason))
+#define GRPC_CALL_COMBINER_START_INLINE_IF_IDLE(call_combiner, closure, \
+                                                error, reason)          \
+  grpc_call_combiner_start_inline_if_idle((call_combiner), (closure),   \
+                                          (error), __FILE__, __LINE__,  \
+                                          (reason))
 /// Starts processing \a closure on \a call_combiner.
 void grpc_call_combiner_start(grpc_call_combiner* call_combiner,
                               grpc_closure* closure, grpc_error* error,
                               const char* file, int line, const char* reason);
+/// See GRPC_CALL_COMBINER_START_INLINE_IF_IDLE() below.
+void grpc_call_combiner_start_inline_if_idle(
+    grpc_call_combiner* call_combiner, grpc_closure* closure,
+    grpc_error* error, const char* file, int line, const char* reason);
 /// Yields the call combiner to the next closure in the queue, if any.
 void grpc_call_combiner_stop(grpc_call_combiner* call_combiner,
                              const char* file, int line, const char* reason);
@@ -99,15 +108,35 @@ void grpc_call_combiner_stop(grpc_call_combiner* call_combiner,
   grpc_call_combiner_start((call_combiner), (closure), (error), (reason))
 #define GRPC_CALL_COMBINER_STOP(call_combiner, reason) \
   grpc_call_combiner_stop((call_combiner), (reason))
+#define GRPC_CALL_COMBINER_START_INLINE_IF_IDLE(call_combiner, closure, \
+                                                error, reason)          \
+  grpc_call_combiner_start_inline_if_idle((call_combiner), (closure),   \
+                                          (error), (reason))
 /// Starts processing \a closure on \a call_combiner.
 void grpc_call_combiner_start(grpc_call_combiner* call_combiner,
                               grpc_closure* closure, grpc_error* error,
                               const char* reason);
+/// See GRPC_CALL_COMBINER_START_INLINE_IF_IDLE() below.
+void grpc_call_combiner_start_inline_if_idle(grpc_call_combiner* call_combiner,
+                                             grpc_closure* closure,
+                                             grpc_error* error,
+                                             const char* reason);
 /// Yields the call combiner to the next closure in the queue, if any.
 void grpc_call_combiner_stop(grpc_call_combiner* call_combiner,
                              const char* reason);
 #endif
 
+/// GRPC_CALL_COMBINER_START_INLINE_IF_IDLE() is like
+/// GRPC_CALL_COMBINER_START(), except that if the call combiner is idle,
+/// it is taken with a single CAS and \a closure is run right away via
+/// GRPC_CLOSURE_RUN() rather than scheduled.  If the call combiner is busy,
+/// \a closure is queued as usual.
+///
+/// This saves a trip through the ExecCtx for the common case of a batch
+/// started on a call that has nothing else in flight.  As with
+/// GRPC_CLOSURE_RUN(), \a closure runs under whatever locks the caller
+/// holds, so the caller must not hold any lock that \a closure may take.
+
 /// Registers \a closure to be invoked by \a call_combiner when
 /// grpc_call_combiner_cancel() is called.
 ///
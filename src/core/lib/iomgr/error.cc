@@ -32,6 +32,7 @@
 #endif
 
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/iomgr/error_internal.h"
 #include "src/core/lib/profiling/timers.h"
@@ -356,7 +357,8 @@ grpc_error* grpc_error_create(const char* file, int line, grpc_slice desc,
             referencing[i]));  // TODO(ncteisen), change ownership semantics
   }
 
-  internal_set_time(&err, GRPC_ERROR_TIME_CREATED, gpr_now(GPR_CLOCK_REALTIME));
+  internal_set_time(&err, GRPC_ERROR_TIME_CREATED,
+                    gpr_coarse_clock_now(GPR_CLOCK_REALTIME));
 
   gpr_atm_no_barrier_store(&err->atomics.error_string, 0);
   gpr_ref_init(&err->atomics.refs, 1);
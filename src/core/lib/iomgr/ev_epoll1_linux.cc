@@ -43,6 +43,7 @@
 #include <grpc/support/string_util.h>
 
 #include "src/core/lib/debug/stats.h"
+#include "src/core/lib/gpr/numa.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gpr/tls.h"
 #include "src/core/lib/gpr/useful.h"
@@ -56,6 +57,16 @@
 
 static grpc_wakeup_fd global_wakeup_fd;
 
+/* Set while a write to global_wakeup_fd has not been consumed by
+   process_epoll_events() yet. The designated poller cannot block in
+   epoll_wait() past a pending wakeup, so kicks arriving in the meantime do not
+   need to write to the eventfd again. */
+static gpr_atm g_wakeup_pending;
+
+/* True for the "epoll1-busy" engine: the designated poller and the workers
+   waiting for it spin instead of sleeping in the kernel */
+static bool g_busy_poll = false;
+
 /*******************************************************************************
  * Singleton epoll set related fields
  */
@@ -177,6 +188,8 @@ static const char* kick_state_string(kick_state st) {
 struct grpc_pollset_worker {
   kick_state state;
   int kick_state_mutator;  // which line of code last changed kick state
+  // Copy of 'state' that a spinning worker can poll without the pollset lock
+  gpr_atm spin_state;
   bool initialized_cv;
   grpc_pollset_worker* next;
   grpc_pollset_worker* prev;
@@ -184,14 +197,33 @@ struct grpc_pollset_worker {
   grpc_closure_list schedule_on_end_work;
 };
 
-#define SET_KICK_STATE(worker, kick_state)   \
-  do {                                       \
-    (worker)->state = (kick_state);          \
-    (worker)->kick_state_mutator = __LINE__; \
+#define SET_KICK_STATE(worker, kick_state)                           \
+  do {                                                               \
+    (worker)->state = (kick_state);                                  \
+    (worker)->kick_state_mutator = __LINE__;                         \
+    gpr_atm_rel_store(&(worker)->spin_state, (gpr_atm)(kick_state)); \
   } while (false)
 
 #define MAX_NEIGHBORHOODS 1024
 
+/* Bounds on the number of times a worker polls its kick state before parking
+   on its condition variable (see spin_before_parking()) */
+#define MIN_WORKER_SPIN_ITERATIONS 16
+#define MAX_WORKER_SPIN_ITERATIONS 512
+
+#if defined(__i386__) || defined(__x86_64__)
+#define CPU_RELAX() __asm__ __volatile__("pause" ::: "memory")
+#elif defined(__aarch64__)
+#define CPU_RELAX() __asm__ __volatile__("yield" ::: "memory")
+#else
+#define CPU_RELAX() __asm__ __volatile__("" ::: "memory")
+#endif
+
+/* Current spin length, adapted by spin_before_parking(), and its upper bound
+   (0 on single core machines, where spinning cannot help) */
+static gpr_atm g_worker_spin_iterations;
+static gpr_atm g_max_spin_iterations;
+
 typedef struct pollset_neighborhood {
   union {
     char pad[GPR_CACHELINE_SIZE];
@@ -461,6 +493,12 @@ static gpr_atm g_active_poller;
 
 static pollset_neighborhood* g_neighborhoods;
 static size_t g_num_neighborhoods;
+/* Neighborhood of each cpu. Neighborhoods are handed out to the cpus of one
+   NUMA node after the other, so the cpus of a node share a contiguous range
+   of neighborhoods and the scan for the next poller in end_worker() tends to
+   stay on the node of the previous one. */
+static size_t* g_cpu_neighborhoods;
+static size_t g_num_cpus;
 
 /* Return true if first in list */
 static bool worker_insert(grpc_pollset* pollset, grpc_pollset_worker* worker) {
@@ -500,13 +538,54 @@ static worker_remove_result worker_remove(grpc_pollset* pollset,
 }
 
 static size_t choose_neighborhood(void) {
-  return static_cast<size_t>(gpr_cpu_current_cpu()) % g_num_neighborhoods;
+  size_t cpu = static_cast<size_t>(gpr_cpu_current_cpu());
+  if (cpu >= g_num_cpus) return cpu % g_num_neighborhoods;
+  return g_cpu_neighborhoods[cpu];
+}
+
+void grpc_epoll1_map_cpu_neighborhoods(const unsigned* cpu_nodes,
+                                       size_t num_cpus, size_t num_nodes,
+                                       size_t num_neighborhoods,
+                                       size_t* cpu_neighborhoods) {
+  /* Rank the cpus by (node, cpu) and split that order into equal blocks */
+  size_t* node_start =
+      static_cast<size_t*>(gpr_zalloc(sizeof(size_t) * (num_nodes + 1)));
+  for (size_t cpu = 0; cpu < num_cpus; cpu++) {
+    node_start[cpu_nodes[cpu] + 1]++;
+  }
+  for (size_t node = 0; node < num_nodes; node++) {
+    node_start[node + 1] += node_start[node];
+  }
+  for (size_t cpu = 0; cpu < num_cpus; cpu++) {
+    size_t rank = node_start[cpu_nodes[cpu]]++;
+    cpu_neighborhoods[cpu] = rank * num_neighborhoods / num_cpus;
+  }
+  gpr_free(node_start);
+}
+
+static void init_cpu_neighborhoods(void) {
+  g_num_cpus = GPR_MAX(gpr_cpu_num_cores(), 1);
+  g_cpu_neighborhoods =
+      static_cast<size_t*>(gpr_malloc(sizeof(size_t) * g_num_cpus));
+  unsigned* cpu_nodes =
+      static_cast<unsigned*>(gpr_malloc(sizeof(unsigned) * g_num_cpus));
+  for (size_t cpu = 0; cpu < g_num_cpus; cpu++) {
+    cpu_nodes[cpu] = gpr_cpu_numa_node(static_cast<unsigned>(cpu));
+  }
+  grpc_epoll1_map_cpu_neighborhoods(cpu_nodes, g_num_cpus,
+                                    gpr_cpu_num_numa_nodes(),
+                                    g_num_neighborhoods, g_cpu_neighborhoods);
+  gpr_free(cpu_nodes);
 }
 
 static grpc_error* pollset_global_init(void) {
   gpr_tls_init(&g_current_thread_pollset);
   gpr_tls_init(&g_current_thread_worker);
   gpr_atm_no_barrier_store(&g_active_poller, 0);
+  gpr_atm_no_barrier_store(&g_wakeup_pending, 0);
+  g_max_spin_iterations =
+      gpr_cpu_num_cores() > 1 ? MAX_WORKER_SPIN_ITERATIONS : 0;
+  gpr_atm_no_barrier_store(&g_worker_spin_iterations, g_max_spin_iterations);
   global_wakeup_fd.read_fd = -1;
   grpc_error* err = grpc_wakeup_fd_init(&global_wakeup_fd);
   if (err != GRPC_ERROR_NONE) return err;
@@ -523,6 +602,7 @@ static grpc_error* pollset_global_init(void) {
   for (size_t i = 0; i < g_num_neighborhoods; i++) {
     gpr_mu_init(&g_neighborhoods[i].mu);
   }
+  init_cpu_neighborhoods();
   return GRPC_ERROR_NONE;
 }
 
@@ -534,6 +614,7 @@ static void pollset_global_shutdown(void) {
     gpr_mu_destroy(&g_neighborhoods[i].mu);
   }
   gpr_free(g_neighborhoods);
+  gpr_free(g_cpu_neighborhoods);
 }
 
 static void pollset_init(grpc_pollset* pollset, gpr_mu** mu) {
@@ -578,6 +659,17 @@ static void pollset_destroy(grpc_pollset* pollset) {
   gpr_mu_destroy(&pollset->mu);
 }
 
+/* Wakes up the designated poller, unless a wakeup is already pending */
+static grpc_error* wakeup_active_poller(void) {
+  if (gpr_atm_no_barrier_load(&g_wakeup_pending) != 0 ||
+      !gpr_atm_full_cas(&g_wakeup_pending, 0, 1)) {
+    GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD_COALESCED();
+    return GRPC_ERROR_NONE;
+  }
+  GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD();
+  return grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+}
+
 static grpc_error* pollset_kick_all(grpc_pollset* pollset) {
   GPR_TIMER_SCOPE("pollset_kick_all", 0);
   grpc_error* error = GRPC_ERROR_NONE;
@@ -597,10 +689,8 @@ static grpc_error* pollset_kick_all(grpc_pollset* pollset) {
           }
           break;
         case DESIGNATED_POLLER:
-          GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD();
           SET_KICK_STATE(worker, KICKED);
-          append_error(&error, grpc_wakeup_fd_wakeup(&global_wakeup_fd),
-                       "pollset_kick_all");
+          append_error(&error, wakeup_active_poller(), "pollset_kick_all");
           break;
       }
 
@@ -666,8 +756,16 @@ static grpc_error* process_epoll_events(grpc_pollset* pollset) {
     void* data_ptr = ev->data.ptr;
 
     if (data_ptr == &global_wakeup_fd) {
+      /* Read the eventfd before clearing the flag: clearing it first would
+         let a kick set it and write in between, and the read would then
+         swallow that write while the flag stays set, so that no later kick
+         would ever write again. A kick that lands between the read and the
+         clear is dropped, which is harmless: this poller is awake and
+         returns from pollset_work() once its events are processed */
       append_error(&error, grpc_wakeup_fd_consume_wakeup(&global_wakeup_fd),
                    err_desc);
+      gpr_atm_full_barrier();
+      gpr_atm_no_barrier_store(&g_wakeup_pending, 0);
     } else {
       grpc_fd* fd = reinterpret_cast<grpc_fd*>(
           reinterpret_cast<intptr_t>(data_ptr) & ~static_cast<intptr_t>(1));
@@ -696,6 +794,21 @@ static grpc_error* process_epoll_events(grpc_pollset* pollset) {
   return error;
 }
 
+/* Busy-polling version of the epoll_wait() call in do_epoll_wait(): polls the
+   epoll set without blocking until it has events (a kick shows up as an event
+   on global_wakeup_fd) or the deadline has passed. */
+static int busy_epoll_wait(grpc_millis deadline) {
+  for (;;) {
+    GRPC_STATS_INC_SYSCALL_POLL();
+    int r = epoll_wait(g_epoll_set.epfd, g_epoll_set.events, MAX_EPOLL_EVENTS,
+                       0);
+    if (r > 0 || (r < 0 && errno != EINTR)) return r;
+    grpc_core::ExecCtx::Get()->InvalidateNow();
+    if (poll_deadline_to_millis_timeout(deadline) == 0) return 0;
+    CPU_RELAX();
+  }
+}
+
 /* Do epoll_wait and store the events in g_epoll_set.events field. This does not
    "process" any of the events yet; that is done in process_epoll_events().
    *See process_epoll_events() function for more details.
@@ -708,16 +821,20 @@ static grpc_error* do_epoll_wait(grpc_pollset* ps, grpc_millis deadline) {
 
   int r;
   int timeout = poll_deadline_to_millis_timeout(deadline);
-  if (timeout != 0) {
-    GRPC_SCHEDULING_START_BLOCKING_REGION;
-  }
-  do {
-    GRPC_STATS_INC_SYSCALL_POLL();
-    r = epoll_wait(g_epoll_set.epfd, g_epoll_set.events, MAX_EPOLL_EVENTS,
-                   timeout);
-  } while (r < 0 && errno == EINTR);
-  if (timeout != 0) {
-    GRPC_SCHEDULING_END_BLOCKING_REGION;
+  if (g_busy_poll && timeout != 0) {
+    r = busy_epoll_wait(deadline);
+  } else {
+    if (timeout != 0) {
+      GRPC_SCHEDULING_START_BLOCKING_REGION;
+    }
+    do {
+      GRPC_STATS_INC_SYSCALL_POLL();
+      r = epoll_wait(g_epoll_set.epfd, g_epoll_set.events, MAX_EPOLL_EVENTS,
+                     timeout);
+    } while (r < 0 && errno == EINTR);
+    if (timeout != 0) {
+      GRPC_SCHEDULING_END_BLOCKING_REGION;
+    }
   }
 
   if (r < 0) return GRPC_OS_ERROR(errno, "epoll_wait");
@@ -734,6 +851,45 @@ static grpc_error* do_epoll_wait(grpc_pollset* ps, grpc_millis deadline) {
   return GRPC_ERROR_NONE;
 }
 
+/* Before parking a non-poller worker on its condition variable, spin for a
+   little while with the pollset lock released: a worker that gets kicked
+   shortly after it started waiting then skips the futex sleep and wakeup
+   altogether. The spin length adapts to how often spinning pays off. With
+   busy polling the worker spins until it is kicked or its deadline passes. */
+static void spin_before_parking(grpc_pollset* pollset,
+                                grpc_pollset_worker* worker,
+                                grpc_millis deadline) {
+  if (g_busy_poll) {
+    gpr_mu_unlock(&pollset->mu);
+    while (gpr_atm_acq_load(&worker->spin_state) == UNKICKED) {
+      grpc_core::ExecCtx::Get()->InvalidateNow();
+      if (poll_deadline_to_millis_timeout(deadline) == 0) break;
+      CPU_RELAX();
+    }
+    gpr_mu_lock(&pollset->mu);
+    return;
+  }
+  gpr_atm iterations = gpr_atm_no_barrier_load(&g_worker_spin_iterations);
+  if (iterations == 0) return;
+  gpr_mu_unlock(&pollset->mu);
+  bool kicked = false;
+  for (gpr_atm i = 0; i < iterations; i++) {
+    if (gpr_atm_acq_load(&worker->spin_state) != UNKICKED) {
+      kicked = true;
+      break;
+    }
+    CPU_RELAX();
+  }
+  gpr_mu_lock(&pollset->mu);
+  if (kicked) {
+    GRPC_STATS_INC_POLLSET_WORKER_SPIN_KICKED();
+    iterations = GPR_MIN(iterations * 2, g_max_spin_iterations);
+  } else {
+    iterations = GPR_MAX(iterations / 2, MIN_WORKER_SPIN_ITERATIONS);
+  }
+  gpr_atm_no_barrier_store(&g_worker_spin_iterations, iterations);
+}
+
 static bool begin_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
                          grpc_pollset_worker** worker_hdl,
                          grpc_millis deadline) {
@@ -814,6 +970,13 @@ static bool begin_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
     GPR_ASSERT(gpr_atm_no_barrier_load(&g_active_poller) != (gpr_atm)worker);
     worker->initialized_cv = true;
     gpr_cv_init(&worker->cv);
+    if (!pollset->shutting_down &&
+        poll_deadline_to_millis_timeout(deadline) != 0) {
+      spin_before_parking(pollset, worker, deadline);
+    }
+    if (worker->state == UNKICKED && !pollset->shutting_down) {
+      GRPC_STATS_INC_POLLSET_WORKER_PARK();
+    }
     while (worker->state == UNKICKED && !pollset->shutting_down) {
       if (grpc_polling_trace.enabled()) {
         gpr_log(GPR_INFO, "PS:%p BEGIN_WAIT:%p kick_state=%s shutdown=%d",
@@ -1113,12 +1276,11 @@ static grpc_error* pollset_kick(grpc_pollset* pollset,
                                      // there is no next worker
                  root_worker == (grpc_pollset_worker*)gpr_atm_no_barrier_load(
                                     &g_active_poller)) {
-        GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD();
         if (grpc_polling_trace.enabled()) {
           gpr_log(GPR_INFO, " .. kicked %p", root_worker);
         }
         SET_KICK_STATE(root_worker, KICKED);
-        ret_err = grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+        ret_err = wakeup_active_poller();
         goto done;
       } else if (next_worker->state == UNKICKED) {
         GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
@@ -1144,13 +1306,12 @@ static grpc_error* pollset_kick(grpc_pollset* pollset,
           }
           goto done;
         } else {
-          GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD();
           if (grpc_polling_trace.enabled()) {
             gpr_log(GPR_INFO, " .. non-root poller %p (root=%p)", next_worker,
                     root_worker);
           }
           SET_KICK_STATE(next_worker, KICKED);
-          ret_err = grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+          ret_err = wakeup_active_poller();
           goto done;
         }
       } else {
@@ -1185,12 +1346,11 @@ static grpc_error* pollset_kick(grpc_pollset* pollset,
     goto done;
   } else if (specific_worker ==
              (grpc_pollset_worker*)gpr_atm_no_barrier_load(&g_active_poller)) {
-    GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD();
     if (grpc_polling_trace.enabled()) {
       gpr_log(GPR_INFO, " .. kick active poller");
     }
     SET_KICK_STATE(specific_worker, KICKED);
-    ret_err = grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+    ret_err = wakeup_active_poller();
     goto done;
   } else if (specific_worker->initialized_cv) {
     GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
@@ -1305,14 +1465,17 @@ static void reset_event_manager_on_fork() {
     fork_fd_list_head = fork_fd_list_head->fork_fd_list->next;
   }
   gpr_mu_unlock(&fork_fd_list_mu);
+  bool busy_poll = g_busy_poll;
   shutdown_engine();
   grpc_init_epoll1_linux(true);
+  g_busy_poll = busy_poll;
 }
 
 /* It is possible that GLIBC has epoll but the underlying kernel doesn't.
  * Create epoll_fd (epoll_set_init() takes care of that) to make sure epoll
  * support is available */
 const grpc_event_engine_vtable* grpc_init_epoll1_linux(bool explicit_request) {
+  g_busy_poll = false;
   if (!grpc_has_wakeup_fd()) {
     gpr_log(GPR_ERROR, "Skipping epoll1 because of no wakeup fd.");
     return nullptr;
@@ -1338,6 +1501,16 @@ const grpc_event_engine_vtable* grpc_init_epoll1_linux(bool explicit_request) {
   return &vtable;
 }
 
+/* Busy polling is never picked automatically: it burns a core per poller */
+const grpc_event_engine_vtable* grpc_init_epoll1_busy_linux(
+    bool explicit_request) {
+  if (!explicit_request) return nullptr;
+  const grpc_event_engine_vtable* engine =
+      grpc_init_epoll1_linux(explicit_request);
+  if (engine != nullptr) g_busy_poll = true;
+  return engine;
+}
+
 #else /* defined(GRPC_LINUX_EPOLL) */
 #if defined(GRPC_POSIX_SOCKET_EV_EPOLL1)
 #include "src/core/lib/iomgr/ev_epoll1_linux.h"
@@ -1346,5 +1519,9 @@ const grpc_event_engine_vtable* grpc_init_epoll1_linux(bool explicit_request) {
 const grpc_event_engine_vtable* grpc_init_epoll1_linux(bool explicit_request) {
   return nullptr;
 }
+const grpc_event_engine_vtable* grpc_init_epoll1_busy_linux(
+    bool explicit_request) {
+  return nullptr;
+}
 #endif /* defined(GRPC_POSIX_SOCKET_EV_EPOLL1) */
 #endif /* !defined(GRPC_LINUX_EPOLL) */
@@ -28,4 +28,19 @@
 
 const grpc_event_engine_vtable* grpc_init_epoll1_linux(bool explicit_request);
 
+// the same engine, with pollers that spin on epoll_wait() with a zero timeout
+// instead of blocking; only used when requested by name ("epoll1-busy")
+const grpc_event_engine_vtable* grpc_init_epoll1_busy_linux(
+    bool explicit_request);
+
+// Exposed for testing: maps each of num_cpus cpus to one of
+// num_neighborhoods pollset neighborhoods, given the NUMA node of each cpu
+// in [0, num_nodes). The cpus are ranked by (node, cpu) and that order is
+// split into equal blocks, so that a neighborhood spans as few nodes as
+// possible.
+void grpc_epoll1_map_cpu_neighborhoods(const unsigned* cpu_nodes,
+                                       size_t num_cpus, size_t num_nodes,
+                                       size_t num_neighborhoods,
+                                       size_t* cpu_neighborhoods);
+
 #endif /* GRPC_CORE_LIB_IOMGR_EV_EPOLL1_LINUX_H */
@@ -318,6 +318,28 @@ grpc_error* grpc_set_socket_tcp_user_timeout(
   return GRPC_ERROR_NONE;
 }
 
+/* Set SO_BUSY_POLL */
+grpc_error* grpc_set_socket_busy_poll(int fd,
+                                      const grpc_channel_args* channel_args) {
+  const grpc_arg* arg =
+      grpc_channel_args_find(channel_args, GRPC_ARG_SOCKET_BUSY_POLL_US);
+  if (arg == nullptr) return GRPC_ERROR_NONE;
+  int busy_poll_us =
+      grpc_channel_arg_get_integer(arg, grpc_integer_options{0, 0, INT_MAX});
+  if (busy_poll_us == 0) return GRPC_ERROR_NONE;
+#ifdef SO_BUSY_POLL
+  if (0 != setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &busy_poll_us,
+                      sizeof(busy_poll_us))) {
+    /* Do not fail: this is an optimization, and raising it above the system
+       default needs privileges the process may not have. */
+    gpr_log(GPR_ERROR, "setsockopt(SO_BUSY_POLL) %s", strerror(errno));
+  }
+#else
+  gpr_log(GPR_ERROR, "SO_BUSY_POLL not supported for this platform");
+#endif /* SO_BUSY_POLL */
+  return GRPC_ERROR_NONE;
+}
+
 /* set a socket using a grpc_socket_mutator */
 grpc_error* grpc_set_socket_with_mutator(int fd, grpc_socket_mutator* mutator) {
   GPR_ASSERT(mutator);
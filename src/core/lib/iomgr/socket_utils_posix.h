@@ -60,6 +60,11 @@ void config_default_tcp_user_timeout(bool enable, int timeout, bool is_client);
 grpc_error* grpc_set_socket_tcp_user_timeout(
     int fd, const grpc_channel_args* channel_args, bool is_client);
 
+/* Set SO_BUSY_POLL from GRPC_ARG_SOCKET_BUSY_POLL_US in channel_args, if
+   present and supported */
+grpc_error* grpc_set_socket_busy_poll(int fd,
+                                      const grpc_channel_args* channel_args);
+
 /* Returns true if this system can create AF_INET6 sockets bound to ::1.
    The value is probed once, and cached for the life of the process.
 
@@ -743,4 +743,138 @@ void GrpcUdpListener::OnDestroy() {
   }
 }
 
+#ifdef GRPC_LINUX_MMSG
+typedef struct mmsghdr grpc_udp_msg_header;
+#define GRPC_UDP_MSG_HDR(h) ((h)->msg_hdr)
+#else
+typedef struct msghdr grpc_udp_msg_header;
+#define GRPC_UDP_MSG_HDR(h) (*(h))
+#endif
+
+GrpcUdpDatagramBatch::GrpcUdpDatagramBatch(size_t capacity,
+                                           size_t max_datagram_size)
+    : capacity_(capacity), max_datagram_size_(max_datagram_size) {
+  GPR_ASSERT(capacity > 0);
+  GPR_ASSERT(max_datagram_size > 0);
+  buffer_ = static_cast<char*>(gpr_malloc(capacity * max_datagram_size));
+  lengths_ = static_cast<size_t*>(gpr_zalloc(capacity * sizeof(*lengths_)));
+  peers_ = static_cast<grpc_resolved_address*>(
+      gpr_zalloc(capacity * sizeof(*peers_)));
+  iovecs_ = gpr_zalloc(capacity * sizeof(struct iovec));
+  headers_ = gpr_zalloc(capacity * sizeof(grpc_udp_msg_header));
+}
+
+GrpcUdpDatagramBatch::~GrpcUdpDatagramBatch() {
+  gpr_free(headers_);
+  gpr_free(iovecs_);
+  gpr_free(peers_);
+  gpr_free(lengths_);
+  gpr_free(buffer_);
+}
+
+void GrpcUdpDatagramBatch::Clear() {
+  count_ = 0;
+  sent_ = 0;
+}
+
+void GrpcUdpDatagramBatch::PrepareHeader(size_t i, size_t len,
+                                         socklen_t peer_len) {
+  struct iovec* iov = static_cast<struct iovec*>(iovecs_) + i;
+  iov->iov_base = buffer_ + i * max_datagram_size_;
+  iov->iov_len = len;
+  grpc_udp_msg_header* header =
+      static_cast<grpc_udp_msg_header*>(headers_) + i;
+  memset(header, 0, sizeof(*header));
+  struct msghdr* msg = &GRPC_UDP_MSG_HDR(header);
+  msg->msg_name = peers_[i].addr;
+  msg->msg_namelen = peer_len;
+  msg->msg_iov = iov;
+  msg->msg_iovlen = 1;
+}
+
+int GrpcUdpDatagramBatch::RecvFrom(int fd) {
+  Clear();
+  for (size_t i = 0; i < capacity_; ++i) {
+    PrepareHeader(i, max_datagram_size_, sizeof(peers_[i].addr));
+  }
+  grpc_udp_msg_header* headers = static_cast<grpc_udp_msg_header*>(headers_);
+  int received;
+#ifdef GRPC_LINUX_MMSG
+  do {
+    received = recvmmsg(fd, headers, static_cast<unsigned int>(capacity_),
+                        MSG_DONTWAIT, nullptr);
+  } while (received < 0 && errno == EINTR);
+  if (received < 0) {
+    return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+  }
+  for (int i = 0; i < received; ++i) {
+    lengths_[i] = headers[i].msg_len;
+  }
+#else
+  for (received = 0; static_cast<size_t>(received) < capacity_; ++received) {
+    ssize_t len;
+    do {
+      len = recvmsg(fd, &headers[received], MSG_DONTWAIT);
+    } while (len < 0 && errno == EINTR);
+    if (len < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+      if (received == 0) return -1;
+      break;
+    }
+    lengths_[received] = static_cast<size_t>(len);
+  }
+#endif
+  for (int i = 0; i < received; ++i) {
+    // A datagram longer than the buffer has been truncated to it.
+    if (lengths_[i] > max_datagram_size_) lengths_[i] = max_datagram_size_;
+    peers_[i].len = GRPC_UDP_MSG_HDR(&headers[i]).msg_namelen;
+  }
+  count_ = static_cast<size_t>(received);
+  return received;
+}
+
+bool GrpcUdpDatagramBatch::Add(const void* data, size_t len,
+                               const grpc_resolved_address* peer) {
+  if (sent_ > 0 && sent_ == count_) Clear();
+  if (count_ == capacity_ || len > max_datagram_size_) return false;
+  memcpy(buffer_ + count_ * max_datagram_size_, data, len);
+  lengths_[count_] = len;
+  memcpy(&peers_[count_], peer, sizeof(*peer));
+  PrepareHeader(count_, len, peer->len);
+  ++count_;
+  return true;
+}
+
+int GrpcUdpDatagramBatch::SendTo(int fd) {
+  grpc_udp_msg_header* headers = static_cast<grpc_udp_msg_header*>(headers_);
+  int sent_now = 0;
+  while (sent_ < count_) {
+#ifdef GRPC_LINUX_MMSG
+    int sent;
+    do {
+      sent = sendmmsg(fd, headers + sent_,
+                      static_cast<unsigned int>(count_ - sent_), MSG_DONTWAIT);
+    } while (sent < 0 && errno == EINTR);
+#else
+    ssize_t sent;
+    do {
+      sent = sendmsg(fd, &headers[sent_], MSG_DONTWAIT);
+    } while (sent < 0 && errno == EINTR);
+    if (sent >= 0) sent = 1;
+#endif
+    if (sent < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+      // Drop the datagram that failed so that it does not hold up the rest.
+      int saved_errno = errno;
+      if (++sent_ == count_) Clear();
+      errno = saved_errno;
+      return sent_now > 0 ? sent_now : -1;
+    }
+    sent_ += static_cast<size_t>(sent);
+    sent_now += static_cast<int>(sent);
+  }
+  if (sent_ == count_) Clear();
+  return sent_now;
+}
+
 #endif
@@ -74,6 +74,70 @@ class GrpcUdpHandlerFactory {
   GRPC_ABSTRACT_BASE_CLASS
 };
 
+/* A reusable set of datagram buffers for GrpcUdpHandler implementations that
+ * want to move several datagrams per system call. On Linux a batch is
+ * received with a single recvmmsg() and sent with a single sendmmsg();
+ * elsewhere it falls back to one recvmsg()/sendmsg() per datagram. The
+ * buffers are allocated once up front, so a handler can keep one batch per
+ * socket and reuse it on every Read() without allocating.
+ * Not thread safe. */
+class GrpcUdpDatagramBatch {
+ public:
+  /* Holds up to |capacity| datagrams of at most |max_datagram_size| bytes. */
+  GrpcUdpDatagramBatch(size_t capacity, size_t max_datagram_size);
+  ~GrpcUdpDatagramBatch();
+
+  GrpcUdpDatagramBatch(const GrpcUdpDatagramBatch&) = delete;
+  GrpcUdpDatagramBatch& operator=(const GrpcUdpDatagramBatch&) = delete;
+
+  /* Replaces the contents of the batch with as many datagrams as are
+   * immediately available on the non-blocking socket |fd|, up to capacity().
+   * Datagrams longer than max_datagram_size() are truncated. Returns the
+   * number of datagrams received, 0 if none was available, or -1 on error
+   * with errno set. */
+  int RecvFrom(int fd);
+
+  /* Queues a copy of |data| to be sent to |peer| by the next SendTo(). Returns
+   * false if the batch is full or |len| exceeds max_datagram_size(). */
+  bool Add(const void* data, size_t len, const grpc_resolved_address* peer);
+
+  /* Sends the queued datagrams on the non-blocking socket |fd|. Returns the
+   * number of datagrams sent by this call, or -1 with errno set if the first
+   * of them failed. A datagram that fails is dropped; the ones that could not
+   * be sent because the socket would block stay queued and go first on the
+   * next SendTo(). The batch is cleared once all of them have been sent. */
+  int SendTo(int fd);
+
+  /* Drops all datagrams in the batch. */
+  void Clear();
+
+  size_t size() const { return count_; }
+  size_t capacity() const { return capacity_; }
+  size_t max_datagram_size() const { return max_datagram_size_; }
+
+  /* Accessors for the |i|-th datagram, i < size(). */
+  const char* data(size_t i) const { return buffer_ + i * max_datagram_size_; }
+  size_t length(size_t i) const { return lengths_[i]; }
+  const grpc_resolved_address& peer(size_t i) const { return peers_[i]; }
+
+ private:
+  void PrepareHeader(size_t i, size_t len, socklen_t peer_len);
+
+  const size_t capacity_;
+  const size_t max_datagram_size_;
+  // Number of datagrams in the batch.
+  size_t count_ = 0;
+  // Number of datagrams of the batch already sent by SendTo().
+  size_t sent_ = 0;
+  char* buffer_;
+  size_t* lengths_;
+  grpc_resolved_address* peers_;
+  // struct iovec and struct mmsghdr (or struct msghdr) arrays, kept opaque so
+  // that this header does not need the socket headers.
+  void* iovecs_;
+  void* headers_;
+};
+
 /* Create a server, initially not bound to any ports */
 grpc_udp_server* grpc_udp_server_create(const grpc_channel_args* args);
 
@@ -30,6 +30,7 @@
 #include "src/core/lib/iomgr/iomgr_internal.h" /* for iomgr_abort_on_leaks() */
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
+#include "src/core/lib/transport/registered_metadata.h"
 #include "src/core/lib/transport/static_metadata.h"
 
 #define LOG2_SHARD_COUNT 5
@@ -70,6 +71,7 @@ static static_metadata_hash_ent
     static_metadata_hash[4 * GRPC_STATIC_MDSTR_COUNT];
 static uint32_t max_static_metadata_hash_probe;
 static uint32_t static_metadata_hash_values[GRPC_STATIC_MDSTR_COUNT];
+static uint32_t registered_metadata_hash_values[GRPC_REGISTERED_MDSTR_MAX];
 
 static void interned_slice_ref(void* p) {
   interned_slice_refcount* s = static_cast<interned_slice_refcount*>(p);
@@ -171,6 +173,27 @@ int grpc_static_slice_eq(grpc_slice a, grpc_slice b) {
   return GRPC_STATIC_METADATA_INDEX(a) == GRPC_STATIC_METADATA_INDEX(b);
 }
 
+uint32_t grpc_registered_slice_hash(grpc_slice s) {
+  return registered_metadata_hash_values[GRPC_REGISTERED_METADATA_INDEX(s)];
+}
+
+int grpc_registered_slice_eq(grpc_slice a, grpc_slice b) {
+  return GRPC_REGISTERED_METADATA_INDEX(a) == GRPC_REGISTERED_METADATA_INDEX(b);
+}
+
+/* there are only a handful of registered keys: scan them */
+static bool find_registered_slice(grpc_slice slice, uint32_t hash,
+                                  grpc_slice* registered_slice) {
+  for (size_t i = 0; i < grpc_registered_mdstr_count; i++) {
+    if (registered_metadata_hash_values[i] == hash &&
+        grpc_slice_eq(grpc_registered_slice_table[i], slice)) {
+      *registered_slice = grpc_registered_slice_table[i];
+      return true;
+    }
+  }
+  return false;
+}
+
 uint32_t grpc_slice_hash(grpc_slice s) {
   return s.refcount == nullptr ? grpc_slice_default_hash_impl(s)
                                : s.refcount->vtable->hash(s);
@@ -178,7 +201,8 @@ uint32_t grpc_slice_hash(grpc_slice s) {
 
 grpc_slice grpc_slice_maybe_static_intern(grpc_slice slice,
                                           bool* returned_slice_is_different) {
-  if (GRPC_IS_STATIC_METADATA_STRING(slice)) {
+  if (GRPC_IS_STATIC_METADATA_STRING(slice) ||
+      GRPC_IS_REGISTERED_METADATA_STRING(slice)) {
     return slice;
   }
 
@@ -193,17 +217,25 @@ grpc_slice grpc_slice_maybe_static_intern(grpc_slice slice,
     }
   }
 
+  grpc_slice registered_slice;
+  if (find_registered_slice(slice, hash, &registered_slice)) {
+    *returned_slice_is_different = true;
+    return registered_slice;
+  }
+
   return slice;
 }
 
 bool grpc_slice_is_interned(grpc_slice slice) {
   return (slice.refcount && slice.refcount->vtable == &interned_slice_vtable) ||
-         GRPC_IS_STATIC_METADATA_STRING(slice);
+         GRPC_IS_STATIC_METADATA_STRING(slice) ||
+         GRPC_IS_REGISTERED_METADATA_STRING(slice);
 }
 
 grpc_slice grpc_slice_intern(grpc_slice slice) {
   GPR_TIMER_SCOPE("grpc_slice_intern", 0);
-  if (GRPC_IS_STATIC_METADATA_STRING(slice)) {
+  if (GRPC_IS_STATIC_METADATA_STRING(slice) ||
+      GRPC_IS_REGISTERED_METADATA_STRING(slice)) {
     return slice;
   }
 
@@ -217,6 +249,11 @@ grpc_slice grpc_slice_intern(grpc_slice slice) {
     }
   }
 
+  grpc_slice registered_slice;
+  if (find_registered_slice(slice, hash, &registered_slice)) {
+    return registered_slice;
+  }
+
   interned_slice_refcount* s;
   slice_shard* shard = &g_shards[SHARD_IDX(hash)];
 
@@ -304,9 +341,15 @@ void grpc_slice_intern_init(void) {
       }
     }
   }
+  for (size_t i = 0; i < grpc_registered_mdstr_count; i++) {
+    registered_metadata_hash_values[i] =
+        grpc_slice_default_hash_impl(grpc_registered_slice_table[i]);
+  }
+  grpc_registered_metadata_frozen = true;
 }
 
 void grpc_slice_intern_shutdown(void) {
+  grpc_registered_metadata_frozen = false;
   for (size_t i = 0; i < SHARD_COUNT; i++) {
     slice_shard* shard = &g_shards[i];
     gpr_mu_destroy(&shard->mu);
@@ -37,7 +37,7 @@ bool grpc_slice_is_interned(grpc_slice slice);
 void grpc_slice_intern_init(void);
 void grpc_slice_intern_shutdown(void);
 void grpc_test_only_set_slice_hash_seed(uint32_t key);
-// if slice matches a static slice, returns the static slice
+// if slice matches a static or registered slice, returns that slice
 // otherwise returns the passed in slice (without reffing it)
 // used for surface boundaries where we might receive an un-interned static
 // string
@@ -45,6 +45,8 @@ grpc_slice grpc_slice_maybe_static_intern(grpc_slice slice,
                                           bool* returned_slice_is_different);
 uint32_t grpc_static_slice_hash(grpc_slice s);
 int grpc_static_slice_eq(grpc_slice a, grpc_slice b);
+uint32_t grpc_registered_slice_hash(grpc_slice s);
+int grpc_registered_slice_eq(grpc_slice a, grpc_slice b);
 
 // Returns the memory used by this slice, not counting the slice structure
 // itself. This means that inlined and slices from static strings will return
@@ -65,9 +65,10 @@ int grpc_byte_buffer_reader_init(grpc_byte_buffer_reader* reader,
           memset(reader, 0, sizeof(*reader));
           return 0;
         } else { /* all fine */
-          reader->buffer_out =
-              grpc_raw_byte_buffer_create(decompressed_slices_buffer.slices,
-                                          decompressed_slices_buffer.count);
+          /* move the decompressed slices instead of taking a ref on each */
+          reader->buffer_out = grpc_raw_byte_buffer_create(nullptr, 0);
+          grpc_slice_buffer_swap(&reader->buffer_out->data.raw.slice_buffer,
+                                 &decompressed_slices_buffer);
         }
         grpc_slice_buffer_destroy_internal(&decompressed_slices_buffer);
       } else { /* not compressed, use the input buffer as output */
@@ -109,19 +110,41 @@ int grpc_byte_buffer_reader_next(grpc_byte_buffer_reader* reader,
   return 0;
 }
 
+int grpc_byte_buffer_reader_peek(grpc_byte_buffer_reader* reader,
+                                 grpc_slice** slice) {
+  switch (reader->buffer_in->type) {
+    case GRPC_BB_RAW: {
+      grpc_slice_buffer* slice_buffer;
+      slice_buffer = &reader->buffer_out->data.raw.slice_buffer;
+      if (reader->current.index < slice_buffer->count) {
+        *slice = &slice_buffer->slices[reader->current.index];
+        reader->current.index += 1;
+        return 1;
+      }
+      break;
+    }
+  }
+  return 0;
+}
+
 grpc_slice grpc_byte_buffer_reader_readall(grpc_byte_buffer_reader* reader) {
-  grpc_slice in_slice;
+  grpc_slice* in_slice;
   size_t bytes_read = 0;
+  grpc_slice_buffer* slice_buffer = &reader->buffer_out->data.raw.slice_buffer;
+  /* a buffer made of a single slice is already contiguous: share it */
+  if (slice_buffer->count == 1 && reader->current.index == 0) {
+    GPR_ASSERT(grpc_byte_buffer_reader_peek(reader, &in_slice) != 0);
+    return grpc_slice_ref_internal(*in_slice);
+  }
   const size_t input_size = grpc_byte_buffer_length(reader->buffer_out);
   grpc_slice out_slice = GRPC_SLICE_MALLOC(input_size);
   uint8_t* const outbuf = GRPC_SLICE_START_PTR(out_slice); /* just an alias */
 
-  grpc_core::ExecCtx exec_ctx;
-  while (grpc_byte_buffer_reader_next(reader, &in_slice) != 0) {
-    const size_t slice_length = GRPC_SLICE_LENGTH(in_slice);
-    memcpy(&(outbuf[bytes_read]), GRPC_SLICE_START_PTR(in_slice), slice_length);
+  while (grpc_byte_buffer_reader_peek(reader, &in_slice) != 0) {
+    const size_t slice_length = GRPC_SLICE_LENGTH(*in_slice);
+    memcpy(&(outbuf[bytes_read]), GRPC_SLICE_START_PTR(*in_slice),
+           slice_length);
     bytes_read += slice_length;
-    grpc_slice_unref_internal(in_slice);
     GPR_ASSERT(bytes_read <= input_size);
   }
 
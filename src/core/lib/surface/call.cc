@@ -273,7 +273,8 @@ grpc_core::TraceFlag grpc_compression_trace(false, "compression");
   CALL_FROM_CALL_STACK(grpc_call_stack_from_top_element(top_elem))
 
 static void execute_batch(grpc_call* call, grpc_transport_stream_op_batch* op,
-                          grpc_closure* start_batch_closure);
+                          grpc_closure* start_batch_closure,
+                          bool run_inline_if_idle);
 
 static void cancel_with_status(grpc_call* c, grpc_status_code status,
                                const char* description);
@@ -615,15 +616,25 @@ static void execute_batch_in_call_combiner(void* arg, grpc_error* ignored) {
 }
 
 // start_batch_closure points to a caller-allocated closure to be used
-// for entering the call combiner.
+// for entering the call combiner.  If run_inline_if_idle is true and
+// nothing else is running in the call combiner, the batch is sent down the
+// filter stack right away, on the caller's stack and under whatever locks
+// the caller holds.
 static void execute_batch(grpc_call* call,
                           grpc_transport_stream_op_batch* batch,
-                          grpc_closure* start_batch_closure) {
+                          grpc_closure* start_batch_closure,
+                          bool run_inline_if_idle) {
   batch->handler_private.extra_arg = call;
   GRPC_CLOSURE_INIT(start_batch_closure, execute_batch_in_call_combiner, batch,
                     grpc_schedule_on_exec_ctx);
-  GRPC_CALL_COMBINER_START(&call->call_combiner, start_batch_closure,
-                           GRPC_ERROR_NONE, "executing batch");
+  if (run_inline_if_idle) {
+    GRPC_CALL_COMBINER_START_INLINE_IF_IDLE(&call->call_combiner,
+                                            start_batch_closure,
+                                            GRPC_ERROR_NONE, "executing batch");
+  } else {
+    GRPC_CALL_COMBINER_START(&call->call_combiner, start_batch_closure,
+                             GRPC_ERROR_NONE, "executing batch");
+  }
 }
 
 char* grpc_call_get_peer(grpc_call* call) {
@@ -691,7 +702,7 @@ static void cancel_with_error(grpc_call* c, grpc_error* error) {
       grpc_make_transport_stream_op(&state->finish_batch);
   op->cancel_stream = true;
   op->payload->cancel_stream.cancel_error = error;
-  execute_batch(c, op, &state->start_batch);
+  execute_batch(c, op, &state->start_batch, false /* run_inline_if_idle */);
 }
 
 void grpc_call_cancel_internal(grpc_call* call) {
@@ -1861,7 +1872,18 @@ static grpc_call_error call_start_batch(grpc_call* call, const grpc_op* ops,
   }
 
   gpr_atm_rel_store(&call->any_ops_sent_atm, 1);
-  execute_batch(call, stream_op, &bctl->start_batch);
+  // Batches from the public API enter an idle call combiner inline. This
+  // does not change which thread runs the filter stack, nor the locks held
+  // while it runs: the ExecCtx created by grpc_call_start_batch() used to
+  // run the scheduled batch before returning anyway. That includes the
+  // application's own mutex if it holds one, and whatever core holds when
+  // it runs a callback-CQ functor that starts a batch. What changes is that
+  // the batch now runs ahead of the closures already on that ExecCtx.
+  // Internal callers of grpc_call_start_batch_and_execute() may hold locks
+  // that the filter stack takes; their ExecCtx is only flushed once those
+  // are released, so their batches are always scheduled.
+  execute_batch(call, stream_op, &bctl->start_batch,
+                !is_notify_tag_closure /* run_inline_if_idle */);
 
 done:
   return error;
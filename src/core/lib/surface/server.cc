@@ -36,6 +36,7 @@
 #include "src/core/lib/gpr/mpscq.h"
 #include "src/core/lib/gpr/spinlock.h"
 #include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/iomgr.h"
 #include "src/core/lib/slice/slice_internal.h"
@@ -44,7 +45,10 @@
 #include "src/core/lib/surface/channel.h"
 #include "src/core/lib/surface/completion_queue.h"
 #include "src/core/lib/surface/init.h"
+#include "src/core/lib/surface/server_response_cache.h"
+#include "src/core/lib/transport/byte_stream.h"
 #include "src/core/lib/transport/metadata.h"
+#include "src/core/lib/transport/service_config.h"
 #include "src/core/lib/transport/static_metadata.h"
 
 grpc_core::TraceFlag grpc_server_channel_trace(false, "server_channel");
@@ -52,6 +56,9 @@ grpc_core::TraceFlag grpc_server_channel_trace(false, "server_channel");
 static void server_on_recv_initial_metadata(void* ptr, grpc_error* error);
 static void server_recv_trailing_metadata_ready(void* user_data,
                                                 grpc_error* error);
+static void on_send_message_next_done(void* arg, grpc_error* error);
+static void send_message_on_complete(void* arg, grpc_error* error);
+static void cached_response_done(void* arg, grpc_error* error);
 
 namespace {
 struct listener {
@@ -143,6 +150,13 @@ struct call_data {
     GRPC_CLOSURE_INIT(&recv_trailing_metadata_ready,
                       server_recv_trailing_metadata_ready, elem,
                       grpc_schedule_on_exec_ctx);
+    GRPC_CLOSURE_INIT(&on_send_message_next_done, ::on_send_message_next_done,
+                      elem, grpc_schedule_on_exec_ctx);
+    GRPC_CLOSURE_INIT(&send_message_on_complete, ::send_message_on_complete,
+                      elem, grpc_schedule_on_exec_ctx);
+    GRPC_CLOSURE_INIT(&cached_response_done, ::cached_response_done, elem,
+                      grpc_schedule_on_exec_ctx);
+    grpc_slice_buffer_init(&response_message);
   }
   ~call_data() {
     GPR_ASSERT(state != PENDING);
@@ -155,6 +169,9 @@ struct call_data {
     }
     grpc_metadata_array_destroy(&initial_metadata);
     grpc_byte_buffer_destroy(payload);
+    grpc_slice_unref_internal(response_cache_key);
+    grpc_slice_buffer_destroy_internal(&response_message);
+    grpc_byte_buffer_destroy(cached_response);
   }
 
   grpc_call* call;
@@ -175,6 +192,8 @@ struct call_data {
       grpc_metadata_array();  // Zero-initialize the C struct.
 
   request_matcher* matcher = nullptr;
+  /* null for unregistered methods */
+  registered_method* method = nullptr;
   grpc_byte_buffer* payload = nullptr;
 
   grpc_closure got_initial_metadata;
@@ -191,6 +210,26 @@ struct call_data {
 
   call_data* pending_next = nullptr;
   grpc_call_combiner* call_combiner;
+
+  /* State for calls to methods with a response cache TTL whose request missed
+     the cache: the response is cached if it turns out to be cacheable. */
+  bool response_cacheable = false;
+  grpc_slice response_cache_key = grpc_empty_slice();
+  bool response_message_seen = false;
+  grpc_slice_buffer response_message;
+  grpc_transport_stream_op_batch* send_message_batch = nullptr;
+  size_t send_message_bytes_read = 0;
+  grpc_core::ManualConstructor<grpc_core::ByteStreamCache> send_message_cache;
+  grpc_core::ManualConstructor<grpc_core::ByteStreamCache::CachingByteStream>
+      send_message_caching_stream;
+  grpc_closure on_send_message_next_done;
+  grpc_closure* original_send_message_on_complete = nullptr;
+  grpc_closure send_message_on_complete;
+
+  /* State for calls answered from the response cache */
+  grpc_byte_buffer* cached_response = nullptr;
+  int cached_response_cancelled = 0;
+  grpc_closure cached_response_done;
 };
 
 struct request_matcher {
@@ -205,6 +244,9 @@ struct registered_method {
   char* host;
   grpc_server_register_method_payload_handling payload_handling;
   uint32_t flags;
+  /* how long responses are cached, from the service config; 0 if they are
+     not */
+  grpc_millis response_cache_ttl;
   /* one request matcher per method */
   request_matcher matcher;
   registered_method* next;
@@ -261,6 +303,9 @@ struct grpc_server {
   gpr_timespec last_shutdown_message_time;
 
   grpc_core::RefCountedPtr<grpc_core::channelz::ServerNode> channelz_server;
+
+  /* null unless some registered method has a response cache TTL */
+  grpc_core::RefCountedPtr<grpc_core::ServerResponseCache> response_cache;
 };
 
 #define SERVER_FROM_CALL_ELEM(elem) \
@@ -407,6 +452,10 @@ static void server_delete(grpc_server* server) {
   registered_method* rm;
   size_t i;
   server->channelz_server.reset();
+  if (server->response_cache != nullptr) {
+    server->response_cache->Shutdown();
+    server->response_cache.reset();
+  }
   grpc_channel_args_destroy(server->channel_args);
   gpr_mu_destroy(&server->mu_global);
   gpr_mu_destroy(&server->mu_call);
@@ -515,6 +564,52 @@ static void publish_call(grpc_server* server, call_data* calld, size_t cq_idx,
                  rc, &rc->completion);
 }
 
+static void cached_response_done(void* arg, grpc_error* error) {
+  grpc_call_element* elem = static_cast<grpc_call_element*>(arg);
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  grpc_call_unref(calld->call);
+}
+
+/* Answers the call from the response cache if its method has a response
+   cache TTL and the cache holds a response to its request. Returns false if
+   the call must be published to the application. */
+static bool maybe_respond_from_cache(grpc_server* server,
+                                     grpc_call_element* elem) {
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  if (server->response_cache == nullptr || calld->method == nullptr ||
+      calld->method->response_cache_ttl == 0 || calld->payload == nullptr) {
+    return false;
+  }
+  grpc_slice key = grpc_core::ServerResponseCache::MakeKey(
+      calld->host, calld->path, calld->payload);
+  calld->cached_response = server->response_cache->Lookup(key);
+  if (calld->cached_response == nullptr) {
+    /* cache the response the application sends, see
+       maybe_capture_response() */
+    calld->response_cache_key = key;
+    calld->response_cacheable = true;
+    return false;
+  }
+  grpc_slice_unref_internal(key);
+  gpr_atm_no_barrier_store(&calld->state, ACTIVATED);
+  grpc_op ops[4];
+  memset(ops, 0, sizeof(ops));
+  ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+  ops[1].op = GRPC_OP_SEND_MESSAGE;
+  ops[1].data.send_message.send_message = calld->cached_response;
+  ops[2].op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+  ops[2].data.send_status_from_server.status = GRPC_STATUS_OK;
+  ops[3].op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+  ops[3].data.recv_close_on_server.cancelled =
+      &calld->cached_response_cancelled;
+  /* the server owns the call until it is published, so it drops the call
+     once the response is sent, in cached_response_done() */
+  grpc_call_error err = grpc_call_start_batch_and_execute(
+      calld->call, ops, GPR_ARRAY_SIZE(ops), &calld->cached_response_done);
+  GPR_ASSERT(err == GRPC_CALL_OK);
+  return true;
+}
+
 static void publish_new_rpc(void* arg, grpc_error* error) {
   grpc_call_element* call_elem = static_cast<grpc_call_element*>(arg);
   call_data* calld = static_cast<call_data*>(call_elem->call_data);
@@ -532,6 +627,8 @@ static void publish_new_rpc(void* arg, grpc_error* error) {
     return;
   }
 
+  if (maybe_respond_from_cache(server, call_elem)) return;
+
   for (size_t i = 0; i < server->cq_count; i++) {
     size_t cq_idx = (chand->cq_idx + i) % server->cq_count;
     requested_call* rc = reinterpret_cast<requested_call*>(
@@ -637,6 +734,7 @@ static void start_new_rpc(grpc_call_element* elem) {
                 GRPC_INITIAL_METADATA_IDEMPOTENT_REQUEST)) {
         continue;
       }
+      calld->method = rm->server_registered_method;
       finish_start_new_rpc(server, elem, &rm->server_registered_method->matcher,
                            rm->server_registered_method->payload_handling);
       return;
@@ -654,6 +752,7 @@ static void start_new_rpc(grpc_call_element* elem) {
                 GRPC_INITIAL_METADATA_IDEMPOTENT_REQUEST)) {
         continue;
       }
+      calld->method = rm->server_registered_method;
       finish_start_new_rpc(server, elem, &rm->server_registered_method->matcher,
                            rm->server_registered_method->payload_handling);
       return;
@@ -826,9 +925,132 @@ static void server_mutate_op(grpc_call_element* elem,
   }
 }
 
+static void send_message_on_complete(void* arg, grpc_error* error) {
+  grpc_call_element* elem = static_cast<grpc_call_element*>(arg);
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  calld->send_message_cache.Destroy();
+  GRPC_CLOSURE_RUN(calld->original_send_message_on_complete,
+                   GRPC_ERROR_REF(error));
+}
+
+/* Pulls a slice from the send_message byte stream, updating
+   calld->send_message_bytes_read. */
+static grpc_error* pull_slice_from_send_message(call_data* calld) {
+  grpc_slice incoming_slice;
+  grpc_error* error = calld->send_message_caching_stream->Pull(&incoming_slice);
+  if (error == GRPC_ERROR_NONE) {
+    calld->send_message_bytes_read += GRPC_SLICE_LENGTH(incoming_slice);
+    grpc_slice_unref_internal(incoming_slice);
+  }
+  return error;
+}
+
+/* Reads as many slices as possible from the send_message byte stream. Upon
+   successful return, if calld->send_message_bytes_read ==
+   calld->send_message_caching_stream->length(), then we have completed
+   reading from the byte stream; otherwise, an async read has been dispatched
+   and on_send_message_next_done() will be invoked when it is complete. */
+static grpc_error* read_all_available_send_message_data(call_data* calld) {
+  while (calld->send_message_bytes_read <
+             calld->send_message_caching_stream->length() &&
+         calld->send_message_caching_stream->Next(
+             SIZE_MAX, &calld->on_send_message_next_done)) {
+    grpc_error* error = pull_slice_from_send_message(calld);
+    if (error != GRPC_ERROR_NONE) return error;
+  }
+  return GRPC_ERROR_NONE;
+}
+
+/* Async callback for ByteStream::Next(). The message was not available
+   synchronously, so it is not cached: reset the byte stream and send the
+   batch down as-is. */
+static void on_send_message_next_done(void* arg, grpc_error* error) {
+  grpc_call_element* elem = static_cast<grpc_call_element*>(arg);
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  if (error != GRPC_ERROR_NONE) {
+    grpc_transport_stream_op_batch_finish_with_failure(
+        calld->send_message_batch, GRPC_ERROR_REF(error),
+        calld->call_combiner);
+    return;
+  }
+  error = pull_slice_from_send_message(calld);
+  if (error != GRPC_ERROR_NONE) {
+    grpc_transport_stream_op_batch_finish_with_failure(
+        calld->send_message_batch, error, calld->call_combiner);
+    return;
+  }
+  calld->send_message_caching_stream->Reset();
+  grpc_call_next_op(elem, calld->send_message_batch);
+}
+
+/* Follows the response of a call whose request missed the response cache,
+   and caches it if it is a single uncompressed message with no metadata and
+   an OK status. Returns true if the batch will be sent down asynchronously. */
+static bool maybe_capture_response(grpc_call_element* elem,
+                                   grpc_transport_stream_op_batch* op) {
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  if (!calld->response_cacheable) return false;
+  if (op->send_initial_metadata &&
+      op->payload->send_initial_metadata.send_initial_metadata->list.count !=
+          0) {
+    calld->response_cacheable = false;
+  }
+  if (op->send_message && calld->response_cacheable) {
+    if (calld->response_message_seen ||
+        (op->payload->send_message.send_message->flags() &
+         GRPC_WRITE_INTERNAL_COMPRESS)) {
+      calld->response_cacheable = false;
+    } else {
+      calld->response_message_seen = true;
+      calld->send_message_cache.Init(
+          std::move(op->payload->send_message.send_message));
+      calld->send_message_caching_stream.Init(calld->send_message_cache.get());
+      op->payload->send_message.send_message.reset(
+          calld->send_message_caching_stream.get());
+      calld->original_send_message_on_complete = op->on_complete;
+      op->on_complete = &calld->send_message_on_complete;
+      calld->send_message_batch = op;
+      grpc_error* error = read_all_available_send_message_data(calld);
+      if (error != GRPC_ERROR_NONE) {
+        calld->response_cacheable = false;
+        grpc_transport_stream_op_batch_finish_with_failure(
+            op, error, calld->call_combiner);
+        return true;
+      }
+      if (calld->send_message_bytes_read <
+          calld->send_message_caching_stream->length()) {
+        calld->response_cacheable = false;
+        return true;
+      }
+      grpc_slice_buffer* message = calld->send_message_cache->cache_buffer();
+      for (size_t i = 0; i < message->count; i++) {
+        grpc_slice_buffer_add(&calld->response_message,
+                              grpc_slice_ref_internal(message->slices[i]));
+      }
+      calld->send_message_caching_stream->Reset();
+    }
+  }
+  if (op->send_trailing_metadata && calld->response_cacheable) {
+    grpc_metadata_batch* trailing_metadata =
+        op->payload->send_trailing_metadata.send_trailing_metadata;
+    if (calld->response_message_seen && trailing_metadata->list.count == 1 &&
+        trailing_metadata->idx.named.grpc_status != nullptr &&
+        grpc_mdelem_eq(trailing_metadata->idx.named.grpc_status->md,
+                       GRPC_MDELEM_GRPC_STATUS_0)) {
+      SERVER_FROM_CALL_ELEM(elem)->response_cache->Insert(
+          calld->response_cache_key, &calld->response_message,
+          calld->method->response_cache_ttl);
+      calld->response_cache_key = grpc_empty_slice();
+    }
+    calld->response_cacheable = false;
+  }
+  return false;
+}
+
 static void server_start_transport_stream_op_batch(
     grpc_call_element* elem, grpc_transport_stream_op_batch* op) {
   server_mutate_op(elem, op);
+  if (maybe_capture_response(elem, op)) return;
   grpc_call_next_op(elem, op);
 }
 
@@ -1110,6 +1332,48 @@ static void start_listeners(void* s, grpc_error* error) {
   server_unref(server);
 }
 
+/* Reads the response cache TTLs of the registered methods from the service
+   config in the server's channel args, and creates the response cache if any
+   method has one. Only methods that read their request up front can be
+   answered from the cache. */
+static void configure_response_cache(grpc_server* server) {
+  const grpc_arg* arg =
+      grpc_channel_args_find(server->channel_args, GRPC_ARG_SERVICE_CONFIG);
+  const char* service_config_json = grpc_channel_arg_get_string(arg);
+  if (service_config_json == nullptr) return;
+  arg = grpc_channel_args_find(server->channel_args,
+                               GRPC_ARG_SERVER_RESPONSE_CACHE_MAX_BYTES);
+  const int max_bytes = grpc_channel_arg_get_integer(
+      arg, {GRPC_SERVER_RESPONSE_CACHE_DEFAULT_MAX_BYTES, 0, INT_MAX});
+  if (max_bytes == 0) return;
+  grpc_core::UniquePtr<grpc_core::ServiceConfig> service_config =
+      grpc_core::ServiceConfig::Create(service_config_json);
+  if (service_config == nullptr) return;
+  auto method_params_table = service_config->CreateMethodConfigTable(
+      grpc_core::ServerResponseCache::MethodParams::CreateFromJson);
+  if (method_params_table == nullptr) return;
+  bool any_cacheable = false;
+  for (registered_method* rm = server->registered_methods; rm; rm = rm->next) {
+    if (rm->payload_handling != GRPC_SRM_PAYLOAD_READ_INITIAL_BYTE_BUFFER) {
+      continue;
+    }
+    grpc_core::RefCountedPtr<grpc_core::ServerResponseCache::MethodParams>
+        method_params = grpc_core::ServiceConfig::MethodConfigTableLookup(
+            *method_params_table, grpc_slice_from_static_string(rm->method));
+    if (method_params != nullptr && method_params->ttl() > 0) {
+      rm->response_cache_ttl = method_params->ttl();
+      any_cacheable = true;
+    }
+  }
+  if (!any_cacheable) return;
+  grpc_resource_quota* resource_quota =
+      grpc_resource_quota_from_channel_args(server->channel_args);
+  server->response_cache =
+      grpc_core::MakeRefCounted<grpc_core::ServerResponseCache>(
+          resource_quota, static_cast<size_t>(max_bytes));
+  grpc_resource_quota_unref_internal(resource_quota);
+}
+
 void grpc_server_start(grpc_server* server) {
   size_t i;
   grpc_core::ExecCtx exec_ctx;
@@ -1130,6 +1394,7 @@ void grpc_server_start(grpc_server* server) {
   for (registered_method* rm = server->registered_methods; rm; rm = rm->next) {
     request_matcher_init(&rm->matcher, server);
   }
+  configure_response_cache(server);
 
   server_ref(server);
   server->starting = true;
@@ -0,0 +1,274 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/surface/server_response_cache.h"
+
+#include <string.h>
+
+#include <grpc/support/alloc.h>
+
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/gprpp/mutex_lock.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/transport/service_config.h"
+
+namespace grpc_core {
+
+namespace {
+
+constexpr size_t kInitialNumBuckets = 16;
+
+uint8_t* AppendLengthPrefixed(uint8_t* p, const grpc_slice& slice) {
+  const uint32_t len = static_cast<uint32_t>(GRPC_SLICE_LENGTH(slice));
+  memcpy(p, &len, sizeof(len));
+  p += sizeof(len);
+  memcpy(p, GRPC_SLICE_START_PTR(slice), len);
+  return p + len;
+}
+
+}  // namespace
+
+RefCountedPtr<ServerResponseCache::MethodParams>
+ServerResponseCache::MethodParams::CreateFromJson(const grpc_json* json) {
+  grpc_millis ttl = -1;
+  for (grpc_json* field = json->child; field != nullptr; field = field->next) {
+    if (field->key == nullptr) continue;
+    if (strcmp(field->key, "responseCacheTtl") == 0) {
+      if (ttl >= 0) return nullptr;  // Duplicate.
+      if (!ServiceConfig::ParseJsonDuration(field, &ttl)) return nullptr;
+    }
+  }
+  return MakeRefCounted<MethodParams>(ttl >= 0 ? ttl : 0);
+}
+
+ServerResponseCache::ServerResponseCache(grpc_resource_quota* resource_quota,
+                                         size_t max_bytes)
+    : resource_user_(
+          grpc_resource_user_create(resource_quota, "server_response_cache")),
+      max_bytes_(max_bytes),
+      num_buckets_(kInitialNumBuckets) {
+  gpr_mu_init(&mu_);
+  buckets_ = static_cast<Entry**>(gpr_zalloc(num_buckets_ * sizeof(Entry*)));
+  lru_.lru_prev = lru_.lru_next = &lru_;
+  GRPC_CLOSURE_INIT(&reclaimer_closure_, ReclaimMemory, this,
+                    grpc_schedule_on_exec_ctx);
+}
+
+ServerResponseCache::~ServerResponseCache() {
+  GPR_ASSERT(shutdown_);
+  grpc_resource_user_unref(resource_user_);
+  gpr_free(buckets_);
+  gpr_mu_destroy(&mu_);
+}
+
+void ServerResponseCache::Shutdown() {
+  {
+    MutexLock lock(&mu_);
+    shutdown_ = true;
+    while (lru_.lru_next != &lru_) RemoveLocked(lru_.lru_next);
+  }
+  grpc_resource_user_shutdown(resource_user_);
+}
+
+grpc_slice ServerResponseCache::MakeKey(const grpc_slice& host,
+                                        const grpc_slice& path,
+                                        grpc_byte_buffer* request) {
+  GPR_ASSERT(request->type == GRPC_BB_RAW);
+  const grpc_slice_buffer& payload = request->data.raw.slice_buffer;
+  grpc_slice key = GRPC_SLICE_MALLOC(
+      2 * sizeof(uint32_t) + GRPC_SLICE_LENGTH(host) + GRPC_SLICE_LENGTH(path) +
+      1 + payload.length);
+  uint8_t* p = GRPC_SLICE_START_PTR(key);
+  p = AppendLengthPrefixed(p, host);
+  p = AppendLengthPrefixed(p, path);
+  // The payload is keyed as received, so a compressed request only matches
+  // requests compressed with the same algorithm.
+  *p++ = static_cast<uint8_t>(request->data.raw.compression);
+  for (size_t i = 0; i < payload.count; i++) {
+    memcpy(p, GRPC_SLICE_START_PTR(payload.slices[i]),
+           GRPC_SLICE_LENGTH(payload.slices[i]));
+    p += GRPC_SLICE_LENGTH(payload.slices[i]);
+  }
+  return key;
+}
+
+grpc_byte_buffer* ServerResponseCache::Lookup(const grpc_slice& key) {
+  const uint32_t hash = grpc_slice_hash(key);
+  MutexLock lock(&mu_);
+  Entry* entry = FindLocked(key, hash);
+  if (entry != nullptr && entry->expiration <= ExecCtx::Get()->Now()) {
+    RemoveLocked(entry);
+    GRPC_STATS_INC_SERVER_RESPONSE_CACHE_EVICTIONS();
+    entry = nullptr;
+  }
+  if (entry == nullptr) {
+    GRPC_STATS_INC_SERVER_RESPONSE_CACHE_MISSES();
+    return nullptr;
+  }
+  // Move the entry to the most recently used end of the LRU list.
+  entry->lru_prev->lru_next = entry->lru_next;
+  entry->lru_next->lru_prev = entry->lru_prev;
+  entry->lru_prev = lru_.lru_prev;
+  entry->lru_next = &lru_;
+  lru_.lru_prev->lru_next = entry;
+  lru_.lru_prev = entry;
+  GRPC_STATS_INC_SERVER_RESPONSE_CACHE_HITS();
+  return grpc_byte_buffer_copy(entry->response);
+}
+
+void ServerResponseCache::Insert(grpc_slice key, grpc_slice_buffer* response,
+                                 grpc_millis ttl) {
+  const size_t charge =
+      sizeof(Entry) + GRPC_SLICE_LENGTH(key) + response->length;
+  const uint32_t hash = grpc_slice_hash(key);
+  bool post_reclaimer = false;
+  {
+    MutexLock lock(&mu_);
+    if (shutdown_ || charge > max_bytes_) {
+      grpc_slice_unref_internal(key);
+      return;
+    }
+    // Calls for the same request that missed concurrently all insert their
+    // response; keep the newest one.
+    Entry* existing = FindLocked(key, hash);
+    if (existing != nullptr) RemoveLocked(existing);
+    while (size_bytes_ + charge > max_bytes_) EvictOneLocked();
+    while (!grpc_resource_user_safe_alloc(resource_user_, charge)) {
+      if (num_entries_ == 0) {
+        grpc_slice_unref_internal(key);
+        return;
+      }
+      EvictOneLocked();
+    }
+    Entry* entry = static_cast<Entry*>(gpr_malloc(sizeof(Entry)));
+    entry->key = key;
+    entry->hash = hash;
+    entry->response =
+        grpc_raw_byte_buffer_create(response->slices, response->count);
+    entry->expiration = ExecCtx::Get()->Now() + ttl;
+    entry->charge = charge;
+    MaybeGrowLocked();
+    Entry** bucket = &buckets_[hash % num_buckets_];
+    entry->bucket_next = *bucket;
+    *bucket = entry;
+    entry->lru_prev = lru_.lru_prev;
+    entry->lru_next = &lru_;
+    lru_.lru_prev->lru_next = entry;
+    lru_.lru_prev = entry;
+    size_bytes_ += charge;
+    ++num_entries_;
+    GRPC_STATS_INC_SERVER_RESPONSE_CACHE_INSERTS();
+    post_reclaimer = NeedReclaimerLocked();
+  }
+  if (post_reclaimer) PostReclaimer();
+}
+
+size_t ServerResponseCache::num_entries() {
+  MutexLock lock(&mu_);
+  return num_entries_;
+}
+
+size_t ServerResponseCache::size_bytes() {
+  MutexLock lock(&mu_);
+  return size_bytes_;
+}
+
+ServerResponseCache::Entry* ServerResponseCache::FindLocked(
+    const grpc_slice& key, uint32_t hash) {
+  for (Entry* entry = buckets_[hash % num_buckets_]; entry != nullptr;
+       entry = entry->bucket_next) {
+    if (entry->hash == hash && grpc_slice_eq(entry->key, key)) return entry;
+  }
+  return nullptr;
+}
+
+void ServerResponseCache::MaybeGrowLocked() {
+  if (num_entries_ < num_buckets_) return;
+  const size_t new_num_buckets = 2 * num_buckets_;
+  Entry** new_buckets =
+      static_cast<Entry**>(gpr_zalloc(new_num_buckets * sizeof(Entry*)));
+  for (size_t i = 0; i < num_buckets_; i++) {
+    Entry* entry = buckets_[i];
+    while (entry != nullptr) {
+      Entry* next = entry->bucket_next;
+      Entry** bucket = &new_buckets[entry->hash % new_num_buckets];
+      entry->bucket_next = *bucket;
+      *bucket = entry;
+      entry = next;
+    }
+  }
+  gpr_free(buckets_);
+  buckets_ = new_buckets;
+  num_buckets_ = new_num_buckets;
+}
+
+void ServerResponseCache::RemoveLocked(Entry* entry) {
+  Entry** link = &buckets_[entry->hash % num_buckets_];
+  while (*link != entry) link = &(*link)->bucket_next;
+  *link = entry->bucket_next;
+  entry->lru_prev->lru_next = entry->lru_next;
+  entry->lru_next->lru_prev = entry->lru_prev;
+  size_bytes_ -= entry->charge;
+  --num_entries_;
+  grpc_resource_user_free(resource_user_, entry->charge);
+  grpc_slice_unref_internal(entry->key);
+  grpc_byte_buffer_destroy(entry->response);
+  gpr_free(entry);
+}
+
+void ServerResponseCache::EvictOneLocked() {
+  GPR_ASSERT(lru_.lru_next != &lru_);
+  RemoveLocked(lru_.lru_next);
+  GRPC_STATS_INC_SERVER_RESPONSE_CACHE_EVICTIONS();
+}
+
+void ServerResponseCache::EvictAllLocked() {
+  while (lru_.lru_next != &lru_) EvictOneLocked();
+}
+
+bool ServerResponseCache::NeedReclaimerLocked() {
+  if (reclaimer_posted_ || shutdown_) return false;
+  reclaimer_posted_ = true;
+  return true;
+}
+
+void ServerResponseCache::PostReclaimer() {
+  // Owned by ReclaimMemory().
+  Ref().release();
+  grpc_resource_user_post_reclaimer(resource_user_, false /* destructive */,
+                                    &reclaimer_closure_);
+}
+
+// The cache can always be rebuilt by calling the method handlers again, so
+// it is dropped entirely when the resource quota runs short.
+void ServerResponseCache::ReclaimMemory(void* arg, grpc_error* error) {
+  ServerResponseCache* cache = static_cast<ServerResponseCache*>(arg);
+  if (error == GRPC_ERROR_NONE) {
+    {
+      MutexLock lock(&cache->mu_);
+      cache->reclaimer_posted_ = false;
+      cache->EvictAllLocked();
+    }
+    grpc_resource_user_finish_reclamation(cache->resource_user_);
+  }
+  cache->Unref();
+}
+
+}  // namespace grpc_core
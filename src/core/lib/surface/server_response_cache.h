@@ -0,0 +1,139 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_SURFACE_SERVER_RESPONSE_CACHE_H
+#define GRPC_CORE_LIB_SURFACE_SERVER_RESPONSE_CACHE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <grpc/byte_buffer.h>
+#include <grpc/slice_buffer.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/gprpp/memory.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/resource_quota.h"
+#include "src/core/lib/json/json.h"
+
+// The default value of GRPC_ARG_SERVER_RESPONSE_CACHE_MAX_BYTES.
+#define GRPC_SERVER_RESPONSE_CACHE_DEFAULT_MAX_BYTES (4 * 1024 * 1024)
+
+namespace grpc_core {
+
+// Keeps the serialized responses of server methods that the service config
+// marks as cacheable, keyed by the host, the method and the serialized
+// request. Entries expire after the TTL given on insertion and the least
+// recently used ones are evicted to stay under the byte limit. The memory is
+// charged to a resource user of the server's resource quota, and the cache
+// is emptied when the quota asks for memory back.
+// Thread safe.
+class ServerResponseCache : public RefCounted<ServerResponseCache> {
+ public:
+  // The response cache parameters of a method in the service config:
+  //   "responseCacheTtl": "duration_string"
+  class MethodParams : public RefCounted<MethodParams> {
+   public:
+    // Returns null if the field is malformed. Methods without the field get
+    // a TTL of 0, meaning that their responses are not cached.
+    static RefCountedPtr<MethodParams> CreateFromJson(const grpc_json* json);
+
+    grpc_millis ttl() const { return ttl_; }
+
+   private:
+    // So New() can call our private ctor.
+    template <typename T, typename... Args>
+    friend T* grpc_core::New(Args&&... args);
+
+    explicit MethodParams(grpc_millis ttl) : ttl_(ttl) {}
+
+    grpc_millis ttl_;
+  };
+
+  // Takes its own ref to \a resource_quota.
+  ServerResponseCache(grpc_resource_quota* resource_quota, size_t max_bytes);
+  ~ServerResponseCache();
+
+  // Releases the resource user. Must be called once, before the last ref is
+  // dropped.
+  void Shutdown();
+
+  // Returns the key of a request for \a path on \a host with the payload
+  // \a request. The caller owns the result.
+  static grpc_slice MakeKey(const grpc_slice& host, const grpc_slice& path,
+                            grpc_byte_buffer* request);
+
+  // Returns a byte buffer sharing the slices of the response cached under
+  // \a key, or null if there is none or it expired. The caller owns the
+  // result.
+  grpc_byte_buffer* Lookup(const grpc_slice& key);
+
+  // Caches \a response under \a key for \a ttl. Takes ownership of \a key and
+  // takes refs to the slices of \a response. Does nothing if the entry does
+  // not fit in the cache.
+  void Insert(grpc_slice key, grpc_slice_buffer* response, grpc_millis ttl);
+
+  size_t num_entries();
+  size_t size_bytes();
+
+ private:
+  struct Entry {
+    grpc_slice key;
+    uint32_t hash;
+    grpc_byte_buffer* response;
+    grpc_millis expiration;
+    // The number of bytes charged to the resource user for this entry.
+    size_t charge;
+    Entry* bucket_next;
+    // Neighbours in the LRU list.
+    Entry* lru_prev;
+    Entry* lru_next;
+  };
+
+  static void ReclaimMemory(void* arg, grpc_error* error);
+
+  Entry* FindLocked(const grpc_slice& key, uint32_t hash);
+  void MaybeGrowLocked();
+  void RemoveLocked(Entry* entry);
+  // Removes the least recently used entry.
+  void EvictOneLocked();
+  void EvictAllLocked();
+  // Returns true if the caller must post the reclaimer.
+  bool NeedReclaimerLocked();
+  void PostReclaimer();
+
+  gpr_mu mu_;
+  grpc_resource_user* resource_user_;
+  const size_t max_bytes_;
+  size_t size_bytes_ = 0;
+  size_t num_entries_ = 0;
+  Entry** buckets_;
+  size_t num_buckets_;
+  // Sentinel of the LRU list: lru_.lru_next is the least recently used entry
+  // and lru_.lru_prev the most recently used one.
+  Entry lru_;
+  bool reclaimer_posted_ = false;
+  bool shutdown_ = false;
+  grpc_closure reclaimer_closure_;
+};
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_LIB_SURFACE_SERVER_RESPONSE_CACHE_H */
@@ -39,6 +39,7 @@
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
+#include "src/core/lib/transport/registered_metadata.h"
 #include "src/core/lib/transport/static_metadata.h"
 
 /* There are two kinds of mdelem and mdstr instances.
@@ -337,6 +338,13 @@ grpc_mdelem grpc_mdelem_from_grpc_metadata(grpc_metadata* metadata) {
   bool changed = false;
   grpc_slice key_slice =
       grpc_slice_maybe_static_intern(metadata->key, &changed);
+  if (GRPC_IS_REGISTERED_METADATA_STRING(key_slice) &&
+      grpc_registered_metadata_interns_values(key_slice)) {
+    grpc_slice value_slice = grpc_slice_intern(metadata->value);
+    grpc_mdelem elem = grpc_mdelem_create(key_slice, value_slice, nullptr);
+    grpc_slice_unref_internal(value_slice);
+    return elem;
+  }
   grpc_slice value_slice =
       grpc_slice_maybe_static_intern(metadata->value, &changed);
   return grpc_mdelem_create(
@@ -63,6 +63,10 @@ static void assert_valid_callouts(grpc_metadata_batch* batch) {
       GPR_ASSERT(batch->idx.array[callout_idx] == l);
     }
     grpc_slice_unref_internal(key_interned);
+    if (GRPC_IS_REGISTERED_METADATA_STRING(GRPC_MDKEY(l->md))) {
+      GPR_ASSERT(batch->registered[GRPC_REGISTERED_METADATA_INDEX(
+                     GRPC_MDKEY(l->md))] != nullptr);
+    }
   }
 #endif
 }
@@ -93,6 +97,40 @@ grpc_error* grpc_attach_md_to_error(grpc_error* src, grpc_mdelem md) {
   return out;
 }
 
+static void maybe_link_registered_callout(grpc_metadata_batch* batch,
+                                          grpc_linked_mdelem* storage) {
+  const grpc_slice& key = GRPC_MDKEY(storage->md);
+  if (!GRPC_IS_REGISTERED_METADATA_STRING(key)) {
+    return;
+  }
+  grpc_linked_mdelem** callout =
+      &batch->registered[GRPC_REGISTERED_METADATA_INDEX(key)];
+  if (*callout == nullptr) {
+    *callout = storage;
+  }
+}
+
+static void maybe_unlink_registered_callout(grpc_metadata_batch* batch,
+                                            grpc_linked_mdelem* storage) {
+  const grpc_slice& key = GRPC_MDKEY(storage->md);
+  if (!GRPC_IS_REGISTERED_METADATA_STRING(key)) {
+    return;
+  }
+  grpc_linked_mdelem** callout =
+      &batch->registered[GRPC_REGISTERED_METADATA_INDEX(key)];
+  if (*callout != storage) {
+    return;
+  }
+  /* hand the callout over to a duplicate of the key, if there is one */
+  *callout = nullptr;
+  for (grpc_linked_mdelem* l = batch->list.head; l != nullptr; l = l->next) {
+    if (l != storage && GRPC_MDKEY(l->md).refcount == key.refcount) {
+      *callout = l;
+      break;
+    }
+  }
+}
+
 static grpc_error* maybe_link_callout(grpc_metadata_batch* batch,
                                       grpc_linked_mdelem* storage)
     GRPC_MUST_USE_RESULT;
@@ -102,6 +140,7 @@ static grpc_error* maybe_link_callout(grpc_metadata_batch* batch,
   grpc_metadata_batch_callouts_index idx =
       GRPC_BATCH_INDEX_OF(GRPC_MDKEY(storage->md));
   if (idx == GRPC_BATCH_CALLOUTS_COUNT) {
+    maybe_link_registered_callout(batch, storage);
     return GRPC_ERROR_NONE;
   }
   if (batch->idx.array[idx] == nullptr) {
@@ -119,6 +158,7 @@ static void maybe_unlink_callout(grpc_metadata_batch* batch,
   grpc_metadata_batch_callouts_index idx =
       GRPC_BATCH_INDEX_OF(GRPC_MDKEY(storage->md));
   if (idx == GRPC_BATCH_CALLOUTS_COUNT) {
+    maybe_unlink_registered_callout(batch, storage);
     return;
   }
   --batch->list.default_count;
@@ -28,6 +28,7 @@
 #include <grpc/support/time.h>
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/transport/metadata.h"
+#include "src/core/lib/transport/registered_metadata.h"
 #include "src/core/lib/transport/static_metadata.h"
 
 typedef struct grpc_linked_mdelem {
@@ -50,6 +51,11 @@ typedef struct grpc_metadata_batch {
   /** Metadata elements in this batch */
   grpc_mdelem_list list;
   grpc_metadata_batch_callouts idx;
+  /** Callouts for the application's registered keys, indexed by the value
+      returned from grpc_register_well_known_metadata_key(). Unlike the keys
+      in idx, these may repeat in a batch: the callout then points at the
+      first of the elements that was linked */
+  grpc_linked_mdelem* registered[GRPC_REGISTERED_MDSTR_MAX];
   /** Used to calculate grpc-timeout at the point of sending,
       or GRPC_MILLIS_INF_FUTURE if this batch does not need to send a
       grpc-timeout */
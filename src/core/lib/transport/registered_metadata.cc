@@ -0,0 +1,103 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/transport/registered_metadata.h"
+
+#include <string.h>
+
+#include <grpc/support/log.h>
+#include <grpc/support/string_util.h>
+
+#include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/transport/static_metadata.h"
+
+static void registered_ref(void* unused) {}
+static void registered_unref(void* unused) {}
+static const grpc_slice_refcount_vtable registered_sub_vtable = {
+    registered_ref, registered_unref, grpc_slice_default_eq_impl,
+    grpc_slice_default_hash_impl};
+const grpc_slice_refcount_vtable grpc_registered_metadata_vtable = {
+    registered_ref, registered_unref, grpc_registered_slice_eq,
+    grpc_registered_slice_hash};
+static grpc_slice_refcount registered_sub_refcnt = {&registered_sub_vtable,
+                                                    &registered_sub_refcnt};
+
+grpc_slice_refcount
+    grpc_registered_metadata_refcounts[GRPC_REGISTERED_MDSTR_MAX];
+grpc_slice grpc_registered_slice_table[GRPC_REGISTERED_MDSTR_MAX];
+uint32_t grpc_registered_slice_flags[GRPC_REGISTERED_MDSTR_MAX];
+size_t grpc_registered_mdstr_count;
+bool grpc_registered_metadata_frozen;
+
+/* same character set as grpc_validate_header_key_is_legal(), which cannot be
+   used here since it reports failures as grpc_errors */
+static bool is_legal_key(const char* key, size_t length) {
+  if (length == 0) return false;
+  for (size_t i = 0; i < length; i++) {
+    const char c = key[i];
+    if (!((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '-' ||
+          c == '_' || c == '.')) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int grpc_register_well_known_metadata_key(const char* key, uint32_t flags) {
+  if (grpc_registered_metadata_frozen) {
+    gpr_log(GPR_ERROR,
+            "Metadata key '%s' must be registered before grpc_init()", key);
+    return -1;
+  }
+  const size_t length = strlen(key);
+  if (!is_legal_key(key, length)) {
+    gpr_log(GPR_ERROR, "Cannot register illegal metadata key '%s'", key);
+    return -1;
+  }
+  for (size_t i = 0; i < GRPC_STATIC_MDSTR_COUNT; i++) {
+    if (grpc_slice_str_cmp(grpc_static_slice_table[i], key) == 0) {
+      gpr_log(GPR_ERROR, "Metadata key '%s' is already static", key);
+      return -1;
+    }
+  }
+  for (size_t i = 0; i < grpc_registered_mdstr_count; i++) {
+    if (grpc_slice_str_cmp(grpc_registered_slice_table[i], key) == 0) {
+      grpc_registered_slice_flags[i] |= flags;
+      return static_cast<int>(i);
+    }
+  }
+  if (grpc_registered_mdstr_count == GRPC_REGISTERED_MDSTR_MAX) {
+    gpr_log(GPR_ERROR,
+            "Cannot register metadata key '%s': all %d slots are taken", key,
+            GRPC_REGISTERED_MDSTR_MAX);
+    return -1;
+  }
+  const size_t idx = grpc_registered_mdstr_count++;
+  grpc_registered_metadata_refcounts[idx].vtable =
+      &grpc_registered_metadata_vtable;
+  grpc_registered_metadata_refcounts[idx].sub_refcount = &registered_sub_refcnt;
+  grpc_slice* slice = &grpc_registered_slice_table[idx];
+  slice->refcount = &grpc_registered_metadata_refcounts[idx];
+  /* never freed: slices referring to it may outlive grpc_shutdown() */
+  slice->data.refcounted.bytes = reinterpret_cast<uint8_t*>(gpr_strdup(key));
+  slice->data.refcounted.length = length;
+  grpc_registered_slice_flags[idx] = flags;
+  return static_cast<int>(idx);
+}
@@ -0,0 +1,67 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_TRANSPORT_REGISTERED_METADATA_H
+#define GRPC_CORE_LIB_TRANSPORT_REGISTERED_METADATA_H
+
+#include <grpc/support/port_platform.h>
+
+#include <grpc/grpc.h>
+#include <grpc/slice.h>
+
+// Metadata keys registered by the application with
+// grpc_register_well_known_metadata_key(). They get the treatment that the
+// keys in static_metadata.h get from the code generator:
+// - the key is a static slice: grpc_slice_intern() returns it without taking
+//   a shard lock, and refs to it are free;
+// - grpc_metadata_batch keeps a callout for it (see metadata_batch.h);
+// - the HPACK encoder keeps the key's index in the peer's table in a slot of
+//   its own, instead of in the hashed key cache shared by all other keys.
+//
+// The table only changes while the library is not initialized, so it is read
+// without locking.
+
+#define GRPC_REGISTERED_MDSTR_MAX GRPC_MAX_WELL_KNOWN_METADATA_KEYS
+
+extern const grpc_slice_refcount_vtable grpc_registered_metadata_vtable;
+extern grpc_slice_refcount
+    grpc_registered_metadata_refcounts[GRPC_REGISTERED_MDSTR_MAX];
+extern grpc_slice grpc_registered_slice_table[GRPC_REGISTERED_MDSTR_MAX];
+extern uint32_t grpc_registered_slice_flags[GRPC_REGISTERED_MDSTR_MAX];
+extern size_t grpc_registered_mdstr_count;
+/// Set by grpc_slice_intern_init() and cleared by grpc_slice_intern_shutdown():
+/// keys cannot be registered while the library is initialized.
+extern bool grpc_registered_metadata_frozen;
+
+#define GRPC_IS_REGISTERED_METADATA_STRING(slice) \
+  ((slice).refcount != NULL &&                    \
+   (slice).refcount->vtable == &grpc_registered_metadata_vtable)
+
+#define GRPC_REGISTERED_METADATA_INDEX(registered_slice) \
+  ((int)((registered_slice).refcount - grpc_registered_metadata_refcounts))
+
+/// Returns true if the values of the registered key \a registered_slice are
+/// interned when metadata is created from the application's grpc_metadata.
+inline bool grpc_registered_metadata_interns_values(
+    grpc_slice registered_slice) {
+  return (grpc_registered_slice_flags[GRPC_REGISTERED_METADATA_INDEX(
+              registered_slice)] &
+          GRPC_WELL_KNOWN_METADATA_REPEATED_VALUES) != 0;
+}
+
+#endif /* GRPC_CORE_LIB_TRANSPORT_REGISTERED_METADATA_H */
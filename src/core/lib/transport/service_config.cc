@@ -65,6 +65,40 @@ const char* ServiceConfig::GetLoadBalancingPolicyName() const {
   return lb_policy_name;
 }
 
+bool ServiceConfig::ParseJsonDuration(const grpc_json* field,
+                                      grpc_millis* duration) {
+  // Upper bound of google.proto.Duration; fits in grpc_millis.
+  constexpr int64_t kMaxSeconds = 315576000000;
+  if (field->type != GRPC_JSON_STRING) return false;
+  const char* p = field->value;
+  int64_t seconds = 0;
+  bool have_digits = false;
+  for (; *p >= '0' && *p <= '9'; ++p) {
+    seconds = seconds * 10 + (*p - '0');
+    if (seconds > kMaxSeconds) return false;
+    have_digits = true;
+  }
+  int64_t nanos = 0;
+  if (*p == '.') {
+    ++p;
+    int num_digits = 0;
+    for (; *p >= '0' && *p <= '9'; ++p) {
+      // We don't accept greater precision than nanos.
+      if (++num_digits > 9) return false;
+      nanos = nanos * 10 + (*p - '0');
+    }
+    if (num_digits == 0) return false;
+    have_digits = true;
+    for (; num_digits < 9; ++num_digits) {
+      nanos *= 10;
+    }
+  }
+  if (!have_digits || strcmp(p, "s") != 0) return false;
+  *duration = static_cast<grpc_millis>(seconds * GPR_MS_PER_SEC +
+                                       nanos / GPR_NS_PER_MS);
+  return true;
+}
+
 int ServiceConfig::CountNamesInMethodConfig(grpc_json* json) {
   int num_names = 0;
   for (grpc_json* field = json->child; field != nullptr; field = field->next) {
@@ -24,6 +24,7 @@
 
 #include "src/core/lib/gprpp/inlined_vector.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/json/json.h"
 #include "src/core/lib/slice/slice_hash_table.h"
 
@@ -48,6 +49,11 @@
 //       "timeout": "duration_string",
 //       "maxRequestMessageBytes": "int64_string",
 //       "maxResponseMessageBytes": "int64_string",
+//       // servers only, see src/core/lib/surface/server_response_cache.h
+//       "responseCacheTtl": "duration_string",
+//       // clients only, see
+//       // src/core/ext/filters/client_channel/request_coalescing_filter.h
+//       "coalesceRequests": bool,
 //     }
 //   ]
 // }
@@ -94,6 +100,13 @@ class ServiceConfig {
   static RefCountedPtr<T> MethodConfigTableLookup(
       const SliceHashTable<RefCountedPtr<T>>& table, grpc_slice path);
 
+  /// Parses a JSON field of the form generated for a google.proto.Duration
+  /// proto message, as per:
+  ///   https://developers.google.com/protocol-buffers/docs/proto3#json
+  /// Returns false if \a field is malformed or is negative or longer than
+  /// the 10000 years a google.proto.Duration can hold.
+  static bool ParseJsonDuration(const grpc_json* field, grpc_millis* duration);
+
  private:
   // So New() can call our private ctor.
   template <typename T, typename... Args>
@@ -240,6 +253,7 @@ RefCountedPtr<T> ServiceConfig::MethodConfigTableLookup(
     value = table.Get(wildcard_path);
     grpc_slice_unref_internal(wildcard_path);
     gpr_free(path_str);
+    if (value == nullptr) return nullptr;
   }
   return RefCountedPtr<T>(*value);
 }
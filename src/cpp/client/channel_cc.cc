@@ -42,6 +42,7 @@
 #include <grpcpp/support/config.h>
 #include <grpcpp/support/status.h>
 #include <grpcpp/support/time.h>
+#include "src/core/ext/filters/client_channel/client_channel.h"
 #include "src/core/lib/gpr/env.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/memory.h"
@@ -204,6 +205,25 @@ void Channel::NotifyOnStateChangeImpl(grpc_connectivity_state last_observed,
                                         cq->cq(), tag_saver);
 }
 
+namespace experimental {
+
+void NotifyOnChannelsStateChange(const std::vector<Channel*>& channels,
+                                 grpc_connectivity_state* states,
+                                 gpr_timespec deadline, CompletionQueue* cq,
+                                 void* tag) {
+  std::vector<grpc_channel*> c_channels;
+  c_channels.reserve(channels.size());
+  for (Channel* channel : channels) {
+    c_channels.push_back(channel->c_channel_);
+  }
+  TagSaver* tag_saver = new TagSaver(tag);
+  grpc_channel_watch_connectivity_state_group(c_channels.data(), states,
+                                              c_channels.size(), deadline,
+                                              cq->cq(), tag_saver);
+}
+
+}  // namespace experimental
+
 bool Channel::WaitForStateChangeImpl(grpc_connectivity_state last_observed,
                                      gpr_timespec deadline) {
   CompletionQueue cq;
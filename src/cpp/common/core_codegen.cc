@@ -225,4 +225,9 @@ void CoreCodegen::assert_fail(const char* failed_assertion, const char* file,
   abort();
 }
 
+int CoreCodegen::grpc_byte_buffer_reader_peek(grpc_byte_buffer_reader* reader,
+                                              grpc_slice** slice) {
+  return ::grpc_byte_buffer_reader_peek(reader, slice);
+}
+
 }  // namespace grpc
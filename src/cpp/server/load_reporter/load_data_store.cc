@@ -143,13 +143,14 @@ void PerBalancerStore::MergeRow(const LoadRecordKey& key,
   // During suspension, the load data received will be dropped.
   if (!suspended_) {
     load_record_map_[key].MergeFrom(value);
+  }
+  // Formatting the key and value is expensive, so only do it if the log will
+  // be written.
+  if (gpr_should_log(GPR_LOG_SEVERITY_DEBUG)) {
     gpr_log(GPR_DEBUG,
-            "[PerBalancerStore %p] Load data merged (Key: %s, Value: %s).",
-            this, key.ToString().c_str(), value.ToString().c_str());
-  } else {
-    gpr_log(GPR_DEBUG,
-            "[PerBalancerStore %p] Load data dropped (Key: %s, Value: %s).",
-            this, key.ToString().c_str(), value.ToString().c_str());
+            "[PerBalancerStore %p] Load data %s (Key: %s, Value: %s).", this,
+            suspended_ ? "dropped" : "merged", key.ToString().c_str(),
+            value.ToString().c_str());
   }
   // We always keep track of num_calls_in_progress_, so that when this
   // store is resumed, we still have a correct value of
@@ -236,9 +237,8 @@ void PerHostStore::ReportStreamClosed(const grpc::string& lb_id) {
 
 PerBalancerStore* PerHostStore::FindPerBalancerStore(
     const grpc::string& lb_id) const {
-  return per_balancer_stores_.find(lb_id) != per_balancer_stores_.end()
-             ? per_balancer_stores_.find(lb_id)->second.get()
-             : nullptr;
+  auto it = per_balancer_stores_.find(lb_id);
+  return it != per_balancer_stores_.end() ? it->second.get() : nullptr;
 }
 
 const std::set<PerBalancerStore*>* PerHostStore::GetAssignedStores(
@@ -287,8 +287,27 @@ PerBalancerStore* LoadDataStore::FindPerBalancerStore(
 void LoadDataStore::MergeRow(const grpc::string& hostname,
                              const LoadRecordKey& key,
                              const LoadRecordValue& value) {
-  PerBalancerStore* per_balancer_store =
-      FindPerBalancerStore(hostname, key.lb_id());
+  MergeRowInto(FindPerBalancerStore(hostname, key.lb_id()), key, value);
+}
+
+void LoadDataStore::MergeRows(const std::vector<Row>& rows) {
+  const Row* previous = nullptr;
+  PerBalancerStore* per_balancer_store = nullptr;
+  for (const Row& row : rows) {
+    // Merging doesn't create or re-assign any store, so the result of the
+    // previous lookup is still valid.
+    if (previous == nullptr || row.key.lb_id() != previous->key.lb_id() ||
+        row.hostname != previous->hostname) {
+      per_balancer_store = FindPerBalancerStore(row.hostname, row.key.lb_id());
+    }
+    MergeRowInto(per_balancer_store, row.key, row.value);
+    previous = &row;
+  }
+}
+
+void LoadDataStore::MergeRowInto(PerBalancerStore* per_balancer_store,
+                                 const LoadRecordKey& key,
+                                 const LoadRecordValue& value) {
   if (per_balancer_store != nullptr) {
     per_balancer_store->MergeRow(key, value);
     return;
@@ -24,6 +24,7 @@
 #include <memory>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 #include <grpc/support/log.h>
 #include <grpcpp/impl/codegen/config.h>
@@ -301,6 +302,18 @@ class PerHostStore {
 // PerBalancerStore.
 class LoadDataStore {
  public:
+  // A load record to be merged by MergeRows().
+  struct Row {
+    Row(grpc::string hostname, LoadRecordKey key, LoadRecordValue value)
+        : hostname(std::move(hostname)),
+          key(std::move(key)),
+          value(std::move(value)) {}
+
+    grpc::string hostname;
+    LoadRecordKey key;
+    LoadRecordValue value;
+  };
+
   // Returns null if not found. Caller doesn't own the returned store.
   PerBalancerStore* FindPerBalancerStore(const grpc::string& hostname,
                                          const grpc::string& lb_id) const;
@@ -316,6 +329,11 @@ class LoadDataStore {
   void MergeRow(const grpc::string& hostname, const LoadRecordKey& key,
                 const LoadRecordValue& value);
 
+  // Merges the rows in order, as MergeRow() would. Consecutive rows with the
+  // same hostname and LB ID share one PerBalancerStore lookup, so that a whole
+  // fetch from Census can be merged with a single pass under the caller's lock.
+  void MergeRows(const std::vector<Row>& rows);
+
   // Is the given lb_id a tracked unknown LB ID (i.e., the LB ID was associated
   // with some received load data but unknown to this load data store)?
   bool IsTrackedUnknownBalancerId(const grpc::string& lb_id) const {
@@ -333,6 +351,11 @@ class LoadDataStore {
                           const grpc::string& lb_id);
 
  private:
+  // Merges the load record into per_balancer_store, or tracks its in-progress
+  // calls if per_balancer_store is null (i.e., the LB ID is unknown).
+  void MergeRowInto(PerBalancerStore* per_balancer_store,
+                    const LoadRecordKey& key, const LoadRecordValue& value);
+
   // Buffered data that was fetched from Census but hasn't been sent to
   // balancer. We need to keep this data ourselves because Census will
   // delete the data once it's returned.
@@ -395,7 +395,8 @@ void LoadReporter::ReportStreamClosed(const grpc::string& hostname,
 }
 
 void LoadReporter::ProcessViewDataCallStart(
-    const CensusViewProvider::ViewDataMap& view_data_map) {
+    const CensusViewProvider::ViewDataMap& view_data_map,
+    std::vector<LoadDataStore::Row>* rows) {
   auto it = view_data_map.find(kViewStartCount);
   if (it != view_data_map.end()) {
     for (const auto& p : it->second.int_data()) {
@@ -404,18 +405,15 @@ void LoadReporter::ProcessViewDataCallStart(
       const grpc::string& client_ip_and_token = tag_values[0];
       const grpc::string& host = tag_values[1];
       const grpc::string& user_id = tag_values[2];
-      LoadRecordKey key(client_ip_and_token, user_id);
-      LoadRecordValue value = LoadRecordValue(start_count);
-      {
-        std::unique_lock<std::mutex> lock(store_mu_);
-        load_data_store_.MergeRow(host, key, value);
-      }
+      rows->emplace_back(host, LoadRecordKey(client_ip_and_token, user_id),
+                         LoadRecordValue(start_count));
     }
   }
 }
 
 void LoadReporter::ProcessViewDataCallEnd(
-    const CensusViewProvider::ViewDataMap& view_data_map) {
+    const CensusViewProvider::ViewDataMap& view_data_map,
+    std::vector<LoadDataStore::Row>* rows) {
   uint64_t total_end_count = 0;
   uint64_t total_error_count = 0;
   auto it = view_data_map.find(kViewEndCount);
@@ -456,19 +454,17 @@ void LoadReporter::ProcessViewDataCallEnd(
         error_count = end_count;
         total_error_count += end_count;
       }
-      LoadRecordValue value = LoadRecordValue(
-          0, ok_count, error_count, bytes_sent, bytes_received, latency_ms);
-      {
-        std::unique_lock<std::mutex> lock(store_mu_);
-        load_data_store_.MergeRow(host, key, value);
-      }
+      rows->emplace_back(host, std::move(key),
+                         LoadRecordValue(0, ok_count, error_count, bytes_sent,
+                                         bytes_received, latency_ms));
     }
   }
   AppendNewFeedbackRecord(total_end_count, total_error_count);
 }
 
 void LoadReporter::ProcessViewDataOtherCallMetrics(
-    const CensusViewProvider::ViewDataMap& view_data_map) {
+    const CensusViewProvider::ViewDataMap& view_data_map,
+    std::vector<LoadDataStore::Row>* rows) {
   auto it = view_data_map.find(kViewOtherCallMetricCount);
   if (it != view_data_map.end()) {
     for (const auto& p : it->second.int_data()) {
@@ -483,12 +479,10 @@ void LoadReporter::ProcessViewDataOtherCallMetrics(
           CensusViewProvider::GetRelatedViewDataRowDouble(
               view_data_map, kViewOtherCallMetricValue,
               sizeof(kViewOtherCallMetricValue) - 1, tag_values);
-      LoadRecordValue value = LoadRecordValue(
-          metric_name, static_cast<uint64_t>(num_calls), total_metric_value);
-      {
-        std::unique_lock<std::mutex> lock(store_mu_);
-        load_data_store_.MergeRow(host, key, value);
-      }
+      rows->emplace_back(host, std::move(key),
+                         LoadRecordValue(metric_name,
+                                         static_cast<uint64_t>(num_calls),
+                                         total_metric_value));
     }
   }
 }
@@ -500,9 +494,14 @@ void LoadReporter::FetchAndSample() {
           this);
   CensusViewProvider::ViewDataMap view_data_map =
       census_view_provider_->FetchViewData();
-  ProcessViewDataCallStart(view_data_map);
-  ProcessViewDataCallEnd(view_data_map);
-  ProcessViewDataOtherCallMetrics(view_data_map);
+  // Collect the rows first, so that the store is locked once for the whole
+  // fetch rather than once per row, and not while the rows are assembled.
+  std::vector<LoadDataStore::Row> rows;
+  ProcessViewDataCallStart(view_data_map, &rows);
+  ProcessViewDataCallEnd(view_data_map, &rows);
+  ProcessViewDataOtherCallMetrics(view_data_map, &rows);
+  std::lock_guard<std::mutex> lock(store_mu_);
+  load_data_store_.MergeRows(rows);
 }
 
 }  // namespace load_reporter
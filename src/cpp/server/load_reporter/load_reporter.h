@@ -185,18 +185,22 @@ class LoadReporter {
           cpu_limit(cpu_limit) {}
   };
 
-  // Finds the view data about starting call from the view_data_map and merges
-  // the data to the load data store.
+  // Finds the view data about starting call from the view_data_map and
+  // appends the rows to be merged to the load data store to rows.
   void ProcessViewDataCallStart(
-      const CensusViewProvider::ViewDataMap& view_data_map);
-  // Finds the view data about ending call from the view_data_map and merges the
-  // data to the load data store.
+      const CensusViewProvider::ViewDataMap& view_data_map,
+      std::vector<LoadDataStore::Row>* rows);
+  // Finds the view data about ending call from the view_data_map and appends
+  // the rows to be merged to the load data store to rows.
   void ProcessViewDataCallEnd(
-      const CensusViewProvider::ViewDataMap& view_data_map);
+      const CensusViewProvider::ViewDataMap& view_data_map,
+      std::vector<LoadDataStore::Row>* rows);
   // Finds the view data about the customized call metrics from the
-  // view_data_map and merges the data to the load data store.
+  // view_data_map and appends the rows to be merged to the load data store to
+  // rows.
   void ProcessViewDataOtherCallMetrics(
-      const CensusViewProvider::ViewDataMap& view_data_map);
+      const CensusViewProvider::ViewDataMap& view_data_map,
+      std::vector<LoadDataStore::Row>* rows);
 
   bool IsRecordInWindow(const LoadBalancingFeedbackRecord& record,
                         std::chrono::system_clock::time_point now) {
@@ -193,6 +193,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/surface/lame_client.cc',
     'src/core/lib/surface/metadata_array.cc',
     'src/core/lib/surface/server.cc',
+    'src/core/lib/surface/server_response_cache.cc',
     'src/core/lib/surface/validate_metadata.cc',
     'src/core/lib/surface/version.cc',
     'src/core/lib/transport/bdp_estimator.cc',
@@ -204,6 +205,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/transport/pid_controller.cc',
     'src/core/lib/transport/service_config.cc',
     'src/core/lib/transport/static_metadata.cc',
+    'src/core/lib/transport/registered_metadata.cc',
     'src/core/lib/transport/status_conversion.cc',
     'src/core/lib/transport/status_metadata.cc',
     'src/core/lib/transport/timeout_encoding.cc',
@@ -329,6 +331,7 @@ CORE_SOURCE_FILES = [
     'src/core/ext/filters/client_channel/parse_address.cc',
     'src/core/ext/filters/client_channel/proxy_mapper.cc',
     'src/core/ext/filters/client_channel/proxy_mapper_registry.cc',
+    'src/core/ext/filters/client_channel/request_coalescing_filter.cc',
     'src/core/ext/filters/client_channel/request_routing.cc',
     'src/core/ext/filters/client_channel/resolver.cc',
     'src/core/ext/filters/client_channel/resolver_registry.cc',
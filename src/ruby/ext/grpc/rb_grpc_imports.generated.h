@@ -83,6 +83,9 @@ extern grpc_call_details_destroy_type grpc_call_details_destroy_import;
 typedef void(*grpc_register_plugin_type)(void (*init)(void), void (*destroy)(void));
 extern grpc_register_plugin_type grpc_register_plugin_import;
 #define grpc_register_plugin grpc_register_plugin_import
+typedef int(*grpc_register_well_known_metadata_key_type)(const char* key, uint32_t flags);
+extern grpc_register_well_known_metadata_key_type grpc_register_well_known_metadata_key_import;
+#define grpc_register_well_known_metadata_key grpc_register_well_known_metadata_key_import
 typedef void(*grpc_init_type)(void);
 extern grpc_init_type grpc_init_import;
 #define grpc_init grpc_init_import
@@ -461,6 +464,9 @@ extern grpc_byte_buffer_reader_destroy_type grpc_byte_buffer_reader_destroy_impo
 typedef int(*grpc_byte_buffer_reader_next_type)(grpc_byte_buffer_reader* reader, grpc_slice* slice);
 extern grpc_byte_buffer_reader_next_type grpc_byte_buffer_reader_next_import;
 #define grpc_byte_buffer_reader_next grpc_byte_buffer_reader_next_import
+typedef int(*grpc_byte_buffer_reader_peek_type)(grpc_byte_buffer_reader* reader, grpc_slice** slice);
+extern grpc_byte_buffer_reader_peek_type grpc_byte_buffer_reader_peek_import;
+#define grpc_byte_buffer_reader_peek grpc_byte_buffer_reader_peek_import
 typedef grpc_slice(*grpc_byte_buffer_reader_readall_type)(grpc_byte_buffer_reader* reader);
 extern grpc_byte_buffer_reader_readall_type grpc_byte_buffer_reader_readall_import;
 #define grpc_byte_buffer_reader_readall grpc_byte_buffer_reader_readall_import
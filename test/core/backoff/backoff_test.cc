@@ -166,6 +166,34 @@ TEST(BackOffTest, JitterBackOff) {
   }
 }
 
+TEST(BackOffTest, JitterInitialBackOff) {
+  const grpc_millis initial_backoff = 1000;
+  const double jitter = 0.2;
+  BackOff::Options options;
+  options.set_initial_backoff(initial_backoff)
+      .set_multiplier(1.6)
+      .set_jitter(jitter)
+      .set_max_backoff(120000)
+      .set_jitter_initial_backoff(true);
+  grpc_core::ExecCtx exec_ctx;
+  grpc_core::ExecCtx::Get()->TestOnlySetNow(0);
+  // Clients that fail at the same moment must not all retry at the same
+  // moment, yet every first retry stays within the jitter of the initial
+  // backoff.
+  bool all_equal = true;
+  grpc_millis first_next = -1;
+  for (uint32_t seed = 0; seed < 100; seed++) {
+    BackOff backoff(options);
+    backoff.SetRandomSeed(seed);
+    const grpc_millis next = backoff.NextAttemptTime();
+    EXPECT_GE(next, static_cast<grpc_millis>(initial_backoff * (1 - jitter)));
+    EXPECT_LE(next, static_cast<grpc_millis>(initial_backoff * (1 + jitter)));
+    if (first_next == -1) first_next = next;
+    if (next != first_next) all_equal = false;
+  }
+  EXPECT_FALSE(all_equal);
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace grpc
@@ -31,6 +31,7 @@
 #include <grpc/support/sync.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/gpr/numa.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "test/core/util/test_config.h"
 
@@ -143,8 +144,86 @@ static void cpu_test(void) {
   gpr_free(ct.used);
 }
 
+/* Every cpu belongs to one of the reported NUMA nodes, and every node has a
+   cpu. */
+static void numa_test(void) {
+  unsigned ncores = gpr_cpu_num_cores();
+  unsigned nnodes = gpr_cpu_num_numa_nodes();
+  GPR_ASSERT(nnodes >= 1);
+  GPR_ASSERT(nnodes <= ncores);
+  unsigned* node_cpus =
+      static_cast<unsigned*>(gpr_zalloc(nnodes * sizeof(unsigned)));
+  for (unsigned cpu = 0; cpu < ncores; cpu++) {
+    unsigned node = gpr_cpu_numa_node(cpu);
+    GPR_ASSERT(node < nnodes);
+    node_cpus[node]++;
+  }
+  for (unsigned node = 0; node < nnodes; node++) {
+    GPR_ASSERT(node_cpus[node] > 0);
+  }
+  gpr_free(node_cpus);
+  fprintf(stderr, "Saw %u NUMA node(s)\n", nnodes);
+}
+
+#ifdef GPR_CPU_LINUX
+#define CPULIST_NCPU 16
+#define UNSET 99
+
+/* A cpulist, and the CPUs below CPULIST_NCPU that it lists as a string of
+   '1' and '0', or nullptr if it is malformed */
+struct cpulist_case {
+  const char* list;
+  const char* cpus;
+};
+
+static void cpulist_test(void) {
+  const cpulist_case cases[] = {
+      {"0", "1000000000000000"},
+      {"0-3\n", "1111000000000000"},
+      {"0-3,8-11\n", "1111000011110000"},
+      {"1,3,5", "0101010000000000"},
+      {"2-2,15", "0010000000000001"},
+      /* CPUs above the ones this process knows of are ignored */
+      {"12-40", "0000000000001111"},
+      {"16-31", "0000000000000000"},
+      {"", "0000000000000000"},
+      {"\n", "0000000000000000"},
+      {"x", nullptr},
+      {"-3", nullptr},
+      {"0-", nullptr},
+      {"3-1", nullptr},
+      {"0,,1", nullptr},
+      {"0-3,", nullptr},
+      {"1 2", nullptr},
+      {"0-3x", nullptr},
+      {"0-3\n4", nullptr},
+  };
+  for (const cpulist_case& c : cases) {
+    unsigned cpu_nodes[CPULIST_NCPU];
+    for (unsigned cpu = 0; cpu < CPULIST_NCPU; cpu++) cpu_nodes[cpu] = UNSET;
+    int count = gpr_parse_numa_cpulist(c.list, 7, cpu_nodes, CPULIST_NCPU);
+    if (c.cpus == nullptr) {
+      GPR_ASSERT(count == -1);
+    } else {
+      GPR_ASSERT(count >= 0);
+    }
+    int expected_count = 0;
+    for (unsigned cpu = 0; cpu < CPULIST_NCPU; cpu++) {
+      bool listed = c.cpus != nullptr && c.cpus[cpu] == '1';
+      GPR_ASSERT(cpu_nodes[cpu] == (listed ? 7u : UNSET));
+      if (listed) expected_count++;
+    }
+    if (c.cpus != nullptr) GPR_ASSERT(count == expected_count);
+  }
+}
+#endif /* GPR_CPU_LINUX */
+
 int main(int argc, char* argv[]) {
   grpc::testing::TestEnvironment env(argc, argv);
   cpu_test();
+  numa_test();
+#ifdef GPR_CPU_LINUX
+  cpulist_test();
+#endif
   return 0;
 }
@@ -27,6 +27,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "src/core/lib/gpr/time_precise.h"
 #include "test/core/util/test_config.h"
 
 static void to_fp(void* arg, const char* buf, size_t len) {
@@ -253,6 +254,21 @@ static void test_cmp_extreme(void) {
   GPR_ASSERT(gpr_time_cmp(t1, t2) == 0);
 }
 
+/* The coarse clocks lag behind the precise ones by at most a scheduler tick,
+   which is 10ms with the lowest common HZ. */
+static void test_coarse_clock(void) {
+  const gpr_clock_type clocks[] = {GPR_CLOCK_MONOTONIC, GPR_CLOCK_REALTIME};
+  const gpr_timespec tolerance = gpr_time_from_millis(20, GPR_TIMESPAN);
+  for (gpr_clock_type clock : clocks) {
+    gpr_timespec before = gpr_now(clock);
+    gpr_timespec coarse = gpr_coarse_clock_now(clock);
+    gpr_timespec after = gpr_now(clock);
+    GPR_ASSERT(coarse.clock_type == clock);
+    GPR_ASSERT(gpr_time_cmp(coarse, gpr_time_sub(before, tolerance)) >= 0);
+    GPR_ASSERT(gpr_time_cmp(coarse, after) <= 0);
+  }
+}
+
 int main(int argc, char* argv[]) {
   grpc::testing::TestEnvironment env(argc, argv);
 
@@ -263,5 +279,6 @@ int main(int argc, char* argv[]) {
   test_similar();
   test_convert_extreme();
   test_cmp_extreme();
+  test_coarse_clock();
   return 0;
 }
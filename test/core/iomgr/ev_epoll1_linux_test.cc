@@ -0,0 +1,185 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include "src/core/lib/iomgr/port.h"
+
+/* This test only relevant on linux systems where epoll() is available */
+#if defined(GRPC_LINUX_EPOLL_CREATE1) && defined(GRPC_LINUX_EVENTFD)
+#include "src/core/lib/iomgr/ev_epoll1_linux.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/time.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include "src/core/lib/gprpp/thd.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/pollset.h"
+#include "test/core/util/test_config.h"
+
+#define NUM_KICKERS 8
+#define STRESS_MS 2000
+#define KICK_DELAY_MS 100
+/* A kick that gets through wakes the poller long before this */
+#define POLL_TIMEOUT_MS 10000
+
+static gpr_mu* g_mu;
+static grpc_pollset* g_pollset;
+static gpr_atm g_stop_kicking;
+
+static void pollset_destroy(void* ps, grpc_error* error) {
+  grpc_pollset_destroy(static_cast<grpc_pollset*>(ps));
+  gpr_free(ps);
+}
+
+static void kick_pollset() {
+  gpr_mu_lock(g_mu);
+  GRPC_LOG_IF_ERROR("pollset_kick", grpc_pollset_kick(g_pollset, nullptr));
+  gpr_mu_unlock(g_mu);
+}
+
+static void kick_until_stopped(void* arg) {
+  grpc_core::ExecCtx exec_ctx;
+  while (gpr_atm_acq_load(&g_stop_kicking) == 0) {
+    kick_pollset();
+  }
+}
+
+static void kick_after_delay(void* arg) {
+  grpc_core::ExecCtx exec_ctx;
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(KICK_DELAY_MS));
+  kick_pollset();
+}
+
+/* Polls once, for at most timeout_ms, and returns how long it took */
+static grpc_millis poll_once(grpc_millis timeout_ms) {
+  grpc_core::ExecCtx::Get()->InvalidateNow();
+  grpc_millis start = grpc_core::ExecCtx::Get()->Now();
+  grpc_pollset_worker* worker = nullptr;
+  gpr_mu_lock(g_mu);
+  GRPC_LOG_IF_ERROR("pollset_work",
+                    grpc_pollset_work(g_pollset, &worker, start + timeout_ms));
+  gpr_mu_unlock(g_mu);
+  grpc_core::ExecCtx::Get()->Flush();
+  grpc_core::ExecCtx::Get()->InvalidateNow();
+  return grpc_core::ExecCtx::Get()->Now() - start;
+}
+
+/* Kicks the designated poller from many threads while it keeps consuming
+   wakeups, then checks that a single kick still wakes it up: kicks that skip
+   the eventfd write because a wakeup is pending must never leave the poller
+   without one */
+static void test_concurrent_kicks() {
+  grpc_core::ExecCtx exec_ctx;
+  g_pollset = static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
+  grpc_pollset_init(g_pollset, &g_mu);
+
+  gpr_atm_rel_store(&g_stop_kicking, 0);
+  grpc_core::Thread kickers[NUM_KICKERS];
+  for (int i = 0; i < NUM_KICKERS; i++) {
+    kickers[i] = grpc_core::Thread("grpc_kicker", kick_until_stopped, nullptr);
+    kickers[i].Start();
+  }
+  /* Short polls, so that wakeups are often consumed by a worker other than
+     the one that was kicked, while the next worker is being kicked */
+  gpr_timespec stress_end = grpc_timeout_milliseconds_to_deadline(STRESS_MS);
+  for (int i = 0; gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), stress_end) < 0;
+       i++) {
+    poll_once(i % 2);
+  }
+  gpr_atm_rel_store(&g_stop_kicking, 1);
+  for (int i = 0; i < NUM_KICKERS; i++) {
+    kickers[i].Join();
+  }
+  /* Drop the kicks left over from the stress */
+  poll_once(0);
+  poll_once(0);
+
+  for (int i = 0; i < 3; i++) {
+    grpc_core::Thread kicker("grpc_kicker", kick_after_delay, nullptr);
+    kicker.Start();
+    grpc_millis elapsed = poll_once(POLL_TIMEOUT_MS);
+    kicker.Join();
+    gpr_log(GPR_INFO, "kick %d woke the poller after %" PRId64 "ms", i,
+            elapsed);
+    GPR_ASSERT(elapsed < POLL_TIMEOUT_MS / 2);
+  }
+
+  grpc_closure ps_destroy_closure;
+  GRPC_CLOSURE_INIT(&ps_destroy_closure, pollset_destroy, g_pollset,
+                    grpc_schedule_on_exec_ctx);
+  grpc_pollset_shutdown(g_pollset, &ps_destroy_closure);
+  grpc_core::ExecCtx::Get()->Flush();
+}
+
+struct neighborhood_case {
+  size_t num_cpus;
+  size_t num_nodes;
+  size_t num_neighborhoods;
+  unsigned cpu_nodes[8];
+  size_t expected[8];
+};
+
+/* Neighborhoods are equal blocks of the cpus ranked by (node, cpu), so they
+   span as few NUMA nodes as possible */
+static void test_cpu_neighborhoods() {
+  const neighborhood_case cases[] = {
+      {4, 1, 4, {0, 0, 0, 0}, {0, 1, 2, 3}},
+      {4, 1, 2, {0, 0, 0, 0}, {0, 0, 1, 1}},
+      /* Interleaved nodes */
+      {8, 2, 4, {0, 1, 0, 1, 0, 1, 0, 1}, {0, 2, 0, 2, 1, 3, 1, 3}},
+      /* Uneven nodes, not in cpu order */
+      {6, 2, 3, {1, 1, 0, 0, 0, 0}, {2, 2, 0, 0, 1, 1}},
+      /* A neighborhood that has to straddle two nodes */
+      {5, 3, 2, {2, 0, 1, 0, 2}, {1, 0, 0, 0, 1}},
+  };
+  for (const neighborhood_case& c : cases) {
+    size_t neighborhoods[8];
+    grpc_epoll1_map_cpu_neighborhoods(c.cpu_nodes, c.num_cpus, c.num_nodes,
+                                      c.num_neighborhoods, neighborhoods);
+    for (size_t cpu = 0; cpu < c.num_cpus; cpu++) {
+      GPR_ASSERT(neighborhoods[cpu] == c.expected[cpu]);
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  const char* poll_strategy = nullptr;
+  grpc::testing::TestEnvironment env(argc, argv);
+  test_cpu_neighborhoods();
+  grpc_init();
+  {
+    grpc_core::ExecCtx exec_ctx;
+    poll_strategy = grpc_get_poll_strategy_name();
+    if (poll_strategy != nullptr && strncmp(poll_strategy, "epoll1", 6) == 0) {
+      test_concurrent_kicks();
+    } else {
+      gpr_log(GPR_INFO,
+              "Skipping the test. The test is only relevant for 'epoll1' "
+              "strategies, and the current strategy is: '%s'",
+              poll_strategy);
+    }
+  }
+
+  grpc_shutdown();
+  return 0;
+}
+#else /* defined(GRPC_LINUX_EPOLL_CREATE1) && defined(GRPC_LINUX_EVENTFD) */
+int main(int argc, char** argv) { return 0; }
+#endif
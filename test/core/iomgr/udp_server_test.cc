@@ -359,6 +359,70 @@ static void test_receive(int number_of_clients) {
   shutdown_and_destroy_pollset();
 }
 
+static void test_datagram_batch(void) {
+  LOG_TEST("test_datagram_batch");
+  grpc_resolved_address svr_addr;
+  grpc_resolved_address cli_addr;
+  struct sockaddr_in* addr =
+      reinterpret_cast<struct sockaddr_in*>(svr_addr.addr);
+  int fds[2];
+  for (int i = 0; i < 2; i++) {
+    memset(addr, 0, sizeof(*addr));
+    addr->sin_family = AF_INET;
+    addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    fds[i] = socket(AF_INET, SOCK_DGRAM, 0);
+    GPR_ASSERT(fds[i] >= 0);
+    GPR_ASSERT(bind(fds[i], reinterpret_cast<struct sockaddr*>(addr),
+                    sizeof(*addr)) == 0);
+    GPR_ASSERT(grpc_set_socket_nonblocking(fds[i], 1) == GRPC_ERROR_NONE);
+  }
+  cli_addr.len = static_cast<socklen_t>(sizeof(cli_addr.addr));
+  GPR_ASSERT(getsockname(fds[0], reinterpret_cast<struct sockaddr*>(
+                                     cli_addr.addr),
+                         &cli_addr.len) == 0);
+  svr_addr.len = static_cast<socklen_t>(sizeof(svr_addr.addr));
+  GPR_ASSERT(getsockname(fds[1], reinterpret_cast<struct sockaddr*>(
+                                     svr_addr.addr),
+                         &svr_addr.len) == 0);
+
+  GrpcUdpDatagramBatch send_batch(8, 16);
+  GrpcUdpDatagramBatch recv_batch(16, 4);
+  /* Nothing to read yet. */
+  GPR_ASSERT(recv_batch.RecvFrom(fds[1]) == 0);
+  /* Too large for the batch. */
+  GPR_ASSERT(!send_batch.Add("0123456789abcdefg", 17, &svr_addr));
+  char payload[2];
+  for (int i = 0; i < 8; i++) {
+    payload[0] = 'a' + i;
+    payload[1] = 'z';
+    GPR_ASSERT(send_batch.Add(payload, 1 + (i % 2), &svr_addr));
+  }
+  GPR_ASSERT(!send_batch.Add(payload, 1, &svr_addr));
+  GPR_ASSERT(send_batch.SendTo(fds[0]) == 8);
+  GPR_ASSERT(send_batch.size() == 0);
+
+  /* Loopback delivery is synchronous, so all of the datagrams are queued. */
+  GPR_ASSERT(recv_batch.RecvFrom(fds[1]) == 8);
+  GPR_ASSERT(recv_batch.size() == 8);
+  for (size_t i = 0; i < recv_batch.size(); i++) {
+    GPR_ASSERT(recv_batch.length(i) == 1 + (i % 2));
+    GPR_ASSERT(recv_batch.data(i)[0] == static_cast<char>('a' + i));
+    GPR_ASSERT(recv_batch.peer(i).len == cli_addr.len);
+    GPR_ASSERT(memcmp(recv_batch.peer(i).addr, cli_addr.addr,
+                      cli_addr.len) == 0);
+  }
+
+  /* Datagrams longer than the buffers are truncated. */
+  GPR_ASSERT(send_batch.Add("0123456789", 10, &svr_addr));
+  GPR_ASSERT(send_batch.SendTo(fds[0]) == 1);
+  GPR_ASSERT(recv_batch.RecvFrom(fds[1]) == 1);
+  GPR_ASSERT(recv_batch.length(0) == 4);
+  GPR_ASSERT(memcmp(recv_batch.data(0), "0123", 4) == 0);
+
+  close(fds[0]);
+  close(fds[1]);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
@@ -376,6 +440,7 @@ int main(int argc, char** argv) {
     test_no_op_with_port_and_start();
     test_receive(1);
     test_receive(10);
+    test_datagram_batch();
 
     gpr_free(g_pollset);
   }
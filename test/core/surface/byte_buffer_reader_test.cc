@@ -101,6 +101,29 @@ static void test_read_none_compressed_slice(void) {
   grpc_byte_buffer_destroy(buffer);
 }
 
+static void test_peek_one_slice(void) {
+  grpc_slice slice;
+  grpc_byte_buffer* buffer;
+  grpc_byte_buffer_reader reader;
+  grpc_slice* first_slice;
+  grpc_slice* second_slice;
+  int first_code, second_code;
+
+  LOG_TEST("test_peek_one_slice");
+  slice = grpc_slice_from_copied_string("test");
+  buffer = grpc_raw_byte_buffer_create(&slice, 1);
+  grpc_slice_unref(slice);
+  GPR_ASSERT(grpc_byte_buffer_reader_init(&reader, buffer) &&
+             "Couldn't init byte buffer reader");
+  first_code = grpc_byte_buffer_reader_peek(&reader, &first_slice);
+  GPR_ASSERT(first_code != 0);
+  GPR_ASSERT(first_slice == &buffer->data.raw.slice_buffer.slices[0]);
+  GPR_ASSERT(memcmp(GRPC_SLICE_START_PTR(*first_slice), "test", 4) == 0);
+  second_code = grpc_byte_buffer_reader_peek(&reader, &second_slice);
+  GPR_ASSERT(second_code == 0);
+  grpc_byte_buffer_destroy(buffer);
+}
+
 static void test_read_corrupted_slice(void) {
   grpc_slice slice;
   grpc_byte_buffer* buffer;
@@ -158,6 +181,53 @@ static void read_compressed_slice(grpc_compression_algorithm algorithm,
   grpc_slice_buffer_destroy(&sliceb_in);
 }
 
+static void peek_compressed_slice(grpc_compression_algorithm algorithm,
+                                  size_t input_size) {
+  grpc_slice input_slice;
+  grpc_slice_buffer sliceb_in;
+  grpc_slice_buffer sliceb_out;
+  grpc_byte_buffer* buffer;
+  grpc_byte_buffer_reader reader;
+  grpc_slice* read_slice;
+  size_t read_count = 0;
+
+  grpc_slice_buffer_init(&sliceb_in);
+  grpc_slice_buffer_init(&sliceb_out);
+
+  input_slice = grpc_slice_malloc(input_size);
+  memset(GRPC_SLICE_START_PTR(input_slice), 'a', input_size);
+  grpc_slice_buffer_add(&sliceb_in, input_slice); /* takes ownership */
+  {
+    grpc_core::ExecCtx exec_ctx;
+    GPR_ASSERT(grpc_msg_compress(
+        grpc_compression_algorithm_to_message_compression_algorithm(algorithm),
+        &sliceb_in, &sliceb_out));
+  }
+
+  buffer = grpc_raw_compressed_byte_buffer_create(sliceb_out.slices,
+                                                  sliceb_out.count, algorithm);
+  GPR_ASSERT(grpc_byte_buffer_reader_init(&reader, buffer) &&
+             "Couldn't init byte buffer reader");
+
+  while (grpc_byte_buffer_reader_peek(&reader, &read_slice)) {
+    GPR_ASSERT(memcmp(GRPC_SLICE_START_PTR(*read_slice),
+                      GRPC_SLICE_START_PTR(input_slice) + read_count,
+                      GRPC_SLICE_LENGTH(*read_slice)) == 0);
+    read_count += GRPC_SLICE_LENGTH(*read_slice);
+  }
+  GPR_ASSERT(read_count == input_size);
+  grpc_byte_buffer_reader_destroy(&reader);
+  grpc_byte_buffer_destroy(buffer);
+  grpc_slice_buffer_destroy(&sliceb_out);
+  grpc_slice_buffer_destroy(&sliceb_in);
+}
+
+static void test_peek_gzip_compressed_slice(void) {
+  const size_t INPUT_SIZE = 2048;
+  LOG_TEST("test_peek_gzip_compressed_slice");
+  peek_compressed_slice(GRPC_COMPRESS_GZIP, INPUT_SIZE);
+}
+
 static void test_read_gzip_compressed_slice(void) {
   const size_t INPUT_SIZE = 2048;
   LOG_TEST("test_read_gzip_compressed_slice");
@@ -229,6 +299,29 @@ static void test_readall(void) {
   grpc_byte_buffer_destroy(buffer);
 }
 
+static void test_readall_one_slice(void) {
+  grpc_slice slice;
+  grpc_byte_buffer* buffer;
+  grpc_byte_buffer_reader reader;
+  grpc_slice slice_out;
+
+  LOG_TEST("test_readall_one_slice");
+  /* use a slice large enough to overflow inlining */
+  slice = grpc_slice_malloc(1024);
+  memset(GRPC_SLICE_START_PTR(slice), 'a', 1024);
+  buffer = grpc_raw_byte_buffer_create(&slice, 1);
+  GPR_ASSERT(grpc_byte_buffer_reader_init(&reader, buffer) &&
+             "Couldn't init byte buffer reader");
+  slice_out = grpc_byte_buffer_reader_readall(&reader);
+
+  /* a single slice is returned as is, without a copy */
+  GPR_ASSERT(grpc_slice_eq(slice_out, slice));
+  GPR_ASSERT(GRPC_SLICE_START_PTR(slice_out) == GRPC_SLICE_START_PTR(slice));
+  grpc_slice_unref(slice);
+  grpc_slice_unref(slice_out);
+  grpc_byte_buffer_destroy(buffer);
+}
+
 static void test_byte_buffer_copy(void) {
   char* lotsa_as[512];
   char* lotsa_bs[1024];
@@ -271,11 +364,14 @@ int main(int argc, char** argv) {
   test_read_one_slice();
   test_read_one_slice_malloc();
   test_read_none_compressed_slice();
+  test_peek_one_slice();
   test_read_gzip_compressed_slice();
+  test_peek_gzip_compressed_slice();
   test_read_deflate_compressed_slice();
   test_read_corrupted_slice();
   test_byte_buffer_from_reader();
   test_byte_buffer_copy();
   test_readall();
+  test_readall_one_slice();
   return 0;
 }
@@ -75,6 +75,7 @@ int main(int argc, char **argv) {
   printf("%lx", (unsigned long) grpc_call_details_init);
   printf("%lx", (unsigned long) grpc_call_details_destroy);
   printf("%lx", (unsigned long) grpc_register_plugin);
+  printf("%lx", (unsigned long) grpc_register_well_known_metadata_key);
   printf("%lx", (unsigned long) grpc_init);
   printf("%lx", (unsigned long) grpc_shutdown);
   printf("%lx", (unsigned long) grpc_is_initialized);
@@ -199,6 +200,7 @@ int main(int argc, char **argv) {
   printf("%lx", (unsigned long) grpc_byte_buffer_reader_init);
   printf("%lx", (unsigned long) grpc_byte_buffer_reader_destroy);
   printf("%lx", (unsigned long) grpc_byte_buffer_reader_next);
+  printf("%lx", (unsigned long) grpc_byte_buffer_reader_peek);
   printf("%lx", (unsigned long) grpc_byte_buffer_reader_readall);
   printf("%lx", (unsigned long) grpc_raw_byte_buffer_from_reader);
   printf("%lx", (unsigned long) gpr_log_severity_string);
@@ -16,6 +16,7 @@
  *
  */
 
+#include <grpc/byte_buffer_reader.h>
 #include <grpc/grpc.h>
 #include <grpc/grpc_security.h>
 #include <grpc/support/alloc.h>
@@ -25,6 +26,7 @@
 #include "src/core/lib/gpr/host_port.h"
 #include "src/core/lib/iomgr/resolve_address.h"
 #include "src/core/lib/security/credentials/fake/fake_credentials.h"
+#include "src/core/lib/surface/server_response_cache.h"
 #include "test/core/util/port.h"
 #include "test/core/util/test_config.h"
 
@@ -147,11 +149,106 @@ static void test_bind_server_to_addrs(const char** addrs, size_t n) {
   }
 }
 
+static grpc_byte_buffer* make_byte_buffer(const char* str) {
+  grpc_slice slice = grpc_slice_from_copied_string(str);
+  grpc_byte_buffer* buffer = grpc_raw_byte_buffer_create(&slice, 1);
+  grpc_slice_unref(slice);
+  return buffer;
+}
+
+/* Returns true if the response cached under key is str, and consumes it */
+static bool cached_response_is(grpc_core::ServerResponseCache* cache,
+                               grpc_slice key, const char* str) {
+  grpc_byte_buffer* response = cache->Lookup(key);
+  if (response == nullptr) return false;
+  grpc_byte_buffer_reader reader;
+  GPR_ASSERT(grpc_byte_buffer_reader_init(&reader, response));
+  grpc_slice flat = grpc_byte_buffer_reader_readall(&reader);
+  bool equal = grpc_slice_str_cmp(flat, str) == 0;
+  grpc_slice_unref(flat);
+  grpc_byte_buffer_reader_destroy(&reader);
+  grpc_byte_buffer_destroy(response);
+  return equal;
+}
+
+static void insert_response(grpc_core::ServerResponseCache* cache,
+                            grpc_slice key, const char* str, grpc_millis ttl) {
+  grpc_slice_buffer response;
+  grpc_slice_buffer_init(&response);
+  grpc_slice_buffer_add(&response, grpc_slice_from_copied_string(str));
+  cache->Insert(grpc_slice_ref(key), &response, ttl);
+  grpc_slice_buffer_destroy(&response);
+}
+
+static void test_response_cache(void) {
+  grpc_core::ExecCtx exec_ctx;
+  const grpc_millis kTtl = 3600 * GPR_MS_PER_SEC;
+  grpc_resource_quota* quota = grpc_resource_quota_create("response_cache");
+  grpc_slice host = grpc_slice_from_static_string("host");
+  grpc_slice path = grpc_slice_from_static_string("/svc/method");
+  grpc_slice other_path = grpc_slice_from_static_string("/svc/other");
+  grpc_byte_buffer* requests[3] = {make_byte_buffer("request1"),
+                                   make_byte_buffer("request2"),
+                                   make_byte_buffer("request3")};
+  grpc_slice keys[3];
+  for (size_t i = 0; i < 3; i++) {
+    keys[i] =
+        grpc_core::ServerResponseCache::MakeKey(host, path, requests[i]);
+  }
+  grpc_slice other_key =
+      grpc_core::ServerResponseCache::MakeKey(host, other_path, requests[0]);
+
+  /* hits only for the same method and request, until the entry expires */
+  auto cache = grpc_core::MakeRefCounted<grpc_core::ServerResponseCache>(
+      quota, GRPC_SERVER_RESPONSE_CACHE_DEFAULT_MAX_BYTES);
+  GPR_ASSERT(!cached_response_is(cache.get(), keys[0], "response1"));
+  insert_response(cache.get(), keys[0], "response1", kTtl);
+  GPR_ASSERT(cached_response_is(cache.get(), keys[0], "response1"));
+  GPR_ASSERT(cache->Lookup(keys[1]) == nullptr);
+  GPR_ASSERT(cache->Lookup(other_key) == nullptr);
+  const size_t entry_size = cache->size_bytes();
+  insert_response(cache.get(), keys[1], "response2", 0);
+  GPR_ASSERT(cache->num_entries() == 2);
+  GPR_ASSERT(cache->Lookup(keys[1]) == nullptr);
+  GPR_ASSERT(cache->num_entries() == 1);
+  cache->Shutdown();
+  cache.reset();
+
+  /* evicts the least recently used entry when full */
+  cache = grpc_core::MakeRefCounted<grpc_core::ServerResponseCache>(
+      quota, 2 * entry_size + entry_size / 2);
+  insert_response(cache.get(), keys[0], "response1", kTtl);
+  insert_response(cache.get(), keys[1], "response2", kTtl);
+  GPR_ASSERT(cached_response_is(cache.get(), keys[0], "response1"));
+  insert_response(cache.get(), keys[2], "response3", kTtl);
+  GPR_ASSERT(cache->num_entries() == 2);
+  GPR_ASSERT(cached_response_is(cache.get(), keys[0], "response1"));
+  GPR_ASSERT(cache->Lookup(keys[1]) == nullptr);
+  GPR_ASSERT(cached_response_is(cache.get(), keys[2], "response3"));
+
+  /* evicts entries to stay within the resource quota */
+  grpc_resource_quota_resize(quota, entry_size + entry_size / 2);
+  insert_response(cache.get(), keys[1], "response2", kTtl);
+  GPR_ASSERT(cache->num_entries() == 1);
+  GPR_ASSERT(cached_response_is(cache.get(), keys[1], "response2"));
+  cache->Shutdown();
+  GPR_ASSERT(cache->num_entries() == 0);
+  cache.reset();
+
+  for (size_t i = 0; i < 3; i++) {
+    grpc_slice_unref(keys[i]);
+    grpc_byte_buffer_destroy(requests[i]);
+  }
+  grpc_slice_unref(other_key);
+  grpc_resource_quota_unref(quota);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
   test_register_method_fail();
   test_request_call_on_no_server_cq();
+  test_response_cache();
 #ifndef GRPC_UV
   test_bind_server_twice();
 #endif
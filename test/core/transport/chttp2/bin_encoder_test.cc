@@ -90,6 +90,19 @@ static void expect_combined_equiv(const char* s, size_t len, int line) {
 #define EXPECT_COMBINED_EQUIV(x) \
   expect_combined_equiv(x, sizeof(x) - 1, __LINE__)
 
+/* Checks the combined encoding of |len| pseudo-random bytes, long enough to go
+   through the block encoder. */
+static void expect_combined_equiv_random(size_t len, int line) {
+  char* s = static_cast<char*>(gpr_malloc(len + 1));
+  uint32_t x = static_cast<uint32_t>(len) + 1;
+  for (size_t i = 0; i < len; i++) {
+    x = x * 1103515245 + 12345;
+    s[i] = static_cast<char>(x >> 16);
+  }
+  expect_combined_equiv(s, len, line);
+  gpr_free(s);
+}
+
 static void expect_binary_header(const char* hdr, int binary) {
   if (grpc_is_binary_header(grpc_slice_from_static_string(hdr)) != binary) {
     gpr_log(GPR_ERROR, "FAILED: expected header '%s' to be %s", hdr,
@@ -166,6 +179,12 @@ int main(int argc, char** argv) {
       "\xd0\xd1\xd2\xd3\xd4\xd5\xd6\xd7\xd8\xd9\xda\xdb\xdc\xdd\xde\xdf"
       "\xe0\xe1\xe2\xe3\xe4\xe5\xe6\xe7\xe8\xe9\xea\xeb\xec\xed\xee\xef"
       "\xf0\xf1\xf2\xf3\xf4\xf5\xf6\xf7\xf8\xf9\xfa\xfb\xfc\xfd\xfe\xff");
+  for (size_t len = 0; len < 64; len++) {
+    expect_combined_equiv_random(len, __LINE__);
+  }
+  for (size_t len = 1024; len <= 16384; len = len * 2 + 1) {
+    expect_combined_equiv_random(len, __LINE__);
+  }
 
   expect_binary_header("foo-bin", 1);
   expect_binary_header("foo-bar", 0);
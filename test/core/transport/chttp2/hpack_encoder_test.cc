@@ -30,6 +30,7 @@
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 #include "src/core/lib/transport/metadata.h"
+#include "src/core/lib/transport/timeout_encoding.h"
 #include "test/core/util/parse_hexstring.h"
 #include "test/core/util/slice_splitter.h"
 #include "test/core/util/test_config.h"
@@ -250,6 +251,109 @@ static void test_interned_key_indexed() {
   }
 }
 
+static void encode_deadline(grpc_chttp2_hpack_compressor* c,
+                            grpc_millis timeout) {
+  grpc_slice_buffer output;
+  grpc_metadata_batch b;
+  grpc_metadata_batch_init(&b);
+  b.deadline = grpc_core::ExecCtx::Get()->Now() + timeout;
+  grpc_slice_buffer_init(&output);
+
+  grpc_transport_one_way_stats stats;
+  memset(&stats, 0, sizeof(stats));
+  grpc_encode_header_options hopt = {
+      0xdeadbeef, /* stream_id */
+      false,      /* is_eof */
+      false,      /* use_true_binary_metadata */
+      16384,      /* max_frame_size */
+      &stats /* stats */};
+  grpc_chttp2_encode_header(c, nullptr, 0, &b, &hopt, &output);
+  grpc_slice_buffer_destroy_internal(&output);
+  grpc_metadata_batch_destroy(&b);
+}
+
+/* returns the slot of c's grpc-timeout cache that holds the encoding of
+   timeout, or -1 if it is not cached */
+static int find_timeout_slot(grpc_chttp2_hpack_compressor* c,
+                             grpc_millis timeout) {
+  char value[GRPC_HTTP2_TIMEOUT_ENCODE_MIN_BUFSIZE];
+  grpc_http2_encode_timeout(timeout, value);
+  int slot = -1;
+  for (int i = 0; i < GRPC_CHTTP2_HPACKC_NUM_TIMEOUTS; i++) {
+    if (!GRPC_MDISNULL(c->timeout_elems[i]) &&
+        grpc_slice_str_cmp(GRPC_MDVALUE(c->timeout_elems[i]), value) == 0) {
+      GPR_ASSERT(slot == -1);
+      slot = i;
+    }
+  }
+  return slot;
+}
+
+static void test_timeout_elem_reused() {
+  encode_deadline(&g_compressor, 1500);
+  int slot = find_timeout_slot(&g_compressor, 1500);
+  GPR_ASSERT(slot >= 0);
+  grpc_mdelem elem = g_compressor.timeout_elems[slot];
+  for (int i = 0; i < 10; i++) {
+    encode_deadline(&g_compressor, 1500);
+    GPR_ASSERT(find_timeout_slot(&g_compressor, 1500) == slot);
+    GPR_ASSERT(GRPC_MDELEM_DATA(g_compressor.timeout_elems[slot]) ==
+               GRPC_MDELEM_DATA(elem));
+  }
+  for (int i = 0; i < GRPC_CHTTP2_HPACKC_NUM_TIMEOUTS; i++) {
+    GPR_ASSERT(i == slot || GRPC_MDISNULL(g_compressor.timeout_elems[i]));
+  }
+}
+
+static void test_timeout_elem_replaced() {
+  encode_deadline(&g_compressor, 1000);
+  int slot = find_timeout_slot(&g_compressor, 1000);
+  GPR_ASSERT(slot >= 0);
+  /* send other timeouts until one of them lands in the same slot */
+  grpc_millis timeout = 1000;
+  while (find_timeout_slot(&g_compressor, 1000) == slot) {
+    timeout += 1000;
+    GPR_ASSERT(timeout <= 1000 * 1000);
+    encode_deadline(&g_compressor, timeout);
+  }
+  GPR_ASSERT(find_timeout_slot(&g_compressor, 1000) == -1);
+  GPR_ASSERT(find_timeout_slot(&g_compressor, timeout) == slot);
+  /* the evicted value takes its slot back when it is sent again */
+  encode_deadline(&g_compressor, 1000);
+  GPR_ASSERT(find_timeout_slot(&g_compressor, 1000) == slot);
+  GPR_ASSERT(find_timeout_slot(&g_compressor, timeout) == -1);
+}
+
+static void count_released_elem(void* released) {
+  ++*static_cast<int*>(released);
+}
+
+/* grpc_shutdown() frees every interned elem that is no longer referenced,
+   so by then each timeout elem the compressor created must have been
+   released, whether it was replaced or still cached when it was destroyed */
+static void test_timeout_elems_released() {
+  gpr_log(GPR_INFO, "RUN TEST: test_timeout_elems_released");
+  const int num_timeouts = 2 * GRPC_CHTTP2_HPACKC_NUM_TIMEOUTS;
+  int released = 0;
+  grpc_init();
+  {
+    grpc_core::ExecCtx exec_ctx;
+    grpc_chttp2_hpack_compressor c;
+    grpc_chttp2_hpack_compressor_init(&c);
+    for (int i = 1; i <= num_timeouts; i++) {
+      encode_deadline(&c, i * 1000);
+      int slot = find_timeout_slot(&c, i * 1000);
+      GPR_ASSERT(slot >= 0);
+      GPR_ASSERT(grpc_mdelem_set_user_data(c.timeout_elems[slot],
+                                           count_released_elem,
+                                           &released) == &released);
+    }
+    grpc_chttp2_hpack_compressor_destroy(&c);
+  }
+  grpc_shutdown();
+  GPR_ASSERT(released == num_timeouts);
+}
+
 static void run_test(void (*test)(), const char* name) {
   gpr_log(GPR_INFO, "RUN TEST: %s", name);
   grpc_core::ExecCtx exec_ctx;
@@ -267,7 +371,10 @@ int main(int argc, char** argv) {
   TEST(test_decode_table_overflow);
   TEST(test_encode_header_size);
   TEST(test_interned_key_indexed);
+  TEST(test_timeout_elem_reused);
+  TEST(test_timeout_elem_replaced);
   grpc_shutdown();
+  test_timeout_elems_released();
   for (i = 0; i < num_to_delete; i++) {
     gpr_free(to_delete[i]);
   }
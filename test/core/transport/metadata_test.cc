@@ -31,6 +31,8 @@
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "src/core/lib/transport/registered_metadata.h"
 #include "src/core/lib/transport/static_metadata.h"
 #include "test/core/util/test_config.h"
 
@@ -369,8 +371,75 @@ static void test_copied_static_metadata(bool dup_key, bool dup_value) {
   grpc_shutdown();
 }
 
+static int g_tenant_id_index;
+static int g_request_id_index;
+
+static void register_well_known_metadata_keys(void) {
+  g_tenant_id_index = grpc_register_well_known_metadata_key(
+      "x-tenant-id", GRPC_WELL_KNOWN_METADATA_REPEATED_VALUES);
+  g_request_id_index = grpc_register_well_known_metadata_key("x-request-id", 0);
+  GPR_ASSERT(g_tenant_id_index >= 0);
+  GPR_ASSERT(g_request_id_index >= 0);
+  GPR_ASSERT(g_tenant_id_index != g_request_id_index);
+  GPR_ASSERT(grpc_register_well_known_metadata_key("x-request-id", 0) ==
+             g_request_id_index);
+  GPR_ASSERT(grpc_register_well_known_metadata_key("user-agent", 0) == -1);
+  GPR_ASSERT(grpc_register_well_known_metadata_key("X-Tenant-Id", 0) == -1);
+  GPR_ASSERT(grpc_register_well_known_metadata_key("", 0) == -1);
+}
+
+static void test_registered_metadata(void) {
+  gpr_log(GPR_INFO, "test_registered_metadata");
+  grpc_init();
+  grpc_core::ExecCtx exec_ctx;
+
+  GPR_ASSERT(grpc_register_well_known_metadata_key("x-too-late", 0) == -1);
+
+  grpc_slice key =
+      grpc_slice_intern(grpc_slice_from_static_string("x-tenant-id"));
+  GPR_ASSERT(GRPC_IS_REGISTERED_METADATA_STRING(key));
+  GPR_ASSERT(GRPC_REGISTERED_METADATA_INDEX(key) == g_tenant_id_index);
+  GPR_ASSERT(grpc_slice_is_interned(key));
+  grpc_slice_unref(key);
+
+  grpc_metadata md[3];
+  memset(md, 0, sizeof(md));
+  md[0].key = grpc_slice_from_static_string("x-tenant-id");
+  md[0].value = grpc_slice_from_static_string("tenant-1");
+  md[1].key = grpc_slice_from_static_string("x-request-id");
+  md[1].value = grpc_slice_from_static_string("1234");
+  md[2].key = grpc_slice_from_static_string("x-request-id");
+  md[2].value = grpc_slice_from_static_string("5678");
+  grpc_mdelem elems[3];
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(md); i++) {
+    elems[i] = grpc_mdelem_from_grpc_metadata(&md[i]);
+    GPR_ASSERT(GRPC_IS_REGISTERED_METADATA_STRING(GRPC_MDKEY(elems[i])));
+  }
+  /* only the values of the tenant id are worth interning */
+  GPR_ASSERT(GRPC_MDELEM_IS_INTERNED(elems[0]));
+  GPR_ASSERT(!GRPC_MDELEM_IS_INTERNED(elems[1]));
+
+  grpc_metadata_batch batch;
+  grpc_metadata_batch_init(&batch);
+  grpc_linked_mdelem storage[3];
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(elems); i++) {
+    GPR_ASSERT(GRPC_ERROR_NONE ==
+               grpc_metadata_batch_add_tail(&batch, &storage[i], elems[i]));
+  }
+  GPR_ASSERT(batch.registered[g_tenant_id_index] == &storage[0]);
+  GPR_ASSERT(batch.registered[g_request_id_index] == &storage[1]);
+  grpc_metadata_batch_remove(&batch, &storage[1]);
+  GPR_ASSERT(batch.registered[g_request_id_index] == &storage[2]);
+  grpc_metadata_batch_remove(&batch, &storage[2]);
+  GPR_ASSERT(batch.registered[g_request_id_index] == nullptr);
+  grpc_metadata_batch_destroy(&batch);
+
+  grpc_shutdown();
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
+  register_well_known_metadata_keys();
   grpc_init();
   test_no_op();
   for (int k = 0; k <= 1; k++) {
@@ -386,6 +455,7 @@ int main(int argc, char** argv) {
   test_create_many_persistant_metadata();
   test_things_stick_around();
   test_user_data_works();
+  test_registered_metadata();
   grpc_shutdown();
   return 0;
 }
@@ -0,0 +1,109 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/lib/transport/service_config.h"
+
+#include <string.h>
+
+#include <gtest/gtest.h>
+
+#include "src/core/lib/json/json.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+bool ParseDuration(const char* value, grpc_millis* duration) {
+  grpc_json field;
+  memset(&field, 0, sizeof(field));
+  field.type = GRPC_JSON_STRING;
+  field.value = value;
+  return ServiceConfig::ParseJsonDuration(&field, duration);
+}
+
+void ExpectDuration(const char* value, grpc_millis expected) {
+  grpc_millis duration = -1;
+  EXPECT_TRUE(ParseDuration(value, &duration)) << value;
+  EXPECT_EQ(expected, duration) << value;
+}
+
+void ExpectMalformed(const char* value) {
+  grpc_millis duration = -1;
+  EXPECT_FALSE(ParseDuration(value, &duration)) << value;
+  EXPECT_EQ(-1, duration) << value;
+}
+
+TEST(ParseJsonDuration, WholeSeconds) {
+  ExpectDuration("0s", 0);
+  ExpectDuration("1s", 1000);
+  ExpectDuration("3000000s", 3000000000);
+}
+
+TEST(ParseJsonDuration, FractionalSeconds) {
+  ExpectDuration("1.5s", 1500);
+  ExpectDuration(".5s", 500);
+  ExpectDuration("0.001s", 1);
+  // Precision below a millisecond is truncated.
+  ExpectDuration("1.000999999s", 1000);
+}
+
+TEST(ParseJsonDuration, UpperBound) {
+  ExpectDuration("315575999999s", 315575999999000);
+  ExpectDuration("315576000000s", 315576000000000);
+  ExpectMalformed("315576000001s");
+  ExpectMalformed("99999999999999999999999s");
+}
+
+TEST(ParseJsonDuration, TooManyFractionalDigits) {
+  ExpectDuration("1.000000001s", 1000);
+  ExpectMalformed("1.0000000001s");
+}
+
+TEST(ParseJsonDuration, Malformed) {
+  ExpectMalformed("");
+  ExpectMalformed("s");
+  ExpectMalformed(".s");
+  ExpectMalformed("1.s");
+  ExpectMalformed("1");
+  ExpectMalformed("1.5");
+  ExpectMalformed("1S");
+  ExpectMalformed("1s ");
+  ExpectMalformed("1ms");
+  ExpectMalformed("-1s");
+  ExpectMalformed("+1s");
+}
+
+TEST(ParseJsonDuration, NotAString) {
+  grpc_json field;
+  memset(&field, 0, sizeof(field));
+  field.type = GRPC_JSON_NUMBER;
+  field.value = "1";
+  grpc_millis duration = -1;
+  EXPECT_FALSE(ServiceConfig::ParseJsonDuration(&field, &duration));
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
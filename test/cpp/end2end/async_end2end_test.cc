@@ -17,10 +17,13 @@
  */
 
 #include <cinttypes>
+#include <functional>
 #include <memory>
 #include <thread>
 
+#include <grpc/byte_buffer.h>
 #include <grpc/grpc.h>
+#include <grpc/slice_buffer.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/time.h>
@@ -32,8 +35,10 @@
 #include <grpcpp/server_builder.h>
 #include <grpcpp/server_context.h>
 
+#include "src/core/lib/compression/message_compress.h"
 #include "src/core/lib/gpr/env.h"
 #include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/port.h"
 #include "src/proto/grpc/health/v1/health.grpc.pb.h"
 #include "src/proto/grpc/testing/duplicate/echo_duplicate.grpc.pb.h"
@@ -51,6 +56,20 @@ using grpc::testing::kTlsCredentialsType;
 using std::chrono::system_clock;
 
 namespace grpc {
+namespace internal {
+
+// Provides access to ByteBuffer internals.
+class GrpcByteBufferPeer {
+ public:
+  explicit GrpcByteBufferPeer(ByteBuffer* bb) : bb_(bb) {}
+  void set_buffer(grpc_byte_buffer* buf) { bb_->set_buffer(buf); }
+
+ private:
+  ByteBuffer* bb_;
+};
+
+}  // namespace internal
+
 namespace testing {
 
 namespace {
@@ -279,6 +298,16 @@ class AsyncEnd2endTest : public ::testing::TestWithParam<TestScenario> {
     if (GetParam().health_check_service) {
       builder.RegisterService(&health_check_);
     }
+    if (extra_service_ != nullptr) {
+      builder.RegisterService(extra_service_);
+    }
+    if (!server_service_config_.empty()) {
+      builder.AddChannelArgument(GRPC_ARG_SERVICE_CONFIG,
+                                 server_service_config_);
+    }
+    if (server_default_compression_ != GRPC_COMPRESS_NONE) {
+      builder.SetDefaultCompressionAlgorithm(server_default_compression_);
+    }
     cq_ = builder.AddCompletionQueue();
 
     // TODO(zyc): make a test option to choose wheather sync plugins should be
@@ -289,15 +318,32 @@ class AsyncEnd2endTest : public ::testing::TestWithParam<TestScenario> {
     server_ = builder.BuildAndStart();
   }
 
-  void ResetStub() {
+  std::shared_ptr<Channel> CreateTestChannel() {
     ChannelArguments args;
     auto channel_creds = GetCredentialsProvider()->GetChannelCredentials(
         GetParam().credentials_type, &args);
-    std::shared_ptr<Channel> channel =
-        !(GetParam().inproc)
-            ? CreateCustomChannel(server_address_.str(), channel_creds, args)
-            : server_->InProcessChannel(args);
-    stub_ = grpc::testing::EchoTestService::NewStub(channel);
+    return !(GetParam().inproc)
+               ? CreateCustomChannel(server_address_.str(), channel_creds, args)
+               : server_->InProcessChannel(args);
+  }
+
+  void ResetStub() {
+    stub_ = grpc::testing::EchoTestService::NewStub(CreateTestChannel());
+  }
+
+  // Points stub_ at an in-process channel that coalesces identical Echo
+  // calls.
+  void ResetCoalescingStub() {
+    ChannelArguments args;
+    args.SetInt(GRPC_ARG_ENABLE_REQUEST_COALESCING, 1);
+    args.SetServiceConfigJSON(
+        "{\"methodConfig\": [{\"name\": [{\"service\": "
+        "\"grpc.testing.EchoTestService\", \"method\": \"Echo\"}], "
+        "\"coalesceRequests\": true}]}");
+    GetCredentialsProvider()->GetChannelCredentials(GetParam().credentials_type,
+                                                    &args);
+    stub_ = grpc::testing::EchoTestService::NewStub(
+        server_->InProcessChannel(args));
   }
 
   void SendRpc(int num_rpcs) {
@@ -340,6 +386,11 @@ class AsyncEnd2endTest : public ::testing::TestWithParam<TestScenario> {
   HealthCheck health_check_;
   std::ostringstream server_address_;
   int port_;
+  // The server's GRPC_ARG_SERVICE_CONFIG, if not empty.
+  grpc::string server_service_config_;
+  grpc_compression_algorithm server_default_compression_ = GRPC_COMPRESS_NONE;
+  // Registered alongside service_, if not null.
+  Service* extra_service_ = nullptr;
 };
 
 TEST_P(AsyncEnd2endTest, SimpleRpc) {
@@ -1276,6 +1327,513 @@ TEST_P(AsyncEnd2endTest, UnimplementedRpc) {
   EXPECT_EQ("", recv_status.error_message());
 }
 
+TEST_P(AsyncEnd2endTest, CoalescedRpcs) {
+  // Only in-process channels hand a call's first batch to the coalescing
+  // filter before AsyncEcho() returns; over TCP the calls could still be
+  // waiting for a subchannel pick when the leader completes.
+  if (!GetParam().inproc) {
+    return;
+  }
+  ResetCoalescingStub();
+
+  const int kNumRpcs = 3;
+  EchoRequest send_request;
+  send_request.set_message(GetParam().message_content);
+  ClientContext cli_ctx[kNumRpcs];
+  EchoResponse recv_response[kNumRpcs];
+  Status recv_status[kNumRpcs];
+  std::unique_ptr<ClientAsyncResponseReader<EchoResponse>>
+      response_reader[kNumRpcs];
+
+  EchoRequest recv_request;
+  EchoResponse send_response;
+  ServerContext srv_ctx;
+  grpc::ServerAsyncResponseWriter<EchoResponse> response_writer(&srv_ctx);
+  response_reader[0] = stub_->AsyncEcho(&cli_ctx[0], send_request, cq_.get());
+  service_->RequestEcho(&srv_ctx, &recv_request, &response_writer, cq_.get(),
+                        cq_.get(), tag(1));
+  Verifier().Expect(1, true).Verify(cq_.get());
+
+  // These calls are identical to the one the server is holding, so they are
+  // not sent. If one was, it would never be answered and would hit its
+  // deadline.
+  for (int i = 1; i < kNumRpcs; i++) {
+    cli_ctx[i].set_deadline(grpc_timeout_milliseconds_to_deadline(10000));
+    response_reader[i] = stub_->AsyncEcho(&cli_ctx[i], send_request, cq_.get());
+  }
+  for (int i = 0; i < kNumRpcs; i++) {
+    response_reader[i]->Finish(&recv_response[i], &recv_status[i],
+                               tag(10 + i));
+  }
+
+  send_response.set_message(recv_request.message());
+  response_writer.Finish(send_response, Status::OK, tag(2));
+  Verifier verifier;
+  verifier.Expect(2, true);
+  for (int i = 0; i < kNumRpcs; i++) {
+    verifier.Expect(10 + i, true);
+  }
+  verifier.Verify(cq_.get());
+
+  for (int i = 0; i < kNumRpcs; i++) {
+    EXPECT_TRUE(recv_status[i].ok()) << recv_status[i].error_message();
+    EXPECT_EQ(send_response.message(), recv_response[i].message());
+  }
+}
+
+// The leader is cancelled while the server holds it: its follower, whose
+// deadline is earlier than the leader's, sends its own request instead of
+// failing.
+TEST_P(AsyncEnd2endTest, CoalescedRpcsLeaderCancelled) {
+  if (!GetParam().inproc) {
+    return;
+  }
+  ResetCoalescingStub();
+
+  EchoRequest send_request;
+  send_request.set_message(GetParam().message_content);
+  ClientContext cli_ctx[2];
+  EchoResponse recv_response[2];
+  Status recv_status[2];
+  std::unique_ptr<ClientAsyncResponseReader<EchoResponse>> response_reader[2];
+
+  EchoRequest recv_request[2];
+  EchoResponse send_response;
+  ServerContext srv_ctx[2];
+  grpc::ServerAsyncResponseWriter<EchoResponse> response_writer0(&srv_ctx[0]);
+  grpc::ServerAsyncResponseWriter<EchoResponse> response_writer1(&srv_ctx[1]);
+  response_reader[0] = stub_->AsyncEcho(&cli_ctx[0], send_request, cq_.get());
+  service_->RequestEcho(&srv_ctx[0], &recv_request[0], &response_writer0,
+                        cq_.get(), cq_.get(), tag(1));
+  Verifier().Expect(1, true).Verify(cq_.get());
+
+  cli_ctx[1].set_deadline(grpc_timeout_milliseconds_to_deadline(10000));
+  response_reader[1] = stub_->AsyncEcho(&cli_ctx[1], send_request, cq_.get());
+  for (int i = 0; i < 2; i++) {
+    response_reader[i]->Finish(&recv_response[i], &recv_status[i],
+                               tag(10 + i));
+  }
+  service_->RequestEcho(&srv_ctx[1], &recv_request[1], &response_writer1,
+                        cq_.get(), cq_.get(), tag(3));
+
+  cli_ctx[0].TryCancel();
+  Verifier().Expect(10, true).Expect(3, true).Verify(cq_.get());
+  EXPECT_EQ(StatusCode::CANCELLED, recv_status[0].error_code());
+  EXPECT_EQ(send_request.message(), recv_request[1].message());
+
+  send_response.set_message(recv_request[1].message());
+  response_writer1.Finish(send_response, Status::OK, tag(4));
+  Verifier().Expect(4, true).Expect(11, true).Verify(cq_.get());
+  EXPECT_TRUE(recv_status[1].ok()) << recv_status[1].error_message();
+  EXPECT_EQ(send_response.message(), recv_response[1].message());
+
+  response_writer0.Finish(EchoResponse(), Status::OK, tag(2));
+  Verifier().Expect(2, true).Verify(cq_.get(), true);
+}
+
+// A follower cancelled while it waits for the leader's response fails on its
+// own; the leader still gets its response.
+TEST_P(AsyncEnd2endTest, CoalescedRpcsFollowerCancelled) {
+  if (!GetParam().inproc) {
+    return;
+  }
+  ResetCoalescingStub();
+
+  EchoRequest send_request;
+  send_request.set_message(GetParam().message_content);
+  ClientContext cli_ctx[2];
+  EchoResponse recv_response[2];
+  Status recv_status[2];
+  std::unique_ptr<ClientAsyncResponseReader<EchoResponse>> response_reader[2];
+
+  EchoRequest recv_request;
+  EchoResponse send_response;
+  ServerContext srv_ctx;
+  grpc::ServerAsyncResponseWriter<EchoResponse> response_writer(&srv_ctx);
+  response_reader[0] = stub_->AsyncEcho(&cli_ctx[0], send_request, cq_.get());
+  service_->RequestEcho(&srv_ctx, &recv_request, &response_writer, cq_.get(),
+                        cq_.get(), tag(1));
+  Verifier().Expect(1, true).Verify(cq_.get());
+
+  cli_ctx[1].set_deadline(grpc_timeout_milliseconds_to_deadline(10000));
+  response_reader[1] = stub_->AsyncEcho(&cli_ctx[1], send_request, cq_.get());
+  for (int i = 0; i < 2; i++) {
+    response_reader[i]->Finish(&recv_response[i], &recv_status[i],
+                               tag(10 + i));
+  }
+
+  cli_ctx[1].TryCancel();
+  Verifier().Expect(11, true).Verify(cq_.get());
+  EXPECT_EQ(StatusCode::CANCELLED, recv_status[1].error_code());
+
+  send_response.set_message(recv_request.message());
+  response_writer.Finish(send_response, Status::OK, tag(2));
+  Verifier().Expect(2, true).Expect(10, true).Verify(cq_.get());
+  EXPECT_TRUE(recv_status[0].ok()) << recv_status[0].error_message();
+  EXPECT_EQ(send_response.message(), recv_response[0].message());
+}
+
+// A call whose deadline is later than the leader's still follows it.
+TEST_P(AsyncEnd2endTest, CoalescedRpcsLaterDeadline) {
+  if (!GetParam().inproc) {
+    return;
+  }
+  ResetCoalescingStub();
+
+  EchoRequest send_request;
+  send_request.set_message(GetParam().message_content);
+  ClientContext cli_ctx[2];
+  EchoResponse recv_response[2];
+  Status recv_status[2];
+  std::unique_ptr<ClientAsyncResponseReader<EchoResponse>> response_reader[2];
+
+  EchoRequest recv_request;
+  EchoResponse send_response;
+  ServerContext srv_ctx;
+  grpc::ServerAsyncResponseWriter<EchoResponse> response_writer(&srv_ctx);
+  cli_ctx[0].set_deadline(grpc_timeout_milliseconds_to_deadline(10000));
+  response_reader[0] = stub_->AsyncEcho(&cli_ctx[0], send_request, cq_.get());
+  service_->RequestEcho(&srv_ctx, &recv_request, &response_writer, cq_.get(),
+                        cq_.get(), tag(1));
+  Verifier().Expect(1, true).Verify(cq_.get());
+
+  // If this call was sent, it would never be answered and would hit its
+  // deadline.
+  cli_ctx[1].set_deadline(grpc_timeout_milliseconds_to_deadline(20000));
+  response_reader[1] = stub_->AsyncEcho(&cli_ctx[1], send_request, cq_.get());
+  for (int i = 0; i < 2; i++) {
+    response_reader[i]->Finish(&recv_response[i], &recv_status[i],
+                               tag(10 + i));
+  }
+
+  send_response.set_message(recv_request.message());
+  response_writer.Finish(send_response, Status::OK, tag(2));
+  Verifier().Expect(2, true).Expect(10, true).Expect(11, true).Verify(
+      cq_.get());
+  for (int i = 0; i < 2; i++) {
+    EXPECT_TRUE(recv_status[i].ok()) << recv_status[i].error_message();
+    EXPECT_EQ(send_response.message(), recv_response[i].message());
+  }
+}
+
+// When the leader runs out of time, its follower sends its own request.
+TEST_P(AsyncEnd2endTest, CoalescedRpcsLeaderDeadlineExceeded) {
+  if (!GetParam().inproc) {
+    return;
+  }
+  ResetCoalescingStub();
+
+  EchoRequest send_request;
+  send_request.set_message(GetParam().message_content);
+  ClientContext cli_ctx[2];
+  EchoResponse recv_response[2];
+  Status recv_status[2];
+  std::unique_ptr<ClientAsyncResponseReader<EchoResponse>> response_reader[2];
+
+  EchoRequest recv_request[2];
+  EchoResponse send_response;
+  ServerContext srv_ctx[2];
+  grpc::ServerAsyncResponseWriter<EchoResponse> response_writer0(&srv_ctx[0]);
+  grpc::ServerAsyncResponseWriter<EchoResponse> response_writer1(&srv_ctx[1]);
+  cli_ctx[0].set_deadline(grpc_timeout_milliseconds_to_deadline(1000));
+  response_reader[0] = stub_->AsyncEcho(&cli_ctx[0], send_request, cq_.get());
+  service_->RequestEcho(&srv_ctx[0], &recv_request[0], &response_writer0,
+                        cq_.get(), cq_.get(), tag(1));
+  Verifier().Expect(1, true).Verify(cq_.get());
+
+  cli_ctx[1].set_deadline(grpc_timeout_milliseconds_to_deadline(20000));
+  response_reader[1] = stub_->AsyncEcho(&cli_ctx[1], send_request, cq_.get());
+  for (int i = 0; i < 2; i++) {
+    response_reader[i]->Finish(&recv_response[i], &recv_status[i],
+                               tag(10 + i));
+  }
+  service_->RequestEcho(&srv_ctx[1], &recv_request[1], &response_writer1,
+                        cq_.get(), cq_.get(), tag(3));
+
+  // The server never answers the leader.
+  Verifier().Expect(10, true).Expect(3, true).Verify(cq_.get());
+  EXPECT_EQ(StatusCode::DEADLINE_EXCEEDED, recv_status[0].error_code());
+  EXPECT_EQ(send_request.message(), recv_request[1].message());
+
+  send_response.set_message(recv_request[1].message());
+  response_writer1.Finish(send_response, Status::OK, tag(4));
+  Verifier().Expect(4, true).Expect(11, true).Verify(cq_.get());
+  EXPECT_TRUE(recv_status[1].ok()) << recv_status[1].error_message();
+  EXPECT_EQ(send_response.message(), recv_response[1].message());
+
+  response_writer0.Finish(EchoResponse(), Status::OK, tag(2));
+  Verifier().Expect(2, true).Verify(cq_.get(), true);
+}
+
+// This class is for testing the server's response cache. The server's service
+// config gives every method of EchoTestService a response cache TTL.
+class AsyncEnd2endResponseCacheTest : public AsyncEnd2endTest {
+ protected:
+  void SetUp() override {
+    server_service_config_ =
+        "{\"methodConfig\": [{\"name\": [{\"service\": "
+        "\"grpc.testing.EchoTestService\"}], \"responseCacheTtl\": \"" +
+        ResponseCacheTtl() + "\"}]}";
+    AsyncEnd2endTest::SetUp();
+    ResetStub();
+  }
+
+  virtual grpc::string ResponseCacheTtl() { return "3600s"; }
+
+  // Sends an Echo request for |message| and expects the handler to get it.
+  // The handler applies |prepare| to its context and replies with the
+  // request's message and |status|.
+  void EchoFromHandler(
+      const grpc::string& message,
+      const std::function<void(ServerContext*)>& prepare = nullptr,
+      const Status& status = Status::OK) {
+    EchoRequest send_request;
+    EchoRequest recv_request;
+    EchoResponse send_response;
+    EchoResponse recv_response;
+    Status recv_status;
+    ClientContext cli_ctx;
+    ServerContext srv_ctx;
+    grpc::ServerAsyncResponseWriter<EchoResponse> response_writer(&srv_ctx);
+
+    send_request.set_message(message);
+    std::unique_ptr<ClientAsyncResponseReader<EchoResponse>> response_reader(
+        stub_->AsyncEcho(&cli_ctx, send_request, cq_.get()));
+    service_->RequestEcho(&srv_ctx, &recv_request, &response_writer,
+                          cq_.get(), cq_.get(), tag(2));
+    response_reader->Finish(&recv_response, &recv_status, tag(4));
+    // A response from the cache would complete tag 4 first, which the
+    // Verifier does not expect.
+    Verifier().Expect(2, true).Verify(cq_.get());
+    EXPECT_EQ(send_request.message(), recv_request.message());
+
+    if (prepare != nullptr) {
+      prepare(&srv_ctx);
+    }
+    send_response.set_message(recv_request.message());
+    response_writer.Finish(send_response, status, tag(3));
+    Verifier().Expect(3, true).Expect(4, true).Verify(cq_.get());
+    EXPECT_EQ(status.error_code(), recv_status.error_code());
+  }
+
+  // Sends an Echo request for |message| without requesting a call on the
+  // server. Returns true if it got the cached response; a request that
+  // misses the cache fails with DEADLINE_EXCEEDED.
+  bool EchoFromCache(const grpc::string& message) {
+    EchoRequest send_request;
+    EchoResponse recv_response;
+    Status recv_status;
+    ClientContext cli_ctx;
+    cli_ctx.set_deadline(grpc_timeout_milliseconds_to_deadline(5000));
+
+    send_request.set_message(message);
+    std::unique_ptr<ClientAsyncResponseReader<EchoResponse>> response_reader(
+        stub_->AsyncEcho(&cli_ctx, send_request, cq_.get()));
+    response_reader->Finish(&recv_response, &recv_status, tag(4));
+    Verifier().Expect(4, true).Verify(cq_.get());
+    return recv_status.ok() && recv_response.message() == message;
+  }
+};
+
+TEST_P(AsyncEnd2endResponseCacheTest, HitSkipsHandler) {
+  EchoFromHandler(GetParam().message_content);
+  EXPECT_TRUE(EchoFromCache(GetParam().message_content));
+  EXPECT_TRUE(EchoFromCache(GetParam().message_content));
+  // Other requests to the same method still go to the handler.
+  EchoFromHandler(GetParam().message_content + " again");
+}
+
+TEST_P(AsyncEnd2endResponseCacheTest, NoInsertWithInitialMetadata) {
+  EchoFromHandler(GetParam().message_content, [](ServerContext* srv_ctx) {
+    srv_ctx->AddInitialMetadata("key", "val");
+  });
+  EchoFromHandler(GetParam().message_content);
+  EXPECT_TRUE(EchoFromCache(GetParam().message_content));
+}
+
+TEST_P(AsyncEnd2endResponseCacheTest, NoInsertWithErrorStatus) {
+  EchoFromHandler(GetParam().message_content, nullptr,
+                  Status(StatusCode::NOT_FOUND, "not found"));
+  EchoFromHandler(GetParam().message_content);
+  EXPECT_TRUE(EchoFromCache(GetParam().message_content));
+}
+
+// ResponseStream is cacheable too, since the server reads its request up
+// front; only a response with a single message is cached.
+TEST_P(AsyncEnd2endResponseCacheTest, NoInsertWithSecondMessage) {
+  for (int num_messages : {2, 1}) {
+    EchoRequest send_request;
+    EchoRequest recv_request;
+    EchoResponse send_response;
+    EchoResponse recv_response;
+    Status recv_status;
+    ClientContext cli_ctx;
+    ServerContext srv_ctx;
+    ServerAsyncWriter<EchoResponse> srv_stream(&srv_ctx);
+
+    send_request.set_message(GetParam().message_content);
+    std::unique_ptr<ClientAsyncReader<EchoResponse>> cli_stream(
+        stub_->AsyncResponseStream(&cli_ctx, send_request, cq_.get(),
+                                   tag(1)));
+    service_->RequestResponseStream(&srv_ctx, &recv_request, &srv_stream,
+                                    cq_.get(), cq_.get(), tag(2));
+    bool got_request = false;
+    Verifier().Expect(1, true).ExpectMaybe(2, true, &got_request).Verify(
+        cq_.get());
+    // A response from the cache would complete tag 4 before tag 2.
+    cli_stream->Read(&recv_response, tag(4));
+    if (!got_request) {
+      Verifier().Expect(2, true).Verify(cq_.get());
+    }
+
+    send_response.set_message(recv_request.message());
+    for (int i = 0; i < num_messages; i++) {
+      srv_stream.Write(send_response, tag(3));
+      Verifier().Expect(3, true).Expect(4, true).Verify(cq_.get());
+      EXPECT_EQ(send_response.message(), recv_response.message());
+      cli_stream->Read(&recv_response, tag(4));
+    }
+    srv_stream.Finish(Status::OK, tag(5));
+    Verifier().Expect(5, true).Expect(4, false).Verify(cq_.get());
+    cli_stream->Finish(&recv_status, tag(6));
+    Verifier().Expect(6, true).Verify(cq_.get());
+    EXPECT_TRUE(recv_status.ok());
+  }
+}
+
+// A response message that the application compressed itself reaches the
+// response cache already compressed, and must not be cached: it would be
+// served later as if it was not. The Echo handler of the duplicate service
+// sends raw ByteBuffers, and the server compresses with gzip by default, so
+// that its initial metadata stays empty above the compression filter,
+// where the cache looks at it.
+class AsyncEnd2endResponseCacheCompressedTest : public AsyncEnd2endTest {
+ protected:
+  typedef grpc::testing::duplicate::EchoTestService::WithRawMethod_Echo<
+      grpc::testing::duplicate::EchoTestService::AsyncService>
+      RawEchoService;
+
+  void SetUp() override {
+    server_service_config_ =
+        "{\"methodConfig\": [{\"name\": [{\"service\": "
+        "\"grpc.testing.duplicate.EchoTestService\"}], "
+        "\"responseCacheTtl\": \"3600s\"}]}";
+    server_default_compression_ = GRPC_COMPRESS_GZIP;
+    extra_service_ = &raw_service_;
+    AsyncEnd2endTest::SetUp();
+    dup_stub_ =
+        grpc::testing::duplicate::EchoTestService::NewStub(CreateTestChannel());
+  }
+
+  // A message that gzip makes smaller.
+  grpc::string Message() {
+    return GetParam().message_content + grpc::string(1024, 'x');
+  }
+
+  // Serializes an EchoResponse for |message| into |buffer|, compressed with
+  // gzip if |precompressed|.
+  static void SerializeResponse(const grpc::string& message, bool precompressed,
+                                ByteBuffer* buffer) {
+    EchoResponse response;
+    response.set_message(message);
+    grpc::string serialized = response.SerializeAsString();
+    if (!precompressed) {
+      Slice slice(serialized);
+      *buffer = ByteBuffer(&slice, 1);
+      return;
+    }
+    grpc_core::ExecCtx exec_ctx;
+    grpc_slice_buffer input;
+    grpc_slice_buffer output;
+    grpc_slice_buffer_init(&input);
+    grpc_slice_buffer_init(&output);
+    grpc_slice_buffer_add(&input, grpc_slice_from_copied_buffer(
+                                      serialized.data(), serialized.size()));
+    GPR_ASSERT(grpc_msg_compress(GRPC_MESSAGE_COMPRESS_GZIP, &input, &output));
+    grpc::internal::GrpcByteBufferPeer(buffer).set_buffer(
+        grpc_raw_compressed_byte_buffer_create(output.slices, output.count,
+                                               GRPC_COMPRESS_GZIP));
+    grpc_slice_buffer_destroy(&input);
+    grpc_slice_buffer_destroy(&output);
+  }
+
+  // Sends an Echo request for |message| and expects the handler to get it.
+  // The handler replies with |message|, compressed by itself if
+  // |precompressed|.
+  void EchoFromHandler(const grpc::string& message, bool precompressed) {
+    EchoRequest send_request;
+    ByteBuffer recv_request;
+    ByteBuffer send_response;
+    EchoResponse recv_response;
+    Status recv_status;
+    ClientContext cli_ctx;
+    ServerContext srv_ctx;
+    grpc::ServerAsyncResponseWriter<ByteBuffer> response_writer(&srv_ctx);
+
+    send_request.set_message(message);
+    std::unique_ptr<ClientAsyncResponseReader<EchoResponse>> response_reader(
+        dup_stub_->AsyncEcho(&cli_ctx, send_request, cq_.get()));
+    raw_service_.RequestEcho(&srv_ctx, &recv_request, &response_writer,
+                             cq_.get(), cq_.get(), tag(2));
+    response_reader->Finish(&recv_response, &recv_status, tag(4));
+    // A response from the cache would complete tag 4 first, which the
+    // Verifier does not expect.
+    Verifier().Expect(2, true).Verify(cq_.get());
+
+    SerializeResponse(message, precompressed, &send_response);
+    response_writer.Finish(send_response, Status::OK, tag(3));
+    Verifier().Expect(3, true).Expect(4, true).Verify(cq_.get());
+    EXPECT_TRUE(recv_status.ok()) << recv_status.error_message();
+    EXPECT_EQ(message, recv_response.message());
+  }
+
+  // Sends an Echo request for |message| without requesting a call on the
+  // server. Returns true if it got the cached response.
+  bool EchoFromCache(const grpc::string& message) {
+    EchoRequest send_request;
+    EchoResponse recv_response;
+    Status recv_status;
+    ClientContext cli_ctx;
+    cli_ctx.set_deadline(grpc_timeout_milliseconds_to_deadline(5000));
+
+    send_request.set_message(message);
+    std::unique_ptr<ClientAsyncResponseReader<EchoResponse>> response_reader(
+        dup_stub_->AsyncEcho(&cli_ctx, send_request, cq_.get()));
+    response_reader->Finish(&recv_response, &recv_status, tag(4));
+    Verifier().Expect(4, true).Verify(cq_.get());
+    return recv_status.ok() && recv_response.message() == message;
+  }
+
+  RawEchoService raw_service_;
+  std::unique_ptr<grpc::testing::duplicate::EchoTestService::Stub> dup_stub_;
+};
+
+TEST_P(AsyncEnd2endResponseCacheCompressedTest,
+       NoInsertWithCompressedMessage) {
+  EchoFromHandler(Message(), true);
+  EchoFromHandler(Message(), false);
+  EXPECT_TRUE(EchoFromCache(Message()));
+}
+
+// As AsyncEnd2endResponseCacheTest, with a TTL short enough for entries to
+// expire during the test.
+class AsyncEnd2endResponseCacheExpiryTest
+    : public AsyncEnd2endResponseCacheTest {
+ protected:
+  grpc::string ResponseCacheTtl() override {
+    return grpc::to_string(grpc_test_slowdown_factor()) + "s";
+  }
+};
+
+TEST_P(AsyncEnd2endResponseCacheExpiryTest, EntryExpires) {
+  EchoFromHandler(GetParam().message_content);
+  EXPECT_TRUE(EchoFromCache(GetParam().message_content));
+  // grpc_timeout_milliseconds_to_deadline() scales by the slowdown factor,
+  // like the TTL.
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(1500));
+  EchoFromHandler(GetParam().message_content);
+}
+
 // This class is for testing scenarios where RPCs are cancelled on the server
 // by calling ServerContext::TryCancel(). Server uses AsyncNotifyWhenDone
 // API to check for cancellation
@@ -1875,6 +2433,15 @@ INSTANTIATE_TEST_CASE_P(AsyncEnd2end, AsyncEnd2endTest,
 INSTANTIATE_TEST_CASE_P(AsyncEnd2endServerTryCancel,
                         AsyncEnd2endServerTryCancelTest,
                         ::testing::ValuesIn(CreateTestScenarios(false, false)));
+INSTANTIATE_TEST_CASE_P(AsyncEnd2endResponseCache,
+                        AsyncEnd2endResponseCacheTest,
+                        ::testing::ValuesIn(CreateTestScenarios(true, false)));
+INSTANTIATE_TEST_CASE_P(AsyncEnd2endResponseCacheCompressed,
+                        AsyncEnd2endResponseCacheCompressedTest,
+                        ::testing::ValuesIn(CreateTestScenarios(true, false)));
+INSTANTIATE_TEST_CASE_P(AsyncEnd2endResponseCacheExpiry,
+                        AsyncEnd2endResponseCacheExpiryTest,
+                        ::testing::ValuesIn(CreateTestScenarios(false, false)));
 
 }  // namespace
 }  // namespace testing
@@ -1205,6 +1205,54 @@ TEST_P(End2endTest, ChannelState) {
   EXPECT_TRUE(state == GRPC_CHANNEL_CONNECTING || state == GRPC_CHANNEL_READY);
 }
 
+TEST_P(End2endTest, ChannelGroupState) {
+  if ((GetParam().credentials_type != kInsecureCredentialsType) ||
+      GetParam().inproc) {
+    return;
+  }
+  int port = grpc_pick_unused_port_or_die();
+  std::ostringstream server_address;
+  server_address << "127.0.0.1:" << port;
+  const int kNumChannels = 3;
+  std::vector<std::shared_ptr<Channel>> channels;
+  std::vector<Channel*> raw_channels;
+  grpc_connectivity_state states[kNumChannels];
+  for (int i = 0; i < kNumChannels; i++) {
+    channels.push_back(
+        CreateChannel(server_address.str(), InsecureChannelCredentials()));
+    raw_channels.push_back(channels.back().get());
+    // Start IDLE
+    states[i] = channels.back()->GetState(false);
+    EXPECT_EQ(GRPC_CHANNEL_IDLE, states[i]);
+  }
+
+  // Did not ask to connect, no state change.
+  CompletionQueue cq;
+  std::chrono::system_clock::time_point deadline =
+      std::chrono::system_clock::now() + std::chrono::milliseconds(10);
+  experimental::NotifyOnChannelsStateChange(raw_channels, states, deadline,
+                                            &cq, nullptr);
+  void* tag;
+  bool ok = true;
+  cq.Next(&tag, &ok);
+  EXPECT_FALSE(ok);
+  for (int i = 0; i < kNumChannels; i++) {
+    EXPECT_EQ(GRPC_CHANNEL_IDLE, states[i]);
+  }
+
+  // Every channel leaves IDLE once asked to connect.
+  for (int i = 0; i < kNumChannels; i++) {
+    EXPECT_EQ(GRPC_CHANNEL_IDLE, channels[i]->GetState(true));
+  }
+  experimental::NotifyOnChannelsStateChange(
+      raw_channels, states, gpr_inf_future(GPR_CLOCK_REALTIME), &cq, nullptr);
+  cq.Next(&tag, &ok);
+  EXPECT_TRUE(ok);
+  for (int i = 0; i < kNumChannels; i++) {
+    EXPECT_NE(GRPC_CHANNEL_IDLE, states[i]);
+  }
+}
+
 // Takes 10s.
 TEST_P(End2endTest, ChannelStateTimeout) {
   if ((GetParam().credentials_type != kInsecureCredentialsType) ||
@@ -413,9 +413,13 @@ class GrpclbEnd2endTest : public ::testing::Test {
   }
 
   void ResetStub(int fallback_timeout = 0,
-                 const grpc::string& expected_targets = "") {
+                 const grpc::string& expected_targets = "",
+                 int prewarm_ready_percent = 0) {
     ChannelArguments args;
     args.SetGrpclbFallbackTimeout(fallback_timeout);
+    if (prewarm_ready_percent > 0) {
+      args.SetInt(GRPC_ARG_GRPCLB_PREWARM_READY_PERCENT, prewarm_ready_percent);
+    }
     args.SetPointer(GRPC_ARG_FAKE_RESOLVER_RESPONSE_GENERATOR,
                     response_generator_.get());
     if (!expected_targets.empty()) {
@@ -1282,6 +1286,49 @@ TEST_F(UpdatesTest, ReresolveDeadBackend) {
   EXPECT_EQ(0U, balancer_servers_[2].service_->response_count());
 }
 
+TEST_F(UpdatesTest, PrewarmBackendsOfNewServerlist) {
+  ResetStub(0, "", 100 /* prewarm_ready_percent */);
+  SetNextResolutionAllBalancers();
+  const int kServerlistDelayMs = 500 * grpc_test_slowdown_factor();
+  const std::vector<int> first_backend{GetBackendPorts()[0]};
+  // The second serverlist replaces backend 0 with the other backends and
+  // one that is not listening.
+  std::vector<int> second_backends = GetBackendPorts(1);
+  second_backends.push_back(grpc_pick_unused_port_or_die());
+  ScheduleResponseForBalancer(
+      0, BalancerServiceImpl::BuildResponseForBackends(first_backend, {}), 0);
+  ScheduleResponseForBalancer(
+      0, BalancerServiceImpl::BuildResponseForBackends(second_backends, {}),
+      kServerlistDelayMs);
+
+  // Wait until the first backend is ready.
+  WaitForBackend(0);
+
+  // RPCs keep going to backend 0 while the new backends connect, so none of
+  // them fails while the serverlist changes.
+  gpr_log(GPR_INFO, "========= WAITING FOR SECOND SERVERLIST ==========");
+  do {
+    ResetBackendCounters();
+    CheckRpcSendOk();
+  } while (backend_servers_[0].service_->request_count() == 1);
+  gpr_log(GPR_INFO, "========= SWITCHED TO SECOND SERVERLIST ==========");
+
+  // Picks only moved over once all the reachable new backends were READY,
+  // so the next RPCs are spread over all of them right away.
+  ResetBackendCounters();
+  CheckRpcSendOk(3);
+  EXPECT_EQ(0U, backend_servers_[0].service_->request_count());
+  for (size_t i = 1; i < backends_.size(); ++i) {
+    EXPECT_EQ(1U, backend_servers_[i].service_->request_count());
+  }
+
+  balancers_[0]->NotifyDoneWithServerlists();
+  // The balancer got a single request.
+  EXPECT_EQ(1U, balancer_servers_[0].service_->request_count());
+  // and sent two responses.
+  EXPECT_EQ(2U, balancer_servers_[0].service_->response_count());
+}
+
 // TODO(juanlishen): Should be removed when the first response is always the
 // initial response. Currently, if client load reporting is not enabled, the
 // balancer doesn't send initial response. When the backend shuts down, an
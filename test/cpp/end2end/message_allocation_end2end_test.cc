@@ -0,0 +1,383 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <functional>
+#include <memory>
+#include <thread>
+
+#include <google/protobuf/struct.pb.h>
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/completion_queue.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/impl/codegen/async_unary_call.h>
+#include <grpcpp/impl/codegen/client_unary_call.h>
+#include <grpcpp/impl/codegen/method_handler_impl.h>
+#include <grpcpp/impl/codegen/proto_message_arena.h>
+#include <grpcpp/impl/codegen/proto_utils.h>
+#include <grpcpp/impl/codegen/rpc_method.h>
+#include <grpcpp/impl/codegen/server_callback.h>
+#include <grpcpp/impl/codegen/service_type.h>
+#include <grpcpp/impl/codegen/sync_stream.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/server_context.h>
+
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+
+#include <gtest/gtest.h>
+
+namespace grpc {
+namespace testing {
+namespace {
+
+using google::protobuf::Struct;
+
+// google.protobuf.Struct is arena enabled and nests a message in each field,
+// so it shows whether parsing placed the nested messages on the arena too.
+
+void FillMessage(const grpc::string& value, Struct* message) {
+  (*message->mutable_fields())["value"].set_string_value(value);
+  auto* nested =
+      (*message->mutable_fields())["nested"].mutable_struct_value();
+  (*nested->mutable_fields())["value"].set_string_value(value);
+}
+
+grpc::string NestedValue(const Struct& message) {
+  auto nested = message.fields().find("nested");
+  if (nested == message.fields().end()) return "";
+  const auto& fields = nested->second.struct_value().fields();
+  auto value = fields.find("value");
+  return value == fields.end() ? "" : value->second.string_value();
+}
+
+// Checks that a request received by the server, nested messages included,
+// was parsed onto a protobuf arena.
+void ExpectOnArena(const Struct& request) {
+  EXPECT_NE(nullptr, request.GetArena());
+  auto nested = request.fields().find("nested");
+  ASSERT_NE(request.fields().end(), nested);
+  EXPECT_EQ(request.GetArena(), nested->second.struct_value().GetArena());
+}
+
+enum MethodIndex {
+  kSyncUnary,
+  kSyncClientStreaming,
+  kSyncServerStreaming,
+  kCallbackUnary,
+  kCallbackClientStreaming,
+  kCallbackServerStreaming,
+  kAsyncUnary,
+};
+
+const char* const kMethodNames[] = {
+    "/grpc.testing.MessageAllocation/SyncUnary",
+    "/grpc.testing.MessageAllocation/SyncClientStreaming",
+    "/grpc.testing.MessageAllocation/SyncServerStreaming",
+    "/grpc.testing.MessageAllocation/CallbackUnary",
+    "/grpc.testing.MessageAllocation/CallbackClientStreaming",
+    "/grpc.testing.MessageAllocation/CallbackServerStreaming",
+    "/grpc.testing.MessageAllocation/AsyncUnary",
+};
+
+// Registers its handlers as the C++ plugin does for a service compiled with
+// use_message_arena=true. Every method echoes the last request it receives.
+class MessageAllocationService : public Service {
+ public:
+  MessageAllocationService() {
+    using ::grpc::internal::ProtoArenaMessageAllocation;
+    using ::grpc::internal::RpcMethod;
+    using ::grpc::internal::RpcServiceMethod;
+    AddMethod(new RpcServiceMethod(
+        kMethodNames[kSyncUnary], RpcMethod::NORMAL_RPC,
+        new ::grpc::internal::RpcMethodHandler<
+            MessageAllocationService, Struct, Struct,
+            ProtoArenaMessageAllocation>(
+            std::mem_fn(&MessageAllocationService::SyncUnary), this)));
+    AddMethod(new RpcServiceMethod(
+        kMethodNames[kSyncClientStreaming], RpcMethod::CLIENT_STREAMING,
+        new ::grpc::internal::ClientStreamingHandler<
+            MessageAllocationService, Struct, Struct,
+            ProtoArenaMessageAllocation>(
+            std::mem_fn(&MessageAllocationService::SyncClientStreaming),
+            this)));
+    AddMethod(new RpcServiceMethod(
+        kMethodNames[kSyncServerStreaming], RpcMethod::SERVER_STREAMING,
+        new ::grpc::internal::ServerStreamingHandler<
+            MessageAllocationService, Struct, Struct,
+            ProtoArenaMessageAllocation>(
+            std::mem_fn(&MessageAllocationService::SyncServerStreaming),
+            this)));
+    AddMethod(new RpcServiceMethod(kMethodNames[kCallbackUnary],
+                                   RpcMethod::NORMAL_RPC, nullptr));
+    experimental().MarkMethodCallback(
+        kCallbackUnary,
+        new ::grpc::internal::CallbackUnaryHandler<
+            Struct, Struct, ProtoArenaMessageAllocation>(
+            [this](ServerContext* context, const Struct* request,
+                   Struct* response,
+                   experimental::ServerCallbackRpcController* controller) {
+              controller->Finish(SyncUnary(context, request, response));
+            }));
+    AddMethod(new RpcServiceMethod(kMethodNames[kCallbackClientStreaming],
+                                   RpcMethod::CLIENT_STREAMING, nullptr));
+    experimental().MarkMethodCallback(
+        kCallbackClientStreaming,
+        new ::grpc::internal::CallbackClientStreamingHandler<
+            Struct, Struct, ProtoArenaMessageAllocation>(
+            [] { return new EchoLastReadReactor; }));
+    AddMethod(new RpcServiceMethod(kMethodNames[kCallbackServerStreaming],
+                                   RpcMethod::SERVER_STREAMING, nullptr));
+    experimental().MarkMethodCallback(
+        kCallbackServerStreaming,
+        new ::grpc::internal::CallbackServerStreamingHandler<
+            Struct, Struct, ProtoArenaMessageAllocation>(
+            [] { return new EchoWriteReactor; }));
+    AddMethod(new RpcServiceMethod(kMethodNames[kAsyncUnary],
+                                   RpcMethod::NORMAL_RPC, nullptr));
+    MarkMethodAsync(kAsyncUnary);
+  }
+
+  void RequestAsyncUnary(ServerContext* context, Struct* request,
+                         ServerAsyncResponseWriter<Struct>* response,
+                         ServerCompletionQueue* cq, void* tag) {
+    Service::RequestAsyncUnary(kAsyncUnary, context, request, response, cq,
+                               cq, tag);
+  }
+
+ private:
+  Status SyncUnary(ServerContext* context, const Struct* request,
+                   Struct* response) {
+    ExpectOnArena(*request);
+    EXPECT_EQ(request->GetArena(), response->GetArena());
+    *response = *request;
+    return Status::OK;
+  }
+
+  Status SyncClientStreaming(ServerContext* context,
+                             ServerReader<Struct>* reader, Struct* response) {
+    EXPECT_NE(nullptr, response->GetArena());
+    Struct request;
+    while (reader->Read(&request)) {
+      *response = request;
+    }
+    return Status::OK;
+  }
+
+  Status SyncServerStreaming(ServerContext* context, const Struct* request,
+                             ServerWriter<Struct>* writer) {
+    ExpectOnArena(*request);
+    writer->Write(*request);
+    return Status::OK;
+  }
+
+  class EchoLastReadReactor
+      : public experimental::ServerReadReactor<Struct, Struct> {
+   public:
+    void OnStarted(ServerContext* context, Struct* response) override {
+      EXPECT_NE(nullptr, response->GetArena());
+      response_ = response;
+      StartRead(&request_);
+    }
+    void OnReadDone(bool ok) override {
+      if (!ok) {
+        Finish(Status::OK);
+        return;
+      }
+      *response_ = request_;
+      StartRead(&request_);
+    }
+    void OnDone() override { delete this; }
+
+   private:
+    Struct request_;
+    Struct* response_;
+  };
+
+  class EchoWriteReactor
+      : public experimental::ServerWriteReactor<Struct, Struct> {
+   public:
+    void OnStarted(ServerContext* context, const Struct* request) override {
+      ExpectOnArena(*request);
+      StartWriteAndFinish(request, WriteOptions(), Status::OK);
+    }
+    void OnDone() override { delete this; }
+  };
+};
+
+class MessageAllocationEnd2endTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    int port = grpc_pick_unused_port_or_die();
+    server_address_ << "localhost:" << port;
+    ServerBuilder builder;
+    builder.AddListeningPort(server_address_.str(),
+                             InsecureServerCredentials());
+    builder.RegisterService(&service_);
+    cq_ = builder.AddCompletionQueue();
+    server_ = builder.BuildAndStart();
+    channel_ =
+        CreateChannel(server_address_.str(), InsecureChannelCredentials());
+  }
+
+  void TearDown() override {
+    server_->Shutdown();
+    cq_->Shutdown();
+    void* ignored_tag;
+    bool ignored_ok;
+    while (cq_->Next(&ignored_tag, &ignored_ok)) {
+    }
+  }
+
+  Status Unary(MethodIndex method, const Struct& request, Struct* response) {
+    ClientContext context;
+    return ::grpc::internal::BlockingUnaryCall(
+        channel_.get(),
+        ::grpc::internal::RpcMethod(kMethodNames[method],
+                                    ::grpc::internal::RpcMethod::NORMAL_RPC),
+        &context, request, response);
+  }
+
+  void SendUnary(MethodIndex method) {
+    Struct request;
+    Struct response;
+    FillMessage(kMethodNames[method], &request);
+    Status s = Unary(method, request, &response);
+    EXPECT_TRUE(s.ok()) << s.error_message();
+    EXPECT_EQ(kMethodNames[method], NestedValue(response));
+  }
+
+  void SendClientStreaming(MethodIndex method) {
+    ClientContext context;
+    Struct response;
+    std::unique_ptr<ClientWriter<Struct>> writer(
+        ::grpc::internal::ClientWriterFactory<Struct>::Create(
+            channel_.get(),
+            ::grpc::internal::RpcMethod(
+                kMethodNames[method],
+                ::grpc::internal::RpcMethod::CLIENT_STREAMING),
+            &context, &response));
+    for (int i = 0; i < 3; i++) {
+      Struct request;
+      FillMessage(kMethodNames[method] + std::to_string(i), &request);
+      EXPECT_TRUE(writer->Write(request));
+    }
+    EXPECT_TRUE(writer->WritesDone());
+    Status s = writer->Finish();
+    EXPECT_TRUE(s.ok()) << s.error_message();
+    EXPECT_EQ(kMethodNames[method] + grpc::string("2"),
+              NestedValue(response));
+  }
+
+  void SendServerStreaming(MethodIndex method) {
+    ClientContext context;
+    Struct request;
+    FillMessage(kMethodNames[method], &request);
+    std::unique_ptr<ClientReader<Struct>> reader(
+        ::grpc::internal::ClientReaderFactory<Struct>::Create(
+            channel_.get(),
+            ::grpc::internal::RpcMethod(
+                kMethodNames[method],
+                ::grpc::internal::RpcMethod::SERVER_STREAMING),
+            &context, request));
+    Struct response;
+    EXPECT_TRUE(reader->Read(&response));
+    EXPECT_EQ(kMethodNames[method], NestedValue(response));
+    EXPECT_FALSE(reader->Read(&response));
+    Status s = reader->Finish();
+    EXPECT_TRUE(s.ok()) << s.error_message();
+  }
+
+  std::ostringstream server_address_;
+  MessageAllocationService service_;
+  std::unique_ptr<ServerCompletionQueue> cq_;
+  std::unique_ptr<Server> server_;
+  std::shared_ptr<Channel> channel_;
+};
+
+TEST_F(MessageAllocationEnd2endTest, SyncUnary) { SendUnary(kSyncUnary); }
+
+TEST_F(MessageAllocationEnd2endTest, SyncClientStreaming) {
+  SendClientStreaming(kSyncClientStreaming);
+}
+
+TEST_F(MessageAllocationEnd2endTest, SyncServerStreaming) {
+  SendServerStreaming(kSyncServerStreaming);
+}
+
+TEST_F(MessageAllocationEnd2endTest, CallbackUnary) {
+  SendUnary(kCallbackUnary);
+}
+
+TEST_F(MessageAllocationEnd2endTest, CallbackClientStreaming) {
+  SendClientStreaming(kCallbackClientStreaming);
+}
+
+TEST_F(MessageAllocationEnd2endTest, CallbackServerStreaming) {
+  SendServerStreaming(kCallbackServerStreaming);
+}
+
+// Async services own their messages: a request created on the service's own
+// arena is parsed onto that arena, and a response on it is sent as usual.
+TEST_F(MessageAllocationEnd2endTest, AsyncUnary) {
+  protobuf::Arena arena;
+  Struct* request = protobuf::Arena::CreateMessage<Struct>(&arena);
+  Struct* response = protobuf::Arena::CreateMessage<Struct>(&arena);
+  ServerContext server_context;
+  ServerAsyncResponseWriter<Struct> responder(&server_context);
+  service_.RequestAsyncUnary(&server_context, request, &responder, cq_.get(),
+                             reinterpret_cast<void*>(1));
+
+  Struct client_request;
+  Struct client_response;
+  FillMessage(kMethodNames[kAsyncUnary], &client_request);
+  Status client_status;
+  std::thread client([&] {
+    client_status = Unary(kAsyncUnary, client_request, &client_response);
+  });
+
+  void* tag;
+  bool ok;
+  ASSERT_TRUE(cq_->Next(&tag, &ok));
+  EXPECT_EQ(reinterpret_cast<void*>(1), tag);
+  EXPECT_TRUE(ok);
+  EXPECT_EQ(&arena, request->GetArena());
+  ExpectOnArena(*request);
+  *response = *request;
+  responder.Finish(*response, Status::OK, reinterpret_cast<void*>(2));
+  ASSERT_TRUE(cq_->Next(&tag, &ok));
+  EXPECT_EQ(reinterpret_cast<void*>(2), tag);
+  EXPECT_TRUE(ok);
+  client.join();
+
+  EXPECT_TRUE(client_status.ok()) << client_status.error_message();
+  EXPECT_EQ(kMethodNames[kAsyncUnary], NestedValue(client_response));
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
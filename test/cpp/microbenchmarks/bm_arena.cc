@@ -19,10 +19,16 @@
 /* Benchmark arenas */
 
 #include <benchmark/benchmark.h>
+#include <google/protobuf/struct.pb.h>
+#include <grpcpp/impl/codegen/proto_message_arena.h>
+#include <grpcpp/impl/codegen/proto_utils.h>
+#include <grpcpp/support/byte_buffer.h>
 #include "src/core/lib/gpr/arena.h"
 #include "test/cpp/microbenchmarks/helpers.h"
 #include "test/cpp/util/test_config.h"
 
+auto& force_library_initialization = Library::get();
+
 static void BM_Arena_NoOp(benchmark::State& state) {
   while (state.KeepRunning()) {
     gpr_arena_destroy(gpr_arena_create(state.range(0)));
@@ -57,6 +63,76 @@ static void BM_Arena_Batch(benchmark::State& state) {
 }
 BENCHMARK(BM_Arena_Batch)->Ranges({{1, 64 * 1024}, {1, 64}, {1, 1024}});
 
+// Message allocation of a generated unary handler. The request payload is a
+// Struct with range(1) fields per level, nested range(0) levels deep; the
+// gpr_arena stands in for the call arena.
+
+static void FillNestedStruct(google::protobuf::Struct* s, int depth,
+                             int fanout) {
+  for (int i = 0; i < fanout; i++) {
+    auto& value = (*s->mutable_fields())["field" + std::to_string(i)];
+    if (depth > 0) {
+      FillNestedStruct(value.mutable_struct_value(), depth - 1, fanout);
+    } else {
+      value.set_string_value("value" + std::to_string(i));
+    }
+  }
+}
+
+static grpc::ByteBuffer NestedPayload(int depth, int fanout) {
+  google::protobuf::Struct request;
+  FillNestedStruct(&request, depth, fanout);
+  grpc::ByteBuffer payload;
+  bool own_buffer;
+  GPR_ASSERT(grpc::SerializationTraits<google::protobuf::Struct>::Serialize(
+                 request, &payload, &own_buffer)
+                 .ok());
+  return payload;
+}
+
+static void BM_Arena_ProtoHeapMessages(benchmark::State& state) {
+  grpc::ByteBuffer payload = NestedPayload(state.range(0), state.range(1));
+  while (state.KeepRunning()) {
+    gpr_arena* a = gpr_arena_create(1024);
+    auto* request = new (gpr_arena_alloc(a, sizeof(google::protobuf::Struct)))
+        google::protobuf::Struct();
+    grpc::ByteBuffer buf(payload);
+    GPR_ASSERT(grpc::SerializationTraits<google::protobuf::Struct>::Deserialize(
+                   &buf, request)
+                   .ok());
+    auto* response = new (gpr_arena_alloc(a, sizeof(google::protobuf::Struct)))
+        google::protobuf::Struct(*request);
+    request->~Struct();
+    response->~Struct();
+    gpr_arena_destroy(a);
+  }
+}
+BENCHMARK(BM_Arena_ProtoHeapMessages)->Ranges({{1, 4}, {1, 16}});
+
+static void BM_Arena_ProtoArenaMessages(benchmark::State& state) {
+  grpc::ByteBuffer payload = NestedPayload(state.range(0), state.range(1));
+  while (state.KeepRunning()) {
+    gpr_arena* a = gpr_arena_create(1024);
+    void* storage = gpr_arena_alloc(a, sizeof(grpc::protobuf::Arena));
+    void* block =
+        gpr_arena_alloc(a, grpc::internal::kMessageArenaInitialBlockSize);
+    grpc::protobuf::Arena* arena = grpc::internal::NewMessageArena(
+        storage, block, grpc::internal::kMessageArenaInitialBlockSize);
+    auto* request =
+        grpc::protobuf::Arena::CreateMessage<google::protobuf::Struct>(arena);
+    grpc::ByteBuffer buf(payload);
+    GPR_ASSERT(grpc::SerializationTraits<google::protobuf::Struct>::Deserialize(
+                   &buf, request)
+                   .ok());
+    auto* response =
+        grpc::protobuf::Arena::CreateMessage<google::protobuf::Struct>(arena);
+    *response = *request;
+    grpc::internal::DestroyMessageArena(arena);
+    gpr_arena_destroy(a);
+  }
+}
+BENCHMARK(BM_Arena_ProtoArenaMessages)->Ranges({{1, 4}, {1, 16}});
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
@@ -16,13 +16,21 @@
  *
  */
 
-/* This benchmark exists to show that byte-buffer copy is size-independent */
+/* This benchmark exists to show that byte-buffer copy is size-independent,
+   and to measure reading large byte buffers */
 
+#include <sys/resource.h>
 #include <memory>
+#include <sstream>
 
 #include <benchmark/benchmark.h>
+#include <grpc/byte_buffer.h>
+#include <grpc/byte_buffer_reader.h>
+#include <grpcpp/impl/codegen/proto_buffer_reader.h>
 #include <grpcpp/impl/grpc_library.h>
 #include <grpcpp/support/byte_buffer.h>
+#include "src/core/lib/compression/message_compress.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 #include "test/cpp/microbenchmarks/helpers.h"
 #include "test/cpp/util/test_config.h"
 
@@ -48,6 +56,150 @@ static void BM_ByteBuffer_Copy(benchmark::State& state) {
 }
 BENCHMARK(BM_ByteBuffer_Copy)->Ranges({{1, 64}, {1, 1024 * 1024}});
 
+// The size of a large response.
+constexpr size_t kLargeBufferSize = 64 * 1024 * 1024;
+
+// Returns a raw byte buffer of kLargeBufferSize bytes split in slices of
+// \a slice_size bytes.
+static grpc_byte_buffer* MakeLargeByteBuffer(size_t slice_size) {
+  std::vector<grpc_slice> slices;
+  for (size_t size = 0; size < kLargeBufferSize; size += slice_size) {
+    grpc_slice slice = grpc_slice_malloc(slice_size);
+    memset(GRPC_SLICE_START_PTR(slice), 'a', slice_size);
+    slices.push_back(slice);
+  }
+  grpc_byte_buffer* buffer =
+      grpc_raw_byte_buffer_create(slices.data(), slices.size());
+  for (grpc_slice& slice : slices) {
+    grpc_slice_unref(slice);
+  }
+  return buffer;
+}
+
+// Adds the peak resident set size of the process so far to the label.
+static void AddPeakRss(TrackCounters* track_counters) {
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return;
+  std::ostringstream label;
+  label << "peak_rss_kb:" << usage.ru_maxrss;
+  track_counters->AddLabel(label.str());
+}
+
+static void BM_ByteBufferReader_Next(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_byte_buffer* buffer = MakeLargeByteBuffer(state.range(0));
+  while (state.KeepRunning()) {
+    grpc_byte_buffer_reader reader;
+    GPR_ASSERT(grpc_byte_buffer_reader_init(&reader, buffer));
+    grpc_slice slice;
+    while (grpc_byte_buffer_reader_next(&reader, &slice)) {
+      benchmark::DoNotOptimize(GRPC_SLICE_START_PTR(slice)[0]);
+      grpc_slice_unref(slice);
+    }
+    grpc_byte_buffer_reader_destroy(&reader);
+  }
+  grpc_byte_buffer_destroy(buffer);
+  state.SetBytesProcessed(state.iterations() * kLargeBufferSize);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ByteBufferReader_Next)->Range(1024, 1024 * 1024);
+
+static void BM_ByteBufferReader_Peek(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_byte_buffer* buffer = MakeLargeByteBuffer(state.range(0));
+  while (state.KeepRunning()) {
+    grpc_byte_buffer_reader reader;
+    GPR_ASSERT(grpc_byte_buffer_reader_init(&reader, buffer));
+    grpc_slice* slice;
+    while (grpc_byte_buffer_reader_peek(&reader, &slice)) {
+      benchmark::DoNotOptimize(GRPC_SLICE_START_PTR(*slice)[0]);
+    }
+    grpc_byte_buffer_reader_destroy(&reader);
+  }
+  grpc_byte_buffer_destroy(buffer);
+  state.SetBytesProcessed(state.iterations() * kLargeBufferSize);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ByteBufferReader_Peek)->Range(1024, 1024 * 1024);
+
+static void BM_ByteBufferReader_ReadAll(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_byte_buffer* buffer = MakeLargeByteBuffer(state.range(0));
+  while (state.KeepRunning()) {
+    grpc_byte_buffer_reader reader;
+    GPR_ASSERT(grpc_byte_buffer_reader_init(&reader, buffer));
+    grpc_slice slice = grpc_byte_buffer_reader_readall(&reader);
+    benchmark::DoNotOptimize(GRPC_SLICE_START_PTR(slice)[0]);
+    grpc_slice_unref(slice);
+    grpc_byte_buffer_reader_destroy(&reader);
+  }
+  grpc_byte_buffer_destroy(buffer);
+  state.SetBytesProcessed(state.iterations() * kLargeBufferSize);
+  AddPeakRss(&track_counters);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ByteBufferReader_ReadAll)
+    ->Arg(1024)
+    ->Arg(1024 * 1024)
+    ->Arg(kLargeBufferSize);
+
+// Walks a large message the way protobuf parsing does.
+static void BM_ProtoBufferReader(benchmark::State& state) {
+  TrackCounters track_counters;
+  const size_t slice_size = state.range(0);
+  std::vector<grpc::Slice> slices;
+  for (size_t size = 0; size < kLargeBufferSize; size += slice_size) {
+    std::unique_ptr<char[]> buf(new char[slice_size]);
+    memset(buf.get(), 'a', slice_size);
+    slices.emplace_back(buf.get(), slice_size);
+  }
+  grpc::ByteBuffer buffer(slices.data(), slices.size());
+  while (state.KeepRunning()) {
+    ProtoBufferReader reader(&buffer);
+    const void* data;
+    int size;
+    while (reader.Next(&data, &size)) {
+      benchmark::DoNotOptimize(static_cast<const char*>(data)[0]);
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * kLargeBufferSize);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ProtoBufferReader)->Range(1024, 1024 * 1024);
+
+// Reads a large gzip compressed message, which the reader decompresses.
+static void BM_ByteBufferReader_Decompress(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_byte_buffer* buffer;
+  {
+    grpc_core::ExecCtx exec_ctx;
+    grpc_byte_buffer* uncompressed = MakeLargeByteBuffer(1024 * 1024);
+    grpc_slice_buffer compressed;
+    grpc_slice_buffer_init(&compressed);
+    GPR_ASSERT(grpc_msg_compress(GRPC_MESSAGE_COMPRESS_GZIP,
+                                 &uncompressed->data.raw.slice_buffer,
+                                 &compressed));
+    buffer = grpc_raw_compressed_byte_buffer_create(
+        compressed.slices, compressed.count, GRPC_COMPRESS_GZIP);
+    grpc_slice_buffer_destroy(&compressed);
+    grpc_byte_buffer_destroy(uncompressed);
+  }
+  while (state.KeepRunning()) {
+    grpc_byte_buffer_reader reader;
+    GPR_ASSERT(grpc_byte_buffer_reader_init(&reader, buffer));
+    grpc_slice* slice;
+    while (grpc_byte_buffer_reader_peek(&reader, &slice)) {
+      benchmark::DoNotOptimize(GRPC_SLICE_START_PTR(*slice)[0]);
+    }
+    grpc_byte_buffer_reader_destroy(&reader);
+  }
+  grpc_byte_buffer_destroy(buffer);
+  state.SetBytesProcessed(state.iterations() * kLargeBufferSize);
+  AddPeakRss(&track_counters);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ByteBufferReader_Decompress);
+
 }  // namespace testing
 }  // namespace grpc
 
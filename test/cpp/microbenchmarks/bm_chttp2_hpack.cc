@@ -25,6 +25,8 @@
 #include <memory>
 #include <sstream>
 
+#include "src/core/ext/transport/chttp2/transport/bin_decoder.h"
+#include "src/core/ext/transport/chttp2/transport/bin_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_parser.h"
 #include "src/core/ext/transport/chttp2/transport/incoming_metadata.h"
@@ -36,6 +38,19 @@
 #include "test/cpp/microbenchmarks/helpers.h"
 #include "test/cpp/util/test_config.h"
 
+// Keys must be registered before the library is initialized below. The same
+// keys with a "y-" prefix are left unregistered, for comparison.
+static bool RegisterApplicationMetadata() {
+  GPR_ASSERT(grpc_register_well_known_metadata_key(
+                 "x-tenant-id", GRPC_WELL_KNOWN_METADATA_REPEATED_VALUES) >=
+             0);
+  GPR_ASSERT(grpc_register_well_known_metadata_key("x-request-id", 0) >= 0);
+  GPR_ASSERT(grpc_register_well_known_metadata_key("x-trace-context", 0) >=
+             0);
+  return true;
+}
+bool application_metadata_registered = RegisterApplicationMetadata();
+
 auto& force_library_initialization = Library::get();
 
 static grpc_slice MakeSlice(std::vector<uint8_t> bytes) {
@@ -319,6 +334,45 @@ class MoreRepresentativeClientInitialMetadata {
   }
 };
 
+// Headers that an application adds to every call, created the way the surface
+// creates them from the application's grpc_metadata array, which must outlive
+// them.
+static std::vector<grpc_mdelem> ApplicationMetadataElems(
+    const char* const keys[3], grpc_metadata md[3]) {
+  static const char* const kValues[3] = {
+      "tenant-1234", "5f8a0c2e-5d4b-4b6e-9a37-0d1c2b3a4f5e",
+      "00-0af7651916cd43dd8448eb211c80319c-b7ad6b7169203331-01"};
+  std::vector<grpc_mdelem> out;
+  for (size_t i = 0; i < 3; i++) {
+    md[i].key = grpc_slice_from_static_string(keys[i]);
+    md[i].value = grpc_slice_from_static_string(kValues[i]);
+    out.push_back(grpc_mdelem_from_grpc_metadata(&md[i]));
+  }
+  return out;
+}
+
+class UnregisteredApplicationMetadata {
+ public:
+  static constexpr bool kEnableTrueBinary = true;
+  static std::vector<grpc_mdelem> GetElems() {
+    static const char* const kKeys[3] = {"y-tenant-id", "y-request-id",
+                                         "y-trace-context"};
+    static grpc_metadata md[3];
+    return ApplicationMetadataElems(kKeys, md);
+  }
+};
+
+class RegisteredApplicationMetadata {
+ public:
+  static constexpr bool kEnableTrueBinary = true;
+  static std::vector<grpc_mdelem> GetElems() {
+    static const char* const kKeys[3] = {"x-tenant-id", "x-request-id",
+                                         "x-trace-context"};
+    static grpc_metadata md[3];
+    return ApplicationMetadataElems(kKeys, md);
+  }
+};
+
 class RepresentativeServerInitialMetadata {
  public:
   static constexpr bool kEnableTrueBinary = true;
@@ -418,6 +472,10 @@ BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader,
 BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader,
                    MoreRepresentativeClientInitialMetadata)
     ->Args({0, 16384});
+BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader, UnregisteredApplicationMetadata)
+    ->Args({0, 16384});
+BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader, RegisteredApplicationMetadata)
+    ->Args({0, 16384});
 BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader,
                    RepresentativeServerInitialMetadata)
     ->Args({0, 16384});
@@ -920,6 +978,60 @@ BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, SameDeadline, OnHeaderTimeout);
 
 }  // namespace hpack_parser_fixtures
 
+////////////////////////////////////////////////////////////////////////////////
+// Binary metadata codecs
+//
+
+static grpc_slice MakeBinaryValue(size_t length) {
+  grpc_slice s = grpc_slice_malloc(length);
+  uint8_t* p = GRPC_SLICE_START_PTR(s);
+  for (size_t i = 0; i < length; i++) {
+    p[i] = static_cast<uint8_t>(i * 131 + (i >> 8));
+  }
+  return s;
+}
+
+static void BM_Base64Encode(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_slice value = MakeBinaryValue(state.range(0));
+  while (state.KeepRunning()) {
+    grpc_slice_unref(grpc_chttp2_base64_encode(value));
+  }
+  grpc_slice_unref(value);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_Base64Encode)->RangeMultiplier(2)->Range(1024, 16384);
+
+static void BM_Base64EncodeAndHuffmanCompress(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_slice value = MakeBinaryValue(state.range(0));
+  while (state.KeepRunning()) {
+    grpc_slice_unref(grpc_chttp2_base64_encode_and_huffman_compress(value));
+  }
+  grpc_slice_unref(value);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_Base64EncodeAndHuffmanCompress)
+    ->RangeMultiplier(2)
+    ->Range(1024, 16384);
+
+static void BM_Base64Decode(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_slice value = MakeBinaryValue(state.range(0));
+  grpc_slice encoded = grpc_chttp2_base64_encode(value);
+  while (state.KeepRunning()) {
+    grpc_slice_unref(
+        grpc_chttp2_base64_decode_with_length(encoded, state.range(0)));
+  }
+  grpc_slice_unref(encoded);
+  grpc_slice_unref(value);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_Base64Decode)->RangeMultiplier(2)->Range(1024, 16384);
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
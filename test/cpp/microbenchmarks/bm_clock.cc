@@ -0,0 +1,87 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the cost of the clocks used for timestamps on the call path */
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/support/time.h>
+
+#include "src/core/lib/gpr/time_precise.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+auto& force_library_initialization = Library::get();
+
+static void ClockArgs(benchmark::internal::Benchmark* b) {
+  b->Arg(GPR_CLOCK_MONOTONIC)->Arg(GPR_CLOCK_REALTIME);
+}
+
+// Also read from several threads: the cost of clock state shared between
+// readers only shows there.
+static void BM_GprNow(benchmark::State& state) {
+  TrackCounters track_counters;
+  const gpr_clock_type clock = static_cast<gpr_clock_type>(state.range(0));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(gpr_now(clock));
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_GprNow)->Apply(ClockArgs)->ThreadRange(1, 16);
+
+// What each new ExecCtx pays for its first timestamp.
+static void BM_ExecCtxNow(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  while (state.KeepRunning()) {
+    exec_ctx.InvalidateNow();
+    benchmark::DoNotOptimize(exec_ctx.Now());
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ExecCtxNow);
+
+static void BM_CoarseClockNow(benchmark::State& state) {
+  TrackCounters track_counters;
+  const gpr_clock_type clock = static_cast<gpr_clock_type>(state.range(0));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(gpr_coarse_clock_now(clock));
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_CoarseClockNow)->Apply(ClockArgs)->ThreadRange(1, 16);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
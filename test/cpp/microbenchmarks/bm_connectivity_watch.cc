@@ -0,0 +1,159 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark watching the connectivity state of many channels */
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include "test/core/util/port.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+#include "src/core/ext/filters/client_channel/client_channel.h"
+#include "src/core/lib/gpr/host_port.h"
+
+namespace grpc {
+namespace testing {
+
+auto& force_library_initialization = Library::get();
+
+// Idle channels to a port nobody listens on, so their state never changes
+// and every watch runs until its deadline.
+class IdleChannels {
+ public:
+  explicit IdleChannels(size_t num_channels) {
+    char* target;
+    gpr_join_host_port(&target, "localhost", grpc_pick_unused_port_or_die());
+    for (size_t i = 0; i < num_channels; i++) {
+      channels_.push_back(
+          grpc_insecure_channel_create(target, nullptr, nullptr));
+    }
+    gpr_free(target);
+    cq_ = grpc_completion_queue_create_for_next(nullptr);
+  }
+
+  ~IdleChannels() {
+    for (grpc_channel* channel : channels_) {
+      grpc_channel_destroy(channel);
+    }
+    grpc_completion_queue_shutdown(cq_);
+    while (grpc_completion_queue_next(cq_, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                      nullptr)
+               .type != GRPC_QUEUE_SHUTDOWN) {
+    }
+    grpc_completion_queue_destroy(cq_);
+  }
+
+  std::vector<grpc_channel*>& channels() { return channels_; }
+  grpc_completion_queue* cq() { return cq_; }
+
+  void Drain(size_t num_events) {
+    for (size_t i = 0; i < num_events; i++) {
+      grpc_event ev = grpc_completion_queue_next(
+          cq_, gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+      GPR_ASSERT(ev.type == GRPC_OP_COMPLETE);
+    }
+  }
+
+ private:
+  std::vector<grpc_channel*> channels_;
+  grpc_completion_queue* cq_;
+};
+
+// Adds the gpr memory allocated per watched channel to the usual counters.
+class TrackWatchCounters : public TrackCounters {
+ public:
+  void AddToLabel(std::ostream& out, benchmark::State& state) override {
+    TrackCounters::AddToLabel(out, state);
+#ifdef GPR_LOW_LEVEL_COUNTERS
+    grpc_memory_counters counters_at_end = grpc_memory_counters_snapshot();
+    const double watches =
+        static_cast<double>(state.iterations() * state.range(0));
+    out << " alloc_bytes/watch:"
+        << ((double)(counters_at_end.total_size_absolute -
+                     counters_at_start_.total_size_absolute) /
+            watches)
+        << " allocs/watch:"
+        << ((double)(counters_at_end.total_allocs_absolute -
+                     counters_at_start_.total_allocs_absolute) /
+            watches);
+#endif
+  }
+
+ private:
+#ifdef GPR_LOW_LEVEL_COUNTERS
+  const grpc_memory_counters counters_at_start_ =
+      grpc_memory_counters_snapshot();
+#endif
+};
+
+// One watch, timer and completion per channel.
+static void BM_WatchEach(benchmark::State& state) {
+  IdleChannels idle_channels(state.range(0));
+  // Created after the channels, so that only the watches are counted.
+  TrackWatchCounters track_counters;
+  while (state.KeepRunning()) {
+    for (grpc_channel* channel : idle_channels.channels()) {
+      grpc_channel_watch_connectivity_state(
+          channel, GRPC_CHANNEL_IDLE, gpr_inf_past(GPR_CLOCK_MONOTONIC),
+          idle_channels.cq(), nullptr);
+    }
+    idle_channels.Drain(idle_channels.channels().size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_WatchEach)->Arg(10)->Arg(1000)->Arg(10000);
+
+// One group watch with a single timer and completion for all the channels.
+static void BM_WatchGroup(benchmark::State& state) {
+  IdleChannels idle_channels(state.range(0));
+  TrackWatchCounters track_counters;
+  std::vector<grpc_connectivity_state> states(idle_channels.channels().size(),
+                                              GRPC_CHANNEL_IDLE);
+  while (state.KeepRunning()) {
+    grpc_channel_watch_connectivity_state_group(
+        idle_channels.channels().data(), states.data(),
+        idle_channels.channels().size(), gpr_inf_past(GPR_CLOCK_MONOTONIC),
+        idle_channels.cq(), nullptr);
+    idle_channels.Drain(1);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_WatchGroup)->Arg(10)->Arg(1000)->Arg(10000);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -38,6 +38,7 @@ static gpr_mu g_mu;
 static gpr_cv g_cv;
 static int g_threads_active;
 static bool g_active;
+static bool g_fake_engine;
 
 namespace grpc {
 namespace testing {
@@ -102,17 +103,17 @@ static const grpc_event_engine_vtable* init_engine_vtable(bool) {
 }
 
 static void setup() {
-  // This test should only ever be run with a non or any polling engine
   // Override the polling engine for the non-polling engine
-  // and add a custom polling engine
+  // and add a custom polling engine. BM_Cq_Throughput runs on that engine;
+  // BM_Cq_Handoff needs a real one, e.g. GRPC_POLL_STRATEGY=epoll1
   grpc_register_event_engine_factory("none", init_engine_vtable, false);
   grpc_register_event_engine_factory("bm_cq_multiple_threads",
                                      init_engine_vtable, true);
 
   grpc_init();
-  GPR_ASSERT(strcmp(grpc_get_poll_strategy_name(), "none") == 0 ||
-             strcmp(grpc_get_poll_strategy_name(), "bm_cq_multiple_threads") ==
-                 0);
+  g_fake_engine =
+      strcmp(grpc_get_poll_strategy_name(), "none") == 0 ||
+      strcmp(grpc_get_poll_strategy_name(), "bm_cq_multiple_threads") == 0;
 
   g_cq = grpc_completion_queue_create_for_next(nullptr);
 }
@@ -151,10 +152,8 @@ static void teardown() {
  and its Finish call must take place before grpc_shutdown so that it can use
  grpc_stats).
 */
-static void BM_Cq_Throughput(benchmark::State& state) {
+static void StartThread(int thd_idx) {
   gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
-  auto thd_idx = state.thread_index;
-
   gpr_mu_lock(&g_mu);
   g_threads_active++;
   if (thd_idx == 0) {
@@ -167,19 +166,10 @@ static void BM_Cq_Throughput(benchmark::State& state) {
     }
   }
   gpr_mu_unlock(&g_mu);
+}
 
-  // Use a TrackCounters object to monitor the gRPC performance statistics
-  // (optionally including low-level counters) before and after the test
-  TrackCounters track_counters;
-
-  while (state.KeepRunning()) {
-    GPR_ASSERT(grpc_completion_queue_next(g_cq, deadline, nullptr).type ==
-               GRPC_OP_COMPLETE);
-  }
-
-  state.SetItemsProcessed(state.iterations());
-  track_counters.Finish(state);
-
+static void StopThread(int thd_idx) {
+  gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
   gpr_mu_lock(&g_mu);
   g_threads_active--;
   if (g_threads_active == 0) {
@@ -197,8 +187,65 @@ static void BM_Cq_Throughput(benchmark::State& state) {
   }
 }
 
+static void BM_Cq_Throughput(benchmark::State& state) {
+  gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+  auto thd_idx = state.thread_index;
+
+  StartThread(thd_idx);
+  if (!g_fake_engine) {
+    state.SkipWithError("needs the bm_cq_multiple_threads polling engine");
+  }
+
+  // Use a TrackCounters object to monitor the gRPC performance statistics
+  // (optionally including low-level counters) before and after the test
+  TrackCounters track_counters;
+
+  while (state.KeepRunning()) {
+    GPR_ASSERT(grpc_completion_queue_next(g_cq, deadline, nullptr).type ==
+               GRPC_OP_COMPLETE);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  track_counters.Finish(state);
+
+  StopThread(thd_idx);
+}
+
 BENCHMARK(BM_Cq_Throughput)->ThreadRange(1, 16)->UseRealTime();
 
+/* Every thread posts a completion and then waits for one, so the completions
+   keep being handed to threads parked in the real polling engine: each one
+   kicks a waiting worker, and the epoll1 pollset_kick* counters show how
+   many of those kicks needed an eventfd write */
+static void BM_Cq_Handoff(benchmark::State& state) {
+  gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+  auto thd_idx = state.thread_index;
+
+  StartThread(thd_idx);
+  if (g_fake_engine) {
+    state.SkipWithError("needs a real polling engine, e.g. epoll1");
+  }
+
+  TrackCounters track_counters;
+
+  while (state.KeepRunning()) {
+    grpc_core::ExecCtx exec_ctx;
+    void* tag = (void*)static_cast<intptr_t>(thd_idx + 1);
+    GPR_ASSERT(grpc_cq_begin_op(g_cq, tag));
+    grpc_cq_end_op(g_cq, tag, GRPC_ERROR_NONE, cq_done_cb, nullptr,
+                   static_cast<grpc_cq_completion*>(
+                       gpr_malloc(sizeof(grpc_cq_completion))));
+    GPR_ASSERT(grpc_completion_queue_next(g_cq, deadline, nullptr).type ==
+               GRPC_OP_COMPLETE);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  track_counters.Finish(state);
+
+  StopThread(thd_idx);
+}
+BENCHMARK(BM_Cq_Handoff)->ThreadRange(1, 16)->UseRealTime();
+
 }  // namespace testing
 }  // namespace grpc
 
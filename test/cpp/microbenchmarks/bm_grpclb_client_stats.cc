@@ -0,0 +1,92 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark grpclb client load reporting under concurrent calls */
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/grpc.h>
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+#include "src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_client_stats.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+namespace grpc {
+namespace testing {
+
+auto& force_library_initialization = Library::get();
+
+static grpc_core::GrpcLbClientStats* g_client_stats;
+
+// Every thread records started and finished calls on one shared stats
+// object, as the client load reporting filter does for all calls of a
+// channel, while the first thread also takes a load report every
+// kCallsPerReport calls. At the default 10s report interval, 1M calls/sec
+// makes for 10M calls per report; reporting far more often than that keeps
+// the cost of aggregation visible.
+static void BM_GrpcLbClientStatsAddCall(benchmark::State& state) {
+  constexpr int kCallsPerReport = 100000;
+  TrackCounters track_counters;
+  if (state.thread_index == 0) {
+    g_client_stats = grpc_core::New<grpc_core::GrpcLbClientStats>();
+  }
+  grpc_core::ExecCtx exec_ctx;
+  int calls = 0;
+  while (state.KeepRunning()) {
+    g_client_stats->AddCallStarted();
+    g_client_stats->AddCallFinished(false /* client_failed_to_send */,
+                                    true /* known_received */);
+    if (state.thread_index == 0 && ++calls == kCallsPerReport) {
+      calls = 0;
+      int64_t num_calls_started;
+      int64_t num_calls_finished;
+      int64_t num_calls_finished_with_client_failed_to_send;
+      int64_t num_calls_finished_known_received;
+      grpc_core::UniquePtr<grpc_core::GrpcLbClientStats::DroppedCallCounts>
+          drop_token_counts;
+      g_client_stats->GetLocked(
+          &num_calls_started, &num_calls_finished,
+          &num_calls_finished_with_client_failed_to_send,
+          &num_calls_finished_known_received, &drop_token_counts);
+      benchmark::DoNotOptimize(num_calls_finished);
+    }
+  }
+  if (state.thread_index == 0) {
+    grpc_core::Delete(g_client_stats);
+  }
+  state.SetItemsProcessed(state.iterations());
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_GrpcLbClientStatsAddCall)->ThreadRange(1, 64)->UseRealTime();
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,131 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the cost of client-side health checking many subchannels */
+
+#include <benchmark/benchmark.h>
+#include <sys/resource.h>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include <grpc/support/log.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/health_check_service_interface.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/support/channel_arguments.h>
+
+#include "test/core/util/port.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+auto& force_library_initialization = Library::get();
+
+// A server running the in-tree default health checking service, which
+// reports the "" service as SERVING.
+class HealthCheckedServer {
+ public:
+  HealthCheckedServer() {
+    EnableDefaultHealthCheckService(true);
+    std::ostringstream address;
+    address << "localhost:" << grpc_pick_unused_port_or_die();
+    address_ = address.str();
+    ServerBuilder builder;
+    builder.AddListeningPort(address_, InsecureServerCredentials());
+    server_ = builder.BuildAndStart();
+  }
+
+  const grpc::string& address() const { return address_; }
+
+ private:
+  grpc::string address_;
+  std::unique_ptr<Server> server_;
+};
+
+static HealthCheckedServer* GetServer() {
+  static HealthCheckedServer* server = new HealthCheckedServer();
+  return server;
+}
+
+// Connects range(0) channels, each with a subchannel of its own, and waits
+// for all of them to be READY. With range(1) set, every subchannel first runs
+// a Health.Watch call and only becomes READY once the backend says SERVING,
+// so the difference with range(1) unset is the cost of health checking.
+static void BM_HealthCheckedChannelsReady(benchmark::State& state) {
+  TrackCounters track_counters;
+  const grpc::string& address = GetServer()->address();
+  ChannelArguments args;
+  args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+  if (state.range(1)) {
+    args.SetServiceConfigJSON(
+        "{\"loadBalancingPolicy\": \"round_robin\", "
+        "\"healthCheckConfig\": {\"serviceName\": \"\"}}");
+  } else {
+    args.SetServiceConfigJSON("{\"loadBalancingPolicy\": \"round_robin\"}");
+  }
+  while (state.KeepRunning()) {
+    std::vector<std::shared_ptr<Channel>> channels;
+    for (int i = 0; i < state.range(0); i++) {
+      channels.push_back(
+          CreateCustomChannel(address, InsecureChannelCredentials(), args));
+      channels.back()->GetState(true /* try_to_connect */);
+    }
+    for (const auto& channel : channels) {
+      GPR_ASSERT(channel->WaitForConnected(gpr_inf_future(GPR_CLOCK_REALTIME)));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+
+// Each channel holds both ends of a connection open in this process, so only
+// sweep up to 10k subchannels when the fd limit allows it.
+static void HealthCheckArgs(benchmark::internal::Benchmark* b) {
+  struct rlimit limit;
+  const rlim_t max_fds =
+      getrlimit(RLIMIT_NOFILE, &limit) == 0 ? limit.rlim_cur : 1024;
+  for (int num_channels = 10; num_channels <= 10000; num_channels *= 10) {
+    if (static_cast<rlim_t>(2 * num_channels + 100) > max_fds) break;
+    b->Args({num_channels, 0});
+    b->Args({num_channels, 1});
+  }
+}
+BENCHMARK(BM_HealthCheckedChannelsReady)->Apply(HealthCheckArgs);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,190 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the cost of resolver updates to a round_robin policy */
+
+#include <benchmark/benchmark.h>
+#include <stdio.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+#include "src/core/ext/filters/client_channel/client_channel_factory.h"
+#include "src/core/ext/filters/client_channel/connector.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/filters/client_channel/local_subchannel_pool.h"
+#include "src/core/ext/filters/client_channel/parse_address.h"
+#include "src/core/ext/filters/client_channel/server_address.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/iomgr/combiner.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+namespace grpc {
+namespace testing {
+
+auto& force_library_initialization = Library::get();
+
+// A connector whose connection attempts never complete until shut down, so
+// that watched subchannels stay in CONNECTING without any network activity.
+// Each subchannel gets its own.
+struct PendingConnector {
+  grpc_connector base;
+  gpr_refcount refs;
+  grpc_closure* notify;
+};
+
+static void PendingConnectorRef(grpc_connector* connector) {
+  gpr_ref(&reinterpret_cast<PendingConnector*>(connector)->refs);
+}
+static void PendingConnectorUnref(grpc_connector* connector) {
+  PendingConnector* c = reinterpret_cast<PendingConnector*>(connector);
+  if (gpr_unref(&c->refs)) gpr_free(c);
+}
+static void PendingConnectorShutdown(grpc_connector* connector,
+                                     grpc_error* why) {
+  PendingConnector* c = reinterpret_cast<PendingConnector*>(connector);
+  if (c->notify != nullptr) {
+    GRPC_CLOSURE_SCHED(c->notify, why);
+    c->notify = nullptr;
+  } else {
+    GRPC_ERROR_UNREF(why);
+  }
+}
+static void PendingConnectorConnect(grpc_connector* connector,
+                                    const grpc_connect_in_args* in_args,
+                                    grpc_connect_out_args* out_args,
+                                    grpc_closure* notify) {
+  reinterpret_cast<PendingConnector*>(connector)->notify = notify;
+}
+
+static const grpc_connector_vtable pending_connector_vtable = {
+    PendingConnectorRef, PendingConnectorUnref, PendingConnectorShutdown,
+    PendingConnectorConnect};
+
+static void FactoryRef(grpc_client_channel_factory* factory) {}
+static void FactoryUnref(grpc_client_channel_factory* factory) {}
+static grpc_subchannel* FactoryCreateSubchannel(
+    grpc_client_channel_factory* factory, const grpc_channel_args* args) {
+  PendingConnector* connector =
+      static_cast<PendingConnector*>(gpr_zalloc(sizeof(*connector)));
+  connector->base.vtable = &pending_connector_vtable;
+  gpr_ref_init(&connector->refs, 1);
+  grpc_arg arg = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_ENABLE_CHANNELZ), 0);
+  grpc_channel_args* new_args = grpc_channel_args_copy_and_add(args, &arg, 1);
+  grpc_subchannel* subchannel =
+      grpc_subchannel_create(&connector->base, new_args);
+  grpc_channel_args_destroy(new_args);
+  grpc_connector_unref(&connector->base);
+  return subchannel;
+}
+static grpc_channel* FactoryCreateClientChannel(
+    grpc_client_channel_factory* factory, const char* target,
+    grpc_client_channel_type type, const grpc_channel_args* args) {
+  return nullptr;
+}
+
+static const grpc_client_channel_factory_vtable factory_vtable = {
+    FactoryRef, FactoryUnref, FactoryCreateSubchannel,
+    FactoryCreateClientChannel};
+static grpc_client_channel_factory factory = {&factory_vtable};
+
+// Returns the channel args of a resolver result with \a num_addresses
+// addresses, numbered from \a first.
+static grpc_channel_args* MakeResolverResult(int first, int num_addresses) {
+  grpc_core::ServerAddressList addresses;
+  addresses.reserve(num_addresses);
+  for (int i = first; i < first + num_addresses; ++i) {
+    char hostport[32];
+    snprintf(hostport, sizeof(hostport), "10.%d.%d.%d:443", (i >> 16) & 0xff,
+             (i >> 8) & 0xff, i & 0xff);
+    grpc_resolved_address address;
+    GPR_ASSERT(grpc_parse_ipv4_hostport(hostport, &address, true));
+    addresses.emplace_back(address, nullptr);
+  }
+  grpc_arg arg = grpc_core::CreateServerAddressListChannelArg(&addresses);
+  return grpc_channel_args_copy_and_add(nullptr, &arg, 1);
+}
+
+// Alternates a round_robin policy watching state.range(0) subchannels
+// between two resolver results that differ in state.range(1) addresses, and
+// measures the time to apply each update. Updates that keep most addresses
+// should only cost as much as the addresses that changed.
+static void BM_RoundRobinUpdate(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  const int num_addresses = static_cast<int>(state.range(0));
+  const int num_changed = static_cast<int>(state.range(1));
+  grpc_channel_args* results[] = {
+      MakeResolverResult(0, num_addresses),
+      MakeResolverResult(num_changed, num_addresses)};
+  grpc_combiner* combiner = grpc_combiner_create();
+  grpc_core::RefCountedPtr<grpc_core::SubchannelPoolInterface> pool =
+      grpc_core::MakeRefCounted<grpc_core::LocalSubchannelPool>();
+  grpc_core::LoadBalancingPolicy::Args args;
+  args.combiner = combiner;
+  args.client_channel_factory = &factory;
+  args.subchannel_pool = &pool;
+  args.args = results[0];
+  grpc_core::OrphanablePtr<grpc_core::LoadBalancingPolicy> policy =
+      grpc_core::LoadBalancingPolicyRegistry::CreateLoadBalancingPolicy(
+          "round_robin", args);
+  GPR_ASSERT(policy != nullptr);
+  // Start watching all subchannels, as the policy would on the first pick.
+  policy->ExitIdleLocked();
+  exec_ctx.Flush();
+  size_t next = 1;
+  while (state.KeepRunning()) {
+    policy->UpdateLocked(*results[next], nullptr);
+    exec_ctx.Flush();
+    next ^= 1;
+  }
+  policy.reset();
+  exec_ctx.Flush();
+  GRPC_COMBINER_UNREF(combiner, "bm_lb_policy_update");
+  for (grpc_channel_args* result : results) {
+    grpc_channel_args_destroy(result);
+  }
+  exec_ctx.Flush();
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_RoundRobinUpdate)
+    ->Args({5000, 1})
+    ->Args({5000, 50})
+    ->Args({5000, 500})
+    ->Args({5000, 5000});
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
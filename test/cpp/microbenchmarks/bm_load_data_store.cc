@@ -0,0 +1,122 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark merging fetched load data into the server load reporting store */
+
+#include <benchmark/benchmark.h>
+#include <mutex>
+#include <vector>
+
+#include "src/cpp/server/load_reporter/load_data_store.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+auto& force_library_initialization = Library::get();
+
+using ::grpc::load_reporter::LoadDataStore;
+using ::grpc::load_reporter::LoadRecordKey;
+using ::grpc::load_reporter::LoadRecordValue;
+
+constexpr int kNumLbIds = 4;
+constexpr int kRowsPerLbId = 256;
+const char kHostname[] = "kHostname";
+
+static grpc::string LbId(int i) { return "kLbId" + grpc::to_string(i); }
+
+// A store shared by all the benchmark threads, locked the way LoadReporter
+// locks its store.
+struct SharedStore {
+  SharedStore() {
+    for (int i = 0; i < kNumLbIds; i++) {
+      store.ReportStreamCreated(kHostname, LbId(i), "kLoadKey");
+    }
+  }
+
+  std::mutex mu;
+  LoadDataStore store;
+};
+
+static SharedStore* GetSharedStore() {
+  static SharedStore* shared_store = new SharedStore();
+  return shared_store;
+}
+
+// The rows of one fetch from Census, sorted by tags like Census sorts them.
+// Each row starts and finishes one call, so the number of in-progress calls
+// stays constant.
+static std::vector<LoadDataStore::Row> MakeRows() {
+  std::vector<LoadDataStore::Row> rows;
+  for (int i = 0; i < kNumLbIds; i++) {
+    for (int j = 0; j < kRowsPerLbId; j++) {
+      rows.emplace_back(kHostname,
+                        LoadRecordKey(LbId(i), "kLbTag" + grpc::to_string(j),
+                                      "kUser", "00"),
+                        LoadRecordValue(1, 1, 0, 100, 100, 1));
+    }
+  }
+  return rows;
+}
+
+// Merges a fetch with one lock acquisition and store lookup per row.
+static void BM_LoadDataStoreMergeRow(benchmark::State& state) {
+  TrackCounters track_counters;
+  SharedStore* shared_store = GetSharedStore();
+  std::vector<LoadDataStore::Row> rows = MakeRows();
+  while (state.KeepRunning()) {
+    for (const LoadDataStore::Row& row : rows) {
+      std::lock_guard<std::mutex> lock(shared_store->mu);
+      shared_store->store.MergeRow(row.hostname, row.key, row.value);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * rows.size());
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_LoadDataStoreMergeRow)->ThreadRange(1, 8);
+
+// Merges a fetch with a single lock acquisition, as LoadReporter does.
+static void BM_LoadDataStoreMergeRows(benchmark::State& state) {
+  TrackCounters track_counters;
+  SharedStore* shared_store = GetSharedStore();
+  std::vector<LoadDataStore::Row> rows = MakeRows();
+  while (state.KeepRunning()) {
+    std::lock_guard<std::mutex> lock(shared_store->mu);
+    shared_store->store.MergeRows(rows);
+  }
+  state.SetItemsProcessed(state.iterations() * rows.size());
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_LoadDataStoreMergeRows)->ThreadRange(1, 8);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
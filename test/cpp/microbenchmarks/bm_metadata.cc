@@ -22,11 +22,23 @@
 #include <grpc/grpc.h>
 
 #include "src/core/lib/transport/metadata.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "src/core/lib/transport/registered_metadata.h"
 #include "src/core/lib/transport/static_metadata.h"
 
 #include "test/cpp/microbenchmarks/helpers.h"
 #include "test/cpp/util/test_config.h"
 
+// Keys must be registered before the library is initialized below.
+static int RegisterKey(const char* key, uint32_t flags) {
+  int index = grpc_register_well_known_metadata_key(key, flags);
+  GPR_ASSERT(index >= 0);
+  return index;
+}
+static const int kTenantIdIndex =
+    RegisterKey("x-tenant-id", GRPC_WELL_KNOWN_METADATA_REPEATED_VALUES);
+static const int kRequestIdIndex = RegisterKey("x-request-id", 0);
+
 auto& force_library_initialization = Library::get();
 
 static void BM_SliceFromStatic(benchmark::State& state) {
@@ -87,6 +99,26 @@ static void BM_SliceInternEqualToStaticMetadata(benchmark::State& state) {
 }
 BENCHMARK(BM_SliceInternEqualToStaticMetadata);
 
+static void BM_SliceInternEqualToRegisteredMetadata(benchmark::State& state) {
+  TrackCounters track_counters;
+  gpr_slice slice = grpc_slice_from_static_string("x-tenant-id");
+  while (state.KeepRunning()) {
+    grpc_slice_intern(slice);
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_SliceInternEqualToRegisteredMetadata);
+
+static void BM_SliceInternEqualToUnregisteredMetadata(benchmark::State& state) {
+  TrackCounters track_counters;
+  gpr_slice slice = grpc_slice_from_static_string("y-tenant-id");
+  while (state.KeepRunning()) {
+    grpc_slice_unref(grpc_slice_intern(slice));
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_SliceInternEqualToUnregisteredMetadata);
+
 static void BM_MetadataFromNonInternedSlices(benchmark::State& state) {
   TrackCounters track_counters;
   gpr_slice k = grpc_slice_from_static_string("key");
@@ -291,6 +323,103 @@ static void BM_MetadataRefUnrefStatic(benchmark::State& state) {
 }
 BENCHMARK(BM_MetadataRefUnrefStatic);
 
+// Creates metadata the way the surface does for an application's headers.
+static void BM_MetadataFromGrpcMetadata(benchmark::State& state,
+                                        const char* key, const char* value) {
+  TrackCounters track_counters;
+  grpc_metadata md;
+  md.key = grpc_slice_from_static_string(key);
+  md.value = grpc_slice_from_static_string(value);
+  grpc_core::ExecCtx exec_ctx;
+  while (state.KeepRunning()) {
+    GRPC_MDELEM_UNREF(grpc_mdelem_from_grpc_metadata(&md));
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK_CAPTURE(BM_MetadataFromGrpcMetadata, unregistered, "y-tenant-id",
+                  "tenant-1234");
+BENCHMARK_CAPTURE(BM_MetadataFromGrpcMetadata, registered_repeated_values,
+                  "x-tenant-id", "tenant-1234");
+BENCHMARK_CAPTURE(BM_MetadataFromGrpcMetadata, registered, "x-request-id",
+                  "5f8a0c2e-5d4b-4b6e-9a37-0d1c2b3a4f5e");
+
+// Looks up two application headers in a batch that carries state.range(0)
+// other headers, first by walking the batch and then through the callouts of
+// the registered keys.
+static void BuildApplicationBatch(benchmark::State& state, const char* prefix,
+                                  grpc_metadata_batch* batch,
+                                  std::vector<grpc_linked_mdelem>* storage) {
+  grpc_metadata_batch_init(batch);
+  storage->resize(state.range(0) + 2);
+  for (int i = 0; i < state.range(0); i++) {
+    char key[32];
+    snprintf(key, sizeof(key), "x-other-%d", i);
+    GPR_ASSERT(GRPC_ERROR_NONE ==
+               grpc_metadata_batch_add_tail(
+                   batch, &(*storage)[i],
+                   grpc_mdelem_from_slices(
+                       grpc_slice_intern(grpc_slice_from_copied_string(key)),
+                       grpc_slice_from_static_string("value"))));
+  }
+  const char* keys[] = {"tenant-id", "request-id"};
+  for (int i = 0; i < 2; i++) {
+    char key[32];
+    snprintf(key, sizeof(key), "%s%s", prefix, keys[i]);
+    GPR_ASSERT(GRPC_ERROR_NONE ==
+               grpc_metadata_batch_add_tail(
+                   batch, &(*storage)[state.range(0) + i],
+                   grpc_mdelem_from_slices(
+                       grpc_slice_intern(grpc_slice_from_copied_string(key)),
+                       grpc_slice_from_static_string("value"))));
+  }
+}
+
+static grpc_linked_mdelem* FindInBatch(grpc_metadata_batch* batch,
+                                       grpc_slice key) {
+  for (grpc_linked_mdelem* l = batch->list.head; l != nullptr; l = l->next) {
+    if (grpc_slice_eq(GRPC_MDKEY(l->md), key)) return l;
+  }
+  return nullptr;
+}
+
+static void BM_MetadataBatchFindUnregistered(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  grpc_metadata_batch batch;
+  std::vector<grpc_linked_mdelem> storage;
+  BuildApplicationBatch(state, "y-", &batch, &storage);
+  grpc_slice tenant_id =
+      grpc_slice_intern(grpc_slice_from_static_string("y-tenant-id"));
+  grpc_slice request_id =
+      grpc_slice_intern(grpc_slice_from_static_string("y-request-id"));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(FindInBatch(&batch, tenant_id));
+    benchmark::DoNotOptimize(FindInBatch(&batch, request_id));
+  }
+  grpc_slice_unref(tenant_id);
+  grpc_slice_unref(request_id);
+  grpc_metadata_batch_destroy(&batch);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_MetadataBatchFindUnregistered)->Arg(0)->Arg(4)->Arg(16);
+
+static void BM_MetadataBatchFindRegistered(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  grpc_metadata_batch batch;
+  std::vector<grpc_linked_mdelem> storage;
+  BuildApplicationBatch(state, "x-", &batch, &storage);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(batch.registered[kTenantIdIndex]);
+    benchmark::DoNotOptimize(batch.registered[kRequestIdIndex]);
+  }
+  GPR_ASSERT(batch.registered[kTenantIdIndex] != nullptr);
+  GPR_ASSERT(batch.registered[kRequestIdIndex] != nullptr);
+  grpc_metadata_batch_destroy(&batch);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_MetadataBatchFindRegistered)->Arg(0)->Arg(4)->Arg(16);
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
@@ -0,0 +1,154 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark subchannel pool churn caused by resolver updates */
+
+#include <benchmark/benchmark.h>
+#include <stdio.h>
+#include <vector>
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+#include "src/core/ext/filters/client_channel/connector.h"
+#include "src/core/ext/filters/client_channel/global_subchannel_pool.h"
+#include "src/core/ext/filters/client_channel/parse_address.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+namespace grpc {
+namespace testing {
+
+auto& force_library_initialization = Library::get();
+
+// The subchannels are never connected, so the connector does nothing.
+static void NoopConnectorRef(grpc_connector* connector) {}
+static void NoopConnectorUnref(grpc_connector* connector) {}
+static void NoopConnectorShutdown(grpc_connector* connector, grpc_error* why) {
+  GRPC_ERROR_UNREF(why);
+}
+static void NoopConnectorConnect(grpc_connector* connector,
+                                 const grpc_connect_in_args* in_args,
+                                 grpc_connect_out_args* out_args,
+                                 grpc_closure* notify) {
+  GPR_ASSERT(false);
+}
+
+static const grpc_connector_vtable noop_connector_vtable = {
+    NoopConnectorRef, NoopConnectorUnref, NoopConnectorShutdown,
+    NoopConnectorConnect};
+static grpc_connector noop_connector = {&noop_connector_vtable};
+
+// Creates (or finds in the global pool) the subchannel for address \a index.
+static grpc_subchannel* CreateSubchannel(int index) {
+  char hostport[32];
+  snprintf(hostport, sizeof(hostport), "10.%d.%d.%d:443", (index >> 16) & 0xff,
+           (index >> 8) & 0xff, index & 0xff);
+  grpc_resolved_address address;
+  GPR_ASSERT(grpc_parse_ipv4_hostport(hostport, &address, true));
+  grpc_arg args[] = {
+      grpc_create_subchannel_address_arg(&address),
+      grpc_core::SubchannelPoolInterface::CreateChannelArg(
+          grpc_core::GlobalSubchannelPool::instance().get()),
+      grpc_channel_arg_integer_create(
+          const_cast<char*>(GRPC_ARG_ENABLE_CHANNELZ), 0),
+  };
+  grpc_channel_args channel_args = {GPR_ARRAY_SIZE(args), args};
+  grpc_subchannel* subchannel =
+      grpc_subchannel_create(&noop_connector, &channel_args);
+  gpr_free(args[0].value.string);
+  return subchannel;
+}
+
+// Keeps state.range(0) subchannels alive and, on each iteration, applies a
+// resolver update that replaces a tenth of the addresses, the way a large
+// backend fleet rolls over. The new addresses are registered in the global
+// pool and the replaced ones unregister themselves as they are released.
+static void BM_ResolverUpdateChurn(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  const int num_addresses = static_cast<int>(state.range(0));
+  const int churn = num_addresses / 10;
+  std::vector<grpc_subchannel*> subchannels(num_addresses);
+  for (int i = 0; i < num_addresses; ++i) {
+    subchannels[i] = CreateSubchannel(i);
+  }
+  exec_ctx.Flush();
+  int next_address = num_addresses;
+  int next_slot = 0;
+  while (state.KeepRunning()) {
+    for (int i = 0; i < churn; ++i) {
+      grpc_subchannel*& slot = subchannels[next_slot];
+      next_slot = (next_slot + 1) % num_addresses;
+      GRPC_SUBCHANNEL_UNREF(slot, "churn");
+      slot = CreateSubchannel(next_address++);
+    }
+    exec_ctx.Flush();
+  }
+  for (grpc_subchannel* subchannel : subchannels) {
+    GRPC_SUBCHANNEL_UNREF(subchannel, "done");
+  }
+  exec_ctx.Flush();
+  state.SetItemsProcessed(state.iterations() * churn);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ResolverUpdateChurn)->Arg(10000)->Arg(50000)->Arg(100000);
+
+// Looks up addresses that are already in the pool, as happens when a
+// resolver update repeats most of the previous addresses.
+static void BM_FindExisting(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  const int num_addresses = static_cast<int>(state.range(0));
+  std::vector<grpc_subchannel*> subchannels(num_addresses);
+  for (int i = 0; i < num_addresses; ++i) {
+    subchannels[i] = CreateSubchannel(i);
+  }
+  int next_address = 0;
+  while (state.KeepRunning()) {
+    grpc_subchannel* subchannel = CreateSubchannel(next_address);
+    next_address = (next_address + 1) % num_addresses;
+    GRPC_SUBCHANNEL_UNREF(subchannel, "find");
+  }
+  for (grpc_subchannel* subchannel : subchannels) {
+    GRPC_SUBCHANNEL_UNREF(subchannel, "done");
+  }
+  exec_ctx.Flush();
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_FindExisting)->Arg(10000)->Arg(50000)->Arg(100000);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
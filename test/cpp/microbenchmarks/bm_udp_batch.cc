@@ -0,0 +1,135 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Loopback UDP throughput: one sendmsg()/recvmsg() per datagram versus
+   GrpcUdpDatagramBatch, which moves a whole batch per system call. */
+
+#include <benchmark/benchmark.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+#include "src/core/lib/iomgr/socket_utils_posix.h"
+#include "src/core/lib/iomgr/udp_server.h"
+
+namespace grpc {
+namespace testing {
+
+auto& force_library_initialization = Library::get();
+
+constexpr size_t kDatagramSize = 256;
+
+// A pair of non-blocking UDP sockets bound to the loopback interface, sending
+// from fds[0] to fds[1].
+class LoopbackPair {
+ public:
+  LoopbackPair() {
+    for (int i = 0; i < 2; i++) {
+      struct sockaddr_in* addr =
+          reinterpret_cast<struct sockaddr_in*>(addr_.addr);
+      memset(&addr_, 0, sizeof(addr_));
+      addr->sin_family = AF_INET;
+      addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      fds[i] = socket(AF_INET, SOCK_DGRAM, 0);
+      GPR_ASSERT(fds[i] >= 0);
+      GPR_ASSERT(bind(fds[i], reinterpret_cast<struct sockaddr*>(addr),
+                      sizeof(*addr)) == 0);
+      GPR_ASSERT(grpc_set_socket_nonblocking(fds[i], 1) == GRPC_ERROR_NONE);
+    }
+    addr_.len = static_cast<socklen_t>(sizeof(addr_.addr));
+    GPR_ASSERT(getsockname(fds[1], reinterpret_cast<struct sockaddr*>(
+                                       addr_.addr),
+                           &addr_.len) == 0);
+  }
+  ~LoopbackPair() {
+    close(fds[0]);
+    close(fds[1]);
+  }
+
+  const grpc_resolved_address* receiver() const { return &addr_; }
+
+  int fds[2];
+
+ private:
+  grpc_resolved_address addr_;
+};
+
+static void BM_UdpSendRecvSingle(benchmark::State& state) {
+  const int batch_size = state.range(0);
+  TrackCounters track_counters;
+  LoopbackPair pair;
+  char buffer[kDatagramSize] = {};
+  const struct sockaddr* to =
+      reinterpret_cast<const struct sockaddr*>(pair.receiver()->addr);
+  while (state.KeepRunning()) {
+    for (int i = 0; i < batch_size; i++) {
+      GPR_ASSERT(sendto(pair.fds[0], buffer, sizeof(buffer), 0, to,
+                        pair.receiver()->len) == sizeof(buffer));
+    }
+    for (int i = 0; i < batch_size; i++) {
+      GPR_ASSERT(recv(pair.fds[1], buffer, sizeof(buffer), 0) ==
+                 sizeof(buffer));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size);
+  state.SetBytesProcessed(state.iterations() * batch_size * kDatagramSize);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_UdpSendRecvSingle)->Range(1, 64);
+
+static void BM_UdpSendRecvBatch(benchmark::State& state) {
+  const int batch_size = state.range(0);
+  TrackCounters track_counters;
+  LoopbackPair pair;
+  char buffer[kDatagramSize] = {};
+  GrpcUdpDatagramBatch send_batch(batch_size, kDatagramSize);
+  GrpcUdpDatagramBatch recv_batch(batch_size, kDatagramSize);
+  while (state.KeepRunning()) {
+    for (int i = 0; i < batch_size; i++) {
+      send_batch.Add(buffer, sizeof(buffer), pair.receiver());
+    }
+    GPR_ASSERT(send_batch.SendTo(pair.fds[0]) == batch_size);
+    GPR_ASSERT(recv_batch.RecvFrom(pair.fds[1]) == batch_size);
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size);
+  state.SetBytesProcessed(state.iterations() * batch_size * kDatagramSize);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_UdpSendRecvBatch)->Range(1, 64);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -19,6 +19,8 @@
 #ifndef TEST_CPP_MICROBENCHMARKS_FULLSTACK_CONTEXT_MUTATORS_H
 #define TEST_CPP_MICROBENCHMARKS_FULLSTACK_CONTEXT_MUTATORS_H
 
+#include <chrono>
+
 #include <grpc/support/log.h>
 #include <grpcpp/channel.h>
 #include <grpcpp/create_channel.h>
@@ -111,6 +113,15 @@ class Client_AddMetadata : public NoOpMutator {
   }
 };
 
+template <int kDeadlineSeconds>
+class Client_SetDeadline : public NoOpMutator {
+ public:
+  Client_SetDeadline(ClientContext* context) : NoOpMutator(context) {
+    context->set_deadline(std::chrono::system_clock::now() +
+                          std::chrono::seconds(kDeadlineSeconds));
+  }
+};
+
 template <class Generator, int kNumKeys>
 class Server_AddInitialMetadata : public NoOpMutator {
  public:
@@ -23,6 +23,7 @@
 #include <grpc/support/log.h>
 #include <grpcpp/channel.h>
 #include <grpcpp/create_channel.h>
+#include <grpcpp/impl/codegen/client_interceptor.h>
 #include <grpcpp/security/credentials.h>
 #include <grpcpp/security/server_credentials.h>
 #include <grpcpp/server.h>
@@ -58,6 +59,14 @@ class FixtureConfiguration {
     b->SetMaxReceiveMessageSize(INT_MAX);
     b->SetMaxSendMessageSize(INT_MAX);
   }
+
+  // Only honored by the endpoint pair fixtures
+  virtual std::vector<
+      std::unique_ptr<experimental::ClientInterceptorFactoryInterface>>
+  CreateClientInterceptors() const {
+    return std::vector<
+        std::unique_ptr<experimental::ClientInterceptorFactoryInterface>>();
+  }
 };
 
 class BaseFixture : public TrackCounters {};
@@ -219,9 +228,7 @@ class EndpointPairFixture : public BaseFixture {
       grpc_chttp2_transport_start_reading(client_transport_, nullptr, nullptr);
 
       channel_ = CreateChannelInternal(
-          "", channel,
-          std::vector<std::unique_ptr<
-              experimental::ClientInterceptorFactoryInterface>>());
+          "", channel, fixture_configuration.CreateClientInterceptors());
     }
   }
 
@@ -342,6 +349,92 @@ typedef MinStackize<InProcess> MinInProcess;
 typedef MinStackize<SockPair> MinSockPair;
 typedef MinStackize<InProcessCHTTP2> MinInProcessCHTTP2;
 
+// Sets SO_BUSY_POLL on the sockets of both ends. Meant to be run under
+// GRPC_POLL_STRATEGY=epoll1-busy and compared with TCP under the default one.
+class BusyPollConfiguration : public FixtureConfiguration {
+  void ApplyCommonChannelArguments(ChannelArguments* a) const override {
+    a->SetInt(GRPC_ARG_SOCKET_BUSY_POLL_US, 50);
+    FixtureConfiguration::ApplyCommonChannelArguments(a);
+  }
+
+  void ApplyCommonServerBuilderConfig(ServerBuilder* b) const override {
+    b->AddChannelArgument(GRPC_ARG_SOCKET_BUSY_POLL_US, 50);
+    FixtureConfiguration::ApplyCommonServerBuilderConfig(b);
+  }
+};
+
+class BusyPollTCP : public TCP {
+ public:
+  BusyPollTCP(Service* service) : TCP(service, BusyPollConfiguration()) {}
+};
+
+// Marks the Echo method as cacheable in the server's service config, so that
+// every call after the first is answered from the server response cache
+// without reaching the application: use with BM_UnaryPingPongCached.
+class ResponseCacheConfiguration : public FixtureConfiguration {
+  void ApplyCommonServerBuilderConfig(ServerBuilder* b) const override {
+    b->AddChannelArgument(
+        GRPC_ARG_SERVICE_CONFIG,
+        "{\"methodConfig\": [{"
+        "\"name\": [{\"service\": \"grpc.testing.EchoTestService\", "
+        "\"method\": \"Echo\"}], "
+        "\"responseCacheTtl\": \"3600s\"}]}");
+    FixtureConfiguration::ApplyCommonServerBuilderConfig(b);
+  }
+};
+
+class InProcessCHTTP2WithResponseCache : public InProcessCHTTP2 {
+ public:
+  InProcessCHTTP2WithResponseCache(Service* service)
+      : InProcessCHTTP2(service, ResponseCacheConfiguration()) {}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Intercepted fixtures
+
+// Interceptor that observes every batch without modifying it, used to measure
+// the cost of the interception machinery itself
+class PassthroughInterceptor : public experimental::Interceptor {
+ public:
+  void Intercept(experimental::InterceptorBatchMethods* methods) override {
+    methods->Proceed();
+  }
+};
+
+class PassthroughInterceptorFactory
+    : public experimental::ClientInterceptorFactoryInterface {
+ public:
+  experimental::Interceptor* CreateClientInterceptor(
+      experimental::ClientRpcInfo* info) override {
+    return new PassthroughInterceptor;
+  }
+};
+
+template <int kNumInterceptors>
+class InterceptorConfiguration : public FixtureConfiguration {
+  std::vector<std::unique_ptr<experimental::ClientInterceptorFactoryInterface>>
+  CreateClientInterceptors() const override {
+    std::vector<
+        std::unique_ptr<experimental::ClientInterceptorFactoryInterface>>
+        creators;
+    for (int i = 0; i < kNumInterceptors; i++) {
+      creators.push_back(std::unique_ptr<PassthroughInterceptorFactory>(
+          new PassthroughInterceptorFactory()));
+    }
+    return creators;
+  }
+};
+
+template <class Base, int kNumInterceptors>
+class Interceptize : public Base {
+ public:
+  Interceptize(Service* service)
+      : Base(service, InterceptorConfiguration<kNumInterceptors>()) {}
+};
+
+typedef Interceptize<InProcessCHTTP2, 1> InProcessCHTTP2WithInterceptor;
+typedef Interceptize<InProcessCHTTP2, 4> InProcessCHTTP2With4Interceptors;
+
 }  // namespace testing
 }  // namespace grpc
 
@@ -22,7 +22,10 @@
 #define TEST_CPP_MICROBENCHMARKS_FULLSTACK_UNARY_PING_PONG_H
 
 #include <benchmark/benchmark.h>
+#include <algorithm>
 #include <sstream>
+#include <type_traits>
+#include <vector>
 #include "src/core/lib/profiling/timers.h"
 #include "src/proto/grpc/testing/echo.grpc.pb.h"
 #include "test/cpp/microbenchmarks/fullstack_context_mutators.h"
@@ -37,6 +40,16 @@ namespace testing {
 
 static void* tag(intptr_t x) { return reinterpret_cast<void*>(x); }
 
+// Fixtures whose BM_UnaryPingPong runs are labelled with p50_us and p99_us.
+// Timing each RPC costs two clock reads per iteration, so the other fixtures
+// skip it.
+template <class Fixture>
+struct ReportsLatencyPercentiles : std::false_type {};
+template <>
+struct ReportsLatencyPercentiles<TCP> : std::true_type {};
+template <>
+struct ReportsLatencyPercentiles<BusyPollTCP> : std::true_type {};
+
 template <class Fixture, class ClientContextMutator, class ServerContextMutator>
 static void BM_UnaryPingPong(benchmark::State& state) {
   EchoTestService::AsyncService service;
@@ -71,8 +84,14 @@ static void BM_UnaryPingPong(benchmark::State& state) {
                       fixture->cq(), tag(1));
   std::unique_ptr<EchoTestService::Stub> stub(
       EchoTestService::NewStub(fixture->channel()));
+  // Per-RPC latencies, in microseconds, for the percentile labels
+  const bool time_rpcs = ReportsLatencyPercentiles<Fixture>::value;
+  std::vector<double> latencies;
+  if (time_rpcs) latencies.reserve(state.max_iterations);
   while (state.KeepRunning()) {
     GPR_TIMER_SCOPE("BenchmarkCycle", 0);
+    const gpr_timespec start =
+        time_rpcs ? gpr_now(GPR_CLOCK_MONOTONIC) : gpr_timespec();
     recv_response.Clear();
     ClientContext cli_ctx;
     ClientContextMutator cli_ctx_mut(&cli_ctx);
@@ -96,12 +115,23 @@ static void BM_UnaryPingPong(benchmark::State& state) {
       i -= 1 << tagnum;
     }
     GPR_ASSERT(recv_status.ok());
+    if (time_rpcs) {
+      latencies.push_back(gpr_timespec_to_micros(
+          gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start)));
+    }
 
     senv->~ServerEnv();
     senv = new (senv) ServerEnv();
     service.RequestEcho(&senv->ctx, &senv->recv_request, &senv->response_writer,
                         fixture->cq(), fixture->cq(), tag(slot));
   }
+  if (!latencies.empty()) {
+    std::sort(latencies.begin(), latencies.end());
+    std::ostringstream label;
+    label << "p50_us:" << latencies[latencies.size() / 2]
+          << " p99_us:" << latencies[latencies.size() * 99 / 100];
+    fixture->AddLabel(label.str());
+  }
   fixture->Finish(state);
   fixture.reset();
   server_env[0]->~ServerEnv();
@@ -109,6 +139,71 @@ static void BM_UnaryPingPong(benchmark::State& state) {
   state.SetBytesProcessed(state.range(0) * state.iterations() +
                           state.range(1) * state.iterations());
 }
+
+// For fixtures whose server answers repeated requests from its response
+// cache: only the first call reaches the application, and it is made before
+// timing starts. Every timed call is answered from the cache, so the loop only
+// waits for the client's completion.
+template <class Fixture, class ClientContextMutator>
+static void BM_UnaryPingPongCached(benchmark::State& state) {
+  EchoTestService::AsyncService service;
+  std::unique_ptr<Fixture> fixture(new Fixture(&service));
+  EchoRequest send_request;
+  EchoResponse send_response;
+  EchoResponse recv_response;
+  if (state.range(0) > 0) {
+    send_request.set_message(std::string(state.range(0), 'a'));
+  }
+  if (state.range(1) > 0) {
+    send_response.set_message(std::string(state.range(1), 'a'));
+  }
+  Status recv_status;
+  std::unique_ptr<EchoTestService::Stub> stub(
+      EchoTestService::NewStub(fixture->channel()));
+  void* t;
+  bool ok;
+  {
+    ServerContext svr_ctx;
+    EchoRequest recv_request;
+    grpc::ServerAsyncResponseWriter<EchoResponse> response_writer(&svr_ctx);
+    service.RequestEcho(&svr_ctx, &recv_request, &response_writer,
+                        fixture->cq(), fixture->cq(), tag(0));
+    ClientContext cli_ctx;
+    std::unique_ptr<ClientAsyncResponseReader<EchoResponse>> response_reader(
+        stub->AsyncEcho(&cli_ctx, send_request, fixture->cq()));
+    response_reader->Finish(&recv_response, &recv_status, tag(4));
+    GPR_ASSERT(fixture->cq()->Next(&t, &ok));
+    GPR_ASSERT(ok);
+    GPR_ASSERT(t == tag(0));
+    response_writer.Finish(send_response, Status::OK, tag(3));
+    for (int i = (1 << 3) | (1 << 4); i != 0;) {
+      GPR_ASSERT(fixture->cq()->Next(&t, &ok));
+      GPR_ASSERT(ok);
+      int tagnum = static_cast<int>(reinterpret_cast<intptr_t>(t));
+      GPR_ASSERT(i & (1 << tagnum));
+      i -= 1 << tagnum;
+    }
+    GPR_ASSERT(recv_status.ok());
+  }
+  while (state.KeepRunning()) {
+    GPR_TIMER_SCOPE("BenchmarkCycle", 0);
+    recv_response.Clear();
+    ClientContext cli_ctx;
+    ClientContextMutator cli_ctx_mut(&cli_ctx);
+    std::unique_ptr<ClientAsyncResponseReader<EchoResponse>> response_reader(
+        stub->AsyncEcho(&cli_ctx, send_request, fixture->cq()));
+    response_reader->Finish(&recv_response, &recv_status, tag(4));
+    GPR_ASSERT(fixture->cq()->Next(&t, &ok));
+    GPR_ASSERT(ok);
+    GPR_ASSERT(t == tag(4));
+    GPR_ASSERT(recv_status.ok());
+  }
+  fixture->Finish(state);
+  fixture.reset();
+  state.SetBytesProcessed(state.range(0) * state.iterations() +
+                          state.range(1) * state.iterations());
+}
+
 }  // namespace testing
 }  // namespace grpc
 
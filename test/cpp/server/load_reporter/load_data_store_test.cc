@@ -348,6 +348,40 @@ TEST_F(LoadDataStoreTest, UnknownBalancerIdTracking) {
   EXPECT_TRUE(load_data_store.IsTrackedUnknownBalancerId(kLbId3));
 }
 
+TEST_F(LoadDataStoreTest, MergeRows) {
+  LoadDataStore load_data_store;
+  load_data_store.ReportStreamCreated(kHostname1, kLbId1, kLoadKey1);
+  load_data_store.ReportStreamCreated(kHostname2, kLbId2, kLoadKey1);
+  const LoadRecordKey key3(kLbId1, kLbTag2, kUser2, kClientIp1);
+  const LoadRecordKey unknown_key(kLbId3, kLbTag1, kUser1, kClientIp1);
+  std::vector<LoadDataStore::Row> rows;
+  rows.emplace_back(kHostname1, kKey1, LoadRecordValue(10));
+  rows.emplace_back(kHostname1, key3, LoadRecordValue(20));
+  rows.emplace_back(kHostname1, kKey1, LoadRecordValue(0, 4, 1));
+  rows.emplace_back(kHostname2, kKey2, LoadRecordValue(30));
+  // Same LB ID as the previous row, but a different host.
+  rows.emplace_back(kHostname1, kKey2, LoadRecordValue(40));
+  rows.emplace_back(kHostname1, unknown_key, LoadRecordValue(50));
+  load_data_store.MergeRows(rows);
+  auto store_lb_id_1 = load_data_store.FindPerBalancerStore(kHostname1, kLbId1);
+  EXPECT_EQ(store_lb_id_1->load_record_map().size(), 2U);
+  const LoadRecordValue& value1 =
+      store_lb_id_1->load_record_map().find(kKey1)->second;
+  EXPECT_EQ(value1.start_count(), 10U);
+  EXPECT_EQ(value1.ok_count(), 4U);
+  EXPECT_EQ(value1.error_count(), 1U);
+  EXPECT_EQ(store_lb_id_1->load_record_map().find(key3)->second.start_count(),
+            20U);
+  EXPECT_EQ(store_lb_id_1->GetNumCallsInProgressForReport(), 25U);
+  auto store_lb_id_2 = load_data_store.FindPerBalancerStore(kHostname2, kLbId2);
+  EXPECT_EQ(store_lb_id_2->load_record_map().size(), 1U);
+  EXPECT_EQ(store_lb_id_2->load_record_map().find(kKey2)->second.start_count(),
+            30U);
+  EXPECT_TRUE(load_data_store.IsTrackedUnknownBalancerId(kLbId3));
+  EXPECT_TRUE(load_data_store.IsTrackedUnknownBalancerId(kLbId2));
+  EXPECT_EQ(load_data_store.FindPerBalancerStore(kHostname1, kLbId2), nullptr);
+}
+
 TEST_F(PerBalancerStoreTest, Suspend) {
   PerBalancerStore per_balancer_store(kLbId1, kLoadKey1);
   EXPECT_FALSE(per_balancer_store.IsSuspended());
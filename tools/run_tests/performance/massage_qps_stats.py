@@ -38,6 +38,12 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_client_subchannels_created"] = massage_qps_stats_helpers.counter(
                     core_stats, "client_subchannels_created")
+            stats[
+                "core_client_coalesced_call_groups"] = massage_qps_stats_helpers.counter(
+                    core_stats, "client_coalesced_call_groups")
+            stats[
+                "core_client_calls_coalesced"] = massage_qps_stats_helpers.counter(
+                    core_stats, "client_calls_coalesced")
             stats[
                 "core_server_channels_created"] = massage_qps_stats_helpers.counter(
                     core_stats, "server_channels_created")
@@ -56,12 +62,21 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_pollset_kick_wakeup_fd"] = massage_qps_stats_helpers.counter(
                     core_stats, "pollset_kick_wakeup_fd")
+            stats[
+                "core_pollset_kick_wakeup_fd_coalesced"] = massage_qps_stats_helpers.counter(
+                    core_stats, "pollset_kick_wakeup_fd_coalesced")
             stats[
                 "core_pollset_kick_wakeup_cv"] = massage_qps_stats_helpers.counter(
                     core_stats, "pollset_kick_wakeup_cv")
             stats[
                 "core_pollset_kick_own_thread"] = massage_qps_stats_helpers.counter(
                     core_stats, "pollset_kick_own_thread")
+            stats[
+                "core_pollset_worker_spin_kicked"] = massage_qps_stats_helpers.counter(
+                    core_stats, "pollset_worker_spin_kicked")
+            stats[
+                "core_pollset_worker_park"] = massage_qps_stats_helpers.counter(
+                    core_stats, "pollset_worker_park")
             stats["core_syscall_epoll_ctl"] = massage_qps_stats_helpers.counter(
                 core_stats, "syscall_epoll_ctl")
             stats[
@@ -308,6 +323,18 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_server_slowpath_requests_queued"] = massage_qps_stats_helpers.counter(
                     core_stats, "server_slowpath_requests_queued")
+            stats[
+                "core_server_response_cache_hits"] = massage_qps_stats_helpers.counter(
+                    core_stats, "server_response_cache_hits")
+            stats[
+                "core_server_response_cache_misses"] = massage_qps_stats_helpers.counter(
+                    core_stats, "server_response_cache_misses")
+            stats[
+                "core_server_response_cache_inserts"] = massage_qps_stats_helpers.counter(
+                    core_stats, "server_response_cache_inserts")
+            stats[
+                "core_server_response_cache_evictions"] = massage_qps_stats_helpers.counter(
+                    core_stats, "server_response_cache_evictions")
             stats[
                 "core_cq_ev_queue_trylock_failures"] = massage_qps_stats_helpers.counter(
                     core_stats, "cq_ev_queue_trylock_failures")
@@ -509,3 +536,18 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_server_cqs_checked_99p"] = massage_qps_stats_helpers.percentile(
                     h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "grpclb_pick_queue_time_ms")
+            stats["core_grpclb_pick_queue_time_ms"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_grpclb_pick_queue_time_ms_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_grpclb_pick_queue_time_ms_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_grpclb_pick_queue_time_ms_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_grpclb_pick_queue_time_ms_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)